@@ -53,32 +53,38 @@ udm::Array &udm::Array::operator=(Array &&other)
 {
 	if(this == &other)
 		return *this;
+	PrepareWrite(true);
 	Clear();
 	m_valueType = other.m_valueType;
 	m_size = other.m_size;
 	m_values = other.m_values;
+	m_storage = other.m_storage;
+	m_externalValues = std::move(other.m_externalValues);
 	fromProperty = other.fromProperty;
 
 	other.m_values = nullptr;
 	other.m_size = 0;
 	other.m_valueType = Type::Nil;
-	static_assert(sizeof(*this) == 40, "Update this function when the struct has changed!");
+	other.m_storage = Storage::Internal;
+	static_assert(sizeof(*this) == 56, "Update this function when the struct has changed!");
 	return *this;
 }
 udm::Array &udm::Array::operator=(const Array &other)
 {
 	if(this == &other)
 		return *this;
+	PrepareWrite(true);
 	Clear();
 	SetValueType(other.m_valueType);
 	Merge(other);
 	fromProperty = other.fromProperty;
-	static_assert(sizeof(*this) == 40, "Update this function when the struct has changed!");
+	static_assert(sizeof(*this) == 56, "Update this function when the struct has changed!");
 	return *this;
 }
 
 void udm::Array::Merge(const Array &other, MergeFlags mergeFlags)
 {
+	PrepareWrite();
 	if(pragma::math::is_flag_set(mergeFlags, MergeFlags::OverwriteExisting) || GetValueType() != other.GetValueType()) { // TODO: Copy files if compatible?
 		Clear();
 		SetValueType(other.GetValueType());
@@ -120,6 +126,7 @@ void udm::Array::SetValueType(Type valueType)
 {
 	if(valueType == m_valueType)
 		return;
+	PrepareWrite(true);
 	Clear();
 	m_valueType = valueType;
 	Resize(GetSize());
@@ -128,6 +135,20 @@ void udm::Array::SetValueType(Type valueType)
 uint32_t udm::Array::GetValueSize() const { return (m_valueType == Type::Struct) ? GetStructuredDataInfo()->GetDataSizeRequirement() : size_of_base_type(m_valueType); }
 
 void *udm::Array::GetValuePtr(uint32_t idx) { return static_cast<uint8_t *>(GetValues()) + idx * GetValueSize(); }
+const void *udm::Array::GetValuePtr(uint32_t idx) const { return static_cast<const uint8_t *>(GetValues()) + idx * GetValueSize(); }
+
+void udm::Array::PrepareWrite(bool discardValues)
+{
+	if(fromProperty.prop)
+		fromProperty.prop->Unshare();
+	if(m_storage != Storage::BorrowedReadOnly || discardValues)
+		return;
+	auto size = GetByteSize();
+	auto *values = AllocateData(size);
+	memcpy(values, m_values, size);
+	m_values = values;
+	m_storage = Storage::Internal;
+}
 
 void udm::Array::SetValue(uint32_t idx, const void *value)
 {
@@ -163,8 +184,8 @@ void udm::Array::Resize(uint32_t newSize, Range r0, Range r1, bool defaultInitia
 	auto isStructType = (m_valueType == Type::Struct);
 	if(newSize == m_size && (!isStructType || m_values))
 		return;
-	if(GetArrayType() == udm::ArrayType::Compressed)
-		static_cast<udm::ArrayLz4 *>(this)->GetValues(); // Force decompression
+	PrepareWrite(true); // The values are copied into new storage below
+	LoadValues();       // Force decompression
 	auto headerSize = GetHeaderSize();
 	auto cpyData = [&r0, &r1](const void *curValues, void *dataPtr, uint32_t sizeOfElement, void (*fCpy)(const void *, void *, uint32_t, uint32_t, uint32_t, uint32_t)) {
 		if(std::get<0>(r1) == std::get<0>(r0) + std::get<2>(r0) && std::get<1>(r1) == std::get<1>(r0) + std::get<2>(r0))  // Check if no gap between both ranges (i.e. startSrc1 = startSrc0 +count0)
@@ -183,7 +204,7 @@ void udm::Array::Resize(uint32_t newSize, Range r0, Range r1, bool defaultInitia
 			  //for(auto i=decltype(newSize){0u};i<newSize;++i)
 			  //	new (&newValues[i]) T{};
 			  auto *dataPtr = reinterpret_cast<T *>(newValues);
-			  auto *curValues = GetValues();
+			  auto *curValues = LoadValues();
 			  if(curValues) {
 				  auto numCpy = pragma::math::min(newSize, m_size);
 				  cpyData(curValues, dataPtr, 0, copy_non_trivial_data<T>);
@@ -227,7 +248,7 @@ void udm::Array::Resize(uint32_t newSize, Range r0, Range r1, bool defaultInitia
 		if(strct)
 			**reinterpret_cast<StructDescription **>(newValues) = std::move(*strct);
 	}
-	auto *curValues = GetValues();
+	auto *curValues = LoadValues();
 	if(curValues) {
 		auto *dataPtr = newValues;
 		if(isStructType)
@@ -269,6 +290,14 @@ void udm::Array::RemoveValueRange(uint32_t startIndex, uint32_t count)
 }
 
 udm::PropertyWrapper udm::Array::operator[](uint32_t idx) { return PropertyWrapper {*this, idx}; }
+const udm::PropertyWrapper udm::Array::operator[](uint32_t idx) const { return PropertyWrapper {const_cast<Array &>(*this), idx}; }
+
+void udm::Array::ThrowAccessError(AccessError err, uint32_t idx, Type requestedType) const
+{
+	if(err == AccessError::OutOfBounds)
+		throw OutOfBoundsError {"Array index " + std::to_string(idx) + " out of bounds of array of size " + std::to_string(m_size) + "!"};
+	throw LogicError {"Attempted to retrieve value of type " + std::string {magic_enum::enum_name(requestedType)} + " from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
+}
 
 void *udm::Array::GetValuePtr() { return m_values && m_size > 0 ? (static_cast<uint8_t *>(m_values) + GetHeaderSize()) : nullptr; }
 void *udm::Array::GetHeaderPtr() { return (GetHeaderSize() > 0 && m_values) ? m_values : nullptr; }
@@ -329,10 +358,19 @@ uint8_t *udm::Array::AllocateData(uint64_t size) const
 }
 void udm::Array::ReleaseValues()
 {
+	if(m_storage != Storage::Internal) {
+		// External buffers are released by their owner (if any)
+		m_externalValues = nullptr;
+		m_storage = Storage::Internal;
+		m_values = nullptr;
+		return;
+	}
 	if(m_values == nullptr)
 		return;
 	if(m_valueType == Type::Struct)
 		delete *static_cast<StructDescription **>(m_values);
+	else if(m_valueType == Type::Element || is_array_type(m_valueType))
+		invalidate_path_caches(*this); // Items may be referenced by path caches
 
 	if(is_non_trivial_type(m_valueType) && m_valueType != Type::Struct) // Structs are a special case where the array data only consists of trivial types; No destructor required
 	{
@@ -352,6 +390,35 @@ void udm::Array::ReleaseValues()
 	m_values = nullptr;
 }
 
+void udm::Array::SetExternalValues(Type valueType, void *values, uint32_t size, std::shared_ptr<void> owner, Storage storage)
+{
+	if(GetArrayType() != ArrayType::Raw)
+		throw InvalidUsageError {"External buffers are not supported for compressed arrays!"};
+	if(!is_trivial_type(valueType) || valueType == Type::Nil)
+		throw InvalidUsageError {"External buffers are only supported for arrays of trivial types, but value type is " + std::string {magic_enum::enum_name(valueType)} + "!"};
+	if(size > 0 && values == nullptr)
+		throw InvalidUsageError {"External buffer must not be null!"};
+	PrepareWrite(true);
+	Clear();
+	m_valueType = valueType;
+	m_size = 0;
+	if(size == 0)
+		return; // Nothing to reference, the owner (if any) releases the buffer immediately
+	m_values = values;
+	m_size = size;
+	m_storage = storage;
+	m_externalValues = std::move(owner);
+}
+void udm::Array::AdoptValues(Type valueType, void *values, uint32_t size, std::function<void(void *)> deleter)
+{
+	if(!deleter)
+		throw InvalidUsageError {"Adopted buffer requires a deleter, use BorrowValues for non-owning buffers!"};
+	std::shared_ptr<void> owner {values, std::move(deleter)};
+	SetExternalValues(valueType, values, size, std::move(owner), Storage::External);
+}
+void udm::Array::BorrowValues(Type valueType, void *values, uint32_t size) { SetExternalValues(valueType, values, size, nullptr, Storage::Borrowed); }
+void udm::Array::BorrowValues(Type valueType, const void *values, uint32_t size) { SetExternalValues(valueType, const_cast<void *>(values), size, nullptr, Storage::BorrowedReadOnly); }
+
 //////////////////
 
 void udm::ArrayLz4::InitializeSize(uint32_t size) { m_size = size; }
@@ -427,10 +494,9 @@ void udm::ArrayLz4::Compress()
 		auto n = GetSize();
 		StreamData f {};
 		f.IFile::Write<uint32_t>(n);
-		for(auto it = begin<Element>(); it != end<Element>(); ++it) {
-			auto &el = *it;
-			Property::Write(f, el);
-		}
+		auto *elements = static_cast<const Element *>(p);
+		for(auto i = decltype(n) {0u}; i < n; ++i)
+			Property::Write(f, elements[i]);
 		auto &ds = f.GetDataStream();
 		m_compressedBlob = udm::compress_lz4_blob(ds->GetData(), ds->GetInternalSize());
 		if(!pragma::math::is_flag_set(m_flags, Flags::PersistentUncompressedData))
@@ -494,8 +560,11 @@ void udm::ArrayLz4::Decompress()
 		auto numElements = f.IFile::Read<uint32_t>();
 		m_values = AllocateData(numElements * sizeof(Element));
 		auto prop = fromProperty;
-		for(auto i = decltype(numElements) {0u}; i < numElements; ++i)
-			prop->Read(f, GetValue<Element>(i));
+		auto *elements = static_cast<Element *>(GetValuePtr());
+		for(auto i = decltype(numElements) {0u}; i < numElements; ++i) {
+			elements[i].fromProperty = PropertyWrapper {*this, i};
+			prop->Read(f, elements[i]);
+		}
 		m_compressedBlob = {};
 		return;
 	}
@@ -548,12 +617,14 @@ udm::ArrayLz4 &udm::ArrayLz4::operator=(const Array &other)
 }
 udm::ArrayLz4 &udm::ArrayLz4::operator=(ArrayLz4 &&other)
 {
+	PrepareWrite();
 	m_compressedBlob = std::move(other.m_compressedBlob);
 	Array::operator=(std::move(other));
 	return *this;
 }
 udm::ArrayLz4 &udm::ArrayLz4::operator=(const ArrayLz4 &other)
 {
+	PrepareWrite();
 	m_compressedBlob = other.m_compressedBlob;
 	Array::operator=(other);
 	return *this;
@@ -569,10 +640,24 @@ udm::BlobLz4 &udm::ArrayLz4::GetCompressedBlob()
 	Compress();
 	return m_compressedBlob;
 }
-void *udm::ArrayLz4::GetValues()
+void *udm::ArrayLz4::LoadValues()
 {
 	Decompress();
-	return Array::GetValues();
+	return Array::LoadValues();
+}
+bool udm::ArrayLz4::CopyCompressed(const ArrayLz4 &other)
+{
+	if(!pragma::math::is_flag_set(other.m_flags, Flags::Compressed) || other.GetValuePtr())
+		return false;
+	PrepareWrite();
+	Clear();
+	m_valueType = other.m_valueType;
+	m_size = other.m_size;
+	m_compressedBlob = other.m_compressedBlob;
+	if(other.m_structuredDataInfo)
+		m_structuredDataInfo = std::make_unique<StructDescription>(*other.m_structuredDataInfo);
+	pragma::math::set_flag(m_flags, Flags::Compressed);
+	return true;
 }
 void udm::ArrayLz4::Clear()
 {
@@ -5,6 +5,23 @@ module;
 
 #include <cassert>
 
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "text_scan.hpp"
+
 module pragma.udm;
 
 #ifndef UDM_SINGLE_MODULE_INTERFACE
@@ -14,14 +31,49 @@ import :core;
 namespace udm {
 	class AsciiReader {
 	  public:
-		static std::shared_ptr<udm::Data> LoadAscii(std::unique_ptr<IFile> &&f);
+		// Files of at least this size are parsed in parallel
+		static constexpr size_t PARALLEL_MIN_FILE_SIZE = 4 * 1024 * 1024;
+		// Smallest block that is parsed as a separate task
+		static constexpr size_t PARALLEL_MIN_BLOCK_SIZE = 64 * 1024;
+		// The data has to remain valid until the function returns
+		static std::shared_ptr<udm::Data> LoadAscii(const std::string_view &data);
+		// Writes the document in the binary format without building a property tree (see Data::TranscodeToBinary)
+		static void TranscodeToBinary(const std::string_view &data, IFile &out);
 	  private:
 		enum class BlockResult : uint8_t { EndOfBlock = 0, EndOfFile };
+		// Key-value or child block of a block, without its value
+		struct BlockEntry {
+			std::string_view key;
+			Type type = Type::Invalid;
+			const char *start = nullptr; // Character that starts the entry, i.e. the '$' or the block name
+		};
+		// Block that is parsed on the worker pool once the rest of the document has been read
+		struct DeferredBlock {
+			const char *start = nullptr; // Character after '{'
+			const char *end = nullptr;   // Character after the matching '}'
+			Element *element = nullptr;
+			// Items of element arrays are identified by index, since the array may still be resized while the document is read
+			Array *array = nullptr;
+			uint32_t index = 0;
+		};
+		struct ParallelState {
+			std::vector<std::pair<uint64_t, uint64_t>> blocks; // Offsets of all '{' and their matching '}', in document order
+			size_t minBlockSize = PARALLEL_MIN_BLOCK_SIZE;
+			size_t maxBlockSize = 0;
+			std::vector<DeferredBlock> deferred;
+		};
+		static void Read(const std::string_view &data, Element &root, ParallelState *parallel);
+		// Has to be called after the '{' of a block has been read. If the block is deferred, the cursor is moved past its end.
+		bool TryDeferBlock(Element *el, Array *a = nullptr, uint32_t index = 0);
 		template<class TException>
 		TException BuildException(const std::string &msg)
 		{
-			return TException {msg, m_curLine, (m_curCharPos > 0) ? (m_curCharPos - 1) : 0};
+			uint32_t line, column;
+			GetCursorPosition(line, column);
+			return TException {msg, line, column};
 		}
+		// Line and column of the last character that was read. These are only needed for error messages, so they're determined on demand.
+		void GetCursorPosition(uint32_t &outLine, uint32_t &outColumn) const;
 		char PeekNextChar();
 		char ReadUntil(char c, std::string_view *optOut = nullptr);
 		char ReadNextToken();
@@ -37,13 +89,92 @@ namespace udm {
 		void ReadTypedValueList(T &outData);
 		template<typename T>
 		void ReadFloatValueList(T &outData);
+		// Reads the items of a numeric array directly into the array memory, returns the number of values that were read
+		template<typename T>
+		uint32_t ReadNumericArrayValues(Array &a);
 		void ReadBlobData(std::vector<uint8_t> &outData);
 		BlockResult ReadBlockKeyValues(Element &parent);
 		char ReadChar();
 
-		std::unique_ptr<IFile> m_file;
-		uint32_t m_curCharPos = 0; // Current character relative to current line
-		uint32_t m_curLine = 0;
+		// Collects the entries of the current block without reading their values. The cursor is moved past the end of the block.
+		BlockResult ScanBlockEntries(std::vector<BlockEntry> &outEntries);
+		void SkipValue(Type type);
+		// Same as skip_ascii_group, but blocks are skipped using m_blocks if they have been determined, so that nested blocks are only scanned
+		// once instead of once for every parent block.
+		const char *SkipGroup(const char *p) const;
+		// Writes the entries as an element value, i.e. without the property type
+		void TranscodeElement(const std::vector<BlockEntry> &entries, IFile &out);
+		BlockResult TranscodeBlock(IFile &out);
+		void TranscodeEntry(IFile &out);
+		// Items of element arrays are written one at a time, instead of reading the entire array first. Returns false if the value is not an
+		// element array, in which case the cursor is left unchanged.
+		bool TryTranscodeElementArray(IFile &out);
+
+		const char *m_begin = nullptr;
+		const char *m_cur = nullptr;
+		const char *m_end = nullptr;
+		ParallelState *m_parallel = nullptr;
+		std::vector<std::pair<uint64_t, uint64_t>> m_blocks; // Offsets of all '{' and their matching '}', in document order (see TranscodeToBinary)
+		const void *m_propertyValue = nullptr; // Value of the property that is currently being read
+	};
+
+	// Writes the ASCII format through a fixed-size buffer, either to a file or a stream
+	class AsciiWriter : public TextWriter<AsciiWriter> {
+	  public:
+		static constexpr std::string_view LIST_SEPARATOR = "";
+		// Elements with at least this many children and element arrays with at least this many items are written in parallel,
+		// if enabled. Each task formats its items into a separate buffer, the buffers are then written in order.
+		static constexpr uint32_t PARALLEL_MIN_ITEMS_PER_TASK = 64;
+		static constexpr uint32_t PARALLEL_MIN_NUMERIC_VALUES_PER_TASK = 16 * 1024;
+		AsciiWriter(IFile &f, AsciiSaveFlags flags);
+		// 'prefix' is the indentation of the top level
+		AsciiWriter(std::stringstream &ss, AsciiSaveFlags flags, const std::string_view &prefix = {});
+		AsciiWriter(std::string &outStr, AsciiSaveFlags flags, const std::string_view &prefix = {});
+		void SetParallel(bool parallel) { m_parallel = parallel; }
+
+		void WriteElementChildren(const Element &el);
+		void WriteProperty(const std::string_view &name, Type type, const void *value);
+		void WriteValue(Type type, const void *value);
+		void WriteArrayValues(const Array &a);
+		// Writes binary data without building a property tree (see Data::TranscodeToAscii). The file cursor has to be at the root property.
+		void TranscodeBinary(IFile &f);
+	  private:
+		friend TextWriter<AsciiWriter>;
+		struct BinaryChild {
+			std::string key;
+			uint64_t offset = 0; // Offset of the property type
+		};
+		// Reads the keys and offsets of the children of the element value at the file cursor. The cursor is moved past the element.
+		static void ReadBinaryElementChildren(IFile &f, std::vector<BinaryChild> &outChildren);
+		void TranscodeBinaryElementChildren(IFile &f);
+		void TranscodeBinaryProperty(const std::string_view &name, IFile &f);
+		void WriteVariablePrefix(const std::string_view &name, Type type, const void *value);
+		// Calls writeItem(writer, i) for all items in [0, numItems) on the worker pool
+		template<typename TFunc>
+		void WriteParallel(uint32_t numItems, uint32_t minItemsPerTask, const TFunc &writeItem);
+		void WriteIndent() { Write(m_indent); }
+		void Indent() { m_indent += '\t'; }
+		void Unindent() { m_indent.pop_back(); }
+		void WriteQuoted(const std::string_view &str);
+		template<typename T>
+		void WriteNumber(T value);
+
+		void WriteValue(const Nil &nil) {}
+		void WriteValue(const Blob &blob);
+		void WriteValue(const BlobLz4 &blob);
+		void WriteValue(const Utf8String &utf8);
+		void WriteValue(const Element &el);
+		void WriteValue(const Array &a);
+		void WriteValue(const ArrayLz4 &a);
+		void WriteValue(const String &str);
+		void WriteValue(const Reference &ref);
+		void WriteValue(const Struct &strct);
+		using TextWriter::WriteValue;
+
+		AsciiSaveFlags m_flags = AsciiSaveFlags::None;
+		bool m_parallel = false;
+		// Shared by all levels, grows by one tab for each nested block
+		std::string m_indent;
 	};
 };
 
@@ -69,6 +200,61 @@ void udm::AsciiReader::ReadFloatValueList(T &outData)
 	ReadTypedValueList<T, float>(outData);
 }
 
+// Parses the number without allocating. Integers have the same results as with strtoll/strtoull: They're
+// parsed with 64 bits and then truncated to T, negative values wrap around for unsigned types, and values that don't fit into 64 bits
+// are clamped. Parsing stops at the first invalid character, invalid values (and floating point values outside of the range of double)
+// result in 0.
+template<typename T>
+static T parse_number(const std::string_view &str)
+{
+	if constexpr(std::is_same_v<T, udm::Half>)
+		return udm::Half {parse_number<float>(str)};
+	else {
+		auto *first = str.data();
+		auto *last = first + str.size();
+		auto negative = (first != last && *first == '-');
+		if(first != last && (*first == '+' || (negative && std::is_unsigned_v<T>)))
+			++first;
+		if constexpr(std::is_integral_v<T>) {
+			using TWide = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+			TWide value {};
+			if(std::from_chars(first, last, value).ec == std::errc::result_out_of_range)
+				value = (std::is_signed_v<T> && negative) ? std::numeric_limits<TWide>::lowest() : std::numeric_limits<TWide>::max();
+			else if constexpr(std::is_unsigned_v<T>) {
+				if(negative)
+					value = TWide {0} - value;
+			}
+			return static_cast<T>(value);
+		}
+		else {
+			double value {};
+			std::from_chars(first, last, value);
+			return static_cast<T>(value);
+		}
+	}
+}
+
+template<typename T>
+uint32_t udm::AsciiReader::ReadNumericArrayValues(Array &a)
+{
+	auto t = ReadNextToken();
+	if(t != '[')
+		throw BuildException<SyntaxError>("Expected '[' to initiate value list, got '" + std::string {t} + "'");
+	uint32_t numValues = 0;
+	for(;;) {
+		t = ReadNextToken();
+		if(t == ']')
+			return numValues;
+		if(t == std::char_traits<char>::eof())
+			throw BuildException<SyntaxError>("Unexpected EOF");
+		if(t == ',')
+			t = ReadNextToken();
+		if(numValues >= a.GetSize())
+			a.Resize(numValues * 2 + 20);
+		static_cast<T *>(a.GetValues())[numValues++] = parse_number<T>(ReadString(t));
+	}
+}
+
 void udm::AsciiReader::ReadTemplateParameterList(std::vector<Type> &outTypes, std::vector<std::string_view> &outNames)
 {
 	auto t = ReadNextToken();
@@ -141,9 +327,8 @@ void udm::AsciiReader::ReadValueList(Type type, const std::function<bool()> &val
 		else if(t == std::char_traits<char>::eof())
 			throw BuildException<SyntaxError>("Unexpected EOF");
 		if(t != ',') {
-			assert(m_curCharPos > 0);
-			--m_curCharPos;
-			m_file->Seek(m_file->Tell() - 1);
+			assert(m_cur > m_begin);
+			--m_cur;
 		}
 		else
 			SeekNextToken();
@@ -157,26 +342,15 @@ void udm::AsciiReader::ReadBlobData(std::vector<uint8_t> &outData)
 	auto t = ReadNextToken();
 	if(t != '[')
 		throw BuildException<SyntaxError>("Expected '[' to initiate blob data, got '" + std::string {t} + "'");
-	auto start = m_file->Tell();
-	ReadUntil(']');
-	auto end = m_file->Tell();
-	auto blobSize = end - start - 1;
-	std::string strData;
-	m_file->Seek(start);
-	strData.resize(blobSize);
-	auto numRead = m_file->Read(strData.data(), blobSize);
-	if(numRead != blobSize)
+	std::string_view encoded;
+	if(ReadUntil(']', &encoded) == std::char_traits<char>::eof())
 		throw BuildException<SyntaxError>("Unexpected end of blob data");
-	// TODO: Optimize this so no copy is required!
-	try {
-		auto decoded = pragma::util::base64_decode(strData);
-		outData.resize(decoded.size());
-		memcpy(outData.data(), decoded.data(), outData.size());
-	}
-	catch(const std::runtime_error &e) {
-		throw BuildException<DataError>(e.what());
-	}
-	MoveCursorForward(1); // Move past ']'
+	// Decode straight from the parse buffer into the final storage
+	outData.resize(base64_get_max_decoded_size(encoded.size()));
+	auto size = base64_decode(encoded, outData.data());
+	if(!size.has_value())
+		throw BuildException<DataError>("Invalid base64 blob data");
+	outData.resize(*size);
 }
 
 constexpr bool is_float_based_type(udm::Type type)
@@ -273,7 +447,7 @@ void udm::AsciiReader::ReadValue(Type type, void *outData)
 		auto vs = [this, outData](auto tag) {
 			using T = typename decltype(tag)::type;
 			if constexpr(!std::is_same_v<T, Half> && !std::is_same_v<T, Boolean>)
-				*static_cast<T *>(outData) = pragma::util::to_number<T>(ReadString());
+				*static_cast<T *>(outData) = parse_number<T>(ReadString());
 		};
 		std::visit(vs, get_numeric_tag(type));
 		return;
@@ -424,6 +598,20 @@ void udm::AsciiReader::ReadValue(Type type, void *outData)
 			auto szValue = a.GetValueSize();
 			a.Resize(*size);
 
+			if(is_numeric_type(valueType) && valueType != Type::Boolean) {
+				auto numValues = std::visit(
+				  [this, &a](auto tag) -> uint32_t {
+					  using T = typename decltype(tag)::type;
+					  if constexpr(!std::is_same_v<T, Boolean>)
+						  return ReadNumericArrayValues<T>(a);
+					  else
+						  return 0;
+				  },
+				  get_numeric_tag(valueType));
+				a.Resize(numValues);
+				break;
+			}
+
 			uint32_t numValues = 0;
 			std::function<void(uint32_t)> fReadValue = nullptr;
 			if(valueType == Type::Struct) {
@@ -433,6 +621,15 @@ void udm::AsciiReader::ReadValue(Type type, void *outData)
 					ReadStructValue(strct, p);
 				};
 			}
+			else if(valueType == Type::Element && m_parallel && outData == m_propertyValue) {
+				fReadValue = [this, &a](uint32_t idx) {
+					auto t = ReadNextToken();
+					if(t != '{')
+						throw BuildException<SyntaxError>("Expected '{' for array element block definition, got '" + std::string {t} + "'");
+					if(!TryDeferBlock(nullptr, &a, idx) && ReadBlockKeyValues(static_cast<Element *>(a.GetValues())[idx]) == BlockResult::EndOfFile)
+						throw BuildException<SyntaxError>("Unexpected end of file");
+				};
+			}
 			else {
 				fReadValue = [this, &a, valueType, szValue](uint32_t idx) {
 					auto *p = static_cast<uint8_t *>(a.GetValues()) + idx * szValue;
@@ -454,7 +651,7 @@ void udm::AsciiReader::ReadValue(Type type, void *outData)
 			break;
 		}
 	case Type::Half:
-		*static_cast<Half *>(outData) = pragma::util::to_number<float>(ReadString());
+		*static_cast<Half *>(outData) = parse_number<Half>(ReadString());
 		break;
 	case Type::Struct:
 		{
@@ -473,7 +670,6 @@ void udm::AsciiReader::ReadValue(Type type, void *outData)
 
 udm::AsciiReader::BlockResult udm::AsciiReader::ReadBlockKeyValues(Element &parent)
 {
-	auto &f = m_file;
 	for(;;) {
 		auto t = ReadNextToken();
 		if(t == '$') {
@@ -494,6 +690,7 @@ udm::AsciiReader::BlockResult udm::AsciiReader::ReadBlockKeyValues(Element &pare
 			}
 			auto key = ReadString(ReadNextToken());
 			SeekNextToken();
+			m_propertyValue = prop->value;
 			ReadValue(eType, prop->value);
 			parent.AddChild(std::string {key}, prop);
 			continue;
@@ -511,7 +708,8 @@ udm::AsciiReader::BlockResult udm::AsciiReader::ReadBlockKeyValues(Element &pare
 			throw BuildException<SyntaxError>("Expected '{' for child block definition, got '" + std::string {t} + "'");
 
 		auto child = Property::Create<Element>();
-		if(ReadBlockKeyValues(child->GetValue<Element>()) == BlockResult::EndOfFile)
+		auto &el = child->GetValue<Element>();
+		if(!TryDeferBlock(&el) && ReadBlockKeyValues(el) == BlockResult::EndOfFile)
 			throw BuildException<SyntaxError>("Unexpected end of file");
 		parent.AddChild(std::string {childBlockName}, child);
 	}
@@ -531,9 +729,10 @@ bool udm::Data::SaveAscii(const std::string &fileName, AsciiSaveFlags flags) con
 }
 bool udm::Data::SaveAscii(IFile &f, AsciiSaveFlags flags) const
 {
-	std::stringstream ss;
-	ToAscii(ss, flags);
-	f.WriteString(ss.str());
+	AsciiWriter writer {f, flags};
+	writer.SetParallel(true);
+	ToAscii(writer, flags);
+	writer.Flush();
 	return true;
 }
 bool udm::Data::SaveAscii(const pragma::fs::VFilePtr &f, AsciiSaveFlags flags) const
@@ -542,186 +741,734 @@ bool udm::Data::SaveAscii(const pragma::fs::VFilePtr &f, AsciiSaveFlags flags) c
 	return SaveAscii(fp, flags);
 }
 
-std::shared_ptr<udm::Data> udm::AsciiReader::LoadAscii(std::unique_ptr<IFile> &&f)
+// Character classification for the tokenizer. These have to match udm::WHITESPACE_CHARACTERS and udm::CONTROL_CHARACTERS.
+static constexpr std::string_view ASCII_CONTROL_CHARACTERS = "{}[]<>$,:;";
+static constexpr uint8_t ASCII_CHAR_CLASS_WHITESPACE = 1;
+static constexpr uint8_t ASCII_CHAR_CLASS_CONTROL = 2;
+static constexpr auto ASCII_CHAR_CLASSES = []() {
+	std::array<uint8_t, 256> classes {};
+	for(auto c : std::string_view {" \t\f\v\n\r"})
+		classes[static_cast<uint8_t>(c)] = ASCII_CHAR_CLASS_WHITESPACE;
+	for(auto c : ASCII_CONTROL_CHARACTERS)
+		classes[static_cast<uint8_t>(c)] = ASCII_CHAR_CLASS_CONTROL;
+	return classes;
+}();
+
+// Comments are only recognized at the start of a token (see AsciiReader::ReadNextToken), i.e. after whitespace or a control character.
+// A '/' directly after '[' or after any other character is part of a value, e.g. base64 data like "[//8A]" or "[Af///w==]".
+static bool is_ascii_comment_start(const char *p, const char *begin, const char *end)
 {
-	auto udmData = std::shared_ptr<udm::Data> {new udm::Data {}};
-	auto rootProp = Property::Create<Element>();
-	AsciiReader reader {};
-	reader.m_file = std::move(f);
-	auto res = reader.ReadBlockKeyValues(rootProp->GetValue<Element>());
-	if(res != BlockResult::EndOfFile)
-		throw reader.BuildException<SyntaxError>("Block has been terminated improperly");
+	if(p + 1 >= end || (p[1] != '/' && p[1] != '*'))
+		return false;
+	if(p == begin)
+		return true;
+	auto prev = *(p - 1);
+	return prev != '[' && ASCII_CHAR_CLASSES[static_cast<uint8_t>(prev)] != 0;
+}
 
-	auto udmAssetData = (*rootProp)[Data::KEY_ASSET_DATA];
-	if(!udmAssetData) {
-		auto assetDataProp = rootProp;
-		rootProp = Property::Create<Element>();
-		auto &elRoot = rootProp->GetValue<Element>();
-		elRoot.AddChild(Data::KEY_ASSET_DATA, assetDataProp);
-		elRoot[Data::KEY_ASSET_VERSION] = static_cast<uint32_t>(1);
-		elRoot[Data::KEY_ASSET_TYPE] = "nil";
+// Returns a pointer to the last character of the quoted string or comment that starts at p, p itself if there is none,
+// or nullptr if it isn't terminated
+static const char *skip_ascii_string_or_comment(const char *p, const char *end)
+{
+	if(*p == '\"') {
+		// Same rules as AsciiReader::ReadString
+		auto *start = p + 1;
+		for(auto *q = start;; ++q) {
+			q = static_cast<const char *>(memchr(q, '\"', end - q));
+			if(!q)
+				return nullptr;
+			if(q - start < 2 || *(q - 1) != '\\')
+				return q;
+		}
 	}
-	udmData->m_rootProperty = rootProp;
-	std::string assetType;
-	if((*rootProp)[Data::KEY_ASSET_TYPE] >> assetType) {
-		for(auto &c : udmData->m_header.identifier)
-			c = '\0';
-		for(size_t i = 0; i < std::min(assetType.size(), udmData->m_header.identifier.size()); ++i)
-			udmData->m_header.identifier[i] = assetType[i];
+	if(*p != '/' || p + 1 >= end)
+		return p;
+	if(p[1] == '/') {
+		auto *lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+		return lineEnd ? lineEnd : (end - 1);
 	}
-	(*rootProp)[Data::KEY_ASSET_VERSION] >> udmData->m_header.version;
-	return udmData->ValidateHeaderProperties() ? udmData : nullptr;
+	if(p[1] == '*') {
+		for(auto *q = p + 2;; ++q) {
+			q = static_cast<const char *>(memchr(q, '*', end - q));
+			if(!q || q + 1 >= end)
+				return nullptr;
+			if(q[1] == '/')
+				return q + 1;
+		}
+	}
+	return p;
 }
 
-struct MemoryData : public udm::IFile {
-	MemoryData() = default;
-	std::vector<uint8_t> &GetData() { return m_data; }
-	virtual size_t Read(void *data, size_t size) override
-	{
-		if(m_pos + size > m_data.size())
-			return 0;
-		memcpy(data, m_data.data() + m_pos, size);
-		m_pos += size;
-		return size;
-	}
-	virtual size_t Write(const void *data, size_t size) override
-	{
-		if(m_pos + size > m_data.size())
-			return 0;
-		memcpy(m_data.data() + m_pos, data, size);
-		m_pos += size;
-		return size;
+// Returns a pointer past the bracket or brace that closes the one at p, or nullptr if there is none
+static const char *skip_ascii_group(const char *p, const char *end)
+{
+	auto *begin = p;
+	uint32_t depth = 0;
+	for(; p < end; ++p) {
+		switch(*p) {
+		case '/':
+			if(!is_ascii_comment_start(p, begin, end))
+				break;
+			[[fallthrough]];
+		case '\"':
+			p = skip_ascii_string_or_comment(p, end);
+			if(!p)
+				return nullptr;
+			break;
+		case '[':
+		case '{':
+			++depth;
+			break;
+		case ']':
+		case '}':
+			if(--depth == 0)
+				return p + 1;
+			break;
+		}
 	}
-	virtual size_t Tell() override { return m_pos; }
-	virtual void Seek(size_t offset, Whence whence) override
-	{
-		switch(whence) {
-		case Whence::Set:
-			m_pos = offset;
+	return nullptr;
+}
+
+// Finds the matching braces of all blocks in the document, skipping quoted strings and comments. Returns false if the braces are unbalanced.
+static bool find_ascii_blocks(const std::string_view &data, std::vector<std::pair<uint64_t, uint64_t>> &outBlocks)
+{
+	auto *begin = data.data();
+	auto *end = begin + data.size();
+	std::vector<size_t> openBlocks;
+	for(auto *p = begin; p < end; ++p) {
+		switch(*p) {
+		case '/':
+			if(!is_ascii_comment_start(p, begin, end))
+				break;
+			[[fallthrough]];
+		case '\"':
+			p = skip_ascii_string_or_comment(p, end);
+			if(!p)
+				return false;
 			break;
-		case Whence::End:
-			m_pos = m_data.size() + offset;
+		case '{':
+			openBlocks.push_back(outBlocks.size());
+			outBlocks.push_back({static_cast<uint64_t>(p - begin), 0});
 			break;
-		case Whence::Cur:
-			m_pos += offset;
+		case '}':
+			if(openBlocks.empty())
+				return false;
+			outBlocks[openBlocks.back()].second = p - begin;
+			openBlocks.pop_back();
 			break;
 		}
 	}
-	virtual int32_t ReadChar() override
-	{
-		if(m_pos >= m_data.size())
-			return std::char_traits<char>::eof();
-		char c;
-		Read(&c, sizeof(c));
-		return c;
+	return openBlocks.empty();
+}
+
+// Returns the block that starts at the specified offset (see find_ascii_blocks), or nullptr if there is none
+static const std::pair<uint64_t, uint64_t> *find_ascii_block(const std::vector<std::pair<uint64_t, uint64_t>> &blocks, uint64_t offset)
+{
+	auto it = std::lower_bound(blocks.begin(), blocks.end(), offset, [](const std::pair<uint64_t, uint64_t> &block, uint64_t offset) { return block.first < offset; });
+	if(it == blocks.end() || it->first != offset)
+		return nullptr;
+	return &*it;
+}
+
+bool udm::AsciiReader::TryDeferBlock(Element *el, Array *a, uint32_t index)
+{
+	if(!m_parallel)
+		return false;
+	auto *it = find_ascii_block(m_parallel->blocks, (m_cur - 1) - m_begin);
+	if(!it)
+		return false;
+	auto size = it->second - it->first;
+	// Blocks that are too large are read on this thread instead, so their children can be split up
+	if(size < m_parallel->minBlockSize || size > m_parallel->maxBlockSize)
+		return false;
+	auto *blockEnd = m_begin + it->second + 1;
+	m_parallel->deferred.push_back({m_cur, blockEnd, el, a, index});
+	m_cur = blockEnd;
+	return true;
+}
+
+void udm::AsciiReader::Read(const std::string_view &data, Element &root, ParallelState *parallel)
+{
+	AsciiReader reader {};
+	reader.m_begin = data.data();
+	reader.m_cur = reader.m_begin;
+	reader.m_end = reader.m_begin + data.size();
+	reader.m_parallel = parallel;
+	auto res = reader.ReadBlockKeyValues(root);
+	if(res != BlockResult::EndOfFile)
+		throw reader.BuildException<SyntaxError>("Block has been terminated improperly");
+	if(!parallel || parallel->deferred.empty())
+		return;
+	auto &deferred = parallel->deferred;
+	parallel_for(
+	  static_cast<uint32_t>(deferred.size()),
+	  [&deferred, &reader](uint32_t, uint32_t start, uint32_t end) {
+		  for(auto i = start; i < end; ++i) {
+			  auto &block = deferred[i];
+			  // The reader still starts at the beginning of the document, so line numbers in error messages are correct
+			  AsciiReader blockReader {};
+			  blockReader.m_begin = reader.m_begin;
+			  blockReader.m_cur = block.start;
+			  blockReader.m_end = block.end;
+			  auto &el = block.array ? static_cast<Element *>(block.array->GetValues())[block.index] : *block.element;
+			  if(blockReader.ReadBlockKeyValues(el) != BlockResult::EndOfBlock || blockReader.m_cur != block.end)
+				  throw blockReader.BuildException<SyntaxError>("Unexpected end of file");
+		  }
+	  },
+	  1);
+}
+
+std::shared_ptr<udm::Data> udm::AsciiReader::LoadAscii(const std::string_view &data)
+{
+	auto rootProp = Property::Create<Element>();
+	ParallelState parallel {};
+	auto numThreads = get_parallel_thread_count();
+	if(data.size() >= PARALLEL_MIN_FILE_SIZE && numThreads > 1 && find_ascii_blocks(data, parallel.blocks)) {
+		parallel.maxBlockSize = std::max(parallel.minBlockSize, data.size() / (numThreads * 4));
+		try {
+			Read(data, rootProp->GetValue<Element>(), &parallel);
+		}
+		catch(const Exception &e) {
+			// The pre-scan doesn't cover the entire grammar, so we'll read the file again sequentially to make sure
+			// we get either the correct result or the correct error
+			rootProp = Property::Create<Element>();
+			Read(data, rootProp->GetValue<Element>(), nullptr);
+		}
 	}
-	char *GetMemoryDataPtr() { return reinterpret_cast<char *>(m_data.data() + m_pos); }
-  private:
-	std::vector<uint8_t> m_data;
-	size_t m_pos = 0;
-};
+	else
+		Read(data, rootProp->GetValue<Element>(), nullptr);
+	return Data::CreateFromRootProperty(rootProp);
+}
+
 namespace udm {
 	std::shared_ptr<udm::Data> load_ascii(std::unique_ptr<IFile> &&f)
 	{
-		auto memData = std::make_unique<MemoryData>();
-		auto &data = memData->GetData();
+		// Files that are already in memory can be parsed in place
+		auto *memFile = dynamic_cast<MemoryFile *>(f.get());
+		if(memFile) {
+			auto offset = std::min(memFile->Tell(), memFile->GetDataSize());
+			auto udmData = AsciiReader::LoadAscii(std::string_view {reinterpret_cast<const char *>(memFile->GetData()) + offset, memFile->GetDataSize() - offset});
+			// Same cursor position as if the data had been read from the file
+			memFile->Seek(memFile->GetDataSize());
+			return udmData;
+		}
+		std::vector<char> data;
 		data.resize(f->GetSize());
 		auto size = f->Read(data.data(), data.size());
 		data.resize(size);
 		// Don't need the file handle anymore at this point
 		auto tmp = std::move(f);
 		tmp = nullptr;
-		return AsciiReader::LoadAscii(std::move(memData));
+		return AsciiReader::LoadAscii(std::string_view {data.data(), data.size()});
 	}
 };
 
-char udm::AsciiReader::ReadChar()
+// Read-only memory mapping of an entire file
+struct MappedFile {
+	MappedFile(const std::string &path);
+	~MappedFile();
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	std::string_view GetData() const { return std::string_view {static_cast<const char *>(m_data), m_size}; }
+  private:
+	const void *m_data = nullptr;
+	size_t m_size = 0;
+#ifdef _WIN32
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+#endif
+};
+#ifdef _WIN32
+// Paths are UTF-8, the ANSI variants of the API would interpret them with the current code page instead
+static std::wstring utf8_to_wide_string(const std::string &str)
 {
-	auto c = m_file->ReadChar();
-	if(c == std::char_traits<char>::eof())
-		return std::char_traits<char>::eof();
-	if(c == '\n') {
-		++m_curLine;
-		m_curCharPos = 0;
+	if(str.empty())
+		return {};
+	auto size = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, str.data(), static_cast<int>(str.size()), nullptr, 0);
+	if(size <= 0)
+		throw udm::FileError {"Invalid UTF-8 file path '" + str + "'!"};
+	std::wstring wstr(size, L'\0');
+	MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, str.data(), static_cast<int>(str.size()), wstr.data(), size);
+	return wstr;
+}
+MappedFile::MappedFile(const std::string &path)
+{
+	m_file = CreateFileW(utf8_to_wide_string(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(m_file == INVALID_HANDLE_VALUE)
+		throw udm::FileError {"Unable to open file '" + path + "'!"};
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(m_file, &size)) {
+		CloseHandle(m_file);
+		throw udm::FileError {"Unable to determine size of file '" + path + "'!"};
 	}
-	else
-		++m_curCharPos;
-	return c;
+	m_size = static_cast<size_t>(size.QuadPart);
+	if(m_size == 0)
+		return;
+	m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if(!m_data) {
+		if(m_mapping)
+			CloseHandle(m_mapping);
+		CloseHandle(m_file);
+		throw udm::FileError {"Unable to map file '" + path + "'!"};
+	}
+}
+MappedFile::~MappedFile()
+{
+	if(m_data)
+		UnmapViewOfFile(m_data);
+	if(m_mapping)
+		CloseHandle(m_mapping);
+	if(m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file);
 }
+#else
+MappedFile::MappedFile(const std::string &path)
+{
+	auto fd = ::open(path.c_str(), O_RDONLY);
+	if(fd == -1)
+		throw udm::FileError {"Unable to open file '" + path + "'!"};
+	struct stat st;
+	if(fstat(fd, &st) != 0) {
+		::close(fd);
+		throw udm::FileError {"Unable to determine size of file '" + path + "'!"};
+	}
+	m_size = static_cast<size_t>(st.st_size);
+	if(m_size > 0) {
+		auto *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data == MAP_FAILED) {
+			::close(fd);
+			throw udm::FileError {"Unable to map file '" + path + "'!"};
+		}
+		madvise(data, m_size, MADV_SEQUENTIAL);
+		m_data = data;
+	}
+	// The mapping remains valid after the descriptor has been closed
+	::close(fd);
+}
+MappedFile::~MappedFile()
+{
+	if(m_data)
+		munmap(const_cast<void *>(m_data), m_size);
+}
+#endif
 
-char udm::AsciiReader::PeekNextChar()
+std::shared_ptr<udm::Data> udm::Data::LoadAscii(const std::string_view &data) { return AsciiReader::LoadAscii(data); }
+std::shared_ptr<udm::Data> udm::Data::LoadAsciiMapped(const std::string &systemPath)
 {
-	auto &f = m_file;
-	auto pos = f->Tell();
-	auto c = f->ReadChar();
-	f->Seek(pos);
-	return c;
+	MappedFile f {systemPath};
+	return AsciiReader::LoadAscii(f.GetData());
 }
 
-char udm::AsciiReader::ReadUntil(char c, std::string_view *optOut)
+udm::AsciiReader::BlockResult udm::AsciiReader::ScanBlockEntries(std::vector<BlockEntry> &outEntries)
 {
-	auto &f = m_file;
-	auto *ptr = static_cast<MemoryData *>(f.get())->GetMemoryDataPtr();
-	auto cur = ReadChar();
 	for(;;) {
-		if(cur == std::char_traits<char>::eof() || cur == c) {
-			if(optOut) {
-				auto len = static_cast<size_t>(static_cast<MemoryData *>(f.get())->GetMemoryDataPtr() - ptr);
-				*optOut = std::string_view {ptr, (len > 0) ? (len - 1) : 0};
+		auto t = ReadNextToken();
+		if(t == '}')
+			return BlockResult::EndOfBlock;
+		if(t == std::char_traits<char>::eof())
+			return BlockResult::EndOfFile;
+		auto *start = m_cur - 1;
+		if(t == '$') {
+			auto type = ReadString();
+			auto eType = ascii_type_to_enum(type);
+			if(eType == udm::Type::Invalid)
+				throw BuildException<SyntaxError>("Invalid keyvalue type '" + std::string {type} + "' found");
+			if(eType == Type::Struct) {
+				std::vector<Type> types;
+				std::vector<std::string_view> names;
+				ReadTemplateParameterList(types, names);
 			}
-			return cur;
+			auto key = ReadString(ReadNextToken());
+			SkipValue(eType);
+			outEntries.push_back({key, eType, start});
+			continue;
 		}
-		cur = ReadChar();
+		if(is_control_character(t))
+			throw BuildException<SyntaxError>("Expected variable or child block, got unexpected control character '" + std::string {t} + "'");
+		auto childBlockName = ReadString(t);
+		t = ReadNextToken();
+		if(t != '{')
+			throw BuildException<SyntaxError>("Expected '{' for child block definition, got '" + std::string {t} + "'");
+		auto *blockEnd = SkipGroup(m_cur - 1);
+		if(!blockEnd)
+			throw BuildException<SyntaxError>("Unexpected end of file");
+		m_cur = blockEnd;
+		outEntries.push_back({childBlockName, Type::Element, start});
 	}
-	if(optOut) {
-		auto len = static_cast<size_t>(static_cast<MemoryData *>(f.get())->GetMemoryDataPtr() - ptr);
-		*optOut = std::string_view {ptr, len};
+	// Unreachable
+	return BlockResult::EndOfFile;
+}
+
+void udm::AsciiReader::SkipValue(Type type)
+{
+	// These don't have a value (see ReadValue)
+	if(type == Type::Nil || type == Type::Element)
+		return;
+	SeekNextToken();
+	if(PeekNextChar() != '[') {
+		ReadString(ReadNextToken());
+		return;
 	}
-	return cur;
+	// Some values consist of multiple lists, e.g. "[type;size][values]" for arrays
+	do {
+		auto *end = SkipGroup(m_cur);
+		if(!end)
+			throw BuildException<SyntaxError>("Unexpected end of file");
+		m_cur = end;
+		SeekNextToken();
+	} while(PeekNextChar() == '[');
 }
 
-void udm::AsciiReader::SeekNextToken(const std::optional<char> &tSeek)
+const char *udm::AsciiReader::SkipGroup(const char *p) const
+{
+	if(m_blocks.empty())
+		return skip_ascii_group(p, m_end);
+	auto *begin = p;
+	uint32_t depth = 0;
+	for(; p < m_end; ++p) {
+		switch(*p) {
+		case '/':
+			if(!is_ascii_comment_start(p, begin, m_end))
+				break;
+			[[fallthrough]];
+		case '\"':
+			p = skip_ascii_string_or_comment(p, m_end);
+			if(!p)
+				return nullptr;
+			break;
+		case '{':
+			{
+				auto *block = find_ascii_block(m_blocks, p - m_begin);
+				if(!block)
+					return nullptr;
+				p = m_begin + block->second;
+				if(depth == 0)
+					return p + 1;
+				break;
+			}
+		case '[':
+			++depth;
+			break;
+		case ']':
+		case '}':
+			if(--depth == 0)
+				return p + 1;
+			break;
+		}
+	}
+	return nullptr;
+}
+
+void udm::AsciiReader::TranscodeElement(const std::vector<BlockEntry> &entries, IFile &out)
+{
+	// Later entries replace earlier ones with the same key (see Element::AddChild)
+	std::vector<const BlockEntry *> children;
+	children.reserve(entries.size());
+	std::unordered_set<std::string_view> keys;
+	for(auto it = entries.rbegin(); it != entries.rend(); ++it) {
+		if(keys.insert(it->key).second)
+			children.push_back(&*it);
+	}
+
+	auto offsetToSize = Property::WriteBlockSize<uint64_t>(out);
+	out.Write<uint32_t>(children.size());
+	for(auto *child : children)
+		Data::WriteKey(out, child->key);
+	for(auto *child : children) {
+		m_cur = child->start;
+		TranscodeEntry(out);
+	}
+	Property::WriteBlockSize<uint64_t>(out, offsetToSize);
+}
+
+udm::AsciiReader::BlockResult udm::AsciiReader::TranscodeBlock(IFile &out)
+{
+	std::vector<BlockEntry> entries;
+	auto res = ScanBlockEntries(entries);
+	auto *end = m_cur;
+	TranscodeElement(entries, out);
+	m_cur = end;
+	return res;
+}
+
+void udm::AsciiReader::TranscodeEntry(IFile &out)
 {
+	// The syntax of the entry up to its value has already been checked by ScanBlockEntries
 	auto t = ReadNextToken();
-	if(t == std::char_traits<char>::eof())
+	if(t != '$') {
+		ReadString(t);
+		ReadNextToken();
+		out.Write(Type::Element);
+		if(TranscodeBlock(out) == BlockResult::EndOfFile)
+			throw BuildException<SyntaxError>("Unexpected end of file");
+		return;
+	}
+	auto eType = ascii_type_to_enum(ReadString());
+	std::vector<Type> types;
+	std::vector<std::string_view> names;
+	if(eType == Type::Struct)
+		ReadTemplateParameterList(types, names);
+	ReadString(ReadNextToken());
+	SeekNextToken();
+	if(eType == Type::Array && TryTranscodeElementArray(out))
 		return;
-	if(tSeek.has_value() && t != *tSeek)
-		return SeekNextToken(tSeek);
-	assert(m_curCharPos > 0);
-	--m_curCharPos;
-	m_file->Seek(m_file->Tell() - 1);
+
+	auto prop = Property::Create(eType);
+	if(eType == Type::Struct) {
+		auto &strct = prop->GetValue<Struct>();
+		strct->types = std::move(types);
+		strct->names.reserve(names.size());
+		for(auto &name : names)
+			strct->names.push_back(std::string {name});
+	}
+	ReadValue(eType, prop->value);
+	prop->Write(out);
 }
 
-void udm::AsciiReader::MoveCursorForward(uint32_t n)
+bool udm::AsciiReader::TryTranscodeElementArray(IFile &out)
 {
-	for(auto i = decltype(n) {0u}; i < n; ++i)
-		ReadChar();
+	auto *start = m_cur;
+	if(ReadNextToken() != '[' || ascii_type_to_enum(ReadString()) != Type::Element) {
+		m_cur = start;
+		return false;
+	}
+	// The size is only used to reserve memory when reading, the number of items is determined by the value list
+	auto t = ReadNextToken();
+	while(t == ';') {
+		uint64_t size;
+		ReadValue(Type::UInt64, &size);
+		t = ReadNextToken();
+	}
+	if(t != ']')
+		throw BuildException<SyntaxError>("Expected ']' to close value list, got '" + std::string {t} + "'");
+
+	// Same layout as Property::Write(IFile&, const Array&)
+	out.Write(Type::Array);
+	out.Write(Type::Element);
+	auto offsetToNumItems = out.Tell();
+	out.Write<uint32_t>(0);
+	auto offsetToSize = Property::WriteBlockSize<uint64_t>(out);
+	uint32_t numItems = 0;
+	ReadValueList(
+	  Type::Element,
+	  [this, &out, &numItems]() -> bool {
+		  auto t = ReadNextToken();
+		  if(t != '{')
+			  throw BuildException<SyntaxError>("Expected '{' for array element block definition, got '" + std::string {t} + "'");
+		  if(TranscodeBlock(out) == BlockResult::EndOfFile)
+			  throw BuildException<SyntaxError>("Unexpected end of file");
+		  ++numItems;
+		  return true;
+	  },
+	  false);
+	Property::WriteBlockSize<uint64_t>(out, offsetToSize);
+	auto offset = out.Tell();
+	out.Seek(offsetToNumItems);
+	out.Write<uint32_t>(numItems);
+	out.Seek(offset);
+	return true;
 }
 
+void udm::AsciiReader::TranscodeToBinary(const std::string_view &data, IFile &out)
+{
+	AsciiReader reader {};
+	reader.m_begin = data.data();
+	reader.m_cur = reader.m_begin;
+	reader.m_end = reader.m_begin + data.size();
+	// Child blocks are scanned again when they're transcoded, so their extents are only determined once. If the braces are unbalanced,
+	// the blocks are skipped the regular way, so that the error is reported where it occurs.
+	if(!find_ascii_blocks(data, reader.m_blocks))
+		reader.m_blocks.clear();
+	std::vector<BlockEntry> entries;
+	if(reader.ScanBlockEntries(entries) != BlockResult::EndOfFile)
+		throw reader.BuildException<SyntaxError>("Block has been terminated improperly");
+
+	Header header {};
+	out.Write<Header>(header);
+	out.Write(Type::Element);
+	auto hasHeader = std::find_if(entries.begin(), entries.end(), [](const BlockEntry &entry) { return entry.key == Data::KEY_ASSET_DATA; }) != entries.end();
+	if(hasHeader) {
+		// Same requirements as Data::ValidateHeaderProperties
+		constexpr std::array<const char *, 3> requiredKeys = {Data::KEY_ASSET_TYPE, Data::KEY_ASSET_VERSION, Data::KEY_ASSET_DATA};
+		constexpr std::array<Type, 3> requiredKeyTypes = {Type::String, Type::UInt32, Type::Element};
+		for(auto i = decltype(requiredKeys.size()) {0u}; i < requiredKeys.size(); ++i) {
+			auto it = std::find_if(entries.rbegin(), entries.rend(), [&requiredKeys, i](const BlockEntry &entry) { return entry.key == requiredKeys[i]; });
+			if(it == entries.rend())
+				throw InvalidFormatError {"KeyValue '" + std::string {requiredKeys[i]} + "' not found! Not a valid UDM file!"};
+			if(it->type != requiredKeyTypes[i])
+				throw InvalidFormatError {"Excepted type '" + std::string {enum_type_to_ascii(requiredKeyTypes[i])} + "' for KeyValue '" + std::string {requiredKeys[i]} + "', but got type '" + std::string {enum_type_to_ascii(it->type)} + "'!"};
+		}
+		reader.TranscodeElement(entries, out);
+		return;
+	}
+
+	// Same as LoadAscii, the document becomes the asset data
+	auto offsetToSize = Property::WriteBlockSize<uint64_t>(out);
+	out.Write<uint32_t>(3);
+	Data::WriteKey(out, Data::KEY_ASSET_DATA);
+	Data::WriteKey(out, Data::KEY_ASSET_VERSION);
+	Data::WriteKey(out, Data::KEY_ASSET_TYPE);
+	out.Write(Type::Element);
+	reader.TranscodeElement(entries, out);
+	out.Write(Type::UInt32);
+	out.Write<uint32_t>(1);
+	out.Write(Type::String);
+	Property::Write(out, String {"nil"});
+	Property::WriteBlockSize<uint64_t>(out, offsetToSize);
+}
+
+void udm::Data::TranscodeToBinary(const std::string_view &ascii, IFile &out) { AsciiReader::TranscodeToBinary(ascii, out); }
+void udm::Data::TranscodeToBinaryMapped(const std::string &systemPath, IFile &out)
+{
+	MappedFile f {systemPath};
+	AsciiReader::TranscodeToBinary(f.GetData(), out);
+}
+
+// Whitespace characters are ' ' and the range ['\t', '\r'], so they can be detected with two comparisons
+struct AsciiWhitespace {
+	static bool IsMember(char c) { return ASCII_CHAR_CLASSES[static_cast<uint8_t>(c)] == ASCII_CHAR_CLASS_WHITESPACE; }
+#ifdef UDM_TEXT_SIMD_AVX2
+	static __m256i GetMask(__m256i v)
+	{
+		auto offset = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+		auto inRange = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8('\r' - '\t')), offset);
+		return _mm256_or_si256(inRange, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+	}
+#endif
+#ifdef UDM_TEXT_SIMD_SSE2
+	static __m128i GetMask(__m128i v)
+	{
+		auto offset = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+		auto inRange = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8('\r' - '\t')), offset);
+		return _mm_or_si128(inRange, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+	}
+#elif defined(UDM_TEXT_SIMD_NEON)
+	static uint8x16_t GetMask(uint8x16_t v)
+	{
+		auto inRange = vcleq_u8(vsubq_u8(v, vdupq_n_u8('\t')), vdupq_n_u8('\r' - '\t'));
+		return vorrq_u8(inRange, vceqq_u8(v, vdupq_n_u8(' ')));
+	}
+#endif
+};
+
+// Whitespace and control characters, either of which ends an unquoted string
+struct AsciiStringEnd {
+	static bool IsMember(char c) { return ASCII_CHAR_CLASSES[static_cast<uint8_t>(c)] != 0; }
+#ifdef UDM_TEXT_SIMD_AVX2
+	static __m256i GetMask(__m256i v)
+	{
+		auto mask = AsciiWhitespace::GetMask(v);
+		for(auto c : ASCII_CONTROL_CHARACTERS)
+			mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)));
+		return mask;
+	}
+#endif
+#ifdef UDM_TEXT_SIMD_SSE2
+	static __m128i GetMask(__m128i v)
+	{
+		auto mask = AsciiWhitespace::GetMask(v);
+		for(auto c : ASCII_CONTROL_CHARACTERS)
+			mask = _mm_or_si128(mask, _mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+		return mask;
+	}
+#elif defined(UDM_TEXT_SIMD_NEON)
+	static uint8x16_t GetMask(uint8x16_t v)
+	{
+		auto mask = AsciiWhitespace::GetMask(v);
+		for(auto c : ASCII_CONTROL_CHARACTERS)
+			mask = vorrq_u8(mask, vceqq_u8(v, vdupq_n_u8(static_cast<uint8_t>(c))));
+		return mask;
+	}
+#endif
+};
+
+// Returns a pointer to the first character in [p, end) that is not a whitespace character, or 'end'
+static const char *skip_whitespace(const char *p, const char *end)
+{
+	// Tokens are usually only separated by a few characters, so check the next one before going wide
+	if(p < end && !AsciiWhitespace::IsMember(*p))
+		return p;
+	return udm::text_scan::find_char<AsciiWhitespace, false>(p, end);
+}
+
+// Returns a pointer to the first whitespace or control character in [p, end), or 'end'
+static const char *find_string_end(const char *p, const char *end) { return udm::text_scan::find_char<AsciiStringEnd, true>(p, end); }
+
+void udm::AsciiReader::GetCursorPosition(uint32_t &outLine, uint32_t &outColumn) const
+{
+	uint32_t column;
+	text_scan::get_cursor_position(m_begin, m_cur, outLine, column);
+	outColumn = (column > 0) ? (column - 1) : 0;
+}
+
+char udm::AsciiReader::ReadChar()
+{
+	if(m_cur >= m_end)
+		return std::char_traits<char>::eof();
+	return *m_cur++;
+}
+
+char udm::AsciiReader::PeekNextChar()
+{
+	if(m_cur >= m_end)
+		return std::char_traits<char>::eof();
+	return *m_cur;
+}
+
+char udm::AsciiReader::ReadUntil(char c, std::string_view *optOut)
+{
+	auto *start = m_cur;
+	auto *p = (m_cur < m_end) ? static_cast<const char *>(memchr(m_cur, c, m_end - m_cur)) : nullptr;
+	if(!p) {
+		m_cur = m_end;
+		if(optOut)
+			*optOut = std::string_view {start, static_cast<size_t>(m_end - start)};
+		return std::char_traits<char>::eof();
+	}
+	if(optOut)
+		*optOut = std::string_view {start, static_cast<size_t>(p - start)};
+	m_cur = p + 1;
+	return c;
+}
+
+void udm::AsciiReader::SeekNextToken(const std::optional<char> &tSeek)
+{
+	for(;;) {
+		auto t = ReadNextToken();
+		if(t == std::char_traits<char>::eof())
+			return;
+		if(tSeek.has_value() && t != *tSeek)
+			continue;
+		assert(m_cur > m_begin);
+		--m_cur;
+		return;
+	}
+}
+
+void udm::AsciiReader::MoveCursorForward(uint32_t n) { m_cur = (n < m_end - m_cur) ? (m_cur + n) : m_end; }
+
 char udm::AsciiReader::ReadNextToken()
 {
-	auto &f = m_file;
-	int c;
 	for(;;) {
-		c = ReadChar();
+		m_cur = skip_whitespace(m_cur, m_end);
+		auto c = ReadChar();
 		if(c == std::char_traits<char>::eof())
 			return std::char_traits<char>::eof();
-		if(pragma::string::WHITESPACE.find(c) != std::string::npos)
-			continue;
 		if(c == '/') {
 			auto cNext = PeekNextChar();
 			if(cNext == '/') {
-				f->Seek(f->Tell() + 1);
+				++m_cur;
 				ReadUntil('\n');
 				continue;
 			}
 			else if(cNext == '*') {
-				f->Seek(f->Tell() + 1);
+				++m_cur;
 				for(;;) {
 					if(ReadUntil('*') == std::char_traits<char>::eof())
 						return std::char_traits<char>::eof();
 					if(PeekNextChar() == '/') {
-						f->Seek(f->Tell() + 1);
+						++m_cur;
 						break;
 					}
 				}
@@ -735,43 +1482,29 @@ char udm::AsciiReader::ReadNextToken()
 
 std::string_view udm::AsciiReader::ReadString(char initialC)
 {
-	auto &f = m_file;
 	auto t = initialC;
 	if(t == std::char_traits<char>::eof())
 		return {};
 	if(is_control_character(initialC))
 		throw BuildException<SyntaxError>("Expected string, got control character '" + std::string {t} + "'");
 	if(t == '\"') {
-		std::string_view str;
+		auto *start = m_cur;
 		for(;;) {
-			auto c = ReadUntil('\"', &str);
-			if(c == std::char_traits<char>::eof())
+			if(ReadUntil('\"') == std::char_traits<char>::eof())
 				throw BuildException<SyntaxError>("Expected quotation mark to end string, got EOF");
-			if(str.size() <= 1 || str.back() != '\\')
-				return str;
-			continue;
+			// Skip escaped quotation marks
+			auto *quote = m_cur - 1;
+			if(quote - start < 2 || *(quote - 1) != '\\')
+				return std::string_view {start, static_cast<size_t>(quote - start)};
 		}
-		// Unreachable
-		return str;
 	}
 
-	f->Seek(f->Tell() - 1);
-	auto *ptr = static_cast<MemoryData *>(f.get())->GetMemoryDataPtr();
-	uint32_t len = 0;
-	--m_curCharPos;
-	for(;;) {
-		t = PeekNextChar();
-		if(t == std::char_traits<char>::eof())
-			return std::string_view {ptr, len};
-		if(is_whitespace_character(t) || is_control_character(t))
-			return std::string_view {ptr, len};
-		++len;
-		f->Seek(f->Tell() + 1);
-	}
-	return std::string_view {ptr, len};
+	auto *start = m_cur - 1;
+	m_cur = find_string_end(m_cur, m_end);
+	return std::string_view {start, static_cast<size_t>(m_cur - start)};
 }
 
-std::string_view udm::AsciiReader::ReadString() { return ReadString(m_file->ReadChar()); }
+std::string_view udm::AsciiReader::ReadString() { return ReadString(ReadChar()); }
 
 template<typename T, typename TBase>
 void udm::AsciiReader::ReadTypedValueList(T &outData)
@@ -792,59 +1525,235 @@ void udm::AsciiReader::ReadTypedValueList(T &outData)
 	memcpy(&outData, values.data(), sizeof(outData));
 }
 
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Nil &nil, const std::string &prefix) { return ""; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Blob &blob, const std::string &prefix)
+udm::AsciiWriter::AsciiWriter(IFile &f, AsciiSaveFlags flags) : TextWriter {f}, m_flags {flags} {}
+udm::AsciiWriter::AsciiWriter(std::stringstream &ss, AsciiSaveFlags flags, const std::string_view &prefix) : TextWriter {ss}, m_flags {flags}, m_indent {prefix} {}
+udm::AsciiWriter::AsciiWriter(std::string &outStr, AsciiSaveFlags flags, const std::string_view &prefix) : TextWriter {outStr}, m_flags {flags}, m_indent {prefix} {}
+template<typename T>
+void udm::AsciiWriter::WriteNumber(T value)
 {
-	try {
-		return "[" + pragma::util::base64_encode(blob.data.data(), blob.data.size()) + "]";
-	}
-	catch(const std::runtime_error &e) {
-		throw CompressionError {e.what()};
-	}
-	return "";
+	WriteChars(Property::NUMERIC_STRING_BUFFER_SIZE, [value](char *first, char *last) { return Property::NumericTypeToChars(value, first, last); });
 }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const BlobLz4 &blob, const std::string &prefix)
+template<typename TFunc>
+void udm::AsciiWriter::WriteParallel(uint32_t numItems, uint32_t minItemsPerTask, const TFunc &writeItem)
 {
-	try {
-		return "[" + std::to_string(blob.uncompressedSize) + "][" + pragma::util::base64_encode(blob.compressedData.data(), blob.compressedData.size()) + "]";
+	// Items are processed in batches to limit the amount of output that has to be held in memory at once
+	auto batchSize = minItemsPerTask * get_parallel_thread_count() * 4;
+	std::vector<std::string> chunks;
+	for(uint32_t offset = 0; offset < numItems; offset += batchSize) {
+		auto count = std::min(batchSize, numItems - offset);
+		chunks.clear();
+		chunks.resize(get_parallel_chunk_count(count, minItemsPerTask));
+		parallel_for(
+		  count,
+		  [this, &chunks, &writeItem, offset](uint32_t chunkIdx, uint32_t start, uint32_t end) {
+			  AsciiWriter writer {chunks[chunkIdx], m_flags, m_indent};
+			  writer.m_parallel = true;
+			  for(auto i = start; i < end; ++i)
+				  writeItem(writer, offset + i);
+		  },
+		  minItemsPerTask);
+		for(auto &chunk : chunks)
+			Write(chunk);
 	}
-	catch(const std::runtime_error &e) {
-		throw CompressionError {e.what()};
+}
+void udm::AsciiWriter::WriteQuoted(const std::string_view &str)
+{
+	Write('\"');
+	Write(str);
+	Write('\"');
+}
+
+void udm::AsciiWriter::WriteElementChildren(const Element &el)
+{
+	// We want to sort the children by name to have some consistency
+	std::vector<std::pair<std::string_view, const Property *>> children;
+	children.reserve(el.children.size());
+	for(auto &[name, child] : el.children)
+		children.push_back({name, child.get()});
+	std::sort(children.begin(), children.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+	auto n = static_cast<uint32_t>(children.size());
+	auto writeChild = [&children](AsciiWriter &writer, uint32_t i) {
+		if(i > 0)
+			writer.Write('\n');
+		auto &[name, child] = children[i];
+		writer.WriteProperty(name, child->type, child->value);
+	};
+	if(m_parallel && n >= PARALLEL_MIN_ITEMS_PER_TASK * 2) {
+		WriteParallel(n, PARALLEL_MIN_ITEMS_PER_TASK, writeChild);
+		return;
 	}
-	return "";
+	for(auto i = decltype(n) {0u}; i < n; ++i)
+		writeChild(*this, i);
 }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Utf8String &utf8, const std::string &prefix)
+void udm::AsciiWriter::WriteProperty(const std::string_view &name, Type type, const void *value)
 {
-	try {
-		return "[base64][" + pragma::util::base64_encode(utf8.data.data(), utf8.data.size()) + ']';
+	if(type == Type::Element) {
+		WriteIndent();
+		WriteQuoted(name);
+		Write('\n');
+		WriteIndent();
+		Write("{\n");
+		Indent();
+		WriteElementChildren(*static_cast<const Element *>(value));
+		Unindent();
+		Write('\n');
+		WriteIndent();
+		Write('}');
+		return;
 	}
-	catch(const std::runtime_error &e) {
-		throw CompressionError {e.what()};
+	WriteVariablePrefix(name, type, value);
+	WriteValue(type, value);
+}
+void udm::AsciiWriter::WriteVariablePrefix(const std::string_view &name, Type type, const void *value)
+{
+	WriteIndent();
+	Write('$');
+	Write(enum_type_to_ascii(type));
+	if(type == Type::Struct)
+		Write((*static_cast<const Struct *>(value))->GetTemplateArgumentList());
+	Write(' ');
+	if(does_key_require_quotes(name))
+		WriteQuoted(name);
+	else
+		Write(name);
+	Write(' ');
+}
+void udm::AsciiWriter::WriteValue(Type type, const void *value)
+{
+	if(is_numeric_type(type)) {
+		std::visit(
+		  [this, value](auto tag) {
+			  using T = typename decltype(tag)::type;
+			  WriteNumber(*static_cast<const T *>(value));
+		  },
+		  get_numeric_tag(type));
+		return;
 	}
-	return "";
+	auto vs = [this, value](auto tag) {
+		using T = typename decltype(tag)::type;
+		WriteValue(*static_cast<const T *>(value));
+	};
+	if(is_gnt_type(type))
+		visit_gnt(type, vs);
+}
+
+void udm::AsciiWriter::WriteValue(const Blob &blob)
+{
+	Write('[');
+	WriteBase64(blob.data.data(), blob.data.size());
+	Write(']');
 }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Element &el, const std::string &prefix)
+void udm::AsciiWriter::WriteValue(const BlobLz4 &blob)
+{
+	Write('[');
+	WriteNumber(blob.uncompressedSize);
+	Write("][");
+	WriteBase64(blob.compressedData.data(), blob.compressedData.size());
+	Write(']');
+}
+void udm::AsciiWriter::WriteValue(const Utf8String &utf8)
+{
+	Write("[base64][");
+	WriteBase64(utf8.data.data(), utf8.data.size());
+	Write(']');
+}
+void udm::AsciiWriter::WriteValue(const Element &el)
 {
 	// Unreachable
 	throw std::runtime_error {"Cannot convert value of type Element to ASCII!"};
 }
-void udm::Property::ArrayValuesToAscii(AsciiSaveFlags flags, std::stringstream &ss, const Array &a, const std::string &prefix)
+void udm::AsciiWriter::WriteValue(const Array &a)
+{
+	auto valueType = a.GetValueType();
+	Write('[');
+	Write(enum_type_to_ascii(valueType));
+	if(valueType == Type::Struct)
+		Write(a.GetStructuredDataInfo()->GetTemplateArgumentList());
+	Write(';');
+	WriteNumber(a.GetSize());
+	Write(']');
+	WriteArrayValues(a);
+}
+void udm::AsciiWriter::WriteValue(const ArrayLz4 &a)
+{
+	auto valueType = a.GetValueType();
+	auto compress = !pragma::math::is_flag_set(m_flags, AsciiSaveFlags::DontCompressLz4Arrays);
+	Write('[');
+	Write(enum_type_to_ascii(valueType));
+	if(valueType == Type::Struct)
+		Write(a.GetStructuredDataInfo()->GetTemplateArgumentList());
+	Write(';');
+	WriteNumber(a.GetSize());
+	auto &blob = a.GetCompressedBlob();
+	if(compress) {
+		Write(';');
+		WriteNumber(blob.uncompressedSize);
+	}
+	Write(']');
+	if(!compress) {
+		WriteArrayValues(a);
+		return;
+	}
+	Write('[');
+	WriteBase64(blob.compressedData.data(), blob.compressedData.size());
+	Write(']');
+}
+void udm::AsciiWriter::WriteValue(const String &str)
+{
+	Write('\"');
+	// Backslashes have to be escaped
+	std::string_view remaining {str};
+	for(;;) {
+		auto pos = remaining.find('\\');
+		if(pos == std::string_view::npos)
+			break;
+		Write(remaining.substr(0, pos + 1));
+		Write('\\');
+		remaining.remove_prefix(pos + 1);
+	}
+	Write(remaining);
+	Write('\"');
+}
+void udm::AsciiWriter::WriteValue(const Reference &ref) { WriteValue(ref.path); }
+void udm::AsciiWriter::WriteValue(const Struct &strct)
+{
+	WriteIndent();
+	WriteStructValue(*strct, strct.data.data());
+}
+
+void udm::AsciiWriter::WriteArrayValues(const Array &a)
 {
-	ss << "[";
+	Write('[');
 	auto valueType = a.GetValueType();
+	auto n = a.GetSize();
 	if(valueType == Type::Element) {
-		auto *ptr = static_cast<const Element *>(a.GetValues());
-		for(auto i = decltype(a.GetSize()) {0u}; i < a.GetSize(); ++i) {
+		auto *items = static_cast<const Element *>(a.GetValues());
+		auto writeItem = [items](AsciiWriter &writer, uint32_t i) {
 			if(i > 0)
-				ss << ',';
-			ss << "\n";
-			ss << prefix << "\t{\n";
-			ptr->ToAscii(flags, ss, prefix + "\t");
-			ss << "\n" << prefix << "\t}";
-			++ptr;
+				writer.Write(',');
+			writer.Write('\n');
+			writer.WriteIndent();
+			writer.Write("\t{\n");
+			writer.Indent();
+			writer.Indent();
+			writer.WriteElementChildren(items[i]);
+			writer.Unindent();
+			writer.Unindent();
+			writer.Write('\n');
+			writer.WriteIndent();
+			writer.Write("\t}");
+		};
+		if(m_parallel && n >= PARALLEL_MIN_ITEMS_PER_TASK * 2)
+			WriteParallel(n, PARALLEL_MIN_ITEMS_PER_TASK, writeItem);
+		else {
+			for(auto i = decltype(n) {0u}; i < n; ++i)
+				writeItem(*this, i);
+		}
+		if(n > 0) {
+			Write('\n');
+			WriteIndent();
 		}
-		if(a.GetSize() > 0)
-			ss << "\n" << prefix;
 	}
 	else if(valueType == Type::Struct) {
 		auto *ptr = static_cast<const uint8_t *>(a.GetValues());
@@ -856,24 +1765,24 @@ void udm::Property::ArrayValuesToAscii(AsciiSaveFlags flags, std::stringstream &
 		// bloat the file, so we'll put multiple items into the same line until we reach maxLenPerLine characters, then we
 		// use the number of items we've written so far as a reference for when to put the next new-lines (to ensure that
 		// each line has the same number of items).
-		uint32_t curLen = 0;
-		constexpr uint32_t maxLenPerLine = 100;
+		size_t curLen = 0;
+		constexpr size_t maxLenPerLine = 100;
 		std::optional<uint32_t> nPerLine {};
-		auto n = a.GetSize();
-		auto subPrefix = prefix + '\t';
 		for(auto i = decltype(n) {0u}; i < n; ++i) {
 			if(i > 0)
-				ss << ',';
+				Write(',');
 			if(insertNewLine) {
-				ss << "\n" << subPrefix;
+				Write('\n');
+				WriteIndent();
+				Write('\t');
 				curLen = 0;
 				insertNewLine = false;
 			}
 			else
-				ss << ' ';
-			auto l = ss.tellp();
-			ss << StructToAsciiValue(flags, strctDesc, ptr);
-			curLen += ss.tellp() - l;
+				Write(' ');
+			auto l = Tell();
+			WriteStructValue(strctDesc, ptr);
+			curLen += Tell() - l;
 			if(nPerLine.has_value()) {
 				if(((i + 1) % *nPerLine) == 0)
 					insertNewLine = true;
@@ -885,178 +1794,250 @@ void udm::Property::ArrayValuesToAscii(AsciiSaveFlags flags, std::stringstream &
 
 			ptr += sz;
 		}
-		if(n > 0)
-			ss << '\n' << prefix;
+		if(n > 0) {
+			Write('\n');
+			WriteIndent();
+		}
 	}
 	else if(is_numeric_type(valueType)) {
-		auto tag = get_numeric_tag(valueType);
 		std::visit(
-		  [&a, &ss](auto tag) {
+		  [this, &a, n](auto tag) {
 			  using T = typename decltype(tag)::type;
-			  auto *ptr = static_cast<const T *>(a.GetValues());
-			  for(auto i = decltype(a.GetSize()) {0u}; i < a.GetSize(); ++i) {
+			  auto *values = static_cast<const T *>(a.GetValues());
+			  auto writeValue = [values](AsciiWriter &writer, uint32_t i) {
 				  if(i > 0)
-					  ss << ",";
-				  NumericTypeToString(*ptr, ss);
-				  ++ptr;
+					  writer.Write(',');
+				  writer.WriteNumber(values[i]);
+			  };
+			  if(m_parallel && n >= PARALLEL_MIN_NUMERIC_VALUES_PER_TASK * 2) {
+				  WriteParallel(n, PARALLEL_MIN_NUMERIC_VALUES_PER_TASK, writeValue);
+				  return;
 			  }
+			  for(auto i = decltype(n) {0u}; i < n; ++i)
+				  writeValue(*this, i);
 		  },
-		  tag);
+		  get_numeric_tag(valueType));
 	}
 	else {
-		auto vs = [&a, &ss, &prefix, flags](auto tag) {
+		auto vs = [this, &a, n](auto tag) {
 			using T = typename decltype(tag)::type;
 			auto *ptr = static_cast<const T *>(a.GetValues());
-			for(auto i = decltype(a.GetSize()) {0u}; i < a.GetSize(); ++i) {
+			for(auto i = decltype(n) {0u}; i < n; ++i) {
 				if(i > 0)
-					ss << ",";
-				ss << ToAsciiValue(flags, *ptr, prefix);
-				++ptr;
+					Write(',');
+				WriteValue(ptr[i]);
 			}
 		};
 		if(is_gnt_type(valueType))
 			visit_gnt(valueType, vs);
 	}
-	ss << "]";
+	Write(']');
 }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Array &a, const std::string &prefix)
+
+void udm::AsciiWriter::ReadBinaryElementChildren(IFile &f, std::vector<BinaryChild> &outChildren)
 {
-	auto valueType = a.GetValueType();
-	std::stringstream ss;
-	ss << "[";
-	ss << enum_type_to_ascii(valueType);
-	if(valueType == Type::Struct)
-		ss << a.GetStructuredDataInfo()->GetTemplateArgumentList();
-	ss << ';' << a.GetSize();
-	ss << "]";
-	ArrayValuesToAscii(flags, ss, a, prefix);
-	return ss.str();
+	auto size = f.Read<uint64_t>();
+	auto end = f.Tell() + size;
+	auto numChildren = f.Read<uint32_t>();
+	outChildren.resize(numChildren);
+	for(auto &child : outChildren)
+		child.key = Data::ReadKey(f);
+	for(auto &child : outChildren) {
+		child.offset = f.Tell();
+		Data::SkipProperty(f, f.Read<Type>());
+	}
+	f.Seek(end);
 }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const ArrayLz4 &a, const std::string &prefix)
+void udm::AsciiWriter::TranscodeBinaryElementChildren(IFile &f)
 {
-	auto valueType = a.GetValueType();
-	auto &blob = a.GetCompressedBlob();
-	auto stype = std::string {enum_type_to_ascii(valueType)};
-	if(valueType == Type::Struct)
-		stype += a.GetStructuredDataInfo()->GetTemplateArgumentList();
-	auto r = "[" + stype + ';' + std::to_string(a.GetSize());
-	if(/*valueType == Type::Element && */ !pragma::math::is_flag_set(flags, AsciiSaveFlags::DontCompressLz4Arrays))
-		r += ';' + std::to_string(blob.uncompressedSize);
-	r += "]";
-	if(pragma::math::is_flag_set(flags, AsciiSaveFlags::DontCompressLz4Arrays)) {
-		std::stringstream ss;
-		ArrayValuesToAscii(flags, ss, a, prefix);
-		return r + ss.str();
+	std::vector<BinaryChild> children;
+	ReadBinaryElementChildren(f, children);
+	auto end = f.Tell();
+	// Same order as WriteElementChildren
+	std::sort(children.begin(), children.end(), [](const BinaryChild &a, const BinaryChild &b) { return a.key < b.key; });
+	for(auto i = decltype(children.size()) {0u}; i < children.size(); ++i) {
+		if(i > 0)
+			Write('\n');
+		f.Seek(children[i].offset);
+		TranscodeBinaryProperty(children[i].key, f);
 	}
-	try {
-		return r + "[" + pragma::util::base64_encode(blob.compressedData.data(), blob.compressedData.size()) + "]";
+	f.Seek(end);
+}
+void udm::AsciiWriter::TranscodeBinaryProperty(const std::string_view &name, IFile &f)
+{
+	auto type = f.Read<Type>();
+	if(type == Type::Element) {
+		WriteIndent();
+		WriteQuoted(name);
+		Write('\n');
+		WriteIndent();
+		Write("{\n");
+		Indent();
+		TranscodeBinaryElementChildren(f);
+		Unindent();
+		Write('\n');
+		WriteIndent();
+		Write('}');
+		return;
 	}
-	catch(const std::runtime_error &e) {
-		throw CompressionError {e.what()};
+	if(type == Type::Array) {
+		// Items of element arrays are written one at a time, instead of reading the entire array first
+		auto offset = f.Tell();
+		if(f.Read<Type>() == Type::Element) {
+			auto n = f.Read<uint32_t>();
+			f.Seek(f.Tell() + sizeof(uint64_t)); // Skip size
+			WriteVariablePrefix(name, type, nullptr);
+			Write('[');
+			Write(enum_type_to_ascii(Type::Element));
+			Write(';');
+			WriteNumber(n);
+			Write("][");
+			// Same format as WriteArrayValues
+			for(auto i = decltype(n) {0u}; i < n; ++i) {
+				if(i > 0)
+					Write(',');
+				Write('\n');
+				WriteIndent();
+				Write("\t{\n");
+				Indent();
+				Indent();
+				TranscodeBinaryElementChildren(f);
+				Unindent();
+				Unindent();
+				Write('\n');
+				WriteIndent();
+				Write("\t}");
+			}
+			if(n > 0) {
+				Write('\n');
+				WriteIndent();
+			}
+			Write(']');
+			return;
+		}
+		f.Seek(offset);
 	}
-	return "";
+	auto prop = Property::Create();
+	if(!prop->Read(type, f))
+		throw InvalidFormatError {"Unable to read property '" + std::string {name} + "'!"};
+	WriteProperty(name, type, prop->value);
 }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const String &str, const std::string &prefix)
+void udm::AsciiWriter::TranscodeBinary(IFile &f)
 {
-	auto val = str;
-	pragma::string::replace(val, "\\", "\\\\");
-	return '\"' + val + '\"';
+	auto type = f.Read<Type>();
+	if(type != Type::Element)
+		throw InvalidFormatError {"Expected root element to be type Element, but is type " + std::string {enum_type_to_ascii(type)} + "!"};
+	if(pragma::math::is_flag_set(m_flags, AsciiSaveFlags::IncludeHeader)) {
+		TranscodeBinaryElementChildren(f);
+		return;
+	}
+	// Only the asset data is written, same as Data::ToAscii
+	std::vector<BinaryChild> children;
+	ReadBinaryElementChildren(f, children);
+	auto it = std::find_if(children.begin(), children.end(), [](const BinaryChild &child) { return child.key == Data::KEY_ASSET_DATA; });
+	if(it == children.end())
+		return;
+	f.Seek(it->offset);
+	if(f.Read<Type>() == Type::Element)
+		TranscodeBinaryElementChildren(f);
 }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Reference &ref, const std::string &prefix) { return ToAsciiValue(flags, ref.path, prefix); }
-std::string udm::Property::StructToAsciiValue(AsciiSaveFlags flags, const StructDescription &strct, const void *data, const std::string &prefix)
+
+void udm::Data::TranscodeToAscii(IFile &in, IFile &out, AsciiSaveFlags flags)
 {
-	std::stringstream ss;
-	ss << prefix << '[';
-	auto n = strct.GetMemberCount();
-	auto *ptr = static_cast<const uint8_t *>(data);
-	for(auto i = decltype(n) {0u}; i < n; ++i) {
-		if(i > 0)
-			ss << ',';
-		auto type = strct.types[i];
-		if(is_numeric_type(type)) {
-			std::visit(
-			  [ptr, &ss](auto tag) {
-				  using T = typename decltype(tag)::type;
-				  NumericTypeToString(*reinterpret_cast<const T *>(ptr), ss);
-			  },
-			  get_numeric_tag(type));
-		}
-		else if(is_generic_type(type)) {
-			std::visit(
-			  [ptr, &ss, flags](auto tag) {
-				  using T = typename decltype(tag)::type;
-				  ss << ToAsciiValue(flags, *reinterpret_cast<const T *>(ptr));
-			  },
-			  get_generic_tag(type));
+	ReadHeader(in);
+	AsciiWriter writer {out, flags};
+	writer.TranscodeBinary(in);
+	writer.Flush();
+}
+
+void udm::Data::ToAscii(AsciiWriter &writer, AsciiSaveFlags flags) const
+{
+	assert(m_rootProperty->type == Type::Element);
+	if(m_rootProperty->type == Type::Element) {
+		if(!pragma::math::is_flag_set(flags, AsciiSaveFlags::IncludeHeader)) {
+			auto udmAssetData = GetAssetData().GetData();
+			if(udmAssetData && udmAssetData->IsType(Type::Element))
+				writer.WriteElementChildren(udmAssetData->GetValue<Element>());
 		}
 		else
-			throw InvalidUsageError {"Non-trivial types are not allowed for structs!"};
-		ptr += size_of(type);
+			writer.WriteElementChildren(*static_cast<Element *>(m_rootProperty->value));
 	}
-	ss << ']';
-	return ss.str();
-}
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Struct &strct, const std::string &prefix) { return StructToAsciiValue(flags, *strct, strct.data.data(), prefix); }
-
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector2 &v, const std::string &prefix) { return '[' + NumericTypeToString(v.x) + ',' + NumericTypeToString(v.y) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector2i &v, const std::string &prefix) { return '[' + NumericTypeToString(v.x) + ',' + NumericTypeToString(v.y) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector3 &v, const std::string &prefix) { return '[' + NumericTypeToString(v.x) + ',' + NumericTypeToString(v.y) + ',' + NumericTypeToString(v.z) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector3i &v, const std::string &prefix) { return '[' + NumericTypeToString(v.x) + ',' + NumericTypeToString(v.y) + ',' + NumericTypeToString(v.z) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector4 &v, const std::string &prefix) { return '[' + NumericTypeToString(v.x) + ',' + NumericTypeToString(v.y) + ',' + NumericTypeToString(v.z) + ',' + NumericTypeToString(v.w) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector4i &v, const std::string &prefix) { return '[' + NumericTypeToString(v.x) + ',' + NumericTypeToString(v.y) + ',' + NumericTypeToString(v.z) + ',' + NumericTypeToString(v.w) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Quaternion &q, const std::string &prefix) { return '[' + NumericTypeToString(q.w) + ',' + NumericTypeToString(q.x) + ',' + NumericTypeToString(q.y) + ',' + NumericTypeToString(q.z) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const EulerAngles &a, const std::string &prefix) { return '[' + NumericTypeToString(a.p) + ',' + NumericTypeToString(a.y) + ',' + NumericTypeToString(a.r) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Srgba &srgb, const std::string &prefix) { return '[' + NumericTypeToString(srgb[0]) + ',' + NumericTypeToString(srgb[1]) + ',' + NumericTypeToString(srgb[2]) + ',' + NumericTypeToString(srgb[3]) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const HdrColor &col, const std::string &prefix) { return '[' + NumericTypeToString(col[0]) + ',' + NumericTypeToString(col[1]) + ',' + NumericTypeToString(col[2]) + ']'; }
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Transform &t, const std::string &prefix)
-{
-	auto &pos = t.GetOrigin();
-	auto &rot = t.GetRotation();
-	std::string s = "[";
-	s += "[" + NumericTypeToString(pos.x) + ',' + NumericTypeToString(pos.y) + ',' + NumericTypeToString(pos.z) + "]";
-	s += "[" + NumericTypeToString(rot.w) + ',' + NumericTypeToString(rot.x) + ',' + NumericTypeToString(rot.y) + ',' + NumericTypeToString(rot.z) + "]";
-	s += "]";
-	return s;
-}
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const ScaledTransform &t, const std::string &prefix)
-{
-	auto &pos = t.GetOrigin();
-	auto &rot = t.GetRotation();
-	auto &scale = t.GetScale();
-	std::string s = "[";
-	s += "[" + NumericTypeToString(pos.x) + ',' + NumericTypeToString(pos.y) + ',' + NumericTypeToString(pos.z) + "]";
-	s += "[" + NumericTypeToString(rot.w) + ',' + NumericTypeToString(rot.x) + ',' + NumericTypeToString(rot.y) + ',' + NumericTypeToString(rot.z) + "]";
-	s += "[" + NumericTypeToString(scale.x) + ',' + NumericTypeToString(scale.y) + ',' + NumericTypeToString(scale.z) + "]";
-	s += "]";
-	return s;
-}
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Mat4 &m, const std::string &prefix)
-{
-	std::string s {"["};
-	for(uint8_t i = 0; i < 4; ++i) {
-		s += '[';
-		for(uint8_t j = 0; j < 4; ++j) {
-			if(j > 0)
-				s += ',';
-			s += NumericTypeToString(m[i][j]);
-		}
-		s += ']';
+}
+void udm::Data::ToAscii(std::stringstream &ss, AsciiSaveFlags flags) const
+{
+	AsciiWriter writer {ss, flags};
+	writer.SetParallel(true);
+	ToAscii(writer, flags);
+}
+
+void udm::Element::ToAscii(AsciiSaveFlags flags, std::stringstream &ss, const std::optional<std::string> &prefix) const
+{
+	AsciiWriter writer {ss, flags, prefix.has_value() ? (*prefix + '\t') : ""};
+	writer.WriteElementChildren(*this);
+}
+
+void udm::Property::ToAscii(AsciiSaveFlags flags, std::stringstream &ss, const std::string &propName, Type type, const DataValue value, const std::string &prefix)
+{
+	AsciiWriter writer {ss, flags, prefix};
+	if(type == Type::Element)
+		writer.WriteProperty(propName, type, value);
+	else
+		writer.WriteValue(type, value);
+}
+
+void udm::Property::ToAscii(AsciiSaveFlags flags, std::stringstream &ss, const std::string &propName, const std::string &prefix)
+{
+	AsciiWriter writer {ss, flags, prefix};
+	writer.WriteProperty(propName, type, value);
+}
+
+void udm::Property::ArrayValuesToAscii(AsciiSaveFlags flags, std::stringstream &ss, const Array &a, const std::string &prefix)
+{
+	AsciiWriter writer {ss, flags, prefix};
+	writer.WriteArrayValues(a);
+}
+
+template<typename T>
+static std::string to_ascii_value(udm::AsciiSaveFlags flags, const T &value, const std::string &prefix)
+{
+	std::string str;
+	{
+		udm::AsciiWriter writer {str, flags, prefix};
+		writer.WriteValue(udm::type_to_enum_s<T>(), &value);
 	}
-	s += "]";
-	return s;
-}
-std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Mat3x4 &m, const std::string &prefix)
-{
-	std::string s {"["};
-	for(uint8_t i = 0; i < 3; ++i) {
-		s += '[';
-		for(uint8_t j = 0; j < 4; ++j) {
-			if(j > 0)
-				s += ',';
-			s += NumericTypeToString(m[i][j]);
-		}
-		s += ']';
+	return str;
+}
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Nil &nil, const std::string &prefix) { return to_ascii_value(flags, nil, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Blob &blob, const std::string &prefix) { return to_ascii_value(flags, blob, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const BlobLz4 &blob, const std::string &prefix) { return to_ascii_value(flags, blob, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Utf8String &utf8, const std::string &prefix) { return to_ascii_value(flags, utf8, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Element &el, const std::string &prefix) { return to_ascii_value(flags, el, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Array &a, const std::string &prefix) { return to_ascii_value(flags, a, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const ArrayLz4 &a, const std::string &prefix) { return to_ascii_value(flags, a, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const String &str, const std::string &prefix) { return to_ascii_value(flags, str, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Reference &ref, const std::string &prefix) { return to_ascii_value(flags, ref, prefix); }
+std::string udm::Property::StructToAsciiValue(AsciiSaveFlags flags, const StructDescription &strct, const void *data, const std::string &prefix)
+{
+	auto str = prefix;
+	{
+		AsciiWriter writer {str, flags};
+		writer.WriteStructValue(strct, data);
 	}
-	s += "]";
-	return s;
+	return str;
 }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Struct &strct, const std::string &prefix) { return to_ascii_value(flags, strct, prefix); }
+
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector2 &v, const std::string &prefix) { return to_ascii_value(flags, v, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector2i &v, const std::string &prefix) { return to_ascii_value(flags, v, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector3 &v, const std::string &prefix) { return to_ascii_value(flags, v, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector3i &v, const std::string &prefix) { return to_ascii_value(flags, v, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector4 &v, const std::string &prefix) { return to_ascii_value(flags, v, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Vector4i &v, const std::string &prefix) { return to_ascii_value(flags, v, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Quaternion &q, const std::string &prefix) { return to_ascii_value(flags, q, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const EulerAngles &a, const std::string &prefix) { return to_ascii_value(flags, a, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Srgba &srgb, const std::string &prefix) { return to_ascii_value(flags, srgb, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const HdrColor &col, const std::string &prefix) { return to_ascii_value(flags, col, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Transform &t, const std::string &prefix) { return to_ascii_value(flags, t, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const ScaledTransform &t, const std::string &prefix) { return to_ascii_value(flags, t, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Mat4 &m, const std::string &prefix) { return to_ascii_value(flags, m, prefix); }
+std::string udm::Property::ToAsciiValue(AsciiSaveFlags flags, const Mat3x4 &m, const std::string &prefix) { return to_ascii_value(flags, m, prefix); }
@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+// SSSE3 isn't part of the x86-64 baseline, so the SIMD code is compiled for it explicitly and only used if the CPU supports it
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86)
+#include <tmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#define UDM_BASE64_SIMD_SSSE3
+#if defined(__GNUC__) || defined(__clang__)
+#define UDM_BASE64_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+#define UDM_BASE64_TARGET_SSSE3
+#endif
+#endif
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+static constexpr std::string_view BASE64_CHARACTERS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static constexpr uint8_t BASE64_INVALID = 0xFF;
+static constexpr uint8_t BASE64_WHITESPACE = 0xFE;
+static constexpr uint8_t BASE64_PADDING = 0xFD;
+static constexpr auto BASE64_DECODE_TABLE = []() {
+	std::array<uint8_t, 256> table {};
+	table.fill(BASE64_INVALID);
+	for(size_t i = 0; i < BASE64_CHARACTERS.size(); ++i)
+		table[static_cast<uint8_t>(BASE64_CHARACTERS[i])] = static_cast<uint8_t>(i);
+	for(auto c : std::string_view {" \t\f\v\n\r"})
+		table[static_cast<uint8_t>(c)] = BASE64_WHITESPACE;
+	table['='] = BASE64_PADDING;
+	return table;
+}();
+
+#ifdef UDM_BASE64_SIMD_SSSE3
+static bool is_ssse3_supported()
+{
+#if defined(__SSSE3__)
+	return true;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 9)) != 0;
+#else
+	__builtin_cpu_init(); // May be called before the constructor that initializes the CPU features has run
+	return __builtin_cpu_supports("ssse3");
+#endif
+}
+static const bool g_ssse3Supported = is_ssse3_supported();
+
+// See Wojciech Muła, "Base64 encoding with SIMD instructions" and "Base64 decoding with SIMD instructions"
+// Encodes the first 12 bytes of 'in' to 16 characters
+static UDM_BASE64_TARGET_SSSE3 __m128i base64_encode_block(__m128i in)
+{
+	in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+	auto t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+	auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+	auto t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+	auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+	auto indices = _mm_or_si128(t1, t3);
+
+	auto shiftLut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+	auto result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+	auto less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+	result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+	result = _mm_shuffle_epi8(shiftLut, result);
+	return _mm_add_epi8(result, indices);
+}
+// Decodes 16 characters to the first 12 bytes of 'out'. Returns false if the block contains anything other than base64 characters.
+static UDM_BASE64_TARGET_SSSE3 bool base64_decode_block(__m128i in, __m128i &out)
+{
+	auto hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+	auto loNibbles = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+	auto lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	auto lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	auto lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	auto lo = _mm_shuffle_epi8(lutLo, loNibbles);
+	auto hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+	if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF)
+		return false;
+	auto eq2F = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+	auto roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+	auto values = _mm_add_epi8(in, roll);
+
+	auto mergedAbBc = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+	auto merged = _mm_madd_epi16(mergedAbBc, _mm_set1_epi32(0x00011000));
+	out = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+	return true;
+}
+
+// Encodes as many blocks as possible and advances 'in' and 'out' past them
+static UDM_BASE64_TARGET_SSSE3 void base64_encode_blocks(const uint8_t *&in, const uint8_t *end, char *&out)
+{
+	// 16 bytes are loaded, but only 12 are consumed
+	for(; end - in >= 16; in += 12, out += 16)
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out), base64_encode_block(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))));
+}
+// Decodes blocks until the first block containing whitespace or padding, which is left to the scalar decoder
+static UDM_BASE64_TARGET_SSSE3 void base64_decode_blocks(const char *&in, const char *end, uint8_t *&out)
+{
+	// 16 bytes are written, but only 12 are used, so we have to make sure the remaining characters decode to at least 4 more bytes
+	while(end - in >= 24) {
+		__m128i decoded;
+		if(!base64_decode_block(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), decoded))
+			break;
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out), decoded);
+		in += 16;
+		out += 12;
+	}
+}
+#endif
+
+void udm::base64_encode(const void *data, size_t size, char *out)
+{
+	auto *in = static_cast<const uint8_t *>(data);
+	auto *end = in + size;
+#ifdef UDM_BASE64_SIMD_SSSE3
+	if(g_ssse3Supported)
+		base64_encode_blocks(in, end, out);
+#endif
+	for(; end - in >= 3; in += 3, out += 4) {
+		uint32_t v = (in[0] << 16) | (in[1] << 8) | in[2];
+		out[0] = BASE64_CHARACTERS[(v >> 18) & 0x3F];
+		out[1] = BASE64_CHARACTERS[(v >> 12) & 0x3F];
+		out[2] = BASE64_CHARACTERS[(v >> 6) & 0x3F];
+		out[3] = BASE64_CHARACTERS[v & 0x3F];
+	}
+	auto remaining = end - in;
+	if(remaining == 0)
+		return;
+	uint32_t v = in[0] << 16;
+	if(remaining > 1)
+		v |= in[1] << 8;
+	out[0] = BASE64_CHARACTERS[(v >> 18) & 0x3F];
+	out[1] = BASE64_CHARACTERS[(v >> 12) & 0x3F];
+	out[2] = (remaining > 1) ? BASE64_CHARACTERS[(v >> 6) & 0x3F] : '=';
+	out[3] = '=';
+}
+
+std::string udm::base64_encode(const void *data, size_t size)
+{
+	std::string str;
+	str.resize(base64_get_encoded_size(size));
+	base64_encode(data, size, str.data());
+	return str;
+}
+
+std::optional<size_t> udm::base64_decode(const std::string_view &str, void *out)
+{
+	auto *in = str.data();
+	auto *end = in + str.size();
+	auto *outStart = static_cast<uint8_t *>(out);
+	auto *outCur = outStart;
+#ifdef UDM_BASE64_SIMD_SSSE3
+	if(g_ssse3Supported)
+		base64_decode_blocks(in, end, outCur);
+#endif
+	uint32_t accum = 0;
+	uint32_t numSextets = 0;
+	uint32_t numPadding = 0;
+	for(; in < end; ++in) {
+		auto v = BASE64_DECODE_TABLE[static_cast<uint8_t>(*in)];
+		if(v == BASE64_WHITESPACE)
+			continue;
+		if(v == BASE64_PADDING) {
+			++numPadding;
+			continue;
+		}
+		// Nothing but padding and whitespace may follow the first padding character
+		if(v == BASE64_INVALID || numPadding > 0)
+			return {};
+		accum = (accum << 6) | v;
+		if(++numSextets == 4) {
+			*outCur++ = static_cast<uint8_t>(accum >> 16);
+			*outCur++ = static_cast<uint8_t>(accum >> 8);
+			*outCur++ = static_cast<uint8_t>(accum);
+			accum = 0;
+			numSextets = 0;
+		}
+	}
+	switch(numSextets) {
+	case 0:
+		break;
+	case 2:
+		*outCur++ = static_cast<uint8_t>(accum >> 4);
+		break;
+	case 3:
+		*outCur++ = static_cast<uint8_t>(accum >> 10);
+		*outCur++ = static_cast<uint8_t>(accum >> 2);
+		break;
+	default:
+		return {};
+	}
+	if(numPadding > 2)
+		return {};
+	return static_cast<size_t>(outCur - outStart);
+}
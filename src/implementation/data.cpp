@@ -86,6 +86,16 @@ std::shared_ptr<udm::Data> udm::Data::Create(const std::string &assetType, Versi
 
 std::shared_ptr<udm::Data> udm::Data::Create() { return Create("", 0); }
 
+std::shared_ptr<udm::Data> udm::Data::Copy(MergeFlags mergeFlags) const
+{
+	auto udmData = std::shared_ptr<udm::Data> {new udm::Data {}};
+	udmData->m_header = m_header;
+	udmData->m_rootProperty = m_rootProperty->Copy(mergeFlags);
+	return udmData;
+}
+
+std::shared_ptr<const udm::FrozenData> udm::Data::Freeze() const { return FrozenData::Create(*m_rootProperty, m_header); }
+
 bool udm::Data::DebugTest()
 {
 	try {
@@ -316,25 +326,47 @@ std::shared_ptr<udm::Data> udm::Data::Open(const pragma::fs::VFilePtr &f) { retu
 std::shared_ptr<udm::Data> udm::Data::Open(std::unique_ptr<IFile> &&f)
 {
 	auto udmData = std::shared_ptr<udm::Data> {new udm::Data {}};
-	if(f->GetSize() < sizeof(Header)) {
+	udmData->m_header = ReadHeader(*f);
+	udmData->m_file = std::move(f);
+	return udmData;
+}
+
+udm::Header udm::Data::ReadHeader(IFile &f)
+{
+	if(f.GetSize() < sizeof(Header))
 		throw InvalidFormatError {"Header is too small, file is not a valid UDM file!"};
-		return nullptr;
-	}
-	udmData->m_header = f->Read<Header>();
-	if(pragma::string::compare(udmData->m_header.identifier.data(), HEADER_IDENTIFIER, true, strlen(HEADER_IDENTIFIER)) == false) {
+	auto header = f.Read<Header>();
+	if(pragma::string::compare(header.identifier.data(), HEADER_IDENTIFIER, true, strlen(HEADER_IDENTIFIER)) == false)
 		throw InvalidFormatError {"Unexpected header identifier, file is not a valid UDM file!"};
-		return nullptr;
-	}
-	if(udmData->m_header.version == 0) {
+	if(header.version == 0)
 		throw InvalidFormatError {"Unexpected header version, file is not a valid UDM file!"};
-		return nullptr;
+	if(header.version > VERSION)
+		throw InvalidFormatError {"File uses a newer UDM version (" + std::to_string(header.version) + ") than is supported by this version of UDM (" + std::to_string(VERSION) + ")!"};
+	return header;
+}
+
+std::shared_ptr<udm::Data> udm::Data::CreateFromRootProperty(PProperty rootProp)
+{
+	auto udmData = std::shared_ptr<udm::Data> {new udm::Data {}};
+	auto udmAssetData = (*rootProp)[KEY_ASSET_DATA];
+	if(!udmAssetData) {
+		auto assetDataProp = rootProp;
+		rootProp = Property::Create<Element>();
+		auto &elRoot = rootProp->GetValue<Element>();
+		elRoot.AddChild(KEY_ASSET_DATA, assetDataProp);
+		elRoot[KEY_ASSET_VERSION] = static_cast<uint32_t>(1);
+		elRoot[KEY_ASSET_TYPE] = "nil";
 	}
-	if(udmData->m_header.version > VERSION) {
-		throw InvalidFormatError {"File uses a newer UDM version (" + std::to_string(udmData->m_header.version) + ") than is supported by this version of UDM (" + std::to_string(VERSION) + ")!"};
-		return nullptr;
+	udmData->m_rootProperty = rootProp;
+	std::string assetType;
+	if((*rootProp)[KEY_ASSET_TYPE] >> assetType) {
+		for(auto &c : udmData->m_header.identifier)
+			c = '\0';
+		for(size_t i = 0; i < std::min(assetType.size(), udmData->m_header.identifier.size()); ++i)
+			udmData->m_header.identifier[i] = assetType[i];
 	}
-	udmData->m_file = std::move(f);
-	return udmData;
+	(*rootProp)[KEY_ASSET_VERSION] >> udmData->m_header.version;
+	return udmData->ValidateHeaderProperties() ? udmData : nullptr;
 }
 
 bool udm::Data::ValidateHeaderProperties()
@@ -390,26 +422,20 @@ std::shared_ptr<udm::Data> udm::Data::Load(std::unique_ptr<IFile> &&f)
 void udm::Data::ResolveReferences()
 {
 	auto root = GetAssetData().GetData();
-	std::function<void(LinkedPropertyWrapper &)> resolveReferences = nullptr;
-	resolveReferences = [&resolveReferences, &root](LinkedPropertyWrapper &prop) {
-		if(!prop)
-			return;
-		if(prop.IsType(Type::Element)) {
-			for(auto pair : prop.ElIt())
-				resolveReferences(pair.property);
-		}
-		else if(prop.IsType(Type::Array)) {
-			if(prop.GetValue<Array>().IsValueType(Type::Element)) {
-				for(auto child : prop)
-					resolveReferences(child);
-			}
-		}
-		else if(prop.IsType(Type::Reference)) {
-			auto &ref = prop.GetValue<Reference>();
-			ref.InitializeProperty(root);
+	if(!root.prop)
+		return;
+	walk(*root.prop, [&root](const WalkNode &node) {
+		switch(node.type) {
+		case Type::Reference:
+			node.GetValuePtr<Reference>()->InitializeProperty(root);
+			break;
+		case Type::ArrayLz4:
+			return WalkResult::SkipChildren; // References in compressed arrays aren't resolved, visiting them would decompress the array
+		default:
+			break;
 		}
-	};
-	resolveReferences(root);
+		return WalkResult::Continue;
+	});
 }
 
 udm::PProperty udm::Data::LoadProperty(const std::string_view &path) const
@@ -481,7 +507,7 @@ void udm::Data::SkipProperty(IFile &f, Type type)
 				auto offsetToEndOfStructuredDataHeader = f.Read<StructDescription::SizeType>();
 				f.Seek(f.Tell() + offsetToEndOfStructuredDataHeader);
 			}
-			else if(valueType == Type::Element)
+			else if(valueType == Type::Element || valueType == Type::String)
 				f.Seek(f.Tell() + sizeof(size_t));
 
 			using TSize = decltype(std::declval<Array>().GetSize());
@@ -514,7 +540,7 @@ std::string udm::Data::ReadKey(IFile &f)
 	f.Read(str.data(), len);
 	return str;
 }
-void udm::Data::WriteKey(IFile &f, const std::string &key)
+void udm::Data::WriteKey(IFile &f, const std::string_view &key)
 {
 	if(key.length() > std::numeric_limits<uint8_t>::max())
 		return WriteKey(f, key.substr(0, std::numeric_limits<uint8_t>::max()));
@@ -608,13 +634,13 @@ udm::PProperty udm::Data::LoadProperty(Type type, const std::string_view &path)
 std::string udm::AssetData::GetAssetType() const
 {
 	auto prop = (*this)["assetType"];
-	auto *val = prop ? prop.GetValuePtr<std::string>() : nullptr;
+	auto *val = prop ? prop.GetConstValuePtr<std::string>() : nullptr;
 	return val ? *val : "";
 }
 udm::Version udm::AssetData::GetAssetVersion() const
 {
 	auto prop = (*this)["assetVersion"];
-	auto *version = prop ? prop.GetValuePtr<Version>() : nullptr;
+	auto *version = prop ? prop.GetConstValuePtr<Version>() : nullptr;
 	return version ? *version : Version {0};
 }
 void udm::AssetData::SetAssetType(const std::string &assetType) const { (*this)[Data::KEY_ASSET_TYPE] = assetType; }
@@ -626,20 +652,6 @@ udm::Version udm::Data::GetAssetVersion() const { return AssetData {*m_rootPrope
 void udm::Data::SetAssetType(const std::string &assetType) { return AssetData {*m_rootProperty}.SetAssetType(assetType); }
 void udm::Data::SetAssetVersion(Version version) { return AssetData {*m_rootProperty}.SetAssetVersion(version); }
 
-void udm::Data::ToAscii(std::stringstream &ss, AsciiSaveFlags flags) const
-{
-	assert(m_rootProperty->type == Type::Element);
-	if(m_rootProperty->type == Type::Element) {
-		if(!pragma::math::is_flag_set(flags, AsciiSaveFlags::IncludeHeader)) {
-			auto udmAssetData = GetAssetData().GetData();
-			if(udmAssetData && udmAssetData->IsType(Type::Element))
-				udmAssetData->GetValue<Element>().ToAscii(flags, ss);
-		}
-		else
-			static_cast<Element *>(m_rootProperty->value)->ToAscii(flags, ss);
-	}
-}
-
 bool udm::Data::Save(IFile &f) const
 {
 	Header header {};
@@ -654,7 +666,46 @@ bool udm::Data::Save(const pragma::fs::VFilePtr &f)
 	return Save(fp);
 }
 
-udm::LinkedPropertyWrapper udm::Data::operator[](const std::string &key) const { return LinkedPropertyWrapper {*m_rootProperty}[KEY_ASSET_DATA][key]; }
+udm::LinkedPropertyWrapper udm::Data::operator[](const std::string &key) const
+{
+	// The children are looked up directly instead of through the path cache, which would require building a path for every lookup
+	// and modifying the cache from a const accessor. It's a single hash lookup per level either way.
+	static constexpr Key keyAssetData {KEY_ASSET_DATA};
+	auto &root = GetRootElement();
+	auto itAssetData = root.children.find(keyAssetData);
+	auto *assetData = (itAssetData != root.children.end() && itAssetData->second) ? std::as_const(*itAssetData->second).GetValuePtr<Element>() : nullptr;
+	if(assetData && !key.empty()) {
+		auto it = assetData->children.find(key);
+		if(it != assetData->children.end() && it->second) {
+			LinkedPropertyWrapper wrapper {*it->second};
+			wrapper.prev = std::make_unique<LinkedPropertyWrapper>(*itAssetData->second);
+			wrapper.prev->prev = std::make_unique<LinkedPropertyWrapper>(*m_rootProperty);
+			wrapper.prev->propName = KEY_ASSET_DATA;
+			wrapper.propName = key;
+			return wrapper;
+		}
+	}
+	return LinkedPropertyWrapper {*m_rootProperty}[KEY_ASSET_DATA][key];
+}
+udm::PropertyWrapper udm::Data::ResolvePath(const std::string_view &path)
+{
+	if(m_pathCache)
+		return m_pathCache->Find(*m_rootProperty, path);
+	PathCursor cursor {*m_rootProperty};
+	if(!cursor.DownPath(path))
+		return {};
+	auto &frame = cursor.GetFrame();
+	return frame.array ? PropertyWrapper {*frame.array, frame.arrayIndex} : PropertyWrapper {*frame.prop};
+}
+void udm::Data::SetPathCacheEnabled(bool enabled)
+{
+	if(!enabled) {
+		m_pathCache = nullptr;
+		return;
+	}
+	if(!m_pathCache)
+		m_pathCache = std::make_unique<PathCache>();
+}
 udm::Element *udm::Data::operator->() { return &operator*(); }
 const udm::Element *udm::Data::operator->() const { return const_cast<Data *>(this)->operator->(); }
 udm::Element &udm::Data::operator*() { return GetAssetData()->GetValue<Element>(); }
@@ -12,42 +12,67 @@ module pragma.udm;
 import :core;
 #endif
 
+void udm::Element::InitializeArray(Property &prop, std::optional<uint32_t> size, Type type)
+{
+	auto &a = *static_cast<Array *>(prop.value);
+	a.SetValueType(type);
+	if(size.has_value())
+		a.Resize(*size);
+}
+
 udm::LinkedPropertyWrapper udm::Element::AddArray(const std::string_view &path, std::optional<uint32_t> size, Type type, ArrayType arrayType, bool pathToElements)
 {
 	auto prop = Add(path, (arrayType == ArrayType::Compressed) ? Type::ArrayLz4 : Type::Array, pathToElements);
 	if(!prop)
 		return prop;
-	auto &a = *static_cast<Array *>(prop->value);
-	a.SetValueType(type);
-	if(size.has_value())
-		a.Resize(*size);
+	InitializeArray(*prop, size, type);
 	return prop;
 }
 
+udm::LinkedPropertyWrapper udm::Element::AddArray(const Key &key, std::optional<uint32_t> size, Type type, ArrayType arrayType)
+{
+	auto prop = Add(key, (arrayType == ArrayType::Compressed) ? Type::ArrayLz4 : Type::Array);
+	if(!prop)
+		return prop;
+	InitializeArray(*prop, size, type);
+	return prop;
+}
+
+udm::Property &udm::Element::FindOrAddChild(const Key &key, Type type, bool replaceMismatchingType)
+{
+	PrepareWrite();
+	auto it = children.find(key);
+	if(replaceMismatchingType && it != children.end() && it->second->type != type) {
+		EraseValue(it);
+		it = children.end();
+	}
+	if(it == children.end()) {
+		AddChild(std::string {key.str}, Property::Create(type));
+		it = children.find(key);
+		assert(it != children.end());
+	}
+	it->second->Unshare();
+	return *it->second;
+}
+
+udm::LinkedPropertyWrapper udm::Element::Add(const Key &key, Type type)
+{
+	if(key.str.empty())
+		return fromProperty;
+	return FindOrAddChild(key, type, true);
+}
+
 udm::LinkedPropertyWrapper udm::Element::Add(const std::string_view &path, Type type, bool pathToElements)
 {
 	auto end = pathToElements ? path.find(PATH_SEPARATOR) : std::string::npos;
 	auto name = path.substr(0, end);
 	if(name.empty())
 		return fromProperty;
-	std::string strName {name};
 	auto isLast = (end == std::string::npos);
-	auto it = children.find(strName);
-	if(isLast && it != children.end() && it->second->type != type) {
-		children.erase(it);
-		it = children.end();
-	}
-	if(it == children.end()) {
-		if(isLast)
-			AddChild(strName, Property::Create(type));
-		else
-			AddChild(strName, Property::Create<Element>());
-		it = children.find(strName);
-		assert(it != children.end());
-	}
+	auto &child = FindOrAddChild(Key {name}, isLast ? type : Type::Element, isLast);
 	if(isLast)
-		return *it->second;
-	return static_cast<Element *>(it->second->value)->Add(path.substr(end + 1), type);
+		return child;
+	return static_cast<Element *>(child.value)->Add(path.substr(end + 1), type);
 }
 
 bool udm::Element::operator==(const Element &other) const
@@ -70,7 +95,17 @@ udm::Element &udm::Element::operator=(Element &&other)
 {
 	if(this == &other)
 		return *this;
+	PrepareWrite();
+	DetachChildren();
 	children = std::move(other.children);
+	for(auto &[key, child] : children) {
+		if(!child->parent || child->parent == &other) {
+			child->parent = this;
+			child->key = &key;
+		}
+	}
+	invalidate_path_caches(*this);
+	invalidate_path_caches(other);
 	fromProperty = other.fromProperty;
 	parentProperty = other.parentProperty;
 	return *this;
@@ -79,7 +114,17 @@ udm::Element &udm::Element::operator=(const Element &other)
 {
 	if(this == &other)
 		return *this;
+	PrepareWrite();
+	DetachChildren();
 	children = other.children;
+	// The children are now referenced by both elements, but remain owned by the other one
+	for(auto &[key, child] : children) {
+		if(!child->parent) {
+			child->parent = this;
+			child->key = &key;
+		}
+	}
+	invalidate_path_caches(*this);
 	fromProperty = other.fromProperty;
 	parentProperty = other.parentProperty;
 	return *this;
@@ -90,44 +135,27 @@ void udm::Element::Copy(const Element &other)
 		AddChild(pair.first, pair.second->Copy(true));
 }
 
-void udm::Element::ToAscii(AsciiSaveFlags flags, std::stringstream &ss, const std::optional<std::string> &prefix) const
-{
-	auto childPrefix = prefix.has_value() ? (*prefix + '\t') : "";
-	auto first = true;
-
-	// We want to sort the children by name to have some consistency
-	std::vector<std::string_view> names;
-	names.reserve(children.size());
-	for(auto &[name, child] : children)
-		names.push_back(name);
-	std::sort(names.begin(), names.end());
-
-	for(auto &name : names) {
-		auto it = children.find(name);
-		assert(it != children.end());
-		if(it == children.end())
-			throw ImplementationError {"Failed to find key with name '" + std::string {name} + "'!"};
-		if(first)
-			first = false;
-		else
-			ss << "\n";
-		it->second->ToAscii(flags, ss, it->first, childPrefix);
-	}
-}
-
 void udm::Element::Merge(const Element &other, MergeFlags mergeFlags)
 {
+	auto copyChild = [mergeFlags](const PProperty &prop) -> PProperty {
+		if(pragma::math::is_flag_set(mergeFlags, MergeFlags::DeepCopy))
+			return prop->Copy(true);
+		if(pragma::math::is_flag_set(mergeFlags, MergeFlags::CopyOnWrite))
+			return prop->Share();
+		return prop;
+	};
+	PrepareWrite();
 	for(auto &pair : other.children) {
-		auto &prop = *pair.second;
+		const auto &prop = *pair.second;
 		if(!prop.IsType(Type::Element) && !is_array_type(prop.type)) {
-			AddChild(pair.first, pragma::math::is_flag_set(mergeFlags, MergeFlags::DeepCopy) ? pair.second->Copy(true) : pair.second);
+			AddChild(pair.first, copyChild(pair.second));
 			continue;
 		}
 		auto it = children.find(pair.first);
 		if(it == children.end() || (prop.type != it->second->type && (!is_array_type(prop.type) || !is_array_type(it->second->type)))) {
 			if(it != children.end() && pragma::math::is_flag_set(mergeFlags, MergeFlags::OverwriteExisting) == false)
 				continue;
-			AddChild(pair.first, pragma::math::is_flag_set(mergeFlags, MergeFlags::DeepCopy) ? pair.second->Copy(true) : pair.second);
+			AddChild(pair.first, copyChild(pair.second));
 			continue;
 		}
 		if(prop.IsType(Type::Element)) {
@@ -139,13 +167,77 @@ void udm::Element::Merge(const Element &other, MergeFlags mergeFlags)
 	}
 }
 
+udm::Property *udm::Element::UnshareChild(const std::string_view &key)
+{
+	auto it = children.find(key);
+	if(it == children.end())
+		return nullptr;
+	PrepareWrite();
+	it->second->Unshare();
+	return it->second.get();
+}
+
+void udm::Element::PrepareWrite()
+{
+	if(fromProperty.prop)
+		fromProperty.prop->Unshare();
+}
+
 udm::ElementIterator udm::Element::begin() { return ElementIterator {*this, children, children.begin()}; }
 udm::ElementIterator udm::Element::end() { return ElementIterator {*this, children, children.end()}; }
 
+udm::Element::~Element() { DetachChildren(); }
+
+void udm::Element::DetachChildren()
+{
+	for(auto &[key, child] : children) {
+		if(child && child->parent == this) {
+			child->parent = nullptr;
+			child->key = nullptr;
+		}
+	}
+}
+
+const std::string *udm::Element::FindKey(const Property &child) const
+{
+	if(child.parent == this)
+		return child.key;
+	// The property may have been added to multiple elements, in which case we have to fall back to a linear search
+	auto it = std::find_if(children.begin(), children.end(), [&child](const std::pair<const std::string, PProperty> &pair) { return pair.second.get() == &child; });
+	return (it != children.end()) ? &it->first : nullptr;
+}
+
+udm::KeyMap<udm::PProperty>::iterator udm::Element::FindChild(const Element &child)
+{
+	auto *prop = child.fromProperty.prop;
+	if(prop && prop->type == Type::Element && prop->value == &child && prop->parent == this)
+		return children.find(*prop->key); // The key is known, so this is a single lookup instead of a linear search
+	return std::find_if(children.begin(), children.end(), [&child](const std::pair<const std::string, PProperty> &pair) { return get_property_type(*pair.second) == udm::Type::Element && get_property_value(*pair.second) == &child; });
+}
+
 void udm::Element::EraseValue(const Element &child)
 {
-	auto it = std::find_if(children.begin(), children.end(), [&child](const std::pair<std::string, PProperty> &pair) { return get_property_type(*pair.second) == udm::Type::Element && get_property_value(*pair.second) == &child; });
+	auto it = FindChild(child);
 	if(it == children.end())
 		return;
+	EraseValue(it);
+}
+
+void udm::Element::EraseValue(const std::string_view &key)
+{
+	auto it = children.find(key);
+	if(it == children.end())
+		return;
+	EraseValue(it);
+}
+
+void udm::Element::EraseValue(KeyMap<PProperty>::iterator it)
+{
+	PrepareWrite(); // The value is kept by the owning property, so the iterator remains valid
+	if(it->second && it->second->parent == this) {
+		it->second->parent = nullptr;
+		it->second->key = nullptr;
+	}
 	children.erase(it);
+	invalidate_path_caches(*this);
 }
@@ -0,0 +1,417 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include <cassert>
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+// Payloads of trivial values and arrays are aligned to this boundary, which matches the alignment of the buffer itself
+static constexpr size_t FROZEN_VALUE_ALIGNMENT = 16;
+
+namespace udm {
+	class FrozenDataBuilder {
+	  public:
+		uint64_t Allocate(size_t size, size_t alignment = alignof(uint64_t))
+		{
+			auto offset = (m_data.size() + alignment - 1) & ~(alignment - 1);
+			m_data.resize(offset + size);
+			return offset;
+		}
+		uint64_t Write(const void *data, size_t size, size_t alignment = 1)
+		{
+			auto offset = Allocate(size, alignment);
+			if(size > 0)
+				memcpy(m_data.data() + offset, data, size);
+			return offset;
+		}
+		template<typename T>
+		void Set(uint64_t offset, const T &value)
+		{
+			memcpy(m_data.data() + offset, &value, sizeof(T));
+		}
+		FrozenNode Freeze(Type type, const void *value);
+		std::vector<uint8_t> &GetData() { return m_data; }
+	  private:
+		uint64_t FreezeStruct(const StructDescription &desc, const void *data, uint32_t count);
+		std::vector<uint8_t> m_data;
+	};
+};
+
+uint64_t udm::FrozenDataBuilder::FreezeStruct(const StructDescription &desc, const void *data, uint32_t count)
+{
+	auto memberCount = desc.GetMemberCount();
+	auto offset = Allocate(sizeof(FrozenStruct) + memberCount * sizeof(FrozenStructMember));
+	FrozenStruct strct {};
+	strct.dataSize = desc.GetDataSizeRequirement();
+	strct.memberCount = memberCount;
+	for(auto i = decltype(memberCount) {0u}; i < memberCount; ++i) {
+		FrozenStructMember member {};
+		member.type = desc.types[i];
+		member.nameLength = desc.names[i].length();
+		member.nameOffset = Write(desc.names[i].data(), desc.names[i].length());
+		Set(offset + sizeof(FrozenStruct) + i * sizeof(FrozenStructMember), member);
+	}
+	strct.dataOffset = Write(data, static_cast<size_t>(strct.dataSize) * count, FROZEN_VALUE_ALIGNMENT);
+	Set(offset, strct);
+	return offset;
+}
+
+udm::FrozenNode udm::FrozenDataBuilder::Freeze(Type type, const void *value)
+{
+	FrozenNode node {};
+	node.type = type;
+	if(!value)
+		return node;
+	if(is_trivial_type(type)) {
+		node.size = size_of_base_type(type);
+		node.offset = Write(value, node.size, FROZEN_VALUE_ALIGNMENT);
+		return node;
+	}
+	switch(type) {
+	case Type::String:
+		{
+			auto &str = *static_cast<const String *>(value);
+			node.size = str.length();
+			node.offset = Write(str.data(), str.length());
+			break;
+		}
+	case Type::Utf8String:
+		{
+			auto &str = *static_cast<const Utf8String *>(value);
+			node.size = str.data.size();
+			node.offset = Write(str.data.data(), str.data.size());
+			break;
+		}
+	case Type::Reference:
+		{
+			auto &ref = *static_cast<const Reference *>(value);
+			node.size = ref.path.length();
+			node.offset = Write(ref.path.data(), ref.path.length());
+			break;
+		}
+	case Type::Blob:
+		{
+			auto &blob = *static_cast<const Blob *>(value);
+			node.size = blob.data.size();
+			node.offset = Write(blob.data.data(), blob.data.size(), FROZEN_VALUE_ALIGNMENT);
+			break;
+		}
+	case Type::BlobLz4:
+		{
+			// Uncompressed size followed by the compressed data
+			auto &blob = *static_cast<const BlobLz4 *>(value);
+			node.size = blob.compressedData.size();
+			node.offset = Allocate(sizeof(uint64_t) + blob.compressedData.size());
+			Set<uint64_t>(node.offset, blob.uncompressedSize);
+			if(!blob.compressedData.empty())
+				memcpy(m_data.data() + node.offset + sizeof(uint64_t), blob.compressedData.data(), blob.compressedData.size());
+			break;
+		}
+	case Type::Struct:
+		{
+			auto &strct = *static_cast<const Struct *>(value);
+			node.size = 1;
+			node.offset = FreezeStruct(strct.description, strct.data.data(), 1);
+			break;
+		}
+	case Type::Element:
+		{
+			auto &el = *static_cast<const Element *>(value);
+			std::vector<std::pair<std::string_view, const Property *>> children;
+			children.reserve(el.children.size());
+			for(auto &[key, child] : el.children)
+				children.push_back({key, child.get()});
+			std::sort(children.begin(), children.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+			node.size = children.size();
+			node.offset = Allocate(children.size() * sizeof(FrozenChild));
+			for(auto i = decltype(children.size()) {0u}; i < children.size(); ++i) {
+				auto &[key, child] = children[i];
+				FrozenChild frozenChild {};
+				frozenChild.keyLength = key.length();
+				frozenChild.keyOffset = Write(key.data(), key.length());
+				frozenChild.node = Freeze(child->type, child->value);
+				Set(node.offset + i * sizeof(FrozenChild), frozenChild);
+			}
+			break;
+		}
+	case Type::Array:
+	case Type::ArrayLz4:
+		{
+			// Compressed arrays are stored uncompressed to allow direct access. Decompressing the array would modify the source data,
+			// so the compressed data is decompressed into a temporary copy instead.
+			auto *pa = static_cast<const Array *>(value);
+			PProperty decompressed = nullptr;
+			if(type == Type::ArrayLz4) {
+				decompressed = Property::Create(Type::ArrayLz4);
+				auto &tmp = *static_cast<ArrayLz4 *>(decompressed->value);
+				if(tmp.CopyCompressed(*static_cast<const ArrayLz4 *>(pa)))
+					pa = &tmp;
+			}
+			auto &a = *pa;
+			auto valueType = a.GetValueType();
+			auto size = a.GetSize();
+			node.size = size;
+			node.valueType = valueType;
+			node.arrayType = a.GetArrayType();
+			if(size == 0 && valueType != Type::Struct)
+				break;
+			auto *values = static_cast<const uint8_t *>(a.GetValues());
+			if(valueType == Type::Struct) {
+				auto *strct = a.GetStructuredDataInfo();
+				if(!strct)
+					throw ImplementationError {"Struct array has invalid structure data info!"};
+				node.offset = FreezeStruct(*strct, values, size);
+				break;
+			}
+			if(is_trivial_type(valueType)) {
+				node.offset = Write(values, a.GetByteSize(), FROZEN_VALUE_ALIGNMENT);
+				break;
+			}
+			auto valueSize = size_of_base_type(valueType);
+			node.offset = Allocate(size * sizeof(FrozenNode));
+			for(auto i = decltype(size) {0u}; i < size; ++i)
+				Set(node.offset + i * sizeof(FrozenNode), Freeze(valueType, values + i * valueSize));
+			break;
+		}
+	default:
+		break;
+	}
+	static_assert(pragma::math::to_integral(Type::Count) == 36, "Update this list when new types are added!");
+	return node;
+}
+
+std::shared_ptr<const udm::FrozenData> udm::FrozenData::Create(const Property &root, const Header &header)
+{
+	FrozenDataBuilder builder {};
+	auto rootOffset = builder.Allocate(sizeof(FrozenNode));
+	assert(rootOffset == 0);
+	builder.Set(rootOffset, builder.Freeze(root.type, root.value));
+
+	auto &data = builder.GetData();
+	auto frozenData = std::shared_ptr<FrozenData> {new FrozenData {}};
+	frozenData->m_header = header;
+	frozenData->m_size = data.size();
+	frozenData->m_buffer = std::unique_ptr<uint8_t[]> {new uint8_t[data.size()]};
+	static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= FROZEN_VALUE_ALIGNMENT);
+	memcpy(frozenData->m_buffer.get(), data.data(), data.size());
+	return frozenData;
+}
+
+udm::FrozenProperty udm::FrozenData::GetAssetData() const { return GetRoot()[Data::KEY_ASSET_DATA]; }
+
+std::shared_ptr<udm::Data> udm::FrozenData::Thaw() const
+{
+	auto root = GetRoot().Thaw();
+	if(!root || !root->IsType(Type::Element))
+		return nullptr;
+	auto udmData = std::shared_ptr<Data> {new Data {}};
+	udmData->m_header = m_header;
+	udmData->m_rootProperty = root;
+	udmData->ResolveReferences();
+	return udmData;
+}
+
+uint32_t udm::FrozenProperty::GetSize() const
+{
+	if(!m_node || (m_node->type != Type::Element && !is_array_type(m_node->type)))
+		return 0;
+	return m_node->size;
+}
+
+std::string_view udm::FrozenProperty::GetKey(uint32_t idx) const
+{
+	if(!IsType(Type::Element) || idx >= m_node->size)
+		return {};
+	auto &child = GetData<FrozenChild>(m_node->offset)[idx];
+	return GetString(child.keyOffset, child.keyLength);
+}
+
+udm::FrozenProperty udm::FrozenProperty::GetChild(uint32_t idx) const
+{
+	if(!IsType(Type::Element) || idx >= m_node->size)
+		return {};
+	return FrozenProperty {m_data, &GetData<FrozenChild>(m_node->offset)[idx].node};
+}
+
+udm::FrozenProperty udm::FrozenProperty::operator[](const std::string_view &key) const
+{
+	if(!IsType(Type::Element))
+		return {};
+	auto *begin = GetData<FrozenChild>(m_node->offset);
+	auto *end = begin + m_node->size;
+	auto it = std::lower_bound(begin, end, key, [this](const FrozenChild &child, const std::string_view &key) { return GetString(child.keyOffset, child.keyLength) < key; });
+	if(it == end || GetString(it->keyOffset, it->keyLength) != key)
+		return {};
+	return FrozenProperty {m_data, &it->node};
+}
+
+udm::FrozenProperty udm::FrozenProperty::operator[](uint32_t idx) const
+{
+	if(!m_node || !is_array_type(m_node->type) || idx >= m_node->size || is_trivial_type(m_node->valueType) || m_node->valueType == Type::Struct)
+		return {};
+	return FrozenProperty {m_data, &GetData<FrozenNode>(m_node->offset)[idx]};
+}
+
+udm::FrozenProperty udm::FrozenProperty::GetFromPath(const std::string_view &path) const
+{
+	// Supports the same path syntax as PropertyWrapper::GetFromPath, e.g. a/b[2]/"c d"
+	auto prop = *this;
+	auto valid = for_each_path_segment(path, [&prop](const PathSegment &segment) {
+		prop = segment.IsIndex() ? prop[segment.index] : prop[segment.key.str];
+		return static_cast<bool>(prop);
+	});
+	return valid ? prop : FrozenProperty {};
+}
+
+std::string_view udm::FrozenProperty::GetString() const
+{
+	if(!m_node)
+		return {};
+	switch(m_node->type) {
+	case Type::String:
+	case Type::Utf8String:
+	case Type::Reference:
+		return GetString(m_node->offset, m_node->size);
+	default:
+		break;
+	}
+	return {};
+}
+
+std::span<const uint8_t> udm::FrozenProperty::GetBlobData() const
+{
+	if(!m_node)
+		return {};
+	switch(m_node->type) {
+	case Type::Blob:
+	case Type::Utf8String:
+		return {m_data + m_node->offset, m_node->size};
+	case Type::BlobLz4:
+		return {m_data + m_node->offset + sizeof(uint64_t), m_node->size};
+	case Type::Struct:
+		{
+			auto &strct = *GetData<FrozenStruct>(m_node->offset);
+			return {m_data + strct.dataOffset, strct.dataSize};
+		}
+	default:
+		break;
+	}
+	return {};
+}
+
+void udm::FrozenProperty::ThawStruct(StructDescription &outDesc) const
+{
+	auto &strct = *GetData<FrozenStruct>(m_node->offset);
+	auto *members = GetData<FrozenStructMember>(m_node->offset + sizeof(FrozenStruct));
+	outDesc.Clear();
+	outDesc.types.reserve(strct.memberCount);
+	outDesc.names.reserve(strct.memberCount);
+	for(auto i = decltype(strct.memberCount) {0u}; i < strct.memberCount; ++i) {
+		outDesc.types.push_back(members[i].type);
+		outDesc.names.push_back(String {GetString(members[i].nameOffset, members[i].nameLength)});
+	}
+}
+
+void udm::FrozenProperty::ThawValue(void *outValue) const
+{
+	auto type = m_node->type;
+	if(is_trivial_type(type)) {
+		memcpy(outValue, GetPayload(), size_of_base_type(type));
+		return;
+	}
+	switch(type) {
+	case Type::String:
+		*static_cast<String *>(outValue) = String {GetString()};
+		break;
+	case Type::Utf8String:
+		{
+			auto data = GetBlobData();
+			static_cast<Utf8String *>(outValue)->data.assign(data.begin(), data.end());
+			break;
+		}
+	case Type::Reference:
+		static_cast<Reference *>(outValue)->path = GetString();
+		break;
+	case Type::Blob:
+		{
+			auto data = GetBlobData();
+			static_cast<Blob *>(outValue)->data.assign(data.begin(), data.end());
+			break;
+		}
+	case Type::BlobLz4:
+		{
+			auto &blob = *static_cast<BlobLz4 *>(outValue);
+			auto data = GetBlobData();
+			blob.compressedData.assign(data.begin(), data.end());
+			blob.uncompressedSize = *GetData<uint64_t>(m_node->offset);
+			break;
+		}
+	case Type::Struct:
+		{
+			auto &strct = *static_cast<Struct *>(outValue);
+			ThawStruct(strct.description);
+			strct.UpdateData();
+			auto data = GetBlobData();
+			if(strct.data.size() != data.size())
+				throw ImplementationError {"Size of frozen struct data does not match its types!"};
+			memcpy(strct.data.data(), data.data(), data.size());
+			break;
+		}
+	case Type::Element:
+		{
+			auto &el = *static_cast<Element *>(outValue);
+			for(auto i = decltype(m_node->size) {0u}; i < m_node->size; ++i)
+				el.AddChild(std::string {GetKey(i)}, GetChild(i).Thaw());
+			break;
+		}
+	case Type::Array:
+	case Type::ArrayLz4:
+		{
+			auto &a = *static_cast<Array *>(outValue);
+			auto valueType = m_node->valueType;
+			auto size = m_node->size;
+			a.SetValueType(valueType);
+			if(valueType == Type::Struct) {
+				auto *strct = a.GetStructuredDataInfo();
+				if(strct)
+					ThawStruct(*strct);
+				a.Resize(size);
+				if(size > 0)
+					memcpy(a.GetValues(), m_data + GetData<FrozenStruct>(m_node->offset)->dataOffset, a.GetByteSize());
+				break;
+			}
+			a.Resize(size);
+			if(size == 0)
+				break;
+			if(is_trivial_type(valueType)) {
+				memcpy(a.GetValues(), GetPayload(), a.GetByteSize());
+				break;
+			}
+			for(auto i = decltype(size) {0u}; i < size; ++i)
+				(*this)[i].ThawValue(a.GetValuePtr(i));
+			break;
+		}
+	default:
+		break;
+	}
+	static_assert(pragma::math::to_integral(Type::Count) == 36, "Update this list when new types are added!");
+}
+
+udm::PProperty udm::FrozenProperty::Thaw() const
+{
+	if(!m_node)
+		return nullptr;
+	auto prop = Property::Create(m_node->type);
+	if(prop->value)
+		ThawValue(prop->value);
+	if(prop->IsType(Type::ArrayLz4))
+		static_cast<ArrayLz4 *>(prop->value)->ClearUncompressedMemory();
+	return prop;
+}
@@ -62,10 +62,8 @@ pragma::util::MurmurHash3 hash(const udm::Array &v)
 	udm::visit(valueType, [&](auto tag) {
 		using T = typename decltype(tag)::type;
 		if constexpr(udm::is_non_trivial_type(udm::type_to_enum<T>())) {
-			for(auto &val : const_cast<udm::Array &>(v)) {
-				auto &v = val.GetValue<T>();
-				hash_combine(hashVal, hash(v));
-			}
+			for(auto i = decltype(v.GetSize()) {0u}; i < v.GetSize(); ++i)
+				hash_combine(hashVal, hash(v.GetValue<T>(i)));
 		}
 	});
 	return hashVal;
@@ -25,7 +25,7 @@ udm::ElementIterator::ElementIterator() : m_iterator {} {}
 
 udm::ElementIterator::ElementIterator(udm::Element &e) : ElementIterator {e, e.children, e.children.begin()} {}
 
-udm::ElementIterator::ElementIterator(udm::Element &e, pragma::string::StringMap<PProperty> &c, pragma::string::StringMap<PProperty>::iterator it) : m_iterator {it}, m_pair {}, m_propertyMap {&c}
+udm::ElementIterator::ElementIterator(udm::Element &e, KeyMap<PProperty> &c, KeyMap<PProperty>::iterator it) : m_iterator {it}, m_pair {}, m_propertyMap {&c}
 {
 	if(it != c.end())
 		m_pair = {it};
@@ -5,12 +5,305 @@ module;
 
 #include <cassert>
 
+#include "text_scan.hpp"
+
 module pragma.udm;
 
 #ifndef UDM_SINGLE_MODULE_INTERFACE
 import :core;
 #endif
 
+namespace udm {
+	// Writes standard JSON through a fixed-size buffer, either to a file or a string
+	class JsonWriter : public TextWriter<JsonWriter> {
+	  public:
+		static constexpr std::string_view LIST_SEPARATOR = ",";
+		JsonWriter(IFile &f, JsonFormat format);
+		JsonWriter(std::string &outStr, JsonFormat format);
+
+		void WriteValue(Type type, const void *value);
+	  private:
+		friend TextWriter<JsonWriter>;
+		bool IsPretty() const { return m_format == JsonFormat::Pretty; }
+		// Line break followed by the current indentation, only in pretty mode
+		void WriteLineBreak();
+		void Indent() { m_indent += '\t'; }
+		void Unindent() { m_indent.pop_back(); }
+		void WriteString(const std::string_view &str);
+		void WriteQuotedBase64(const void *data, size_t size);
+		template<typename T>
+		void WriteNumber(T value);
+		void WriteElement(const Element &el);
+		void WriteArray(const Array &a);
+
+		void WriteValue(const Nil &nil) { Write("null"); }
+		void WriteValue(const Blob &blob) { WriteQuotedBase64(blob.data.data(), blob.data.size()); }
+		void WriteValue(const BlobLz4 &blob);
+		void WriteValue(const Utf8String &utf8) { WriteString(std::string_view {reinterpret_cast<const char *>(utf8.data.data()), utf8.data.size()}); }
+		void WriteValue(const Element &el) { WriteElement(el); }
+		void WriteValue(const Array &a) { WriteArray(a); }
+		void WriteValue(const ArrayLz4 &a) { WriteArray(a); }
+		void WriteValue(const String &str) { WriteString(str); }
+		void WriteValue(const Reference &ref) { WriteString(ref.path); }
+		void WriteValue(const Struct &strct) { WriteStructValue(*strct, strct.data.data()); }
+		using TextWriter::WriteValue;
+
+		JsonFormat m_format = JsonFormat::Pretty;
+		std::string m_indent;
+	};
+
+	struct JsonNumber {
+		double d = 0.0;
+		int64_t i = 0;
+		bool isInteger = false;
+		// Integers above the range of int64_t are stored in 'u' instead of 'i'
+		bool isUInt64 = false;
+		uint64_t u = 0;
+	};
+
+	// Single-pass recursive descent parser that creates the properties while the JSON text is read (see Data::LoadJson)
+	class JsonReader {
+	  public:
+		// The data has to remain valid until the function returns
+		static std::shared_ptr<Data> LoadJson(const std::string_view &json, const KeyMap<Type> &typeHints);
+	  private:
+		JsonReader(const std::string_view &json, const KeyMap<Type> &typeHints);
+		template<class TException>
+		TException BuildException(const std::string &msg)
+		{
+			uint32_t line, column;
+			GetCursorPosition(line, column);
+			return TException {msg, line, column};
+		}
+		void GetCursorPosition(uint32_t &outLine, uint32_t &outColumn) const;
+		// Skips whitespace and returns the next character without consuming it, or eof
+		int PeekChar();
+		void ExpectChar(char c);
+		void ReadLiteral(const std::string_view &literal);
+		// Reads a quoted string and resolves its escape sequences
+		void ReadString(std::string &outStr);
+		JsonNumber ReadNumber();
+		JsonNumber ReadNumberOrBoolean();
+		// Calls itemHandler(index) for each item of the array or object at the cursor, returns the number of items
+		template<typename TItemHandler>
+		uint32_t ReadList(char open, char close, TItemHandler &&itemHandler);
+		// Hint for the path of the current value, or Type::Invalid
+		Type GetTypeHint() const;
+		// Type for the specified number or string values, throws a DataError if the hint can't be applied to them
+		Type GetNumericType(Type hint, const JsonNumber *numbers, size_t count, bool isBoolean);
+		Type GetStringType(Type hint);
+		void ReadObject(Element &el);
+		PProperty ReadValue();
+		void ReadStringValue(Type type, void *outData);
+		void ReadArray(Array &a, Type hint);
+		// Appends all numbers of the (possibly nested) array at the cursor to m_numbers, returns its nesting depth
+		uint32_t ReadNestedNumbers(Type type);
+		PProperty ReadGenericValue(Type type);
+
+		const char *m_begin = nullptr;
+		const char *m_cur = nullptr;
+		const char *m_end = nullptr;
+		const KeyMap<Type> &m_typeHints;
+		std::string m_path;
+		std::string m_string;
+		std::vector<JsonNumber> m_numbers;
+	};
+};
+
+udm::JsonWriter::JsonWriter(IFile &f, JsonFormat format) : TextWriter {f}, m_format {format} {}
+udm::JsonWriter::JsonWriter(std::string &outStr, JsonFormat format) : TextWriter {outStr}, m_format {format} {}
+void udm::JsonWriter::WriteLineBreak()
+{
+	if(!IsPretty())
+		return;
+	Write('\n');
+	Write(m_indent);
+}
+void udm::JsonWriter::WriteString(const std::string_view &str)
+{
+	Write('\"');
+	// Unescaped runs are written in one go
+	auto *start = str.data();
+	auto *end = start + str.size();
+	for(auto *p = start; p < end; ++p) {
+		auto c = static_cast<uint8_t>(*p);
+		if(c >= 0x20 && c != '\"' && c != '\\')
+			continue;
+		Write(std::string_view {start, static_cast<size_t>(p - start)});
+		start = p + 1;
+		switch(c) {
+		case '\"':
+			Write("\\\"");
+			break;
+		case '\\':
+			Write("\\\\");
+			break;
+		case '\n':
+			Write("\\n");
+			break;
+		case '\r':
+			Write("\\r");
+			break;
+		case '\t':
+			Write("\\t");
+			break;
+		default:
+			{
+				constexpr std::string_view hexDigits = "0123456789abcdef";
+				std::array<char, 6> escaped {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF]};
+				Write(std::string_view {escaped.data(), escaped.size()});
+				break;
+			}
+		}
+	}
+	Write(std::string_view {start, static_cast<size_t>(end - start)});
+	Write('\"');
+}
+void udm::JsonWriter::WriteQuotedBase64(const void *data, size_t size)
+{
+	Write('\"');
+	WriteBase64(data, size);
+	Write('\"');
+}
+template<typename T>
+void udm::JsonWriter::WriteNumber(T value)
+{
+	if constexpr(std::is_same_v<T, Boolean>)
+		Write(value ? std::string_view {"true"} : std::string_view {"false"});
+	else if constexpr(std::is_same_v<T, Half>)
+		WriteNumber(static_cast<float>(value));
+	else {
+		// JSON has no representation for infinity and NaN
+		if constexpr(std::is_floating_point_v<T>) {
+			if(!std::isfinite(value)) {
+				Write("null");
+				return;
+			}
+		}
+		constexpr size_t maxLen = 32; // Enough for any integer, or floating point value in the shortest representation
+		WriteChars(maxLen, [value](char *first, char *last) {
+			if constexpr(std::is_floating_point_v<T>)
+				return std::to_chars(first, last, value).ptr;
+			else
+				return std::to_chars(first, last, +value).ptr;
+		});
+	}
+}
+void udm::JsonWriter::WriteValue(const BlobLz4 &blob)
+{
+	auto decompressed = Property::GetBlobData(blob);
+	WriteValue(decompressed);
+}
+void udm::JsonWriter::WriteElement(const Element &el)
+{
+	if(el.children.empty()) {
+		Write("{}");
+		return;
+	}
+	Write('{');
+	Indent();
+	auto first = true;
+	for(auto &[key, child] : el.children) {
+		if(first)
+			first = false;
+		else
+			Write(',');
+		WriteLineBreak();
+		WriteString(key);
+		Write(IsPretty() ? std::string_view {": "} : std::string_view {":"});
+		if(child)
+			WriteValue(child->type, child->value);
+		else
+			Write("null");
+	}
+	Unindent();
+	WriteLineBreak();
+	Write('}');
+}
+void udm::JsonWriter::WriteArray(const Array &a)
+{
+	auto *values = a.GetValues(); // Has to be called first in case the array is compressed
+	auto valueType = a.GetValueType();
+	auto n = a.GetSize();
+	Write('[');
+	if(valueType == Type::Element) {
+		// Each element on a separate line
+		Indent();
+		auto *items = static_cast<const Element *>(values);
+		for(auto i = decltype(n) {0u}; i < n; ++i) {
+			if(i > 0)
+				Write(',');
+			WriteLineBreak();
+			WriteElement(items[i]);
+		}
+		Unindent();
+		if(n > 0)
+			WriteLineBreak();
+	}
+	else if(is_numeric_type(valueType)) {
+		std::visit(
+		  [this, values, n](auto tag) {
+			  using T = typename decltype(tag)::type;
+			  auto *typedValues = static_cast<const T *>(values);
+			  for(auto i = decltype(n) {0u}; i < n; ++i) {
+				  if(i > 0)
+					  Write(',');
+				  WriteNumber(typedValues[i]);
+			  }
+		  },
+		  get_numeric_tag(valueType));
+	}
+	else if(valueType == Type::Struct) {
+		auto &strct = *a.GetStructuredDataInfo();
+		auto sz = strct.GetDataSizeRequirement();
+		auto *ptr = static_cast<const uint8_t *>(values);
+		for(auto i = decltype(n) {0u}; i < n; ++i) {
+			if(i > 0)
+				Write(',');
+			WriteStructValue(strct, ptr);
+			ptr += sz;
+		}
+	}
+	else {
+		auto vs = [this, values, n](auto tag) {
+			using T = typename decltype(tag)::type;
+			auto *typedValues = static_cast<const T *>(values);
+			for(auto i = decltype(n) {0u}; i < n; ++i) {
+				if(i > 0)
+					Write(',');
+				WriteValue(typedValues[i]);
+			}
+		};
+		if(is_gnt_type(valueType))
+			visit_gnt(valueType, vs);
+	}
+	Write(']');
+}
+void udm::JsonWriter::WriteValue(Type type, const void *value)
+{
+	if(!value) {
+		Write("null");
+		return;
+	}
+	if(is_numeric_type(type)) {
+		std::visit(
+		  [this, value](auto tag) {
+			  using T = typename decltype(tag)::type;
+			  WriteNumber(*static_cast<const T *>(value));
+		  },
+		  get_numeric_tag(type));
+		return;
+	}
+	auto vs = [this, value](auto tag) {
+		using T = typename decltype(tag)::type;
+		WriteValue(*static_cast<const T *>(value));
+	};
+	if(is_gnt_type(type))
+		visit_gnt(type, vs);
+	else
+		Write("null");
+}
+
 static void to_json(udm::LinkedPropertyWrapperArg prop, std::stringstream &ss, const std::string &t)
 {
 	auto type = prop.GetType();
@@ -59,8 +352,16 @@ static void to_json(udm::LinkedPropertyWrapperArg prop, std::stringstream &ss, c
 			blobData.resize(blobSize);
 			auto res = prop.GetBlobData(blobData.data(), blobData.size());
 			if(res == udm::BlobResult::Success) {
-				auto encoded = pragma::util::base64_encode(blobData.data(), blobData.size());
-				ss << "\"" << encoded << "\"";
+				// Encode in chunks straight into the stream instead of building the whole string first
+				constexpr size_t chunkSize = 3 * 1024;
+				std::array<char, udm::base64_get_encoded_size(chunkSize)> buf;
+				ss << "\"";
+				for(size_t offset = 0; offset < blobData.size(); offset += chunkSize) {
+					auto size = std::min(chunkSize, blobData.size() - offset);
+					udm::base64_encode(blobData.data() + offset, size, buf.data());
+					ss.write(buf.data(), udm::base64_get_encoded_size(size));
+				}
+				ss << "\"";
 				return;
 			}
 		}
@@ -68,6 +369,25 @@ static void to_json(udm::LinkedPropertyWrapperArg prop, std::stringstream &ss, c
 		return;
 	}
 
+	if(udm::is_numeric_type(type) && type != udm::Type::Half) {
+		// Same output as the string conversion (std::to_string), but without the temporary string
+		std::array<char, 384> buf;
+		auto *end = std::visit(
+		  [&prop, &buf](auto tag) -> char * {
+			  using T = typename decltype(tag)::type;
+			  auto value = prop.GetValue<T>();
+			  if constexpr(std::is_floating_point_v<T>)
+				  return std::to_chars(buf.data(), buf.data() + buf.size(), value, std::chars_format::fixed, 6).ptr;
+			  else
+				  return std::to_chars(buf.data(), buf.data() + buf.size(), +value).ptr;
+		  },
+		  udm::get_numeric_tag(type));
+		ss << '"';
+		ss.write(buf.data(), end - buf.data());
+		ss << '"';
+		return;
+	}
+
 	auto strVal = prop.ToValue<udm::String>();
 	if(!strVal.has_value())
 		std::cout << "";
@@ -77,3 +397,629 @@ static void to_json(udm::LinkedPropertyWrapperArg prop, std::stringstream &ss, c
 }
 
 void udm::to_json(LinkedPropertyWrapperArg prop, std::stringstream &ss) { ::to_json(prop, ss, ""); }
+void udm::to_json(LinkedPropertyWrapperArg prop, IFile &f, JsonFormat format)
+{
+	JsonWriter writer {f, format};
+	auto type = Type::Nil;
+	auto *value = prop ? prop.GetValuePtr(type) : nullptr;
+	writer.WriteValue(type, value);
+	writer.Flush();
+}
+void udm::to_json(LinkedPropertyWrapperArg prop, std::string &outStr, JsonFormat format)
+{
+	JsonWriter writer {outStr, format};
+	auto type = Type::Nil;
+	auto *value = prop ? prop.GetValuePtr(type) : nullptr;
+	writer.WriteValue(type, value);
+	writer.Flush();
+}
+
+static constexpr uint8_t JSON_NUMBER_CHAR = 1;
+static constexpr uint8_t JSON_NUMBER_CHAR_FRACTION = 2; // Characters that can only appear in non-integer numbers
+static constexpr auto JSON_NUMBER_CHARS = []() {
+	std::array<uint8_t, 256> classes {};
+	for(auto c : std::string_view {"0123456789+-"})
+		classes[static_cast<uint8_t>(c)] = JSON_NUMBER_CHAR;
+	for(auto c : std::string_view {".eE"})
+		classes[static_cast<uint8_t>(c)] = JSON_NUMBER_CHAR | JSON_NUMBER_CHAR_FRACTION;
+	return classes;
+}();
+
+static bool is_json_whitespace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+// Value types that an empty array can be hinted as, i.e. the types that the items of a JSON array can be read as
+static bool is_json_array_value_type(udm::Type type)
+{
+	switch(type) {
+	case udm::Type::String:
+	case udm::Type::Utf8String:
+	case udm::Type::Reference:
+	case udm::Type::Blob:
+	case udm::Type::Element:
+		return true;
+	}
+	return type != udm::Type::Nil && (udm::is_numeric_type(type) || udm::is_generic_type(type));
+}
+static bool is_json_number_start(int c) { return c == '-' || (c >= '0' && c <= '9'); }
+static std::string describe_json_char(int c) { return (c == std::char_traits<char>::eof()) ? std::string {"end of file"} : ("'" + std::string(1, static_cast<char>(c)) + "'"); }
+
+struct JsonWhitespace {
+	static bool IsMember(char c) { return is_json_whitespace(c); }
+#ifdef UDM_TEXT_SIMD_SSE2
+	static __m128i GetMask(__m128i v)
+	{
+		auto mask = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+		return _mm_or_si128(mask, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))));
+	}
+#elif defined(UDM_TEXT_SIMD_NEON)
+	static uint8x16_t GetMask(uint8x16_t v)
+	{
+		auto mask = vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\n')));
+		return vorrq_u8(mask, vorrq_u8(vceqq_u8(v, vdupq_n_u8('\r')), vceqq_u8(v, vdupq_n_u8('\t'))));
+	}
+#endif
+};
+
+// Quotes, backslashes and control characters
+struct JsonStringSpecial {
+	static bool IsMember(char c) { return c == '"' || c == '\\' || static_cast<uint8_t>(c) < 0x20; }
+#ifdef UDM_TEXT_SIMD_SSE2
+	static __m128i GetMask(__m128i v)
+	{
+		auto mask = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+		return _mm_or_si128(mask, _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v));
+	}
+#elif defined(UDM_TEXT_SIMD_NEON)
+	static uint8x16_t GetMask(uint8x16_t v)
+	{
+		auto mask = vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')), vceqq_u8(v, vdupq_n_u8('\\')));
+		return vorrq_u8(mask, vcleq_u8(v, vdupq_n_u8(0x1F)));
+	}
+#endif
+};
+
+// Returns a pointer to the first character in [p, end) that is not a whitespace character, or 'end'
+static const char *skip_json_whitespace(const char *p, const char *end)
+{
+	// Compact JSON has no whitespace between tokens at all, so check the next character before going wide
+	if(p < end && !is_json_whitespace(*p))
+		return p;
+	return udm::text_scan::find_char<JsonWhitespace, false>(p, end);
+}
+
+// Returns a pointer to the first quote, backslash or control character in [p, end), or 'end'
+static const char *find_json_string_special(const char *p, const char *end) { return udm::text_scan::find_char<JsonStringSpecial, true>(p, end); }
+
+static void append_utf8(std::string &str, uint32_t codePoint)
+{
+	if(codePoint < 0x80)
+		str += static_cast<char>(codePoint);
+	else if(codePoint < 0x800) {
+		str += static_cast<char>(0xC0 | (codePoint >> 6));
+		str += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else if(codePoint < 0x10000) {
+		str += static_cast<char>(0xE0 | (codePoint >> 12));
+		str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		str += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else {
+		str += static_cast<char>(0xF0 | (codePoint >> 18));
+		str += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		str += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+// Type of numbers without a type hint: Int32 if all of them fit, otherwise UInt64 if none of them are negative, or Int64.
+// Numbers that don't fit into a single integer type, i.e. fractions or both negative numbers and numbers above the range of Int64, become Double.
+static udm::Type get_json_number_type(const udm::JsonNumber *numbers, size_t count)
+{
+	auto isInt32 = true;
+	auto hasNegative = false;
+	auto hasUInt64 = false;
+	for(auto i = decltype(count) {0u}; i < count; ++i) {
+		auto &n = numbers[i];
+		if(!n.isInteger)
+			return udm::Type::Double;
+		if(n.isUInt64)
+			hasUInt64 = true;
+		else if(n.i < 0)
+			hasNegative = true;
+		if(n.isUInt64 || n.i < std::numeric_limits<int32_t>::lowest() || n.i > std::numeric_limits<int32_t>::max())
+			isInt32 = false;
+	}
+	if(isInt32)
+		return udm::Type::Int32;
+	if(!hasNegative)
+		return udm::Type::UInt64;
+	return hasUInt64 ? udm::Type::Double : udm::Type::Int64;
+}
+
+template<typename T>
+static T json_number_to(const udm::JsonNumber &n)
+{
+	if constexpr(std::is_same_v<T, udm::Boolean>)
+		return n.isInteger ? (n.isUInt64 || n.i != 0) : (n.d != 0.0);
+	else if constexpr(std::is_same_v<T, udm::Half>)
+		return udm::Half {static_cast<float>(n.d)};
+	else if constexpr(std::is_integral_v<T>) {
+		if(n.isUInt64)
+			return static_cast<T>(n.u);
+		if(n.isInteger)
+			return static_cast<T>(n.i);
+		return static_cast<T>(std::clamp(n.d, static_cast<double>(std::numeric_limits<T>::lowest()), static_cast<double>(std::numeric_limits<T>::max())));
+	}
+	else
+		return static_cast<T>(n.d);
+}
+
+// Components are expected in the same order as they're written by the JsonWriter
+static void assign_json_numbers(const udm::JsonNumber *numbers, udm::Type type, void *outData, uint32_t count)
+{
+	if(udm::is_numeric_type(type)) {
+		std::visit(
+		  [numbers, outData, count](auto tag) {
+			  using T = typename decltype(tag)::type;
+			  auto *values = static_cast<T *>(outData);
+			  for(auto i = decltype(count) {0u}; i < count; ++i)
+				  values[i] = json_number_to<T>(numbers[i]);
+		  },
+		  udm::get_numeric_tag(type));
+		return;
+	}
+	std::visit(
+	  [numbers, outData, count](auto tag) {
+		  using T = typename decltype(tag)::type;
+		  auto *values = static_cast<T *>(outData);
+		  if constexpr(std::is_same_v<T, udm::Transform> || std::is_same_v<T, udm::ScaledTransform>) {
+			  constexpr auto numComponents = udm::get_numeric_component_count(udm::type_to_enum<T>());
+			  for(auto i = decltype(count) {0u}; i < count; ++i) {
+				  auto *n = numbers + i * numComponents;
+				  auto f = [n](uint32_t idx) { return json_number_to<float>(n[idx]); };
+				  values[i].SetOrigin(udm::Vector3 {f(0), f(1), f(2)});
+				  values[i].SetRotation(udm::Quaternion {f(3), f(4), f(5), f(6)});
+				  if constexpr(std::is_same_v<T, udm::ScaledTransform>)
+					  values[i].SetScale(udm::Vector3 {f(7), f(8), f(9)});
+			  }
+		  }
+		  else if constexpr(!std::is_void_v<udm::underlying_numeric_type<T>>) {
+			  using TComponent = udm::underlying_numeric_type<T>;
+			  constexpr auto numComponents = udm::get_numeric_component_count(udm::type_to_enum<T>());
+			  for(auto i = decltype(count) {0u}; i < count; ++i) {
+				  for(uint8_t c = 0; c < numComponents; ++c)
+					  udm::set_numeric_component(values[i], c, json_number_to<TComponent>(numbers[i * numComponents + c]));
+			  }
+		  }
+	  },
+	  udm::get_generic_tag(type));
+}
+
+udm::JsonReader::JsonReader(const std::string_view &json, const KeyMap<Type> &typeHints) : m_begin {json.data()}, m_cur {json.data()}, m_end {json.data() + json.size()}, m_typeHints {typeHints} {}
+
+void udm::JsonReader::GetCursorPosition(uint32_t &outLine, uint32_t &outColumn) const { text_scan::get_cursor_position(m_begin, m_cur, outLine, outColumn); }
+
+int udm::JsonReader::PeekChar()
+{
+	m_cur = skip_json_whitespace(m_cur, m_end);
+	return (m_cur < m_end) ? static_cast<uint8_t>(*m_cur) : std::char_traits<char>::eof();
+}
+
+void udm::JsonReader::ExpectChar(char c)
+{
+	auto next = PeekChar();
+	if(next != c)
+		throw BuildException<SyntaxError>("Expected '" + std::string(1, c) + "', got " + describe_json_char(next));
+	++m_cur;
+}
+
+void udm::JsonReader::ReadLiteral(const std::string_view &literal)
+{
+	if(static_cast<size_t>(m_end - m_cur) < literal.size() || std::string_view {m_cur, literal.size()} != literal)
+		throw BuildException<SyntaxError>("Invalid literal, expected '" + std::string {literal} + "'");
+	m_cur += literal.size();
+}
+
+void udm::JsonReader::ReadString(std::string &outStr)
+{
+	ExpectChar('"');
+	outStr.clear();
+	auto readHex = [this]() -> uint32_t {
+		uint32_t value = 0;
+		if(m_end - m_cur < 4 || std::from_chars(m_cur, m_cur + 4, value, 16).ptr != m_cur + 4)
+			throw BuildException<SyntaxError>("Invalid unicode escape sequence");
+		m_cur += 4;
+		return value;
+	};
+	for(;;) {
+		auto *p = find_json_string_special(m_cur, m_end);
+		outStr.append(m_cur, p);
+		m_cur = p;
+		if(m_cur >= m_end)
+			throw BuildException<SyntaxError>("Unterminated string");
+		auto c = *m_cur;
+		if(c == '"') {
+			++m_cur;
+			return;
+		}
+		if(c != '\\')
+			throw BuildException<SyntaxError>("Unescaped control character in string");
+		if(m_end - m_cur < 2)
+			throw BuildException<SyntaxError>("Unterminated string");
+		c = m_cur[1];
+		switch(c) {
+		case '"':
+		case '\\':
+		case '/':
+			outStr += c;
+			break;
+		case 'b':
+			outStr += '\b';
+			break;
+		case 'f':
+			outStr += '\f';
+			break;
+		case 'n':
+			outStr += '\n';
+			break;
+		case 'r':
+			outStr += '\r';
+			break;
+		case 't':
+			outStr += '\t';
+			break;
+		case 'u':
+			{
+				m_cur += 2;
+				auto codePoint = readHex();
+				if(codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+					// Code points outside of the basic multilingual plane are encoded as UTF-16 surrogate pairs
+					if(m_end - m_cur < 2 || m_cur[0] != '\\' || m_cur[1] != 'u')
+						throw BuildException<SyntaxError>("Unpaired surrogate in unicode escape sequence");
+					m_cur += 2;
+					auto low = readHex();
+					if(low < 0xDC00 || low > 0xDFFF)
+						throw BuildException<SyntaxError>("Unpaired surrogate in unicode escape sequence");
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+				}
+				else if(codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+					throw BuildException<SyntaxError>("Unpaired surrogate in unicode escape sequence");
+				append_utf8(outStr, codePoint);
+				continue;
+			}
+		default:
+			throw BuildException<SyntaxError>("Invalid escape sequence '\\" + std::string(1, c) + "'");
+		}
+		m_cur += 2;
+	}
+}
+
+udm::JsonNumber udm::JsonReader::ReadNumber()
+{
+	auto *start = m_cur;
+	uint8_t charClass = 0;
+	while(m_cur < m_end) {
+		auto c = JSON_NUMBER_CHARS[static_cast<uint8_t>(*m_cur)];
+		if(c == 0)
+			break;
+		charClass |= c;
+		++m_cur;
+	}
+	JsonNumber number {};
+	if(!(charClass & JSON_NUMBER_CHAR_FRACTION)) {
+		auto res = std::from_chars(start, m_cur, number.i);
+		if(res.ec == std::errc {} && res.ptr == m_cur) {
+			number.d = static_cast<double>(number.i);
+			number.isInteger = true;
+			return number;
+		}
+		if(res.ec == std::errc::result_out_of_range && *start != '-') {
+			res = std::from_chars(start, m_cur, number.u);
+			if(res.ec == std::errc {} && res.ptr == m_cur) {
+				number.d = static_cast<double>(number.u);
+				number.isInteger = true;
+				number.isUInt64 = true;
+				return number;
+			}
+		}
+		// Integers that don't fit into 64 bits are read as floating point numbers instead
+	}
+	auto res = std::from_chars(start, m_cur, number.d);
+	if(res.ec != std::errc {} || res.ptr != m_cur) {
+		std::string str {start, m_cur};
+		m_cur = start;
+		throw BuildException<SyntaxError>("Invalid number '" + str + "'");
+	}
+	return number;
+}
+
+udm::JsonNumber udm::JsonReader::ReadNumberOrBoolean()
+{
+	switch(PeekChar()) {
+	case 't':
+		ReadLiteral("true");
+		return JsonNumber {1.0, 1, true};
+	case 'f':
+		ReadLiteral("false");
+		return JsonNumber {0.0, 0, true};
+	}
+	return ReadNumber();
+}
+
+template<typename TItemHandler>
+uint32_t udm::JsonReader::ReadList(char open, char close, TItemHandler &&itemHandler)
+{
+	ExpectChar(open);
+	uint32_t n = 0;
+	if(PeekChar() == close) {
+		++m_cur;
+		return n;
+	}
+	for(;;) {
+		itemHandler(n++);
+		auto c = PeekChar();
+		if(c == close) {
+			++m_cur;
+			return n;
+		}
+		if(c != ',')
+			throw BuildException<SyntaxError>("Expected ',' or '" + std::string(1, close) + "', got " + describe_json_char(c));
+		++m_cur;
+	}
+}
+
+udm::Type udm::JsonReader::GetTypeHint() const
+{
+	if(!m_typeHints.empty()) {
+		auto it = m_typeHints.find(m_path);
+		if(it != m_typeHints.end())
+			return it->second;
+	}
+	return Type::Invalid;
+}
+
+udm::Type udm::JsonReader::GetNumericType(Type hint, const JsonNumber *numbers, size_t count, bool isBoolean)
+{
+	if(hint == Type::Invalid)
+		return isBoolean ? Type::Boolean : get_json_number_type(numbers, count);
+	if(!is_numeric_type(hint))
+		throw BuildException<DataError>("Type hint '" + std::string {enum_type_to_ascii(hint)} + "' for '" + m_path + "' can't be applied to " + (isBoolean ? "booleans" : "numbers"));
+	return hint;
+}
+
+udm::Type udm::JsonReader::GetStringType(Type hint)
+{
+	switch(hint) {
+	case Type::Invalid:
+		return Type::String;
+	case Type::String:
+	case Type::Utf8String:
+	case Type::Reference:
+	case Type::Blob:
+		return hint;
+	}
+	throw BuildException<DataError>("Type hint '" + std::string {enum_type_to_ascii(hint)} + "' for '" + m_path + "' can't be applied to strings");
+}
+
+void udm::JsonReader::ReadObject(Element &el)
+{
+	std::string key;
+	auto pathLen = m_path.size();
+	ReadList('{', '}', [this, &el, &key, pathLen](uint32_t) {
+		ReadString(key);
+		ExpectChar(':');
+		if(pathLen > 0)
+			m_path += '/';
+		m_path += key;
+		auto prop = ReadValue();
+		m_path.resize(pathLen);
+		// JSON allows duplicate keys, the last one wins
+		el.AddChild(std::move(key), prop);
+	});
+}
+
+udm::PProperty udm::JsonReader::ReadValue()
+{
+	auto hint = GetTypeHint();
+	auto c = PeekChar();
+	switch(c) {
+	case '{':
+		{
+			auto prop = Property::Create<Element>();
+			ReadObject(prop->GetValue<Element>());
+			return prop;
+		}
+	case '[':
+		{
+			if(hint != Type::Nil && is_generic_type(hint))
+				return ReadGenericValue(hint);
+			auto prop = Property::Create<Array>();
+			ReadArray(prop->GetValue<Array>(), hint);
+			return prop;
+		}
+	case '"':
+		{
+			auto prop = Property::Create(GetStringType(hint));
+			ReadStringValue(prop->type, prop->value);
+			return prop;
+		}
+	case 'n':
+		ReadLiteral("null");
+		return Property::Create<Nil>();
+	}
+	auto isBoolean = (c == 't' || c == 'f');
+	if(!isBoolean && !is_json_number_start(c))
+		throw BuildException<SyntaxError>("Unexpected " + describe_json_char(c));
+	auto number = ReadNumberOrBoolean();
+	auto type = GetNumericType(hint, &number, 1, isBoolean);
+	auto prop = Property::Create(type);
+	assign_json_numbers(&number, type, prop->value, 1);
+	return prop;
+}
+
+void udm::JsonReader::ReadStringValue(Type type, void *outData)
+{
+	switch(type) {
+	case Type::String:
+		ReadString(*static_cast<String *>(outData));
+		break;
+	case Type::Reference:
+		ReadString(static_cast<Reference *>(outData)->path);
+		break;
+	case Type::Utf8String:
+		{
+			ReadString(m_string);
+			static_cast<Utf8String *>(outData)->data.assign(m_string.begin(), m_string.end());
+			break;
+		}
+	case Type::Blob:
+		{
+			ReadString(m_string);
+			auto &data = static_cast<Blob *>(outData)->data;
+			data.resize(base64_get_max_decoded_size(m_string.size()));
+			auto size = base64_decode(m_string, data.data());
+			if(!size)
+				throw BuildException<DataError>("Invalid base64 blob data");
+			data.resize(*size);
+			break;
+		}
+	}
+}
+
+void udm::JsonReader::ReadArray(Array &a, Type hint)
+{
+	// The value type of the array is determined by its first item
+	auto *listStart = m_cur;
+	ExpectChar('[');
+	auto first = PeekChar();
+	m_cur = listStart;
+	auto checkItem = [this](bool valid) {
+		if(!valid)
+			throw BuildException<DataError>("Arrays with items of different types are not supported");
+	};
+	switch(first) {
+	case ']':
+		{
+			if(hint != Type::Invalid && !is_json_array_value_type(hint))
+				throw BuildException<DataError>("Type hint '" + std::string {enum_type_to_ascii(hint)} + "' for '" + m_path + "' can't be applied to arrays");
+			a.SetValueType((hint != Type::Invalid) ? hint : Type::Element);
+			ReadList('[', ']', [](uint32_t) {});
+			return;
+		}
+	case '{':
+		{
+			if(hint != Type::Invalid && hint != Type::Element)
+				throw BuildException<DataError>("Type hint '" + std::string {enum_type_to_ascii(hint)} + "' for '" + m_path + "' can't be applied to objects");
+			a.SetValueType(Type::Element);
+			auto n = ReadList('[', ']', [this, &a, &checkItem](uint32_t idx) {
+				checkItem(PeekChar() == '{');
+				if(idx >= a.GetSize())
+					a.Resize(idx * 2 + 4);
+				ReadObject(static_cast<Element *>(a.GetValues())[idx]);
+			});
+			a.Resize(n);
+			return;
+		}
+	case '"':
+		{
+			auto type = GetStringType(hint);
+			a.SetValueType(type);
+			auto n = ReadList('[', ']', [this, &a, &checkItem, type](uint32_t idx) {
+				checkItem(PeekChar() == '"');
+				if(idx >= a.GetSize())
+					a.Resize(idx * 2 + 4);
+				ReadStringValue(type, a.GetValuePtr(idx));
+			});
+			a.Resize(n);
+			return;
+		}
+	case '[':
+		{
+			a.SetValueType(Type::Array);
+			auto n = ReadList('[', ']', [this, &a, &checkItem, hint](uint32_t idx) {
+				checkItem(PeekChar() == '[');
+				if(idx >= a.GetSize())
+					a.Resize(idx * 2 + 4);
+				ReadArray(static_cast<Array *>(a.GetValues())[idx], hint);
+			});
+			a.Resize(n);
+			return;
+		}
+	case 'n':
+		throw BuildException<DataError>("Null values in arrays are not supported");
+	}
+	// Numbers or booleans, which are collected first to determine the smallest type that fits all of them
+	auto isBoolean = (first == 't' || first == 'f');
+	m_numbers.clear();
+	ReadList('[', ']', [this, &checkItem, isBoolean](uint32_t) {
+		auto c = PeekChar();
+		checkItem(isBoolean ? (c == 't' || c == 'f') : is_json_number_start(c));
+		m_numbers.push_back(ReadNumberOrBoolean());
+	});
+	auto type = GetNumericType(hint, m_numbers.data(), m_numbers.size(), isBoolean);
+	auto n = static_cast<uint32_t>(m_numbers.size());
+	a.SetValueType(type);
+	a.Resize(n);
+	assign_json_numbers(m_numbers.data(), type, a.GetValues(), n);
+}
+
+uint32_t udm::JsonReader::ReadNestedNumbers(Type type)
+{
+	uint32_t depth = 0;
+	ReadList('[', ']', [this, &depth, type](uint32_t) {
+		auto c = PeekChar();
+		if(c == '[')
+			depth = std::max(depth, ReadNestedNumbers(type));
+		else if(is_json_number_start(c))
+			m_numbers.push_back(ReadNumber());
+		else
+			throw BuildException<DataError>("Expected numbers for values of type '" + std::string {enum_type_to_ascii(type)} + "', got " + describe_json_char(c));
+	});
+	return depth + 1;
+}
+
+udm::PProperty udm::JsonReader::ReadGenericValue(Type type)
+{
+	m_numbers.clear();
+	auto depth = ReadNestedNumbers(type);
+	auto numComponents = get_numeric_component_count(type);
+	if(m_numbers.size() % numComponents != 0)
+		throw BuildException<DataError>("Number of values (" + std::to_string(m_numbers.size()) + ") is not a multiple of the component count of type '" + std::string {enum_type_to_ascii(type)} + "' (" + std::to_string(numComponents) + ")");
+	auto count = static_cast<uint32_t>(m_numbers.size() / numComponents);
+	// Single values are written as a list of components, or a list of lists for transforms and matrices (see JsonWriter).
+	// Anything else is an array of values, either as a list of such lists or as a flat list of all components.
+	auto valueDepth = (type == Type::Transform || type == Type::ScaledTransform || type == Type::Mat4 || type == Type::Mat3x4) ? 2u : 1u;
+	if(count == 1 && depth == valueDepth) {
+		auto prop = Property::Create(type);
+		assign_json_numbers(m_numbers.data(), type, prop->value, 1);
+		return prop;
+	}
+	auto prop = Property::Create<Array>();
+	auto &a = prop->GetValue<Array>();
+	a.SetValueType(type);
+	a.Resize(count);
+	assign_json_numbers(m_numbers.data(), type, a.GetValues(), count);
+	return prop;
+}
+
+std::shared_ptr<udm::Data> udm::JsonReader::LoadJson(const std::string_view &json, const KeyMap<Type> &typeHints)
+{
+	JsonReader reader {json, typeHints};
+	if(json.starts_with("\xEF\xBB\xBF"))
+		reader.m_cur += 3; // UTF-8 byte order mark
+	auto rootProp = Property::Create<Element>();
+	auto &root = rootProp->GetValue<Element>();
+	reader.ReadObject(root);
+	if(reader.PeekChar() != std::char_traits<char>::eof())
+		throw reader.BuildException<SyntaxError>("Unexpected " + describe_json_char(reader.PeekChar()) + " after root object");
+	// If the document has a header, it requires the asset version to be an unsigned integer (see Data::ValidateHeaderProperties).
+	// Otherwise "assetVersion" is just a key of the asset data.
+	auto itVersion = root.children.find(Data::KEY_ASSET_VERSION);
+	if(itVersion != root.children.end() && root.children.contains(Data::KEY_ASSET_DATA) && !typeHints.contains(Data::KEY_ASSET_VERSION)) {
+		auto &version = *itVersion->second;
+		if(is_numeric_type(version.type) && version.type != Type::UInt32)
+			root.AddChild(Data::KEY_ASSET_VERSION, Property::Create<UInt32>(version.ToValue<UInt32>(0)));
+	}
+	return Data::CreateFromRootProperty(rootProp);
+}
+
+std::shared_ptr<udm::Data> udm::Data::LoadJson(const std::string_view &json, const KeyMap<Type> &typeHints) { return JsonReader::LoadJson(json, typeHints); }
@@ -55,24 +55,34 @@ void udm::LinkedPropertyWrapper::operator=(const LinkedPropertyWrapper &v)
 
 std::string udm::LinkedPropertyWrapper::GetPath() const
 {
-	std::string path = propName;
-	if(path.empty() && prop && prev && prev->IsType(Type::Element)) {
-		auto &e = prev->GetValue<Element>();
-		auto it = std::find_if(e.children.begin(), e.children.end(), [this](const std::pair<std::string, PProperty> &pair) { return pair.second.get() == prop; });
-		if(it != e.children.end())
-			path = it->first;
+	std::string path;
+	AppendPath(path);
+	return path;
+}
+
+void udm::LinkedPropertyWrapper::AppendPath(std::string &outPath) const
+{
+	auto offset = outPath.length();
+	if(prev)
+		prev->AppendPath(outPath);
+	auto hasPrefix = (outPath.length() > offset);
+	if(hasPrefix && IsArrayItem() && propName.empty()) {
+		outPath += '[' + std::to_string(arrayIndex) + ']';
+		return;
 	}
-	pragma::string::replace(path, "/", "\\/");
-	if(prev) {
-		auto tmp = prev->GetPath();
-		if(!tmp.empty()) {
-			if(IsArrayItem() && propName.empty())
-				path = tmp + '[' + std::to_string(arrayIndex) + ']';
-			else
-				path = tmp + PATH_SEPARATOR + path;
-		}
+	std::string_view name = propName;
+	if(name.empty() && prop && prev && prev->IsType(Type::Element)) {
+		auto *key = prev->GetConstValuePtr<Element>()->FindKey(*prop);
+		if(key)
+			name = *key;
+	}
+	if(hasPrefix)
+		outPath += PATH_SEPARATOR;
+	for(auto c : name) {
+		if(c == PATH_SEPARATOR)
+			outPath += '\\';
+		outPath += c;
 	}
-	return path;
 }
 
 udm::PProperty udm::LinkedPropertyWrapper::ClaimOwnership() const
@@ -84,6 +94,33 @@ udm::PProperty udm::LinkedPropertyWrapper::ClaimOwnership() const
 	return (it != el.children.end()) ? it->second : nullptr;
 }
 
+bool udm::LinkedPropertyWrapper::IsShared() const
+{
+	for(auto *wrapper = this; wrapper; wrapper = wrapper->prev.get()) {
+		if(wrapper->prop && wrapper->prop->IsShared())
+			return true;
+	}
+	return false;
+}
+
+void udm::LinkedPropertyWrapper::Unshare()
+{
+	// This has to be done from the top down: A property that shares its value keeps it when it's un-shared, so the
+	// properties below it remain the ones this wrapper refers to (see Property::Unshare)
+	if(prev)
+		prev->Unshare();
+	if(!prop)
+		return;
+	prop->Unshare();
+	if(arrayIndex == std::numeric_limits<uint32_t>::max() || propName.empty())
+		return;
+	// Child of an array item
+	auto *a = prop->GetValuePtr<Array>();
+	if(!a || !a->IsValueType(Type::Element) || arrayIndex >= a->GetSize())
+		return;
+	a->GetValue<Element>(arrayIndex).UnshareChild(propName);
+}
+
 udm::Property *udm::LinkedPropertyWrapper::GetProperty(std::vector<uint32_t> *outArrayIndices) const
 {
 	if(prop) {
@@ -107,9 +144,11 @@ void udm::LinkedPropertyWrapper::InitializeProperty(Type type, bool getOnly)
 	if(prop || prev == nullptr || (propName.empty() && !isArrayElement))
 		return;
 	prev->InitializeProperty(!isArrayElement ? Type::Element : Type::Array, getOnly);
+	if(!getOnly)
+		prev->Unshare();
 	if(prev->prop == nullptr || prev->prop->type != Type::Element) {
 		if(prev->prop && prev->prop->type == Type::Array && prev->arrayIndex != std::numeric_limits<uint32_t>::max() && static_cast<Array *>(prev->prop->value)->IsValueType(Type::Element)) {
-			auto *e = static_cast<Array *>(prev->prop->value)->GetValuePtr<Element>(prev->arrayIndex);
+			auto *e = const_cast<Element *>(static_cast<const Array *>(prev->prop->value)->GetValuePtr<Element>(prev->arrayIndex));
 			if(!e)
 				return;
 			if(getOnly) {
@@ -132,19 +171,19 @@ void udm::LinkedPropertyWrapper::InitializeProperty(Type type, bool getOnly)
 		std::vector<uint32_t> arrayIndices;
 		auto *arrayProp = prev->GetProperty(&arrayIndices);
 		if(arrayProp && arrayProp->IsType(Type::Array)) {
-			auto *a = arrayProp->GetValuePtr<Array>();
+			auto *a = std::as_const(*arrayProp).GetValuePtr<Array>();
 			if(arrayIndices.size() > 1) {
 				for(auto it = arrayIndices.rbegin(); it != arrayIndices.rend() - 1; ++it) {
 					if(a->GetValueType() != Type::Array)
 						return;
-					a = static_cast<Array *>(a->GetValuePtr(*it));
+					a = static_cast<const Array *>(a->GetValuePtr(*it));
 				}
 			}
 			if(!a)
 				return;
 			if(arrayIndices.empty() || a->IsValueType(Type::Element) == false)
 				return;
-			auto &children = static_cast<Element *>(a->GetValuePtr(arrayIndices.front()))->children;
+			auto &children = static_cast<const Element *>(a->GetValuePtr(arrayIndices.front()))->children;
 			auto it = children.find(propName);
 			if(it != children.end())
 				prop = it->second.get();
@@ -179,11 +218,15 @@ udm::ElementIteratorWrapper udm::LinkedPropertyWrapper::ElIt()
 udm::LinkedPropertyWrapper udm::LinkedPropertyWrapper::operator[](const std::string_view &key) const { return PropertyWrapper::operator[](key); }
 udm::LinkedPropertyWrapper udm::LinkedPropertyWrapper::operator[](const std::string &key) const { return PropertyWrapper::operator[](key); }
 udm::LinkedPropertyWrapper udm::LinkedPropertyWrapper::operator[](const char *key) const { return PropertyWrapper::operator[]((key)); }
+udm::LinkedPropertyWrapper udm::LinkedPropertyWrapper::operator[](const Key &key) const { return PropertyWrapper::operator[](key); }
 udm::LinkedPropertyWrapper udm::LinkedPropertyWrapper::operator[](int32_t idx) const { return operator[](static_cast<uint32_t>(idx)); }
 udm::LinkedPropertyWrapper udm::LinkedPropertyWrapper::operator[](size_t idx) const { return operator[](static_cast<uint32_t>(idx)); }
 udm::LinkedPropertyWrapper udm::LinkedPropertyWrapper::operator[](uint32_t idx) const
 {
 	auto it = begin();
 	it = it + idx;
-	return *it;
+	auto wrapper = *it;
+	if(wrapper.prop)
+		wrapper.prev = std::make_unique<LinkedPropertyWrapper>(*this);
+	return wrapper;
 }
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+class WorkerPool {
+  public:
+	struct Batch {
+		const std::function<void(uint32_t)> *task = nullptr;
+		uint32_t numTasks = 0;
+		std::atomic<uint32_t> nextTask = 0;
+		std::atomic<uint32_t> numRemaining = 0;
+		std::mutex exceptionMutex;
+		std::exception_ptr exception = nullptr;
+		// Returns false if all tasks of this batch have already been started
+		bool RunNext();
+	};
+	// The pool is intentionally never destroyed, to avoid joining threads during static destruction or library unloading
+	static WorkerPool &Get()
+	{
+		static auto *pool = new WorkerPool {};
+		return *pool;
+	}
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()) + 1; }
+	void Run(uint32_t numTasks, const std::function<void(uint32_t)> &task);
+  private:
+	WorkerPool();
+	void Work();
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<std::shared_ptr<Batch>> m_batches;
+};
+
+bool WorkerPool::Batch::RunNext()
+{
+	auto idx = nextTask.fetch_add(1);
+	if(idx >= numTasks)
+		return false;
+	try {
+		(*task)(idx);
+	}
+	catch(...) {
+		std::scoped_lock lock {exceptionMutex};
+		if(!exception)
+			exception = std::current_exception();
+	}
+	if(numRemaining.fetch_sub(1) == 1)
+		numRemaining.notify_all();
+	return true;
+}
+
+WorkerPool::WorkerPool()
+{
+	auto numThreads = std::thread::hardware_concurrency();
+	if(numThreads > 1)
+		--numThreads; // The calling thread participates as well
+	else
+		numThreads = 0;
+	m_threads.reserve(numThreads);
+	for(auto i = decltype(numThreads) {0u}; i < numThreads; ++i) {
+		m_threads.push_back(std::thread {[this]() { Work(); }});
+		m_threads.back().detach();
+	}
+}
+
+void WorkerPool::Work()
+{
+	for(;;) {
+		std::shared_ptr<Batch> batch = nullptr;
+		{
+			std::unique_lock lock {m_mutex};
+			m_condition.wait(lock, [this]() { return !m_batches.empty(); });
+			batch = m_batches.front();
+		}
+		if(batch->RunNext())
+			continue;
+		// All tasks of the batch have been started, remove it from the queue
+		std::scoped_lock lock {m_mutex};
+		if(!m_batches.empty() && m_batches.front() == batch)
+			m_batches.pop_front();
+	}
+}
+
+void WorkerPool::Run(uint32_t numTasks, const std::function<void(uint32_t)> &task)
+{
+	auto batch = std::make_shared<Batch>();
+	batch->task = &task;
+	batch->numTasks = numTasks;
+	batch->numRemaining = numTasks;
+	{
+		std::scoped_lock lock {m_mutex};
+		m_batches.push_back(batch);
+	}
+	m_condition.notify_all();
+
+	while(batch->RunNext())
+		;
+	for(auto n = batch->numRemaining.load(); n > 0; n = batch->numRemaining.load())
+		batch->numRemaining.wait(n);
+
+	{
+		std::scoped_lock lock {m_mutex};
+		auto it = std::find(m_batches.begin(), m_batches.end(), batch);
+		if(it != m_batches.end())
+			m_batches.erase(it);
+	}
+	if(batch->exception)
+		std::rethrow_exception(batch->exception);
+}
+
+//////////////////
+
+uint32_t udm::get_parallel_thread_count() { return WorkerPool::Get().GetThreadCount(); }
+
+static uint32_t get_chunk_size(uint32_t numItems, uint32_t minItemsPerTask)
+{
+	if(numItems == 0)
+		return 0;
+	minItemsPerTask = std::max(minItemsPerTask, 1u);
+	// A few chunks per thread to balance uneven workloads
+	auto maxChunks = get_parallel_thread_count() * 4;
+	auto numChunks = pragma::math::min((numItems + minItemsPerTask - 1) / minItemsPerTask, maxChunks);
+	numChunks = std::max(numChunks, 1u);
+	return (numItems + numChunks - 1) / numChunks;
+}
+
+uint32_t udm::get_parallel_chunk_count(uint32_t numItems, uint32_t minItemsPerTask)
+{
+	auto chunkSize = get_chunk_size(numItems, minItemsPerTask);
+	return (chunkSize > 0) ? ((numItems + chunkSize - 1) / chunkSize) : 0;
+}
+
+void udm::prepare_parallel_access(const Array &a)
+{
+	if(a.GetArrayType() == ArrayType::Compressed)
+		a.GetValues();
+}
+
+void udm::prepare_parallel_access(const Property &prop)
+{
+	if(prop.type == Type::ArrayLz4 && prop.value)
+		prepare_parallel_access(*static_cast<const Array *>(prop.value));
+}
+
+void udm::parallel_for(uint32_t numItems, const std::function<void(uint32_t, uint32_t, uint32_t)> &task, uint32_t minItemsPerTask)
+{
+	auto chunkSize = get_chunk_size(numItems, minItemsPerTask);
+	if(chunkSize == 0)
+		return;
+	auto numChunks = (numItems + chunkSize - 1) / chunkSize;
+	if(numChunks == 1 || get_parallel_thread_count() == 1) {
+		for(auto i = decltype(numChunks) {0u}; i < numChunks; ++i)
+			task(i, i * chunkSize, pragma::math::min(numItems, (i + 1) * chunkSize));
+		return;
+	}
+	WorkerPool::Get().Run(numChunks, [&task, chunkSize, numItems](uint32_t chunkIdx) { task(chunkIdx, chunkIdx * chunkSize, pragma::math::min(numItems, (chunkIdx + 1) * chunkSize)); });
+}
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+// Caches with a root property, the number of caches is tracked separately so structural changes don't have to
+// acquire the mutex if there are none
+static std::shared_mutex g_cacheMutex;
+static std::vector<udm::PathCache *> g_caches;
+static std::atomic<uint32_t> g_cacheCount = 0;
+
+// Properties deeper than this are treated as if their root was unknown
+static constexpr size_t MAX_INVALIDATION_DEPTH = 64;
+
+// Returns the property owning the element or array. 'outUnknown' is set for items of nested arrays, which don't know their owner.
+template<typename T>
+static const udm::Property *get_owner(const T &o, bool &outUnknown)
+{
+	outUnknown = !o.fromProperty.prop && o.fromProperty.arrayIndex != std::numeric_limits<uint32_t>::max();
+	return o.fromProperty.prop;
+}
+
+void udm::invalidate_path_caches()
+{
+	if(g_cacheCount.load(std::memory_order_relaxed) == 0)
+		return;
+	std::shared_lock lock {g_cacheMutex};
+	for(auto *cache : g_caches)
+		cache->m_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void udm::invalidate_path_caches(const Property &prop)
+{
+	if(g_cacheCount.load(std::memory_order_relaxed) == 0)
+		return;
+	// The caches of the property itself and of all of its parents are affected
+	std::array<const Property *, MAX_INVALIDATION_DEPTH> path;
+	size_t depth = 0;
+	auto unknownOwner = false;
+	for(auto *cur = &prop; cur && !unknownOwner; cur = cur->parent ? get_owner(*cur->parent, unknownOwner) : nullptr) {
+		if(depth == path.size()) {
+			unknownOwner = true;
+			break;
+		}
+		path[depth++] = cur;
+	}
+	if(unknownOwner) {
+		invalidate_path_caches();
+		return;
+	}
+	std::shared_lock lock {g_cacheMutex};
+	for(auto *cache : g_caches) {
+		if(std::find(path.begin(), path.begin() + depth, cache->m_root) != path.begin() + depth)
+			cache->m_generation.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void udm::invalidate_path_caches(const Element &el)
+{
+	auto unknownOwner = false;
+	auto *owner = get_owner(el, unknownOwner);
+	if(owner)
+		invalidate_path_caches(*owner);
+	else if(unknownOwner)
+		invalidate_path_caches();
+}
+
+void udm::invalidate_path_caches(const Array &a)
+{
+	auto unknownOwner = false;
+	auto *owner = get_owner(a, unknownOwner);
+	if(owner)
+		invalidate_path_caches(*owner);
+	else if(unknownOwner)
+		invalidate_path_caches();
+}
+
+udm::PathCache::~PathCache() { SetRoot(nullptr); }
+
+void udm::PathCache::SetRoot(Property *root)
+{
+	if(root == m_root)
+		return;
+	std::unique_lock lock {g_cacheMutex};
+	if(!m_root) {
+		g_caches.push_back(this);
+		g_cacheCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	else if(!root) {
+		g_caches.erase(std::find(g_caches.begin(), g_caches.end(), this));
+		g_cacheCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+	m_root = root;
+}
+
+void udm::PathCache::Validate(Property &root)
+{
+	auto generation = m_generation.load(std::memory_order_relaxed);
+	if(&root == m_root && generation == m_validGeneration)
+		return;
+	if(!m_entries.empty()) {
+		m_entries.clear();
+		++m_statistics.invalidations;
+	}
+	SetRoot(&root);
+	m_validGeneration = generation;
+}
+
+udm::PropertyWrapper udm::PathCache::Find(Property &root, const std::string_view &path)
+{
+	Validate(root);
+	auto it = m_entries.find(path);
+	if(it == m_entries.end()) {
+		++m_statistics.misses;
+		Entry entry {};
+		PathCursor cursor {root};
+		if(cursor.DownPath(path)) {
+			auto &frame = cursor.GetFrame();
+			entry = {frame.prop, frame.array, frame.arrayIndex};
+		}
+		// Lookups of paths that don't exist are cached as well
+		it = m_entries.insert(std::make_pair(std::string {path}, entry)).first;
+	}
+	else
+		++m_statistics.hits;
+	auto &entry = it->second;
+	if(entry.array)
+		return (entry.arrayIndex < entry.array->GetSize()) ? PropertyWrapper {*entry.array, entry.arrayIndex} : PropertyWrapper {};
+	return entry.prop ? PropertyWrapper {*entry.prop} : PropertyWrapper {};
+}
+
+void udm::PathCache::Clear()
+{
+	m_entries.clear();
+	SetRoot(nullptr);
+}
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+udm::PathCursor::PathCursor(Property &root)
+{
+	m_frames[0] = Frame {&root};
+	m_depth = 1;
+}
+
+udm::PathCursor::PathCursor(const PropertyWrapper &root)
+{
+	if(!root.prop)
+		return;
+	m_frames[0] = Frame {root.prop};
+	m_depth = 1;
+	if(root.arrayIndex == std::numeric_limits<uint32_t>::max())
+		return;
+	// Array item, or child of an element array item
+	auto *linked = root.GetLinked();
+	if(!Down(root.arrayIndex) || (linked && !linked->propName.empty() && !Down(linked->propName)))
+		m_depth = 0;
+}
+
+// The const accessors are used for walking the path, values are only un-shared before they're written to (see Unshare)
+udm::Element *udm::PathCursor::GetElement(const Frame &frame)
+{
+	if(frame.array)
+		return (frame.arrayIndex < frame.array->GetSize()) ? const_cast<Element *>(std::as_const(*frame.array).GetValuePtr<Element>(frame.arrayIndex)) : nullptr;
+	return frame.prop ? const_cast<Element *>(std::as_const(*frame.prop).GetValuePtr<Element>()) : nullptr;
+}
+
+udm::Array *udm::PathCursor::GetArray(const Frame &frame)
+{
+	if(frame.array)
+		return (frame.arrayIndex < frame.array->GetSize()) ? const_cast<Array *>(std::as_const(*frame.array).GetValuePtr<Array>(frame.arrayIndex)) : nullptr;
+	return (frame.prop && is_array_type(frame.prop->type)) ? const_cast<Array *>(std::as_const(*frame.prop).GetValuePtr<Array>()) : nullptr;
+}
+
+udm::Type udm::PathCursor::GetType() const
+{
+	if(!IsValid())
+		return Type::Nil;
+	auto &frame = GetFrame();
+	return frame.array ? frame.array->GetValueType() : frame.prop->type;
+}
+
+uint32_t udm::PathCursor::GetSize() const
+{
+	auto *a = GetArray();
+	if(a)
+		return a->GetSize();
+	auto *el = GetElement();
+	return el ? static_cast<uint32_t>(el->children.size()) : 0;
+}
+
+bool udm::PathCursor::Push(const Frame &frame)
+{
+	if(m_depth >= m_frames.size())
+		return false;
+	m_frames[m_depth++] = frame;
+	return true;
+}
+
+bool udm::PathCursor::Down(const std::string_view &key) { return Down(Key {key}); }
+
+bool udm::PathCursor::Down(const Key &key)
+{
+	auto *el = GetElement();
+	if(!el)
+		return false;
+	auto it = el->children.find(key);
+	if(it == el->children.end() || !it->second)
+		return false;
+	return Push(Frame {it->second.get(), nullptr, INVALID_INDEX, it->first});
+}
+
+bool udm::PathCursor::Down(uint32_t idx)
+{
+	auto *a = GetArray();
+	if(!a || idx >= a->GetSize())
+		return false;
+	return Push(Frame {nullptr, a, idx});
+}
+
+bool udm::PathCursor::DownPath(const std::string_view &path)
+{
+	auto depth = m_depth;
+	auto success = for_each_path_segment(path, [this](const PathSegment &segment) { return segment.IsIndex() ? Down(segment.index) : Down(segment.key); });
+	if(!success)
+		m_depth = depth;
+	return success;
+}
+
+bool udm::PathCursor::Up(uint32_t levels)
+{
+	if(levels > GetDepth())
+		return false;
+	m_depth -= levels;
+	return true;
+}
+
+void udm::PathCursor::Reset() { m_depth = pragma::math::min(m_depth, 1u); }
+
+void udm::PathCursor::Unshare() const
+{
+	// This has to be done from the top down: A property that shares its value keeps it when it's un-shared, so the
+	// frames below it remain valid (see Property::Unshare)
+	for(auto i = decltype(m_depth) {0u}; i < m_depth; ++i) {
+		auto &frame = m_frames[i];
+		auto *prop = frame.array ? frame.array->fromProperty.prop : frame.prop;
+		if(prop)
+			prop->Unshare();
+	}
+}
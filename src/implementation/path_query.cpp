@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+bool udm::evaluate_path(PathCursor &cursor, std::span<const PathSegment> segments)
+{
+	auto depth = cursor.GetDepth();
+	for(auto &segment : segments) {
+		auto success = segment.IsIndex() ? cursor.Down(segment.index) : cursor.Down(segment.key);
+		if(success)
+			continue;
+		cursor.Up(cursor.GetDepth() - depth);
+		return false;
+	}
+	return true;
+}
+
+udm::PathQuery udm::PathQuery::Compile(const std::string_view &path)
+{
+	PathQuery query {};
+	query.m_path = std::make_shared<std::string>(path);
+	// A path can't have more segments than characters
+	query.m_segments.resize(path.length());
+	auto count = parse_path(*query.m_path, query.m_segments);
+	if(!count.has_value())
+		throw InvalidUsageError {"Invalid path '" + std::string {path} + "'!"};
+	query.m_segments.resize(*count);
+	query.m_segments.shrink_to_fit();
+	return query;
+}
+
+const std::string &udm::PathQuery::GetPath() const
+{
+	static const std::string empty {};
+	return m_path ? *m_path : empty;
+}
+
+udm::PathCursor udm::PathQuery::Evaluate(Property &root) const
+{
+	PathCursor cursor {root};
+	return evaluate_path(cursor, m_segments) ? cursor : PathCursor {};
+}
+
+udm::PathCursor udm::PathQuery::Evaluate(const PropertyWrapper &root) const
+{
+	PathCursor cursor {root};
+	if(!cursor)
+		return {};
+	return evaluate_path(cursor, m_segments) ? cursor : PathCursor {};
+}
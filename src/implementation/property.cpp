@@ -12,6 +12,12 @@ module pragma.udm;
 import :core;
 #endif
 
+// Number of properties which currently share their value with other properties (see MergeFlags::CopyOnWrite).
+// It's only changed when values are shared or unshared, and lets writes skip the walk over the parents while there are none.
+static std::atomic<uint32_t> g_sharedPropertyCount = 0;
+
+static udm::Property *get_parent_property(const udm::Property &prop) { return prop.parent ? prop.parent->fromProperty.prop : nullptr; }
+
 void udm::Property::Construct(Property &prop, Type type)
 {
 	prop.type = type;
@@ -35,6 +41,17 @@ udm::Property::Property(Property &&other)
 {
 	type = other.type;
 	value = other.value;
+	if(other.m_nextShared) {
+		// Take the place of the other property in the ring of properties sharing the value
+		auto *prev = other.m_nextShared;
+		while(prev->m_nextShared != &other)
+			prev = prev->m_nextShared;
+		prev->m_nextShared = this;
+		m_nextShared = other.m_nextShared;
+		other.m_nextShared = nullptr;
+	}
+	if(other.IsValueBoundTo(other))
+		BindValue();
 
 	other.type = Type::Nil;
 	other.value = nullptr;
@@ -48,8 +65,10 @@ udm::Property &udm::Property::operator=(const Property &other)
 	return *this;
 }
 
-void udm::Property::Copy(const Property &other, bool deepCopy)
+void udm::Property::Copy(const Property &other, bool deepCopy) { Copy(other, deepCopy ? MergeFlags::DeepCopy : MergeFlags::None); }
+void udm::Property::Copy(const Property &other, MergeFlags mergeFlags)
 {
+	UnshareParents();
 	Clear();
 	type = other.type;
 	Initialize();
@@ -58,13 +77,20 @@ void udm::Property::Copy(const Property &other, bool deepCopy)
 		return;
 	}
 	if(is_array_type(type)) {
-		GetValue<udm::Array>().Merge(other.GetValue<udm::Array>(), deepCopy ? MergeFlags::DeepCopy : MergeFlags::None);
+		auto &a = *static_cast<Array *>(value);
+		a.fromProperty = *this;
+		// Compressed data is copied as is, decompressing it would modify the other array
+		if(type != Type::ArrayLz4 || !static_cast<ArrayLz4 &>(a).CopyCompressed(*static_cast<const ArrayLz4 *>(other.value)))
+			a.Merge(*static_cast<const Array *>(other.value), mergeFlags);
 		return;
 	}
 	if(type == Type::Element) {
-		GetValue<udm::Element>().Merge(other.GetValue<udm::Element>(), deepCopy ? MergeFlags::DeepCopy : MergeFlags::None);
+		auto &e = *static_cast<Element *>(value);
+		e.fromProperty = *this;
+		e.Merge(*static_cast<const Element *>(other.value), mergeFlags);
 		return;
 	}
+	auto deepCopy = pragma::math::is_flag_set(mergeFlags, MergeFlags::DeepCopy);
 	auto tag = get_non_trivial_tag(type);
 	std::visit(
 	  [this, &other, deepCopy](auto tag) {
@@ -79,14 +105,144 @@ void udm::Property::Copy(const Property &other, bool deepCopy)
 	  },
 	  tag);
 }
-udm::PProperty udm::Property::Copy(bool deepCopy) const
+udm::PProperty udm::Property::Copy(bool deepCopy) const { return Copy(deepCopy ? MergeFlags::DeepCopy : MergeFlags::None); }
+udm::PProperty udm::Property::Copy(MergeFlags mergeFlags) const
 {
 	auto newProp = Property::Create();
-	newProp->Copy(*this, deepCopy);
+	newProp->Copy(*this, mergeFlags);
 	return newProp;
 }
 
-void udm::Property::SetAppropriatePrecision(std::stringstream &ss, Type type)
+udm::PProperty udm::Property::Share() const
+{
+	if(!value || is_trivial_type(type))
+		return Copy();
+	auto prop = Property::Create();
+	prop->type = type;
+	prop->value = value;
+	auto *self = const_cast<Property *>(this);
+	if(!m_nextShared) {
+		m_nextShared = prop.get();
+		prop->m_nextShared = self;
+		g_sharedPropertyCount.fetch_add(2, std::memory_order_relaxed);
+	}
+	else {
+		prop->m_nextShared = m_nextShared;
+		m_nextShared = prop.get();
+		g_sharedPropertyCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	return prop;
+}
+
+void udm::Property::Unshare()
+{
+	if(g_sharedPropertyCount.load(std::memory_order_relaxed) == 0)
+		return;
+	if(m_nextShared)
+		UnshareValue();
+	UnshareParents();
+}
+
+void udm::Property::UnshareParents()
+{
+	if(g_sharedPropertyCount.load(std::memory_order_relaxed) == 0)
+		return;
+	// If any of the parents shares its value, this property is shared as well
+	for(auto *prop = get_parent_property(*this); prop; prop = get_parent_property(*prop)) {
+		if(prop->m_nextShared)
+			prop->UnshareValue();
+	}
+}
+
+void udm::Property::UnshareValue()
+{
+	// Only the value itself is copied, values of children remain shared until they're written to
+	Property tmp {};
+	tmp.Copy(*this, MergeFlags::CopyOnWrite);
+	auto *copy = tmp.value;
+	tmp.value = nullptr;
+
+	// This property keeps the value, the other properties of the ring receive the copy
+	auto *next = LeaveSharedRing();
+	auto *prop = next;
+	do {
+		prop->value = copy;
+		prop = prop->m_nextShared;
+	} while(prop && prop != next);
+	next->BindValue();
+	BindValue();
+	if(type == Type::Element || is_array_type(type)) {
+		// The other properties of the ring now have different children
+		prop = next;
+		do {
+			invalidate_path_caches(*prop);
+			prop = prop->m_nextShared;
+		} while(prop && prop != next);
+	}
+}
+
+udm::Property *udm::Property::LeaveSharedRing()
+{
+	auto *next = m_nextShared;
+	if(!next)
+		return nullptr;
+	auto *prev = next;
+	while(prev->m_nextShared != this)
+		prev = prev->m_nextShared;
+	if(prev == next) {
+		// The other property was the last one sharing the value
+		prev->m_nextShared = nullptr;
+		g_sharedPropertyCount.fetch_sub(2, std::memory_order_relaxed);
+	}
+	else {
+		prev->m_nextShared = next;
+		g_sharedPropertyCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+	m_nextShared = nullptr;
+	return next;
+}
+
+bool udm::Property::IsValueBoundTo(const Property &prop) const
+{
+	if(!value)
+		return false;
+	if(type == Type::Element)
+		return static_cast<const Element *>(value)->fromProperty.prop == &prop;
+	if(is_array_type(type))
+		return static_cast<const Array *>(value)->fromProperty.prop == &prop;
+	return false;
+}
+
+void udm::Property::BindValue()
+{
+	if(!value)
+		return;
+	if(type == Type::Element) {
+		auto &e = *static_cast<Element *>(value);
+		e.fromProperty = *this;
+		if(parent)
+			e.parentProperty = parent->fromProperty;
+		return;
+	}
+	if(!is_array_type(type))
+		return;
+	auto &a = *static_cast<Array *>(value);
+	a.fromProperty = *this;
+	// Compressed arrays assign the back-references once they're decompressed
+	auto *items = a.GetValuePtr();
+	if(!items)
+		return;
+	if(a.IsValueType(Type::Element)) {
+		for(auto i = decltype(a.GetSize()) {0u}; i < a.GetSize(); ++i)
+			static_cast<Element *>(items)[i].fromProperty = PropertyWrapper {a, i};
+	}
+	else if(a.IsValueType(Type::Array)) {
+		for(auto i = decltype(a.GetSize()) {0u}; i < a.GetSize(); ++i)
+			static_cast<Array *>(items)[i].fromProperty = PropertyWrapper {a, i};
+	}
+}
+
+int udm::Property::GetAsciiPrecision(Type type)
 {
 	switch(type) {
 	case Type::Float:
@@ -100,30 +256,26 @@ void udm::Property::SetAppropriatePrecision(std::stringstream &ss, Type type)
 	case Type::Mat4:
 	case Type::Mat3x4:
 	case Type::Half:
-		ss << std::fixed;
-		ss.precision(4);
-		break;
+		return 4;
 	case Type::Double:
-		ss << std::fixed;
-		ss.precision(8);
-		break;
+		return 8;
 	default:
 		break;
 	}
 	static_assert(pragma::math::to_integral(Type::Count) == 36, "Update this list when new types are added!");
+	return 0;
 }
-void udm::Property::RemoveTrailingZeroes(std::string &str)
+char *udm::Property::RemoveTrailingZeroes(char *first, char *last)
 {
-	auto pos = str.find_last_not_of('0');
-	if(pos == std::string::npos || pos == str.length() - 1)
-		return;
-	auto sep = str.find('.');
-	if(sep == std::string::npos)
-		return;
-	int offset {1};
-	if(pos == sep)
-		offset = 0;
-	str.erase(pos + offset, std::string::npos);
+	auto *sep = std::find(first, last, '.');
+	if(sep == last)
+		return last;
+	while(last > sep + 1 && *(last - 1) == '0')
+		--last;
+	// Remove the separator as well if there are no decimals left
+	if(last == sep + 1)
+		--last;
+	return last;
 }
 
 void udm::Property::Initialize()
@@ -144,6 +296,17 @@ void udm::Property::Clear()
 {
 	if(value == nullptr)
 		return;
+	if(type == Type::Element || is_array_type(type))
+		invalidate_path_caches(*this); // Children may be referenced by path caches
+	if(m_nextShared) {
+		// The value is still in use by the other properties of the ring
+		auto bound = IsValueBoundTo(*this);
+		auto *next = LeaveSharedRing();
+		if(bound)
+			next->BindValue();
+		value = nullptr;
+		return;
+	}
 	if(is_trivial_type(type))
 		delete[] static_cast<uint8_t *>(value);
 	else {
@@ -198,7 +361,9 @@ bool udm::Property::Read(IFile &f, Element &el)
 			el.parentProperty = {*this};
 			el.fromProperty = {*prop};
 		}
-		el.children[std::move(name)] = prop;
+		auto it = el.children.insert_or_assign(std::move(name), prop).first;
+		prop->parent = &el;
+		prop->key = &it->first;
 	}
 	return true;
 }
@@ -465,7 +630,15 @@ void udm::Property::Write(IFile &f) const
 }
 
 udm::LinkedPropertyWrapper udm::Property::operator[](const std::string &key) { return LinkedPropertyWrapper {*this}[key]; }
-udm::LinkedPropertyWrapper udm::Property::operator[](const char *key) { return operator[](std::string {key}); }
+void udm::Property::ThrowAccessError(AccessError err, Type requestedType) const
+{
+	if(err == AccessError::TypeMismatch)
+		throw LogicError {"Type mismatch, requested type is " + std::string {magic_enum::enum_name(requestedType)} + ", but actual type is " + std::string {magic_enum::enum_name(type)} + "!"};
+	throw LogicError {"Attempted to retrieve value of type " + std::string {magic_enum::enum_name(requestedType)} + " from property without a value!"};
+}
+
+udm::LinkedPropertyWrapper udm::Property::operator[](const char *key) { return LinkedPropertyWrapper {*this}[key]; }
+udm::LinkedPropertyWrapper udm::Property::operator[](const Key &key) { return LinkedPropertyWrapper {*this}[key]; }
 
 bool udm::Property::operator==(const Property &other) const
 {
@@ -674,11 +847,14 @@ udm::Blob udm::Property::GetBlobData(Type &outType) const
 void *udm::Property::GetValuePtr(Type &outType)
 {
 	outType = this->type;
+	if(value)
+		Unshare();
 	return value;
 }
 
 bool udm::Property::Read(Type ptype, IFile &f)
 {
+	UnshareParents();
 	Clear();
 	type = ptype;
 	Initialize();
@@ -694,67 +870,3 @@ bool udm::Property::Read(Type ptype, IFile &f)
 }
 bool udm::Property::Read(IFile &f) { return Read(f.Read<Type>(), f); }
 
-void udm::Property::ToAscii(AsciiSaveFlags flags, std::stringstream &ss, const std::string &propName, Type type, const DataValue value, const std::string &prefix)
-{
-	if(type == Type::Element) {
-		ss << prefix << '\"' << propName << "\"\n";
-		ss << prefix << "{\n";
-		static_cast<Element *>(value)->ToAscii(flags, ss, prefix);
-		ss << '\n' << prefix << "}";
-		return;
-	}
-	if(is_numeric_type(type)) {
-		auto tag = get_numeric_tag(type);
-		std::visit(
-		  [value, &ss](auto tag) {
-			  using T = typename decltype(tag)::type;
-			  NumericTypeToString(*static_cast<T *>(value), ss);
-		  },
-		  tag);
-	}
-	else {
-		auto vs = [value, &ss, &prefix, flags](auto tag) {
-			using T = typename decltype(tag)::type;
-			ss << ToAsciiValue(flags, *static_cast<T *>(value), prefix);
-		};
-		if(is_gnt_type(type))
-			visit_gnt(type, vs);
-	}
-}
-
-void udm::Property::ToAscii(AsciiSaveFlags flags, std::stringstream &ss, const std::string &propName, const std::string &prefix)
-{
-	if(type == Type::Element) {
-		ss << prefix << '\"' << propName << "\"\n";
-		ss << prefix << "{\n";
-		static_cast<Element *>(value)->ToAscii(flags, ss, prefix);
-		ss << '\n' << prefix << "}";
-		return;
-	}
-	ss << prefix << "$" << enum_type_to_ascii(type);
-	if(type == Type::Struct)
-		ss << (*static_cast<Struct *>(value))->GetTemplateArgumentList();
-	ss << " ";
-	if(does_key_require_quotes(propName))
-		ss << '\"' << propName << '\"';
-	else
-		ss << propName;
-	ss << " ";
-	if(is_numeric_type(type)) {
-		auto tag = get_numeric_tag(type);
-		std::visit(
-		  [this, &ss](auto tag) {
-			  using T = typename decltype(tag)::type;
-			  NumericTypeToString(*static_cast<T *>(value), ss);
-		  },
-		  tag);
-	}
-	else {
-		auto vs = [this, &ss, &prefix, flags](auto tag) {
-			using T = typename decltype(tag)::type;
-			ss << ToAsciiValue(flags, *static_cast<T *>(value), prefix);
-		};
-		if(is_gnt_type(type))
-			visit_gnt(type, vs);
-	}
-}
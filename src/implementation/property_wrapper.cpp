@@ -17,7 +17,7 @@ udm::PropertyWrapper::PropertyWrapper(const PropertyWrapper &other) : prop {othe
 udm::PropertyWrapper::PropertyWrapper(Array &array, uint32_t idx) : PropertyWrapper {array.fromProperty}
 {
 	arrayIndex = idx;
-	if(array.fromProperty.prop && array.fromProperty.prop->GetValuePtr<Array>() != &array) {
+	if(array.fromProperty.prop && std::as_const(*array.fromProperty.prop).GetValuePtr<Array>() != &array) {
 		// Note: This is a special case where the from-property of the array does not point to the array,
 		// which means this is a sub-array of another array (since array items do not have properties themselves).
 		// We'll set 'prop' to nullptr, but keep the array index, to indicate that this is a sub-array.
@@ -62,7 +62,7 @@ udm::PropertyWrapper::operator bool() const
 	}
 	if(!linked)
 		return false;
-	auto *a = prop->GetValuePtr<Array>();
+	auto *a = std::as_const(*prop).GetValuePtr<Array>();
 	if(a == nullptr || arrayIndex >= a->GetSize())
 		return false;
 	auto &linkedWrapper = static_cast<const LinkedPropertyWrapper &>(*this);
@@ -76,6 +76,7 @@ udm::PropertyWrapper::operator bool() const
 
 void *udm::PropertyWrapper::GetValuePtr(Type &outType) const
 {
+	UnsharePath();
 	if(arrayIndex != std::numeric_limits<decltype(arrayIndex)>::max()) {
 		auto &a = prop->GetValue<Array>();
 		if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
@@ -115,12 +116,12 @@ bool udm::PropertyWrapper::IsType(Type type) const
 	if(IsArrayItem(true)) {
 		if(!is_array_type(prop->type))
 			return false;
-		auto &a = prop->GetValue<Array>();
+		auto &a = std::as_const(*prop).GetValue<Array>();
 		if(!linked || static_cast<const LinkedPropertyWrapper &>(*this).propName.empty())
 			return a.IsValueType(type);
 		if(a.IsValueType(Type::Element) == false)
 			return false;
-		auto &e = *static_cast<Element *>(a.GetValuePtr(arrayIndex));
+		auto &e = *static_cast<const Element *>(a.GetValuePtr(arrayIndex));
 		auto it = e.children.find(static_cast<const LinkedPropertyWrapper &>(*this).propName);
 		return (it != e.children.end()) ? it->second->type == type : false;
 	}
@@ -131,22 +132,40 @@ udm::Type udm::PropertyWrapper::GetType() const
 {
 	if(!prop)
 		return Type::Nil;
-	Type type;
-	return const_cast<PropertyWrapper *>(this)->GetValuePtr(type) ? type : Type::Nil;
+	if(arrayIndex != std::numeric_limits<decltype(arrayIndex)>::max()) {
+		auto &a = std::as_const(*prop).GetValue<Array>();
+		if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
+			auto &e = a.GetValue<Element>(arrayIndex);
+			auto it = e.children.find(static_cast<const LinkedPropertyWrapper &>(*this).propName);
+			return (it != e.children.end() && it->second->value) ? it->second->type : Type::Nil;
+		}
+		return (arrayIndex < a.GetSize()) ? a.GetValueType() : Type::Nil;
+	}
+	return prop->value ? prop->type : Type::Nil;
+}
+
+void udm::PropertyWrapper::UnsharePath() const
+{
+	if(linked) {
+		const_cast<LinkedPropertyWrapper &>(static_cast<const LinkedPropertyWrapper &>(*this)).Unshare();
+		return;
+	}
+	if(prop)
+		prop->Unshare();
 }
 
 void udm::PropertyWrapper::Merge(const PropertyWrapper &other, MergeFlags mergeFlags) const
 {
 	if(IsType(Type::Element) && other.IsType(Type::Element)) {
 		auto *e = GetValuePtr<Element>();
-		auto *eOther = other.GetValuePtr<Element>();
+		auto *eOther = other.GetConstValuePtr<Element>();
 		if(e && eOther)
 			e->Merge(*eOther, mergeFlags);
 		return;
 	}
 	if(is_array_type(GetType()) && is_array_type(other.GetType())) {
 		auto *a = GetValuePtr<Array>();
-		auto *aOther = other.GetValuePtr<Array>();
+		auto *aOther = other.GetConstValuePtr<Array>();
 		if(a && aOther)
 			a->Merge(*aOther, mergeFlags);
 		return;
@@ -158,6 +177,7 @@ udm::Array *udm::PropertyWrapper::GetOwningArray() const
 	if(IsArrayItem() == false)
 		return nullptr;
 	//return &static_cast<const LinkedPropertyWrapper&>(*this).prev->prop->GetValue<Array>();
+	UnsharePath();
 	return &prop->GetValue<Array>();
 }
 
@@ -176,9 +196,11 @@ udm::BlobResult udm::PropertyWrapper::GetBlobData(void *outBuffer, size_t buffer
 	if(!*this)
 		return BlobResult::InvalidProperty;
 	if(IsArrayItem(true)) {
-		auto &a = prop->GetValue<Array>();
-		if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty())
-			return const_cast<Element &>(a.GetValue<Element>(arrayIndex)).children[static_cast<const LinkedPropertyWrapper &>(*this).propName]->GetBlobData(outBuffer, bufferSize, optOutRequiredSize);
+		auto &a = std::as_const(*prop).GetValue<Array>();
+		if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
+			auto *child = find_element_child(a.GetValue<Element>(arrayIndex), static_cast<const LinkedPropertyWrapper &>(*this).propName);
+			return child ? (*child)->GetBlobData(outBuffer, bufferSize, optOutRequiredSize) : BlobResult::InvalidProperty;
+		}
 		switch(a.GetValueType()) {
 		case Type::Blob:
 			{
@@ -205,15 +227,27 @@ udm::BlobResult udm::PropertyWrapper::GetBlobData(void *outBuffer, size_t buffer
 udm::Blob udm::PropertyWrapper::GetBlobData(Type &outType) const
 {
 	if(IsArrayItem(true)) {
-		auto &a = prop->GetValue<Array>();
-		if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty())
-			return const_cast<Element &>(a.GetValue<Element>(arrayIndex)).children[static_cast<const LinkedPropertyWrapper &>(*this).propName]->GetBlobData(outType);
-		return a.IsValueType(Type::Blob) ? a.GetValue<Blob>(arrayIndex) : a.IsValueType(Type::BlobLz4) ? Property::GetBlobData(const_cast<const BlobLz4 &>(a.GetValue<BlobLz4>(arrayIndex))) : udm::Blob {};
+		auto &a = std::as_const(*prop).GetValue<Array>();
+		if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
+			auto *child = find_element_child(a.GetValue<Element>(arrayIndex), static_cast<const LinkedPropertyWrapper &>(*this).propName);
+			if(!child) {
+				outType = Type::Nil;
+				return {};
+			}
+			return (*child)->GetBlobData(outType);
+		}
+		return a.IsValueType(Type::Blob) ? a.GetValue<Blob>(arrayIndex) : a.IsValueType(Type::BlobLz4) ? Property::GetBlobData(a.GetValue<BlobLz4>(arrayIndex)) : udm::Blob {};
 	}
 	return (*this)->GetBlobData(outType);
 }
 
-uint32_t udm::PropertyWrapper::GetSize() const { return (static_cast<bool>(*this) && is_array_type(this->GetType())) ? GetValue<udm::Array>().GetSize() : 0; }
+uint32_t udm::PropertyWrapper::GetSize() const
+{
+	if(!static_cast<bool>(*this) || !is_array_type(this->GetType()))
+		return 0;
+	auto *a = GetConstValuePtr<udm::Array>();
+	return a ? a->GetSize() : 0;
+}
 void udm::PropertyWrapper::Resize(uint32_t size) const
 {
 	if(!static_cast<bool>(*this) || is_array_type(GetType()) == false)
@@ -225,14 +259,15 @@ udm::ArrayIterator<udm::LinkedPropertyWrapper> udm::PropertyWrapper::end() const
 
 uint32_t udm::PropertyWrapper::GetChildCount() const
 {
-	auto *e = GetValuePtr<Element>();
+	auto *e = GetConstValuePtr<Element>();
 	return e ? e->children.size() : 0;
 }
 udm::ElementIterator udm::PropertyWrapper::begin_el() const
 {
 	if(!static_cast<bool>(*this))
 		return ElementIterator {};
-	auto *e = GetValuePtr<Element>();
+	// Writes through the iterator un-share the values along the path (see LinkedPropertyWrapper::Unshare)
+	auto *e = const_cast<Element *>(GetConstValuePtr<Element>());
 	if(e == nullptr)
 		return ElementIterator {};
 	auto it = e->begin();
@@ -244,7 +279,7 @@ udm::ElementIterator udm::PropertyWrapper::end_el() const
 {
 	if(!static_cast<bool>(*this))
 		return ElementIterator {};
-	auto *e = GetValuePtr<Element>();
+	auto *e = const_cast<Element *>(GetConstValuePtr<Element>());
 	if(e == nullptr)
 		return ElementIterator {};
 	return e->end();
@@ -279,6 +314,7 @@ udm::LinkedPropertyWrapper udm::PropertyWrapper::AddArray(const std::string_view
 
 udm::LinkedPropertyWrapper udm::PropertyWrapper::AddArray(const std::string_view &path, std::optional<uint32_t> size, Type type, ArrayType arrayType, bool pathToElements) const
 {
+	UnsharePath();
 	if(arrayIndex != std::numeric_limits<uint32_t>::max()) {
 		if(IsArrayItem(true)) {
 			auto &a = *static_cast<Array *>(prop->value);
@@ -323,6 +359,7 @@ udm::LinkedPropertyWrapper udm::PropertyWrapper::AddArray(const std::string_view
 
 udm::LinkedPropertyWrapper udm::PropertyWrapper::Add(const std::string_view &path, Type type, bool pathToElements) const
 {
+	UnsharePath();
 	if(arrayIndex != std::numeric_limits<uint32_t>::max()) {
 		if(linked) {
 			auto &linkedWrapper = static_cast<const LinkedPropertyWrapper &>(*this);
@@ -362,7 +399,21 @@ udm::LinkedPropertyWrapper udm::PropertyWrapper::Add(const std::string_view &pat
 
 void udm::Element::AddChild(std::string &&key, const PProperty &o)
 {
-	children[std::move(key)] = o;
+	PrepareWrite();
+	auto it = children.try_emplace(std::move(key)).first;
+	auto &child = it->second;
+	if(child && child != o && child->parent == this) {
+		child->parent = nullptr;
+		child->key = nullptr;
+	}
+	child = o;
+	invalidate_path_caches(*this);
+	if(o->parent && o->parent != this)
+		return; // Still owned by another element, which remains its parent
+	o->parent = this;
+	o->key = &it->first;
+	if(o->IsShared())
+		return; // The value remains bound to the property it's shared with until it is written to (see Property::Unshare)
 	if(o->type == Type::Element) {
 		auto *el = static_cast<Element *>(o->value);
 		el->parentProperty = fromProperty;
@@ -379,60 +430,96 @@ void udm::Element::AddChild(const std::string &key, const PProperty &o)
 }
 
 udm::Property &udm::PropertyWrapper::operator*() const { return *prop; }
+
+void udm::PropertyWrapper::ThrowAccessError(AccessError err, Type requestedType) const
+{
+	switch(err) {
+	case AccessError::OutOfBounds:
+		{
+			auto *a = prop ? std::as_const(*prop).GetValuePtr<Array>() : nullptr;
+			throw OutOfBoundsError {"Array index " + std::to_string(arrayIndex) + " out of bounds of array of size " + std::to_string(a ? a->GetSize() : 0) + "!"};
+		}
+	case AccessError::NotFound:
+		throw LogicError {"Attempted to retrieve value of property '" + static_cast<const LinkedPropertyWrapper &>(*this).propName + "' from array element at index " + std::to_string(arrayIndex) + ", but property does not exist!"};
+	case AccessError::TypeMismatch:
+		throw LogicError {"Type mismatch, requested type is " + std::string {magic_enum::enum_name(requestedType)} + ", but actual type is " + std::string {magic_enum::enum_name(GetType())} + "!"};
+	default:
+		break;
+	}
+	throw LogicError {"Attempted to retrieve value of type " + std::string {magic_enum::enum_name(requestedType)} + " from invalid property!"};
+}
+
+std::expected<udm::PropertyWrapper, udm::AccessError> udm::PropertyWrapper::TryIndex(uint32_t idx) const noexcept
+{
+	auto a = TryGetConstValue<Array>();
+	if(!a)
+		return std::unexpected {a.error()};
+	if(idx >= (*a)->GetSize())
+		return std::unexpected {AccessError::OutOfBounds};
+	return PropertyWrapper {const_cast<Array &>(**a), idx};
+}
+
+std::expected<udm::PropertyWrapper, udm::AccessError> udm::PropertyWrapper::TryGetChild(const Key &key) const noexcept
+{
+	auto el = TryGetConstValue<Element>();
+	if(!el)
+		return std::unexpected {el.error()};
+	auto it = (*el)->children.find(key);
+	if(it == (*el)->children.end() || !it->second)
+		return std::unexpected {AccessError::NotFound};
+	return PropertyWrapper {*it->second};
+}
+
+std::expected<udm::PropertyWrapper, udm::AccessError> udm::PropertyWrapper::TryGetFromPath(const std::string_view &path) const noexcept
+{
+	try {
+		PathCursor cursor {*this};
+		if(!cursor)
+			return std::unexpected {AccessError::InvalidProperty};
+		if(!cursor.DownPath(path))
+			return std::unexpected {AccessError::NotFound};
+		auto &frame = cursor.GetFrame();
+		if(frame.array)
+			return PropertyWrapper {*frame.array, frame.arrayIndex};
+		return PropertyWrapper {*frame.prop};
+	}
+	catch(...) {
+		// A compressed array along the path couldn't be decompressed
+		return std::unexpected {AccessError::InvalidProperty};
+	}
+}
 udm::Property *udm::PropertyWrapper::operator->() const { return prop; }
 
 udm::LinkedPropertyWrapper udm::PropertyWrapper::GetFromPath(const std::string_view &key) const
 {
-	if(key.empty())
+	// Uses the same parser as PathCursor::DownPath, but the wrappers are linked, so properties that don't exist yet can be assigned
+	LinkedPropertyWrapper prop {};
+	auto first = true;
+	auto valid = for_each_path_segment(key, [this, &prop, &first](const PathSegment &segment) {
+		if(first)
+			prop = segment.IsIndex() ? (*this)[segment.index] : (*this)[segment.key];
+		else
+			prop = segment.IsIndex() ? prop[segment.index] : prop[segment.key];
+		first = false;
+		return true;
+	});
+	if(!valid || first)
 		return {};
-	auto end = key.find(PATH_SEPARATOR);
-	auto baseKeyName = key.substr(0, end);
-	std::vector<uint32_t> arrayIndices {};
-	while(baseKeyName.back() == ']') {
-		auto st = baseKeyName.rfind('[');
-		if(st == std::string::npos)
-			return {};
-		auto arrayIndex = pragma::util::to_uint(std::string {baseKeyName.substr(st + 1, baseKeyName.length() - st - 2)});
-		arrayIndices.push_back(arrayIndex);
-		baseKeyName = baseKeyName.substr(0, st);
-	}
-	if(baseKeyName.front() == '\"') {
-		uint32_t idx = 0;
-		while(idx < baseKeyName.length()) {
-			if(baseKeyName[idx] == '\"')
-				break;
-			++idx;
-		}
-		if(idx >= baseKeyName.length())
-			return {};
-		baseKeyName = baseKeyName.substr(1, idx - 1);
-	}
-	auto prop = (*this)[baseKeyName];
-	for(auto it = arrayIndices.rbegin(); it != arrayIndices.rend(); ++it)
-		prop = prop[*it];
-	if(end != std::string::npos)
-		return prop.GetFromPath(key.substr(end + 1));
 	return prop;
 }
 
 udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](uint32_t idx) const
 {
-	auto *a = GetValuePtr<Array>();
+	auto *a = const_cast<Array *>(GetConstValuePtr<Array>());
 	if(a == nullptr)
 		return {};
-	auto vs = [this, a, idx](auto tag) {
-		using TTag = typename decltype(tag)::type;
-		auto it = const_cast<PropertyWrapper *>(this)->begin<TTag>() + idx;
-		return it.GetProperty();
-	};
-	auto valueType = a->GetValueType();
-	auto item = visit(valueType, vs);
+	LinkedPropertyWrapper item {*a, idx};
 	if(linked) {
 		auto *l = static_cast<const udm::LinkedPropertyWrapper *>(this);
 		if(!l->propName.empty()) {
 			if(!l->prev)
 				return {};
-			auto *aPrev = l->prev->prop ? l->prev->prop->GetValuePtr<Array>() : nullptr;
+			auto *aPrev = l->prev->prop ? std::as_const(*l->prev->prop).GetValuePtr<Array>() : nullptr;
 			if(aPrev) {
 				if(!aPrev || l->prev->arrayIndex >= aPrev->GetSize())
 					return {};
@@ -445,7 +532,7 @@ udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](uint32_t idx) const
 				item.prop = it->second.get();
 			}
 			else {
-				auto *elPrev = l->prev->GetValuePtr<Element>();
+				auto *elPrev = l->prev->GetConstValuePtr<Element>();
 				if(!elPrev)
 					return {};
 				auto it = elPrev->children.find(l->propName);
@@ -459,31 +546,32 @@ udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](uint32_t idx) const
 	return item;
 }
 
-udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](const char *key) const { return operator[](std::string {key}); }
+udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](const char *key) const { return operator[](Key {key}); }
 udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](int32_t idx) const { return operator[](static_cast<uint32_t>(idx)); }
 udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](size_t idx) const { return operator[](static_cast<uint32_t>(idx)); }
 
-udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](const std::string_view &key) const
+udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](const std::string_view &key) const { return operator[](Key {key}); }
+udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](const Key &key) const
 {
-	if(key.empty())
+	if(key.str.empty())
 		throw InvalidUsageError {"Empty string is not allowed as key!"};
 	if(prop == nullptr) {
 		udm::LinkedPropertyWrapper wrapper {};
 		wrapper.prev = linked ? std::make_unique<udm::LinkedPropertyWrapper>(static_cast<const LinkedPropertyWrapper &>(*this)) : std::make_unique<udm::LinkedPropertyWrapper>(*this);
-		wrapper.propName = key;
+		wrapper.propName = key.str;
 		return wrapper;
 	}
-	auto getElementProperty = [](const PropertyWrapper &prop, Element &el, const std::string_view &key) {
-		auto it = el.children.find(std::string {key});
+	auto getElementProperty = [](const PropertyWrapper &prop, Element &el, const Key &key) {
+		auto it = el.children.find(key);
 		if(it == el.children.end()) {
 			udm::LinkedPropertyWrapper wrapper {};
 			wrapper.prev = prop.linked ? std::make_unique<udm::LinkedPropertyWrapper>(static_cast<const LinkedPropertyWrapper &>(prop)) : std::make_unique<udm::LinkedPropertyWrapper>(prop);
-			wrapper.propName = key;
+			wrapper.propName = key.str;
 			return wrapper;
 		}
 		udm::LinkedPropertyWrapper wrapper {*it->second};
 		wrapper.prev = prop.linked ? std::make_unique<udm::LinkedPropertyWrapper>(static_cast<const LinkedPropertyWrapper &>(prop)) : std::make_unique<udm::LinkedPropertyWrapper>(prop);
-		wrapper.propName = key;
+		wrapper.propName = key.str;
 		return wrapper;
 	};
 	Element *el = nullptr;
@@ -491,7 +579,7 @@ udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](const std::string_vi
 		el = static_cast<Element *>(prop->value);
 	else if(prop->type == Type::Reference) {
 		auto &ref = *static_cast<Reference *>(prop->value);
-		el = ref.property ? ref.property->GetValuePtr<Element>() : nullptr;
+		el = ref.property ? const_cast<Element *>(std::as_const(*ref.property).GetValuePtr<Element>()) : nullptr;
 	}
 	else {
 		if(arrayIndex == std::numeric_limits<uint32_t>::max())
@@ -505,10 +593,10 @@ udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](const std::string_vi
 			if(el == nullptr)
 				return {};
 			return getElementProperty(*this,*el,key);*/
-			el = &static_cast<Array *>(prop->value)->GetValue<Element>(arrayIndex);
-			auto prop = getElementProperty(*this, *el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
+			el = const_cast<Element *>(&static_cast<const Array *>(prop->value)->GetValue<Element>(arrayIndex));
+			auto prop = getElementProperty(*this, *el, Key {static_cast<const LinkedPropertyWrapper &>(*this).propName});
 			prop.InitializeProperty(); // TODO: Don't initialize if this is used as a getter
-			el = prop.GetValuePtr<Element>();
+			el = const_cast<Element *>(prop.GetConstValuePtr<Element>());
 			if(el == nullptr)
 				return {};
 			return getElementProperty(prop, *el, key);
@@ -517,7 +605,7 @@ udm::LinkedPropertyWrapper udm::PropertyWrapper::operator[](const std::string_vi
 			LinkedPropertyWrapper el = (*static_cast<Array *>(prop->value))[arrayIndex];
 			udm::LinkedPropertyWrapper wrapper {el};
 			wrapper.prev = linked ? std::make_unique<udm::LinkedPropertyWrapper>(static_cast<const LinkedPropertyWrapper &>(*this)) : std::make_unique<udm::LinkedPropertyWrapper>(*this);
-			wrapper.propName = key;
+			wrapper.propName = key.str;
 			return wrapper;
 		}
 	}
@@ -0,0 +1,389 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+struct udm::Query::EvaluationContext {
+	Callback output;
+	bool parallel = false;
+	uint32_t minItemsPerTask = MIN_ITEMS_PER_TASK;
+};
+
+// Queries only read, so the values are accessed without un-sharing them (see udm::Property::Unshare)
+static udm::Element *get_element(const udm::PathCursor::Frame &node)
+{
+	if(node.array)
+		return (node.arrayIndex < node.array->GetSize()) ? const_cast<udm::Element *>(std::as_const(*node.array).GetValuePtr<udm::Element>(node.arrayIndex)) : nullptr;
+	return node.prop ? const_cast<udm::Element *>(std::as_const(*node.prop).GetValuePtr<udm::Element>()) : nullptr;
+}
+
+static udm::Array *get_array(const udm::PathCursor::Frame &node)
+{
+	if(node.array)
+		return (node.arrayIndex < node.array->GetSize()) ? const_cast<udm::Array *>(std::as_const(*node.array).GetValuePtr<udm::Array>(node.arrayIndex)) : nullptr;
+	return (node.prop && udm::is_array_type(node.prop->type)) ? const_cast<udm::Array *>(std::as_const(*node.prop).GetValuePtr<udm::Array>()) : nullptr;
+}
+
+static udm::PropertyWrapper to_property_wrapper(const udm::PathCursor::Frame &node)
+{
+	if(node.array)
+		return udm::PropertyWrapper {*node.array, node.arrayIndex};
+	return udm::PropertyWrapper {*node.prop};
+}
+
+static udm::PathCursor::Frame to_node(const udm::PropertyWrapper &wrapper)
+{
+	udm::PathCursor cursor {wrapper};
+	return cursor.IsValid() ? cursor.GetFrame() : udm::PathCursor::Frame {};
+}
+
+// Appends the children of an element sorted by key (the order in which they're saved), or the items of an array
+static void get_children(const udm::PathCursor::Frame &node, std::vector<udm::PathCursor::Frame> &outChildren, bool elementItemsOnly)
+{
+	auto *el = get_element(node);
+	if(el) {
+		auto offset = outChildren.size();
+		outChildren.reserve(offset + el->children.size());
+		for(auto &[key, child] : el->children) {
+			if(child)
+				outChildren.push_back(udm::PathCursor::Frame {child.get(), nullptr, udm::PathCursor::INVALID_INDEX, key});
+		}
+		std::sort(outChildren.begin() + offset, outChildren.end(), [](const udm::PathCursor::Frame &a, const udm::PathCursor::Frame &b) { return a.key < b.key; });
+		return;
+	}
+	auto *a = get_array(node);
+	if(!a || (elementItemsOnly && a->GetValueType() != udm::Type::Element))
+		return;
+	auto size = a->GetSize();
+	outChildren.reserve(outChildren.size() + size);
+	for(auto i = decltype(size) {0u}; i < size; ++i)
+		outChildren.push_back(udm::PathCursor::Frame {nullptr, a, i});
+}
+
+static std::string_view trim(std::string_view str)
+{
+	while(!str.empty() && std::isspace(static_cast<unsigned char>(str.front())))
+		str.remove_prefix(1);
+	while(!str.empty() && std::isspace(static_cast<unsigned char>(str.back())))
+		str.remove_suffix(1);
+	return str;
+}
+
+static std::optional<uint32_t> parse_index(std::string_view str)
+{
+	str = trim(str);
+	uint32_t idx = 0;
+	auto res = std::from_chars(str.data(), str.data() + str.length(), idx);
+	if(str.empty() || res.ec != std::errc {} || res.ptr != str.data() + str.length())
+		return {};
+	return idx;
+}
+
+udm::Query udm::Query::Compile(const std::string_view &query)
+{
+	Query result {};
+	result.m_query = query;
+	auto fail = [&query](const std::string &msg) { throw InvalidUsageError {"Invalid query '" + std::string {query} + "': " + msg}; };
+	auto parseSelector = [&result, &fail](std::string_view selector) {
+		selector = trim(selector);
+		Step step {};
+		if(selector == "*") {
+			step.kind = Step::Kind::Range;
+			result.m_steps.push_back(std::move(step));
+			return;
+		}
+		if(selector.empty() || selector.front() != '?') {
+			auto sep = selector.find(':');
+			if(sep == std::string_view::npos) {
+				auto idx = parse_index(selector);
+				if(!idx.has_value())
+					fail("Invalid array index '" + std::string {selector} + "'.");
+				step.kind = Step::Kind::Index;
+				step.start = *idx;
+				result.m_steps.push_back(std::move(step));
+				return;
+			}
+			step.kind = Step::Kind::Range;
+			auto start = trim(selector.substr(0, sep));
+			auto end = trim(selector.substr(sep + 1));
+			if(!start.empty()) {
+				auto idx = parse_index(start);
+				if(!idx.has_value())
+					fail("Invalid range start '" + std::string {start} + "'.");
+				step.start = *idx;
+			}
+			if(!end.empty()) {
+				auto idx = parse_index(end);
+				if(!idx.has_value())
+					fail("Invalid range end '" + std::string {end} + "'.");
+				step.end = *idx;
+			}
+			result.m_steps.push_back(std::move(step));
+			return;
+		}
+
+		// Predicate
+		step.kind = Step::Kind::Predicate;
+		auto pred = trim(selector.substr(1));
+		size_t offset = 0;
+		if(!pred.empty() && pred.front() == '\"') {
+			auto end = pred.find('\"', 1);
+			if(end == std::string_view::npos)
+				fail("Unterminated quoted key in predicate.");
+			step.key = pred.substr(1, end - 1);
+			offset = end + 1;
+		}
+		else {
+			while(offset < pred.length() && !std::isspace(static_cast<unsigned char>(pred[offset])) && std::string_view {"=!<>"}.find(pred[offset]) == std::string_view::npos)
+				++offset;
+			step.key = pred.substr(0, offset);
+		}
+		if(step.key.empty())
+			fail("Predicate is missing a key.");
+		pred = trim(pred.substr(offset));
+		if(pred.empty()) {
+			result.m_steps.push_back(std::move(step));
+			return;
+		}
+		constexpr std::array<std::pair<std::string_view, CompareOp>, 6> operators {{
+		  {"==", CompareOp::Equal},
+		  {"!=", CompareOp::NotEqual},
+		  {"<=", CompareOp::LessOrEqual},
+		  {">=", CompareOp::GreaterOrEqual},
+		  {"<", CompareOp::Less},
+		  {">", CompareOp::Greater},
+		}};
+		auto it = std::find_if(operators.begin(), operators.end(), [&pred](const std::pair<std::string_view, CompareOp> &op) { return pred.starts_with(op.first); });
+		if(it == operators.end())
+			fail("Unknown operator in predicate '" + std::string {pred} + "'.");
+		step.op = it->second;
+		auto value = trim(pred.substr(it->first.length()));
+		if(value.length() >= 2 && value.front() == '\"' && value.back() == '\"')
+			step.value = std::string {value.substr(1, value.length() - 2)};
+		else if(value == "true" || value == "false")
+			step.value = (value == "true");
+		else {
+			double d = 0.0;
+			auto res = std::from_chars(value.data(), value.data() + value.length(), d);
+			if(value.empty() || res.ec != std::errc {} || res.ptr != value.data() + value.length())
+				fail("Invalid predicate value '" + std::string {value} + "'.");
+			step.value = d;
+		}
+		result.m_steps.push_back(std::move(step));
+	};
+
+	size_t i = 0;
+	while(i < query.length()) {
+		if(query[i] == '\"') {
+			auto end = query.find('\"', i + 1);
+			if(end == std::string_view::npos)
+				fail("Unterminated quoted key.");
+			result.m_steps.push_back(Step {Step::Kind::Child, std::string {query.substr(i + 1, end - i - 1)}});
+			i = end + 1;
+		}
+		else {
+			auto end = i;
+			while(end < query.length() && query[end] != PATH_SEPARATOR && query[end] != '[')
+				++end;
+			auto name = query.substr(i, end - i);
+			if(name == "*")
+				result.m_steps.push_back(Step {Step::Kind::AnyChild});
+			else if(name == "**")
+				result.m_steps.push_back(Step {Step::Kind::Descendants});
+			else if(!name.empty())
+				result.m_steps.push_back(Step {Step::Kind::Child, std::string {name}});
+			i = end;
+		}
+		while(i < query.length() && query[i] == '[') {
+			// Find the closing bracket, ignoring brackets within quoted predicate values
+			auto end = i + 1;
+			auto inQuotes = false;
+			for(; end < query.length(); ++end) {
+				if(query[end] == '\"')
+					inQuotes = !inQuotes;
+				else if(query[end] == ']' && !inQuotes)
+					break;
+			}
+			if(end >= query.length())
+				fail("Missing ']'.");
+			parseSelector(query.substr(i + 1, end - i - 1));
+			i = end + 1;
+		}
+		if(i < query.length()) {
+			if(query[i] != PATH_SEPARATOR)
+				fail("Expected '" + std::string {PATH_SEPARATOR} + "' at position " + std::to_string(i) + ".");
+			++i;
+		}
+	}
+	return result;
+}
+
+bool udm::Query::Matches(const Node &node, const Step &step) const
+{
+	auto *el = get_element(node);
+	if(!el)
+		return false;
+	auto it = el->children.find(step.key);
+	if(it == el->children.end() || !it->second)
+		return false;
+	if(step.op == CompareOp::Exists)
+		return true;
+	PropertyWrapper child {*it->second};
+	return std::visit(
+	  [&child, &step](const auto &value) -> bool {
+		  using T = std::remove_cvref_t<decltype(value)>;
+		  auto childValue = child.ToValue<T>();
+		  if(!childValue.has_value())
+			  return false;
+		  switch(step.op) {
+		  case CompareOp::Equal:
+			  return *childValue == value;
+		  case CompareOp::NotEqual:
+			  return *childValue != value;
+		  case CompareOp::Less:
+			  return *childValue < value;
+		  case CompareOp::LessOrEqual:
+			  return *childValue <= value;
+		  case CompareOp::Greater:
+			  return *childValue > value;
+		  case CompareOp::GreaterOrEqual:
+			  return *childValue >= value;
+		  }
+		  return false;
+	  },
+	  step.value);
+}
+
+bool udm::Query::Evaluate(EvaluationContext &ctx, const Node &node, size_t stepIdx) const
+{
+	if(stepIdx >= m_steps.size())
+		return ctx.output(node);
+	auto &step = m_steps[stepIdx];
+	switch(step.kind) {
+	case Step::Kind::Child:
+		{
+			auto *el = get_element(node);
+			if(!el)
+				return true;
+			auto it = el->children.find(step.key);
+			if(it == el->children.end() || !it->second)
+				return true;
+			return Evaluate(ctx, Node {it->second.get(), nullptr, PathCursor::INVALID_INDEX, it->first}, stepIdx + 1);
+		}
+	case Step::Kind::Index:
+		{
+			auto *a = get_array(node);
+			if(!a || step.start >= a->GetSize())
+				return true;
+			return Evaluate(ctx, Node {nullptr, a, step.start}, stepIdx + 1);
+		}
+	case Step::Kind::AnyChild:
+		{
+			std::vector<Node> children;
+			get_children(node, children, false);
+			return EvaluateAll(ctx, children, stepIdx + 1, false);
+		}
+	case Step::Kind::Range:
+		{
+			auto *a = get_array(node);
+			if(!a)
+				return true;
+			auto end = pragma::math::min(step.end, a->GetSize());
+			std::vector<Node> items;
+			if(step.start < end)
+				items.reserve(end - step.start);
+			for(auto i = step.start; i < end; ++i)
+				items.push_back(Node {nullptr, a, i});
+			return EvaluateAll(ctx, items, stepIdx + 1, false);
+		}
+	case Step::Kind::Descendants:
+		return EvaluateDescendants(ctx, node, stepIdx + 1);
+	case Step::Kind::Predicate:
+		return Matches(node, step) ? Evaluate(ctx, node, stepIdx + 1) : true;
+	}
+	return true;
+}
+
+bool udm::Query::EvaluateDescendants(EvaluationContext &ctx, const Node &node, size_t stepIdx) const
+{
+	if(!Evaluate(ctx, node, stepIdx))
+		return false;
+	std::vector<Node> children;
+	get_children(node, children, true);
+	return EvaluateAll(ctx, children, stepIdx, true);
+}
+
+bool udm::Query::EvaluateAll(EvaluationContext &ctx, const std::vector<Node> &nodes, size_t stepIdx, bool descendants) const
+{
+	auto evaluate = [this, stepIdx, descendants](EvaluationContext &ctx, const Node &node) { return descendants ? EvaluateDescendants(ctx, node, stepIdx) : Evaluate(ctx, node, stepIdx); };
+	auto numNodes = static_cast<uint32_t>(nodes.size());
+	if(!ctx.parallel || numNodes < 2 || numNodes < ctx.minItemsPerTask) {
+		for(auto &node : nodes) {
+			if(!evaluate(ctx, node))
+				return false;
+		}
+		return true;
+	}
+	for(auto &node : nodes) {
+		if(node.array)
+			prepare_parallel_access(*node.array);
+		else if(node.prop)
+			prepare_parallel_access(*node.prop);
+	}
+	// Each chunk collects its results separately, they're passed on in order afterwards to keep the results in document order.
+	// Nested selectors may be evaluated in parallel as well.
+	std::vector<std::vector<Node>> chunkResults {};
+	chunkResults.resize(get_parallel_chunk_count(numNodes, ctx.minItemsPerTask));
+	parallel_for(
+	  numNodes,
+	  [&nodes, &chunkResults, &ctx, &evaluate](uint32_t chunkIdx, uint32_t start, uint32_t end) {
+		  auto &results = chunkResults[chunkIdx];
+		  EvaluationContext chunkCtx {[&results](const Node &node) {
+			                              results.push_back(node);
+			                              return true;
+		                              },
+		    true, ctx.minItemsPerTask};
+		  for(auto i = start; i < end; ++i)
+			  evaluate(chunkCtx, nodes[i]);
+	  },
+	  ctx.minItemsPerTask);
+	for(auto &results : chunkResults) {
+		for(auto &node : results) {
+			if(!ctx.output(node))
+				return false;
+		}
+	}
+	return true;
+}
+
+std::vector<udm::PropertyWrapper> udm::Query::Evaluate(const Node &root, bool parallel, uint32_t minItemsPerTask) const
+{
+	std::vector<PropertyWrapper> results;
+	if(!root.prop && !root.array)
+		return results;
+	EvaluationContext ctx {[&results](const Node &node) {
+		                       results.push_back(to_property_wrapper(node));
+		                       return true;
+	                       },
+	  parallel, minItemsPerTask};
+	Evaluate(ctx, root, 0);
+	return results;
+}
+std::vector<udm::PropertyWrapper> udm::Query::Evaluate(Property &root, bool parallel, uint32_t minItemsPerTask) const { return Evaluate(Node {&root}, parallel, minItemsPerTask); }
+std::vector<udm::PropertyWrapper> udm::Query::Evaluate(const PropertyWrapper &root, bool parallel, uint32_t minItemsPerTask) const { return Evaluate(to_node(root), parallel, minItemsPerTask); }
+
+void udm::Query::ForEach(const Node &root, const std::function<bool(const PropertyWrapper &)> &callback) const
+{
+	if(!root.prop && !root.array)
+		return;
+	EvaluationContext ctx {[&callback](const Node &node) { return callback(to_property_wrapper(node)); }};
+	Evaluate(ctx, root, 0);
+}
+void udm::Query::ForEach(Property &root, const std::function<bool(const PropertyWrapper &)> &callback) const { ForEach(Node {&root}, callback); }
+void udm::Query::ForEach(const PropertyWrapper &root, const std::function<bool(const PropertyWrapper &)> &callback) const { ForEach(to_node(root), callback); }
@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include <cassert>
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+// shared_ptr control block of a property created with Property::Create (reference counts, deleter and pointer)
+static constexpr uint64_t CONTROL_BLOCK_SIZE = sizeof(void *) * 2 + sizeof(uint32_t) * 2;
+// Hash map node (key-value pair, next pointer and cached hash)
+static constexpr uint64_t MAP_NODE_SIZE = sizeof(std::pair<const std::string, udm::PProperty>) + sizeof(void *) + sizeof(size_t);
+
+static uint64_t get_heap_size(const std::string &str)
+{
+	static const auto smallStringCapacity = std::string {}.capacity();
+	return (str.capacity() > smallStringCapacity) ? (str.capacity() + 1) : 0;
+}
+template<typename T>
+static uint64_t get_heap_size(const std::vector<T> &v)
+{
+	return v.capacity() * sizeof(T);
+}
+static uint64_t get_heap_size(const udm::StructDescription &strct)
+{
+	auto size = get_heap_size(strct.types) + get_heap_size(strct.names);
+	for(auto &name : strct.names)
+		size += get_heap_size(name);
+	return size;
+}
+
+struct udm::MemoryStatistics::Collector {
+	// Either an element key or an array index. The path of a subtree is only built if it is one of the largest subtrees.
+	struct PathSegment {
+		std::string_view key;
+		uint32_t index = 0;
+	};
+	Collector(MemoryStatistics &stats, uint32_t numLargestSubtrees) : stats {stats}, numLargestSubtrees {numLargestSubtrees} {}
+	uint64_t Collect(const Property &prop, bool multipleOwners);
+	void CollectChildren(const Element &el);
+	void CollectArray(const Array &a, uint64_t &outDataBytes);
+	void CollectValue(Type type, const void *value, bool includeObjectSize);
+	void AddSubtree(uint64_t size);
+	void BuildPath(std::string &outPath) const;
+
+	MemoryStatistics &stats;
+	uint32_t numLargestSubtrees = 0;
+	uint32_t depth = 0;
+	std::vector<PathSegment> path;
+	// Properties with multiple owners and values shared between properties (see MergeFlags::CopyOnWrite) are only counted once
+	std::unordered_set<const void *> visited;
+};
+
+uint64_t udm::MemoryStatistics::Collector::Collect(const Property &prop, bool multipleOwners)
+{
+	if(multipleOwners && !visited.insert(&prop).second)
+		return 0;
+	auto startSize = stats.GetTotalSize();
+	++stats.typeCounts[pragma::math::to_integral(prop.type)];
+	stats.maxDepth = std::max(stats.maxDepth, depth);
+	stats.nodeBytes += sizeof(Property) + CONTROL_BLOCK_SIZE;
+	if(!prop.IsShared() || visited.insert(prop.value).second)
+		CollectValue(prop.type, prop.value, true);
+	return stats.GetTotalSize() - startSize;
+}
+
+void udm::MemoryStatistics::Collector::BuildPath(std::string &outPath) const
+{
+	outPath.clear();
+	for(auto &segment : path) {
+		if(segment.key.empty()) {
+			outPath += '[' + std::to_string(segment.index) + ']';
+			continue;
+		}
+		if(!outPath.empty())
+			outPath += PATH_SEPARATOR;
+		// Same escape sequence as LinkedPropertyWrapper::GetPath
+		for(auto c : segment.key) {
+			if(c == PATH_SEPARATOR)
+				outPath += '\\';
+			outPath += c;
+		}
+	}
+}
+
+void udm::MemoryStatistics::Collector::AddSubtree(uint64_t size)
+{
+	if(numLargestSubtrees == 0)
+		return;
+	// largestSubtrees is a min-heap while collecting, so the smallest candidate can be replaced quickly
+	auto &subtrees = stats.largestSubtrees;
+	auto cmp = [](const Subtree &a, const Subtree &b) { return a.size > b.size; };
+	if(subtrees.size() < numLargestSubtrees) {
+		subtrees.push_back({{}, size});
+		BuildPath(subtrees.back().path);
+		std::push_heap(subtrees.begin(), subtrees.end(), cmp);
+		return;
+	}
+	if(size <= subtrees.front().size)
+		return;
+	std::pop_heap(subtrees.begin(), subtrees.end(), cmp);
+	BuildPath(subtrees.back().path);
+	subtrees.back().size = size;
+	std::push_heap(subtrees.begin(), subtrees.end(), cmp);
+}
+
+void udm::MemoryStatistics::Collector::CollectChildren(const Element &el)
+{
+	stats.nodeBytes += el.children.bucket_count() * sizeof(void *);
+	++depth;
+	for(auto &[key, child] : el.children) {
+		stats.nodeBytes += MAP_NODE_SIZE;
+		stats.keyBytes += get_heap_size(key);
+		if(!child)
+			continue;
+		path.push_back({key});
+		AddSubtree(Collect(*child, child.use_count() > 1));
+		path.pop_back();
+	}
+	--depth;
+}
+
+void udm::MemoryStatistics::Collector::CollectArray(const Array &a, uint64_t &outDataBytes)
+{
+	auto *values = a.GetValuePtr();
+	if(!values)
+		return; // Compressed
+	auto valueType = a.GetValueType();
+	auto size = a.GetSize();
+	if(valueType == Type::Struct) {
+		outDataBytes += a.GetHeaderSize() + a.GetByteSize();
+		auto *strct = a.GetStructuredDataInfo();
+		if(strct)
+			outDataBytes += sizeof(StructDescription) + get_heap_size(*strct);
+		return;
+	}
+	auto valueSize = size_of_base_type(valueType);
+	outDataBytes += size * valueSize;
+	if(!is_non_trivial_type(valueType))
+		return;
+	++depth;
+	for(auto i = decltype(size) {0u}; i < size; ++i) {
+		auto *value = static_cast<const uint8_t *>(values) + i * valueSize;
+		if(valueType != Type::Element) {
+			CollectValue(valueType, value, false);
+			continue;
+		}
+		auto startSize = stats.GetTotalSize();
+		++stats.typeCounts[pragma::math::to_integral(valueType)];
+		stats.maxDepth = std::max(stats.maxDepth, depth);
+		path.push_back({{}, i});
+		CollectChildren(*reinterpret_cast<const Element *>(value));
+		AddSubtree(stats.GetTotalSize() - startSize + valueSize);
+		path.pop_back();
+	}
+	--depth;
+}
+
+void udm::MemoryStatistics::Collector::CollectValue(Type type, const void *value, bool includeObjectSize)
+{
+	if(!value)
+		return;
+	if(is_trivial_type(type)) {
+		stats.trivialBytes += size_of_base_type(type);
+		return;
+	}
+	auto objectSize = includeObjectSize ? size_of_base_type(type) : 0;
+	switch(type) {
+	case Type::String:
+		stats.stringBytes += objectSize + get_heap_size(*static_cast<const String *>(value));
+		break;
+	case Type::Utf8String:
+		stats.stringBytes += objectSize + get_heap_size(static_cast<const Utf8String *>(value)->data);
+		break;
+	case Type::Reference:
+		stats.stringBytes += objectSize + get_heap_size(static_cast<const Reference *>(value)->path);
+		break;
+	case Type::Blob:
+		stats.blobBytes += objectSize + get_heap_size(static_cast<const Blob *>(value)->data);
+		break;
+	case Type::BlobLz4:
+		stats.blobBytes += objectSize + get_heap_size(static_cast<const BlobLz4 *>(value)->compressedData);
+		break;
+	case Type::Struct:
+		{
+			auto &strct = *static_cast<const Struct *>(value);
+			stats.structBytes += objectSize + get_heap_size(strct.data) + get_heap_size(strct.description);
+			break;
+		}
+	case Type::Element:
+		stats.nodeBytes += objectSize;
+		CollectChildren(*static_cast<const Element *>(value));
+		break;
+	case Type::Array:
+		stats.nodeBytes += objectSize;
+		CollectArray(*static_cast<const Array *>(value), stats.arrayBytes);
+		break;
+	case Type::ArrayLz4:
+		{
+			// Only the data that is currently held is counted, GetCompressedBlob would compress the array and release the decompressed values
+			auto &a = *static_cast<const ArrayLz4 *>(value);
+			stats.nodeBytes += objectSize;
+			CollectArray(a, stats.lz4DecompressedBytes);
+			stats.lz4CompressedBytes += get_heap_size(a.m_compressedBlob.compressedData);
+			break;
+		}
+	default:
+		break;
+	}
+	static_assert(pragma::math::to_integral(Type::Count) == 36, "Update this list when new types are added!");
+}
+
+udm::MemoryStatistics udm::MemoryStatistics::Calculate(const Property &prop, uint32_t numLargestSubtrees)
+{
+	MemoryStatistics stats {};
+	stats.largestSubtrees.reserve(numLargestSubtrees);
+	Collector collector {stats, numLargestSubtrees};
+	collector.Collect(prop, false);
+	std::sort(stats.largestSubtrees.begin(), stats.largestSubtrees.end(), [](const Subtree &a, const Subtree &b) { return a.size > b.size; });
+	return stats;
+}
+
+udm::MemoryStatistics udm::MemoryStatistics::Calculate(const Element &el, uint32_t numLargestSubtrees)
+{
+	MemoryStatistics stats {};
+	stats.largestSubtrees.reserve(numLargestSubtrees);
+	Collector collector {stats, numLargestSubtrees};
+	++stats.typeCounts[pragma::math::to_integral(Type::Element)];
+	stats.nodeBytes += sizeof(Element);
+	collector.CollectChildren(el);
+	std::sort(stats.largestSubtrees.begin(), stats.largestSubtrees.end(), [](const Subtree &a, const Subtree &b) { return a.size > b.size; });
+	return stats;
+}
+
+uint64_t udm::MemoryStatistics::GetTotalSize() const { return nodeBytes + keyBytes + trivialBytes + stringBytes + structBytes + arrayBytes + lz4CompressedBytes + lz4DecompressedBytes + blobBytes; }
+uint64_t udm::MemoryStatistics::GetTypeCount(Type type) const
+{
+	auto idx = pragma::math::to_integral(type);
+	return (idx < typeCounts.size()) ? typeCounts[idx] : 0;
+}
+uint64_t udm::MemoryStatistics::GetNodeCount() const
+{
+	uint64_t count = 0;
+	for(auto n : typeCounts)
+		count += n;
+	return count;
+}
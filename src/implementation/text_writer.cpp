@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+module pragma.udm;
+
+#ifndef UDM_SINGLE_MODULE_INTERFACE
+import :core;
+#endif
+
+udm::TextBuffer::TextBuffer(IFile &f) : m_file {&f}, m_buffer {std::make_unique<char[]>(BUFFER_SIZE)} {}
+udm::TextBuffer::TextBuffer(std::stringstream &ss) : m_stream {&ss}, m_buffer {std::make_unique<char[]>(BUFFER_SIZE)} {}
+udm::TextBuffer::TextBuffer(std::string &outStr) : m_string {&outStr}, m_buffer {std::make_unique<char[]>(BUFFER_SIZE)} {}
+udm::TextBuffer::~TextBuffer() { Flush(); }
+void udm::TextBuffer::WriteToSink(const char *data, size_t size)
+{
+	if(m_file)
+		m_file->Write(data, size);
+	else if(m_stream)
+		m_stream->write(data, size);
+	else
+		m_string->append(data, size);
+	m_numFlushed += size;
+}
+void udm::TextBuffer::Flush()
+{
+	if(m_size == 0)
+		return;
+	WriteToSink(m_buffer.get(), m_size);
+	m_size = 0;
+}
+void udm::TextBuffer::Write(const std::string_view &str)
+{
+	if(m_size + str.size() > BUFFER_SIZE) {
+		Flush();
+		if(str.size() > BUFFER_SIZE) {
+			WriteToSink(str.data(), str.size());
+			return;
+		}
+	}
+	memcpy(m_buffer.get() + m_size, str.data(), str.size());
+	m_size += str.size();
+}
+void udm::TextBuffer::Write(char c)
+{
+	if(m_size == BUFFER_SIZE)
+		Flush();
+	m_buffer[m_size++] = c;
+}
+void udm::TextBuffer::WriteBase64(const void *data, size_t size)
+{
+	// Encode in chunks that are a multiple of 3 bytes so that no padding is inserted in between
+	auto *in = static_cast<const uint8_t *>(data);
+	while(size > 0) {
+		if(BUFFER_SIZE - m_size < 4)
+			Flush();
+		auto chunkSize = std::min(size, ((BUFFER_SIZE - m_size) / 4) * 3);
+		base64_encode(in, chunkSize, m_buffer.get() + m_size);
+		m_size += base64_get_encoded_size(chunkSize);
+		in += chunkSize;
+		size -= chunkSize;
+	}
+}
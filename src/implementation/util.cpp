@@ -133,6 +133,22 @@ udm::StructDescription::SizeType udm::StructDescription::GetDataSizeRequirement(
 		size += size_of(type);
 	return size;
 }
+udm::StructDescription::SizeType udm::StructDescription::GetMemberOffset(MemberCountType idx) const
+{
+	if(idx >= types.size())
+		throw OutOfBoundsError {"Struct member index " + std::to_string(idx) + " out of bounds of struct with " + std::to_string(types.size()) + " members!"};
+	SizeType offset = 0;
+	for(auto i = decltype(idx) {0u}; i < idx; ++i)
+		offset += size_of(types[i]);
+	return offset;
+}
+std::optional<udm::StructDescription::MemberCountType> udm::StructDescription::FindMember(const std::string_view &name) const
+{
+	auto it = std::find(names.begin(), names.end(), name);
+	if(it == names.end())
+		return {};
+	return static_cast<MemberCountType>(it - names.begin());
+}
 
 //////////////
 
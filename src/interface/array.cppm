@@ -16,6 +16,80 @@ import :structure;
 
 export {
 	namespace udm {
+		// View over values with a fixed byte distance between them (e.g. a single member of all items of a struct array)
+		template<typename T>
+		class StridedSpan {
+		  public:
+			using value_type = std::remove_cv_t<T>;
+			using BytePtr = std::conditional_t<std::is_const_v<T>, const uint8_t *, uint8_t *>;
+			class Iterator {
+			  public:
+				using iterator_category = std::random_access_iterator_tag;
+				using value_type = StridedSpan::value_type;
+				using difference_type = std::ptrdiff_t;
+				using pointer = T *;
+				using reference = T &;
+
+				Iterator() = default;
+				Iterator(BytePtr ptr, size_t stride) : m_ptr {ptr}, m_stride {stride} {}
+				reference operator*() const { return *reinterpret_cast<T *>(m_ptr); }
+				pointer operator->() const { return reinterpret_cast<T *>(m_ptr); }
+				reference operator[](difference_type n) const { return *reinterpret_cast<T *>(m_ptr + n * static_cast<difference_type>(m_stride)); }
+				Iterator &operator++()
+				{
+					m_ptr += m_stride;
+					return *this;
+				}
+				Iterator operator++(int)
+				{
+					auto it = *this;
+					m_ptr += m_stride;
+					return it;
+				}
+				Iterator &operator--()
+				{
+					m_ptr -= m_stride;
+					return *this;
+				}
+				Iterator operator--(int)
+				{
+					auto it = *this;
+					m_ptr -= m_stride;
+					return it;
+				}
+				Iterator &operator+=(difference_type n)
+				{
+					m_ptr += n * static_cast<difference_type>(m_stride);
+					return *this;
+				}
+				Iterator &operator-=(difference_type n) { return operator+=(-n); }
+				Iterator operator+(difference_type n) const { return Iterator {*this} += n; }
+				Iterator operator-(difference_type n) const { return Iterator {*this} -= n; }
+				friend Iterator operator+(difference_type n, const Iterator &it) { return it + n; }
+				difference_type operator-(const Iterator &other) const { return (m_stride > 0) ? (m_ptr - other.m_ptr) / static_cast<difference_type>(m_stride) : 0; }
+				bool operator==(const Iterator &other) const { return m_ptr == other.m_ptr; }
+				auto operator<=>(const Iterator &other) const { return m_ptr <=> other.m_ptr; }
+			  private:
+				BytePtr m_ptr = nullptr;
+				size_t m_stride = 0;
+			};
+
+			StridedSpan() = default;
+			StridedSpan(BytePtr data, size_t size, size_t stride) : m_data {data}, m_size {size}, m_stride {stride} {}
+			T &operator[](size_t idx) const { return *reinterpret_cast<T *>(m_data + idx * m_stride); }
+			size_t size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+			// Distance between two values in bytes
+			size_t stride() const { return m_stride; }
+			BytePtr data() const { return m_data; }
+			Iterator begin() const { return Iterator {m_data, m_stride}; }
+			Iterator end() const { return Iterator {m_data + m_size * m_stride, m_stride}; }
+		  private:
+			BytePtr m_data = nullptr;
+			size_t m_size = 0;
+			size_t m_stride = 0;
+		};
+
 		struct DLLUDM Array {
 			virtual ~Array();
 			PropertyWrapper fromProperty {};
@@ -34,28 +108,34 @@ export {
 			Type GetValueType() const { return m_valueType; }
 			uint32_t GetSize() const { return m_size; }
 			uint32_t GetValueSize() const;
-			virtual void *GetValues() { return GetValuePtr(); }
-			const void *GetValues() const { return const_cast<Array *>(this)->GetValues(); }
+			// Note: Non-const accessors un-share the array if it is shared with other properties (see Property::Unshare)
+			void *GetValues()
+			{
+				PrepareWrite();
+				return LoadValues();
+			}
+			const void *GetValues() const { return const_cast<Array *>(this)->LoadValues(); }
 			void Resize(uint32_t newSize);
 			void AddValueRange(uint32_t startIndex, uint32_t count);
 			void RemoveValueRange(uint32_t startIndex, uint32_t count);
 			void *GetValuePtr(uint32_t idx);
+			const void *GetValuePtr(uint32_t idx) const;
 			template<typename T>
 			T *GetValuePtr(uint32_t idx);
 			template<typename T>
-			const T *GetValuePtr(uint32_t idx) const
-			{
-				return const_cast<Array *>(this)->GetValuePtr<T>(idx);
-			}
+			const T *GetValuePtr(uint32_t idx) const;
 			PropertyWrapper operator[](uint32_t idx);
-			const PropertyWrapper operator[](uint32_t idx) const { return const_cast<Array *>(this)->operator[](idx); }
+			const PropertyWrapper operator[](uint32_t idx) const;
 			template<typename T>
 			T &GetValue(uint32_t idx);
 			template<typename T>
-			const T &GetValue(uint32_t idx) const
-			{
-				return const_cast<Array *>(this)->GetValue<T>(idx);
-			}
+			const T &GetValue(uint32_t idx) const;
+			// Non-throwing alternative to GetValue, the returned pointer is never nullptr on success. If the values have to be decompressed
+			// or un-shared and that fails, InvalidProperty is returned.
+			template<typename T>
+			std::expected<T *, AccessError> TryGetValue(uint32_t idx) noexcept;
+			template<typename T>
+			std::expected<const T *, AccessError> TryGetValue(uint32_t idx) const noexcept;
 			template<typename T>
 			void SetValue(uint32_t idx, T &&value);
 			template<typename T>
@@ -74,7 +154,7 @@ export {
 			template<typename T>
 			const T *GetFront() const
 			{
-				return const_cast<Array *>(this)->GetFront<T>();
+				return !IsEmpty() ? GetValuePtr<T>(0u) : nullptr;
 			}
 			template<typename T>
 			T *GetBack()
@@ -84,7 +164,7 @@ export {
 			template<typename T>
 			const T *GetBack() const
 			{
-				return const_cast<Array *>(this)->GetBack<T>();
+				return !IsEmpty() ? GetValuePtr<T>(m_size - 1) : nullptr;
 			}
 
 			template<typename T>
@@ -102,22 +182,80 @@ export {
 
 			using Range = std::tuple<uint32_t, uint32_t, uint32_t>;
 			void Resize(uint32_t newSize, Range r0, Range r1, bool defaultInitializeNewValues);
+
+			// Takes ownership of the vector's buffer without copying. Only supported for uncompressed arrays of trivial types.
+			template<typename T>
+			void AdoptValues(std::vector<T> &&values);
+			// Takes ownership of an external buffer of 'size' values of type 'valueType', which will be released with 'deleter'.
+			void AdoptValues(Type valueType, void *values, uint32_t size, std::function<void(void *)> deleter);
+			// References an external buffer without taking ownership. The caller has to ensure the buffer outlives the array
+			// (or until the array is cleared or resized, which will copy the data into internal storage).
+			void BorrowValues(Type valueType, void *values, uint32_t size);
+			// Same as above, but the buffer is never written to: The values are copied into internal storage before the array is modified
+			// for the first time, which makes it possible to borrow read-only memory (e.g. a MappedFile).
+			void BorrowValues(Type valueType, const void *values, uint32_t size);
+			// Moves the values into 'outValues' and clears the array. The buffer is moved without copying if it was adopted from a
+			// std::vector<T>, otherwise the values are copied. Returns false if T does not match the value type of the array.
+			template<typename T>
+			bool ReleaseValues(std::vector<T> &outValues);
+			bool HasExternalValues() const { return m_storage != Storage::Internal; }
+
+			// Returns a contiguous view over all values. T can either be the value type of the array, or, for struct arrays,
+			// a trivially copyable type with the same size as the struct. Compressed arrays are decompressed once.
+			// The view is invalidated if the array is resized, cleared or compressed. Throws a LogicError if T doesn't match the value type.
+			template<typename T>
+			std::span<T> AsSpan();
+			template<typename T>
+			std::span<const T> AsSpan() const;
+			// Non-throwing alternative to AsSpan (see TryGetValue)
+			template<typename T>
+			std::expected<std::span<T>, AccessError> TryAsSpan() noexcept;
+			template<typename T>
+			std::expected<std::span<const T>, AccessError> TryAsSpan() const noexcept;
+			// Returns a view over a single member of all items of a struct array. T has to match the member type.
+			template<typename T>
+			StridedSpan<T> GetStructMemberSpan(StructDescription::MemberCountType memberIdx);
+			template<typename T>
+			StridedSpan<T> GetStructMemberSpan(const std::string_view &memberName);
+			template<typename T>
+			StridedSpan<const T> GetStructMemberSpan(StructDescription::MemberCountType memberIdx) const;
+			template<typename T>
+			StridedSpan<const T> GetStructMemberSpan(const std::string_view &memberName) const;
+			bool IsBorrowed() const { return m_storage == Storage::Borrowed || m_storage == Storage::BorrowedReadOnly; }
 		  protected:
 			friend Property;
 			friend PropertyWrapper;
+			friend MemoryStatistics;
 			virtual void Clear();
+			// Returns the values without un-sharing them, compressed arrays are decompressed
+			virtual void *LoadValues() { return GetValuePtr(); }
+			// Un-shares the property owning this array before it is modified and copies read-only borrowed values into internal storage.
+			// 'discardValues' can be set if the caller replaces the values, in which case they're not copied.
+			void PrepareWrite(bool discardValues = false);
 
 			void *GetValuePtr();
 			const void *GetValuePtr() const { return const_cast<Array *>(this)->GetValuePtr(); }
+			[[noreturn]] void ThrowAccessError(AccessError err, uint32_t idx, Type requestedType) const;
 			void *GetHeaderPtr();
 			const void *GetHeaderPtr() const { return const_cast<Array *>(this)->GetHeaderPtr(); }
 			uint64_t GetHeaderSize() const;
 			void ReleaseValues();
 			uint8_t *AllocateData(uint64_t size) const;
 
+			enum class Storage : uint8_t {
+				Internal = 0,     // Allocated with AllocateData
+				Vector,           // Adopted from a std::vector, owned by m_externalValues
+				External,         // Adopted buffer with custom deleter, owned by m_externalValues
+				Borrowed,         // Not owned
+				BorrowedReadOnly, // Not owned, copied into internal storage before the array is modified
+			};
+			void SetExternalValues(Type valueType, void *values, uint32_t size, std::shared_ptr<void> owner, Storage storage);
+
 			void *m_values = nullptr;
 			uint32_t m_size = 0;
 			Type m_valueType = Type::Nil;
+			Storage m_storage = Storage::Internal;
+			std::shared_ptr<void> m_externalValues = nullptr;
 		};
 
 		struct DLLUDM ArrayLz4 : public Array {
@@ -134,7 +272,6 @@ export {
 			ArrayLz4 &operator=(const ArrayLz4 &other);
 			const BlobLz4 &GetCompressedBlob() const { return const_cast<ArrayLz4 *>(this)->GetCompressedBlob(); }
 			BlobLz4 &GetCompressedBlob();
-			virtual void *GetValues() override;
 			virtual void SetValueType(Type valueType) override;
 			virtual ArrayType GetArrayType() const override { return ArrayType::Compressed; }
 			void ClearUncompressedMemory();
@@ -146,7 +283,12 @@ export {
 			friend Property;
 			friend PropertyWrapper;
 			friend AsciiReader;
+			friend FrozenDataBuilder;
+			friend MemoryStatistics;
 			virtual StructDescription *GetStructuredDataInfo() override;
+			virtual void *LoadValues() override;
+			// Copies the compressed data of the other array without decompressing it, returns false if it isn't compressed
+			bool CopyCompressed(const ArrayLz4 &other);
 			void InitializeSize(uint32_t size);
 			void Decompress();
 			void Compress();
@@ -165,21 +307,222 @@ export {
 				return nullptr;
 			return &GetValue<T>(idx);
 		}
+		template<typename T>
+		const T *Array::GetValuePtr(uint32_t idx) const
+		{
+			if(type_to_enum<T>() != m_valueType)
+				return nullptr;
+			return &GetValue<T>(idx);
+		}
 
 		template<typename T>
 		T &Array::GetValue(uint32_t idx)
+		{
+			auto res = TryGetValue<T>(idx);
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), idx, type_to_enum<std::remove_cv_t<std::remove_reference_t<T>>>());
+			return **res;
+		}
+		template<typename T>
+		const T &Array::GetValue(uint32_t idx) const
+		{
+			auto res = TryGetValue<T>(idx);
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), idx, type_to_enum<std::remove_cv_t<std::remove_reference_t<T>>>());
+			return **res;
+		}
+
+		template<typename T>
+		std::expected<T *, AccessError> Array::TryGetValue(uint32_t idx) noexcept
+		{
+			// Has to be called before the values are retrieved, since read-only borrowed values are moved into internal storage
+			try {
+				PrepareWrite();
+			}
+			catch(...) {
+				return std::unexpected {AccessError::InvalidProperty};
+			}
+			auto res = static_cast<const Array *>(this)->TryGetValue<T>(idx);
+			if(!res)
+				return std::unexpected {res.error()};
+			return const_cast<T *>(*res);
+		}
+		template<typename T>
+		std::expected<const T *, AccessError> Array::TryGetValue(uint32_t idx) const noexcept
 		{
 			if(idx >= m_size)
-				throw OutOfBoundsError {"Array index " + std::to_string(idx) + " out of bounds of array of size " + std::to_string(m_size) + "!"};
+				return std::unexpected {AccessError::OutOfBounds};
 			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
-			auto vs = [this, idx](auto tag) -> T & {
-				using TTag = typename decltype(tag)::type;
-				if constexpr(std::is_same_v<TTag, TBase>)
-					return static_cast<TTag *>(GetValues())[idx];
-				throw LogicError {"Attempted to retrieve value of type " + std::string {magic_enum::enum_name(type_to_enum<T>())} + " from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
-			};
-			auto valueType = GetValueType();
-			return visit(valueType, vs);
+			if(type_to_enum<TBase>() != GetValueType())
+				return std::unexpected {AccessError::TypeMismatch};
+			const TBase *values = nullptr;
+			try {
+				values = static_cast<const TBase *>(GetValues());
+			}
+			catch(...) {
+				// The values couldn't be decompressed
+			}
+			if(!values)
+				return std::unexpected {AccessError::InvalidProperty};
+			return &values[idx];
+		}
+
+		template<typename T>
+		std::span<T> Array::AsSpan()
+		{
+			if constexpr(!std::is_const_v<T>)
+				PrepareWrite(); // See TryGetValue
+			auto span = static_cast<const Array *>(this)->AsSpan<T>();
+			return std::span<T> {const_cast<T *>(span.data()), span.size()};
+		}
+		template<typename T>
+		std::span<const T> Array::AsSpan() const
+		{
+			using TBase = std::remove_cv_t<T>;
+			constexpr auto type = type_to_enum_s<TBase>();
+			if constexpr(type == Type::Invalid) {
+				static_assert(std::is_trivially_copyable_v<TBase>, "Custom span types have to be trivially copyable!");
+				if(m_valueType != Type::Struct)
+					throw LogicError {"Attempted to retrieve span of custom type from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
+				auto *values = GetValues(); // Has to be called before GetValueSize in case the array is compressed
+				if(GetValueSize() != sizeof(TBase))
+					throw LogicError {"Size of custom span type (" + std::to_string(sizeof(TBase)) + ") does not match size of struct (" + std::to_string(GetValueSize()) + ")!"};
+				return std::span<const T> {static_cast<const T *>(values), values ? m_size : 0};
+			}
+			else {
+				if(m_valueType != type)
+					throw LogicError {"Attempted to retrieve span of type " + std::string {magic_enum::enum_name(type)} + " from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
+				auto *values = GetValues();
+				return std::span<const T> {static_cast<const T *>(values), values ? m_size : 0};
+			}
+		}
+		template<typename T>
+		std::expected<std::span<T>, AccessError> Array::TryAsSpan() noexcept
+		{
+			if constexpr(!std::is_const_v<T>) {
+				try {
+					PrepareWrite(); // See TryGetValue
+				}
+				catch(...) {
+					return std::unexpected {AccessError::InvalidProperty};
+				}
+			}
+			auto span = static_cast<const Array *>(this)->TryAsSpan<T>();
+			if(!span)
+				return std::unexpected {span.error()};
+			return std::span<T> {const_cast<T *>(span->data()), span->size()};
+		}
+		template<typename T>
+		std::expected<std::span<const T>, AccessError> Array::TryAsSpan() const noexcept
+		{
+			using TBase = std::remove_cv_t<T>;
+			constexpr auto type = type_to_enum_s<TBase>();
+			if constexpr(type == Type::Invalid) {
+				static_assert(std::is_trivially_copyable_v<TBase>, "Custom span types have to be trivially copyable!");
+				if(m_valueType != Type::Struct)
+					return std::unexpected {AccessError::TypeMismatch};
+			}
+			else if(m_valueType != type)
+				return std::unexpected {AccessError::TypeMismatch};
+			const void *values = nullptr;
+			try {
+				values = GetValues();
+			}
+			catch(...) {
+				return std::unexpected {AccessError::InvalidProperty}; // The values couldn't be decompressed
+			}
+			if constexpr(type == Type::Invalid) {
+				// Has to be checked after the array has been decompressed
+				if(GetValueSize() != sizeof(TBase))
+					return std::unexpected {AccessError::TypeMismatch};
+			}
+			return std::span<const T> {static_cast<const T *>(values), values ? m_size : 0};
+		}
+
+		template<typename T>
+		StridedSpan<T> Array::GetStructMemberSpan(StructDescription::MemberCountType memberIdx)
+		{
+			if constexpr(!std::is_const_v<T>)
+				PrepareWrite(); // See TryGetValue
+			auto span = static_cast<const Array *>(this)->GetStructMemberSpan<T>(memberIdx);
+			return StridedSpan<T> {const_cast<typename StridedSpan<T>::BytePtr>(span.data()), span.size(), span.stride()};
+		}
+		template<typename T>
+		StridedSpan<const T> Array::GetStructMemberSpan(StructDescription::MemberCountType memberIdx) const
+		{
+			if(m_valueType != Type::Struct)
+				throw LogicError {"Attempted to retrieve struct member span from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
+			auto *values = static_cast<const uint8_t *>(GetValues());
+			auto *strct = GetStructuredDataInfo();
+			if(!strct)
+				throw ImplementationError {"Struct array has invalid structure data info!"};
+			if(memberIdx >= strct->types.size())
+				throw OutOfBoundsError {"Struct member index " + std::to_string(memberIdx) + " out of bounds of struct with " + std::to_string(strct->types.size()) + " members!"};
+			constexpr auto type = type_to_enum_s<std::remove_cv_t<T>>();
+			auto memberType = strct->types[memberIdx];
+			if(memberType != type)
+				throw LogicError {"Attempted to retrieve span of type " + std::string {magic_enum::enum_name(type)} + " for struct member of type " + std::string {magic_enum::enum_name(memberType)} + "!"};
+			if(!values)
+				return {};
+			return StridedSpan<const T> {values + strct->GetMemberOffset(memberIdx), m_size, strct->GetDataSizeRequirement()};
+		}
+
+		template<typename T>
+		StridedSpan<T> Array::GetStructMemberSpan(const std::string_view &memberName)
+		{
+			if constexpr(!std::is_const_v<T>)
+				PrepareWrite(); // See TryGetValue
+			auto span = static_cast<const Array *>(this)->GetStructMemberSpan<T>(memberName);
+			return StridedSpan<T> {const_cast<typename StridedSpan<T>::BytePtr>(span.data()), span.size(), span.stride()};
+		}
+		template<typename T>
+		StridedSpan<const T> Array::GetStructMemberSpan(const std::string_view &memberName) const
+		{
+			auto *strct = (m_valueType == Type::Struct) ? GetStructuredDataInfo() : nullptr;
+			auto memberIdx = strct ? strct->FindMember(memberName) : std::optional<StructDescription::MemberCountType> {};
+			if(!memberIdx.has_value())
+				throw LogicError {"Struct has no member '" + std::string {memberName} + "'!"};
+			return GetStructMemberSpan<T>(*memberIdx);
+		}
+
+		template<typename T>
+		void Array::AdoptValues(std::vector<T> &&values)
+		{
+			constexpr auto valueType = type_to_enum_s<T>();
+			static_assert(valueType != Type::Invalid && valueType != Type::Nil && is_trivial_type(valueType), "Only vectors of trivial types can be adopted!");
+			static_assert(!std::is_same_v<T, bool>, "std::vector<bool> does not have contiguous storage!");
+			if(values.size() > std::numeric_limits<uint32_t>::max())
+				throw OutOfBoundsError {"Vector size exceeds maximum array size!"};
+			auto size = static_cast<uint32_t>(values.size());
+			auto owner = std::make_shared<std::vector<T>>(std::move(values));
+			auto *data = owner->data();
+			SetExternalValues(valueType, data, size, std::move(owner), Storage::Vector);
+		}
+
+		template<typename T>
+		bool Array::ReleaseValues(std::vector<T> &outValues)
+		{
+			constexpr auto valueType = type_to_enum_s<T>();
+			if constexpr(valueType == Type::Invalid || !is_trivial_type(valueType))
+				return false;
+			else {
+				if(m_valueType != valueType)
+					return false;
+				PrepareWrite();
+				if(m_storage == Storage::Vector && m_externalValues.use_count() == 1) {
+					// The vector was adopted with the same value type (see AdoptValues), so it can be moved out directly
+					outValues = std::move(*static_cast<std::vector<T> *>(m_externalValues.get()));
+					Clear();
+					return true;
+				}
+				auto *values = static_cast<const T *>(GetValues());
+				if(values)
+					outValues.assign(values, values + m_size);
+				else
+					outValues.clear();
+				Clear();
+				return true;
+			}
 		}
 
 		template<typename T>
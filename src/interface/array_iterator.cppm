@@ -16,7 +16,7 @@ export {
 		template<typename T>
 		class ArrayIterator {
 		  public:
-			using iterator_category = std::forward_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
 			using value_type = T &;
 			using difference_type = std::ptrdiff_t;
 			using pointer = T *;
@@ -28,11 +28,23 @@ export {
 			ArrayIterator(const ArrayIterator &other);
 			ArrayIterator &operator++();
 			ArrayIterator operator++(int);
-			ArrayIterator operator+(uint32_t n);
+			ArrayIterator &operator--();
+			ArrayIterator operator--(int);
+			ArrayIterator &operator+=(difference_type n);
+			ArrayIterator &operator-=(difference_type n);
+			ArrayIterator operator+(difference_type n) const;
+			ArrayIterator operator-(difference_type n) const;
+			difference_type operator-(const ArrayIterator &other) const;
 			reference operator*();
 			pointer operator->();
+			reference operator[](difference_type n) const
+			    requires(!std::is_same_v<T, LinkedPropertyWrapper>);
 			bool operator==(const ArrayIterator &other) const;
 			bool operator!=(const ArrayIterator &other) const;
+			bool operator<(const ArrayIterator &other) const { return m_curProperty.arrayIndex < other.m_curProperty.arrayIndex; }
+			bool operator>(const ArrayIterator &other) const { return other < *this; }
+			bool operator<=(const ArrayIterator &other) const { return !(other < *this); }
+			bool operator>=(const ArrayIterator &other) const { return !(*this < other); }
 
 			LinkedPropertyWrapper &GetProperty() { return m_curProperty; }
 		  private:
@@ -75,14 +87,64 @@ export {
 		}
 
 		template<typename T>
-		ArrayIterator<T> ArrayIterator<T>::operator+(uint32_t n)
+		ArrayIterator<T> &ArrayIterator<T>::operator--()
+		{
+			--m_curProperty.arrayIndex;
+			return *this;
+		}
+
+		template<typename T>
+		ArrayIterator<T> ArrayIterator<T>::operator--(int)
+		{
+			auto it = *this;
+			it.operator--();
+			return it;
+		}
+
+		template<typename T>
+		ArrayIterator<T> &ArrayIterator<T>::operator+=(difference_type n)
+		{
+			m_curProperty.arrayIndex = static_cast<uint32_t>(static_cast<difference_type>(m_curProperty.arrayIndex) + n);
+			return *this;
+		}
+
+		template<typename T>
+		ArrayIterator<T> &ArrayIterator<T>::operator-=(difference_type n)
+		{
+			return operator+=(-n);
+		}
+
+		template<typename T>
+		ArrayIterator<T> ArrayIterator<T>::operator+(difference_type n) const
+		{
+			auto it = *this;
+			it += n;
+			return it;
+		}
+
+		template<typename T>
+		ArrayIterator<T> ArrayIterator<T>::operator-(difference_type n) const
 		{
 			auto it = *this;
-			for(auto i = decltype(n) {0u}; i < n; ++i)
-				it.operator++();
+			it -= n;
 			return it;
 		}
 
+		template<typename T>
+		typename ArrayIterator<T>::difference_type ArrayIterator<T>::operator-(const ArrayIterator &other) const
+		{
+			return static_cast<difference_type>(m_curProperty.arrayIndex) - static_cast<difference_type>(other.m_curProperty.arrayIndex);
+		}
+
+		template<typename T>
+		typename ArrayIterator<T>::reference ArrayIterator<T>::operator[](difference_type n) const
+		    requires(!std::is_same_v<T, LinkedPropertyWrapper>)
+		{
+			PropertyWrapper item {m_curProperty};
+			item.arrayIndex = static_cast<uint32_t>(static_cast<difference_type>(item.arrayIndex) + n);
+			return get_property_value<T>(item);
+		}
+
 		template<typename T>
 		typename ArrayIterator<T>::reference ArrayIterator<T>::operator*()
 		{
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:base64;
+
+export import std.compat;
+
+export {
+	namespace udm {
+		// Number of characters 'size' bytes are encoded to, including padding
+		constexpr size_t base64_get_encoded_size(size_t size) { return ((size + 2) / 3) * 4; }
+		// Upper bound for the number of bytes 'size' characters are decoded to
+		constexpr size_t base64_get_max_decoded_size(size_t size) { return ((size + 3) / 4) * 3; }
+
+		// Writes base64_get_encoded_size(size) characters to 'out'
+		DLLUDM void base64_encode(const void *data, size_t size, char *out);
+		DLLUDM std::string base64_encode(const void *data, size_t size);
+		// Decodes 'str' into 'out', which has to have room for at least base64_get_max_decoded_size(str.size()) bytes.
+		// Whitespace is ignored. Returns the number of bytes written, or std::nullopt if 'str' is not valid base64.
+		DLLUDM std::optional<size_t> base64_decode(const std::string_view &str, void *out);
+	}
+}
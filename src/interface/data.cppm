@@ -10,6 +10,9 @@ export module pragma.udm:data;
 export import :core;
 export import :enums;
 export import :file;
+import :frozen;
+export import :key;
+import :path_cache;
 import :property;
 export import :types;
 
@@ -29,8 +32,34 @@ export {
 			static std::shared_ptr<Data> Open(const std::string &fileName);
 			static std::shared_ptr<Data> Open(std::unique_ptr<IFile> &&f);
 			static std::shared_ptr<Data> Open(const pragma::filesystem::VFilePtr &f);
+			// Parses ASCII data in place, without copying the buffer first. The buffer only has to remain valid until the function returns.
+			static std::shared_ptr<Data> LoadAscii(const std::string_view &data);
+			// Memory-maps the file at the specified path and parses it in place. The path is a regular file system path, not a virtual one.
+			static std::shared_ptr<Data> LoadAsciiMapped(const std::string &systemPath);
+			// Converts between the binary and the ASCII format in a single pass, without building a property tree. Apart from the input buffer
+			// (and the positions of its blocks for ASCII input), memory usage only depends on the nesting depth and the size of the largest array
+			// that doesn't contain elements. The result is equivalent to loading the input and saving it in the other format. Binary input has
+			// to be seekable, since children are written in sorted order, and so does binary output, since block sizes are only known once the
+			// block has been written.
+			static void TranscodeToAscii(IFile &in, IFile &out, AsciiSaveFlags flags = AsciiSaveFlags::Default);
+			static void TranscodeToBinary(const std::string_view &ascii, IFile &out);
+			static void TranscodeToBinaryMapped(const std::string &systemPath, IFile &out);
+			// Parses JSON in place. Objects become elements, and arrays whose items are all numbers, booleans, strings, objects or arrays become
+			// typed arrays. Integers become Int32, or UInt64 (Int64 if any of them are negative) if they don't fit, other numbers Double, null
+			// becomes Nil. If the root object has no "assetData" key, the entire document becomes the asset data, otherwise "assetVersion" is
+			// read as UInt32.
+			// 'typeHints' overrides the type of the values at specific paths, i.e. keys starting at the root object separated by '/', without
+			// array indices. For arrays the hint is the value type, e.g. {"mesh/vertices", Type::Vector3} packs both [[x,y,z],...] and [x,y,z,...]
+			// into a Vector3 array. Numeric values can be hinted as any numeric type, strings as Reference, Utf8String or Blob (base64 data).
+			static std::shared_ptr<Data> LoadJson(const std::string_view &json, const KeyMap<Type> &typeHints = {});
 			static std::shared_ptr<Data> Create(const std::string &assetType, Version assetVersion);
 			static std::shared_ptr<Data> Create();
+			// By default the copy shares all properties with this instance until either of them is modified. Until then both have to be
+			// synchronized as one document, and references obtained from one of them may refer to the other's values once it is written to
+			// (see Property::Share).
+			std::shared_ptr<Data> Copy(MergeFlags mergeFlags = MergeFlags::CopyOnWrite) const;
+			// Creates an immutable copy of this data in a single contiguous buffer, which can be shared between threads
+			std::shared_ptr<const FrozenData> Freeze() const;
 			static bool DebugTest();
 
 			PProperty LoadProperty(const std::string_view &path) const;
@@ -49,7 +78,14 @@ export {
 			bool operator==(const Data &other) const;
 			bool operator!=(const Data &other) const { return !operator==(other); }
 
+			// Child of the asset data. Doesn't use the path cache, so lookups can be made concurrently (see PathCache).
 			LinkedPropertyWrapper operator[](const std::string &key) const;
+			// Resolves a path relative to the root element (see PathCursor::DownPath). If the path cache is enabled, the result is cached
+			// until the structure of the data changes.
+			PropertyWrapper ResolvePath(const std::string_view &path);
+			void SetPathCacheEnabled(bool enabled);
+			bool IsPathCacheEnabled() const { return m_pathCache != nullptr; }
+			const PathCache *GetPathCache() const { return m_pathCache.get(); }
 			Element *operator->();
 			const Element *operator->() const;
 			Element &operator*();
@@ -65,11 +101,19 @@ export {
 			const Header &GetHeader() const { return m_header; }
 
 			static std::string ReadKey(IFile &f);
-			static void WriteKey(IFile &f, const std::string &key);
+			static void WriteKey(IFile &f, const std::string_view &key);
 		  private:
 			friend AsciiReader;
+			friend AsciiWriter;
+			friend JsonReader;
 			friend ArrayLz4;
+			friend FrozenData;
+			// Wraps the root in an asset data element if it doesn't have one, then initializes the header from it
+			static std::shared_ptr<Data> CreateFromRootProperty(PProperty rootProp);
 			bool ValidateHeaderProperties();
+			// Throws an InvalidFormatError if the header is invalid
+			static Header ReadHeader(IFile &f);
+			void ToAscii(AsciiWriter &writer, AsciiSaveFlags flags) const;
 			static void SkipProperty(IFile &f, Type type);
 			PProperty LoadProperty(Type type, const std::string_view &path) const;
 			static PProperty ReadProperty(IFile &f);
@@ -78,6 +122,7 @@ export {
 			Header m_header;
 			std::unique_ptr<IFile> m_file = nullptr;
 			PProperty m_rootProperty = nullptr;
+			std::unique_ptr<PathCache> m_pathCache = nullptr;
 		};
 	}
 }
@@ -13,7 +13,7 @@ import :wrapper_funcs;
 export {
 	namespace udm {
 		struct DLLUDM ElementIteratorPair {
-			ElementIteratorPair(pragma::string::StringMap<PProperty>::iterator &it);
+			ElementIteratorPair(KeyMap<PProperty>::iterator &it);
 			ElementIteratorPair();
 			bool operator==(const ElementIteratorPair &other) const;
 			bool operator!=(const ElementIteratorPair &other) const;
@@ -31,7 +31,7 @@ export {
 
 			ElementIterator();
 			ElementIterator(Element &e);
-			ElementIterator(Element &e, pragma::string::StringMap<PProperty> &c, pragma::string::StringMap<PProperty>::iterator it);
+			ElementIterator(Element &e, KeyMap<PProperty> &c, KeyMap<PProperty>::iterator it);
 			ElementIterator(const ElementIterator &other);
 			ElementIterator &operator++();
 			ElementIterator operator++(int);
@@ -40,8 +40,8 @@ export {
 			bool operator==(const ElementIterator &other) const;
 			bool operator!=(const ElementIterator &other) const;
 		  private:
-			pragma::string::StringMap<PProperty> *m_propertyMap = nullptr;
-			pragma::string::StringMap<PProperty>::iterator m_iterator {};
+			KeyMap<PProperty> *m_propertyMap = nullptr;
+			KeyMap<PProperty>::iterator m_iterator {};
 			ElementIteratorPair m_pair;
 		};
 
@@ -54,21 +54,32 @@ export {
 		};
 
 		struct DLLUDM Element {
+			Element() = default;
+			~Element();
 			void AddChild(std::string &&key, const PProperty &o);
 			void AddChild(const std::string &key, const PProperty &o);
 			void Copy(const Element &other);
-			pragma::string::StringMap<PProperty> children;
+			KeyMap<PProperty> children;
 			PropertyWrapper fromProperty {};
 			PropertyWrapper parentProperty {};
 
 			LinkedPropertyWrapper operator[](const std::string &key) { return fromProperty[key]; }
-			LinkedPropertyWrapper operator[](const char *key) { return operator[](std::string {key}); }
+			LinkedPropertyWrapper operator[](const char *key) { return fromProperty[key]; }
+			LinkedPropertyWrapper operator[](const Key &key) { return fromProperty[key]; }
 
 			LinkedPropertyWrapper Add(const std::string_view &path, Type type = Type::Element, bool pathToElements = false);
 			LinkedPropertyWrapper AddArray(const std::string_view &path, std::optional<uint32_t> size = {}, Type type = Type::Element, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false);
+			// Same as above, but the key is never treated as a path
+			LinkedPropertyWrapper Add(const Key &key, Type type = Type::Element);
+			LinkedPropertyWrapper AddArray(const Key &key, std::optional<uint32_t> size = {}, Type type = Type::Element, ArrayType arrayType = ArrayType::Raw);
 			void ToAscii(AsciiSaveFlags flags, std::stringstream &ss, const std::optional<std::string> &prefix = {}) const;
 
 			void Merge(const Element &other, MergeFlags mergeFlags = MergeFlags::OverwriteExisting);
+			// Makes sure the value of the child isn't shared with other properties (see Property::Unshare) and returns it
+			Property *UnshareChild(const std::string_view &key);
+			// Returns the key of the specified child, or nullptr if it's not a child of this element.
+			// Note: Properties that are removed from the children map directly have to be detached (see Property::parent) first.
+			const std::string *FindKey(const Property &child) const;
 
 			bool operator==(const Element &other) const;
 			bool operator!=(const Element &other) const { return !operator==(other); }
@@ -81,21 +92,32 @@ export {
 			ElementIterator end();
 		  private:
 			friend void erase_element_child(Element &e, Element &child);
+			friend void remove_element_child(Element &e, const std::string_view &key);
 			template<typename T>
 			friend void set_element_value(Element &parent, Element &child, T &&v);
 
 			template<typename T>
 			void SetValue(Element &child, T &&v);
 			void EraseValue(const Element &child);
+			void EraseValue(const std::string_view &key);
+			void EraseValue(KeyMap<PProperty>::iterator it);
+			KeyMap<PProperty>::iterator FindChild(const Element &child);
+			// Resets the parent of all children owned by this element
+			void DetachChildren();
+			// Un-shares the property owning this element before it is modified
+			void PrepareWrite();
+			// Returns the child with the specified key, or adds it if it doesn't exist. If 'replaceMismatchingType' is true, an existing child of a different type is replaced.
+			Property &FindOrAddChild(const Key &key, Type type, bool replaceMismatchingType);
+			void InitializeArray(Property &prop, std::optional<uint32_t> size, Type type);
 		};
 
 		template<typename T>
 		void Element::SetValue(Element &child, T &&v)
 		{
-			auto it = std::find_if(children.begin(), children.end(), [&child](const std::pair<std::string, PProperty> &pair) { return get_property_type(*pair.second) == Type::Element && get_property_value(*pair.second) == &child; });
+			auto it = FindChild(child);
 			if(it == children.end())
 				return;
-			children[it->first] = create_property<T>(std::forward<T>(v));
+			AddChild(it->first, create_property<T>(std::forward<T>(v)));
 		}
 	}
 }
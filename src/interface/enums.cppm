@@ -74,10 +74,19 @@ export {
 			InvalidProperty,
 		};
 
+		// Error codes of the non-throwing accessors (TryGetValue, TryIndex, etc.)
+		enum class AccessError : uint8_t {
+			InvalidProperty = 0,
+			TypeMismatch,
+			OutOfBounds,
+			NotFound,
+		};
+
 		enum class MergeFlags : uint32_t {
 			None = 0u,
 			OverwriteExisting = 1u,
 			DeepCopy = OverwriteExisting << 1u,
+			CopyOnWrite = DeepCopy << 1u, // Properties are shared until they are written to, ignored if DeepCopy is set
 		};
 
 		enum class FormatType : uint8_t {
@@ -92,6 +101,11 @@ export {
 			Default = None,
 		};
 
+		enum class JsonFormat : uint8_t {
+			Compact = 0, // No whitespace
+			Pretty,      // Line breaks and tab indentation for elements and element arrays
+		};
+
 		constexpr const char *enum_type_to_ascii(Type t)
 		{
 			// Note: These have to match ascii_type_to_enum
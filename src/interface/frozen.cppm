@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:frozen;
+
+export import :conversion;
+export import :core;
+export import :enums;
+export import :types;
+
+export {
+	namespace udm {
+		// Immutable representation of a property tree, stored in a single contiguous buffer.
+		// All offsets are relative to the start of the buffer.
+#pragma pack(push, 1)
+		struct FrozenNode {
+			uint64_t offset = 0; // Offset to the value, child table (elements) or item table (arrays of non-trivial types)
+			uint32_t size = 0;   // Number of children or array items, or number of bytes for strings and blobs
+			Type type = Type::Nil;
+			Type valueType = Type::Nil; // Arrays only
+			ArrayType arrayType = ArrayType::Raw;
+			uint8_t reserved = 0;
+		};
+		struct FrozenChild {
+			uint64_t keyOffset = 0;
+			uint32_t keyLength = 0;
+			uint32_t reserved = 0;
+			FrozenNode node {};
+		};
+		struct FrozenStruct {
+			uint64_t dataOffset = 0;
+			uint32_t dataSize = 0; // Size of a single struct value
+			uint16_t memberCount = 0;
+			uint16_t reserved = 0;
+			// Followed by FrozenStructMember[memberCount]
+		};
+		struct FrozenStructMember {
+			uint64_t nameOffset = 0;
+			uint32_t nameLength = 0;
+			Type type = Type::Nil;
+			std::array<uint8_t, 3> reserved {};
+		};
+#pragma pack(pop)
+		static_assert(sizeof(FrozenNode) == 16 && sizeof(FrozenChild) == 32 && sizeof(FrozenStruct) == 16 && sizeof(FrozenStructMember) == 16);
+
+		class FrozenData;
+		// Lightweight read-only view of a value within a FrozenData buffer. Only valid as long as the FrozenData instance exists.
+		class DLLUDM FrozenProperty {
+		  public:
+			FrozenProperty() = default;
+			FrozenProperty(const uint8_t *data, const FrozenNode *node) : m_data {data}, m_node {node} {}
+
+			Type GetType() const { return m_node ? m_node->type : Type::Nil; }
+			bool IsType(Type type) const { return GetType() == type; }
+			Type GetValueType() const { return m_node ? m_node->valueType : Type::Nil; }
+			ArrayType GetArrayType() const { return m_node ? m_node->arrayType : ArrayType::Raw; }
+			// Number of children for elements, number of items for arrays
+			uint32_t GetSize() const;
+
+			// Element children are sorted by key
+			std::string_view GetKey(uint32_t idx) const;
+			FrozenProperty GetChild(uint32_t idx) const;
+			FrozenProperty operator[](const std::string_view &key) const;
+			FrozenProperty operator[](const char *key) const { return operator[](std::string_view {key}); }
+			FrozenProperty operator[](uint32_t idx) const;
+			FrozenProperty GetFromPath(const std::string_view &path) const;
+
+			// Returns nullptr if the property is not of type T, T has to be a trivial type
+			template<typename T>
+			const T *GetValuePtr() const;
+			template<typename T>
+			std::optional<T> ToValue() const;
+			template<typename T>
+			T ToValue(const T &defaultValue) const;
+			template<typename T>
+			T operator()(const T &defaultValue) const
+			{
+				return ToValue<T>(defaultValue);
+			}
+
+			// String, Utf8String and Reference values
+			std::string_view GetString() const;
+			// Blob, BlobLz4 (compressed), Utf8String and Struct values
+			std::span<const uint8_t> GetBlobData() const;
+			// Arrays of trivial types
+			template<typename T>
+			std::span<const T> GetArray() const;
+
+			PProperty Thaw() const;
+
+			explicit operator bool() const { return m_node != nullptr; }
+		  private:
+			friend FrozenData;
+			template<typename T>
+			const T *GetData(uint64_t offset) const
+			{
+				return reinterpret_cast<const T *>(m_data + offset);
+			}
+			std::string_view GetString(uint64_t offset, uint32_t len) const { return std::string_view {reinterpret_cast<const char *>(m_data) + offset, len}; }
+			const void *GetPayload() const { return m_data + m_node->offset; }
+			void ThawValue(void *outValue) const;
+			void ThawStruct(StructDescription &outDesc) const;
+
+			const uint8_t *m_data = nullptr;
+			const FrozenNode *m_node = nullptr;
+		};
+
+		class DLLUDM FrozenData {
+		  public:
+			static std::shared_ptr<const FrozenData> Create(const Property &root, const Header &header = {});
+			FrozenData(const FrozenData &) = delete;
+			FrozenData &operator=(const FrozenData &) = delete;
+
+			FrozenProperty GetRoot() const { return FrozenProperty {m_buffer.get(), reinterpret_cast<const FrozenNode *>(m_buffer.get())}; }
+			FrozenProperty operator[](const std::string_view &key) const { return GetRoot()[key]; }
+			FrozenProperty GetFromPath(const std::string_view &path) const { return GetRoot().GetFromPath(path); }
+			FrozenProperty GetAssetData() const;
+			const Header &GetHeader() const { return m_header; }
+			// Size of the buffer in bytes
+			size_t GetSize() const { return m_size; }
+
+			std::shared_ptr<Data> Thaw() const;
+		  private:
+			FrozenData() = default;
+			std::unique_ptr<uint8_t[]> m_buffer = nullptr;
+			size_t m_size = 0;
+			Header m_header {};
+		};
+
+		template<typename T>
+		const T *FrozenProperty::GetValuePtr() const
+		{
+			constexpr auto type = type_to_enum_s<T>();
+			if constexpr(type == Type::Invalid || !is_trivial_type(type))
+				return nullptr;
+			else {
+				if(!m_node || m_node->type != type)
+					return nullptr;
+				return static_cast<const T *>(GetPayload());
+			}
+		}
+
+		template<typename T>
+		std::optional<T> FrozenProperty::ToValue() const
+		{
+			if(!m_node)
+				return {};
+			auto vs = [&](auto tag) -> std::optional<T> {
+				using TTag = typename decltype(tag)::type;
+				if constexpr(is_trivial_type(type_to_enum<TTag>())) {
+					if constexpr(is_convertible<TTag, T>())
+						return convert<TTag, T>(*static_cast<const TTag *>(GetPayload()));
+				}
+				else if constexpr(std::is_same_v<TTag, String>) {
+					if constexpr(is_convertible<TTag, T>())
+						return convert<TTag, T>(String {GetString()});
+				}
+				return {};
+			};
+			return visit(m_node->type, vs);
+		}
+
+		template<typename T>
+		T FrozenProperty::ToValue(const T &defaultValue) const
+		{
+			auto val = ToValue<T>();
+			return val.has_value() ? *val : defaultValue;
+		}
+
+		template<typename T>
+		std::span<const T> FrozenProperty::GetArray() const
+		{
+			constexpr auto type = type_to_enum_s<T>();
+			if constexpr(type == Type::Invalid || !is_trivial_type(type))
+				return {};
+			else {
+				if(!m_node || !is_array_type(m_node->type) || m_node->valueType != type)
+					return {};
+				return std::span<const T> {static_cast<const T *>(GetPayload()), m_node->size};
+			}
+		}
+	}
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:key;
+
+export import std.compat;
+
+export {
+	namespace udm {
+		// FNV-1a, used for the keys of element children
+		constexpr size_t hash_key(const std::string_view &key)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for(auto c : key) {
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return static_cast<size_t>(hash);
+		}
+
+		// Child key with a precomputed hash. Keys that are used frequently should be created once and then reused, e.g.:
+		// static constexpr udm::Key KEY_POSITION {"position"};
+		// auto pos = el[KEY_POSITION];
+		// The key refers to the string it was created from, it does not copy it.
+		struct Key {
+			constexpr Key() : Key {std::string_view {}} {}
+			constexpr explicit Key(const std::string_view &str) : str {str}, hash {hash_key(str)} {}
+			constexpr explicit Key(const char *str) : Key {std::string_view {str}} {}
+			explicit Key(const std::string &str) : Key {std::string_view {str}} {}
+			std::string_view str;
+			size_t hash = 0;
+		};
+
+		struct KeyHash {
+			using is_transparent = void;
+			size_t operator()(const std::string_view &key) const { return hash_key(key); }
+			size_t operator()(const std::string &key) const { return hash_key(key); }
+			size_t operator()(const char *key) const { return hash_key(key); }
+			size_t operator()(const Key &key) const { return key.hash; }
+		};
+
+		struct KeyEqual {
+			using is_transparent = void;
+			static std::string_view ToString(const std::string_view &key) { return key; }
+			static std::string_view ToString(const Key &key) { return key.str; }
+			template<typename T0, typename T1>
+			bool operator()(const T0 &a, const T1 &b) const
+			{
+				return ToString(a) == ToString(b);
+			}
+		};
+
+		// Map with heterogeneous lookup for std::string, std::string_view, const char* and Key
+		template<typename T>
+		using KeyMap = std::unordered_map<std::string, T, KeyHash, KeyEqual>;
+	}
+}
@@ -1,5 +1,5 @@
 // GENERATED by merge_cppm.py on 2025-12-13T20:29:56.252214 // UTC
-// Merged 24 partition files
+// Merged 36 partition files
 
 module;
 
@@ -190,10 +190,19 @@ export {
 			InvalidProperty,
 		};
 
+		// Error codes of the non-throwing accessors (TryGetValue, TryIndex, etc.)
+		enum class AccessError : uint8_t {
+			InvalidProperty = 0,
+			TypeMismatch,
+			OutOfBounds,
+			NotFound,
+		};
+
 		enum class MergeFlags : uint32_t {
 			None = 0u,
 			OverwriteExisting = 1u,
 			DeepCopy = OverwriteExisting << 1u,
+			CopyOnWrite = DeepCopy << 1u, // Properties are shared until they are written to, ignored if DeepCopy is set
 		};
 
 		enum class FormatType : uint8_t {
@@ -208,6 +217,11 @@ export {
 			Default = None,
 		};
 
+		enum class JsonFormat : uint8_t {
+			Compact = 0, // No whitespace
+			Pretty,      // Line breaks and tab indentation for elements and element arrays
+		};
+
 		constexpr const char *enum_type_to_ascii(Type t)
 		{
 			// Note: These have to match ascii_type_to_enum
@@ -499,12 +513,18 @@ export {
 		struct Element;
 		struct ElementIteratorPair;
 		class AsciiReader;
+		class AsciiWriter;
+		class JsonReader;
 		struct ArrayLz4;
 		struct AssetData;
 		using AssetDataArg = const AssetData &;
 		enum class FormatType : uint8_t;
 		enum class AsciiSaveFlags : uint32_t;
 		class Data;
+		struct MemoryStatistics;
+		class FrozenData;
+		class FrozenProperty;
+		class FrozenDataBuilder;
 		using Hash = std::array<uint8_t, sizeof(uint32_t) * 4>;
 	};
 }
@@ -1596,6 +1616,9 @@ export {
 			std::string GetTemplateArgumentList() const;
 			SizeType GetDataSizeRequirement() const;
 			MemberCountType GetMemberCount() const;
+			// Byte offset of the member within the struct data
+			SizeType GetMemberOffset(MemberCountType idx) const;
+			std::optional<MemberCountType> FindMember(const std::string_view &name) const;
 
 			// TODO: Use these once C++20 is available
 			// bool operator==(const Struct&) const=default;
@@ -1749,6 +1772,8 @@ export namespace udm {
 	template<typename T>
 	T *get_property_value_ptr(Property &prop);
 	template<typename T>
+	const T *get_property_value_ptr(const Property &prop);
+	template<typename T>
 	std::optional<T> to_property_value(Property &prop);
 
 	// Any struct or class that isn't a UDM type is assumed to be a struct type
@@ -1783,6 +1808,8 @@ export namespace udm {
 	T &get_array_value(Array &a, uint32_t idx);
 	template<typename T>
 	T *get_array_value_ptr(Array &a, uint32_t idx);
+	template<typename T>
+	const T *get_array_value_ptr(const Array &a, uint32_t idx);
 
 	uint16_t get_array_structured_data_info_data_size_requirement(Array &a);
 	// Since we can't know all struct types ahead of time, we handle them separately
@@ -1803,6 +1830,10 @@ export namespace udm {
 	uint32_t get_array_value_size(const Array &a);
 	uint32_t get_array_size(const Array &a);
 	void *get_array_values(Array &a);
+	const void *get_array_values(const Array &a);
+	// Returns an empty span if T doesn't match the value type
+	template<typename T>
+	std::span<T> get_array_span(Array &a);
 	bool is_array_value_type(const Array &a, Type pvalueType);
 
 	template<typename T>
@@ -1813,6 +1844,7 @@ export namespace udm {
 	void get_array_end_iterator(Array &a, ArrayIterator<T> &outIt);
 
 	PProperty *find_element_child(Element &e, const std::string_view &key);
+	const PProperty *find_element_child(const Element &e, const std::string_view &key);
 	void remove_element_child(Element &e, const std::string_view &key);
 	void erase_element_child(Element &e, Element &child);
 	void set_element_child_value(Element &e, const std::string_view &key, const PProperty &prop);
@@ -1859,6 +1891,75 @@ export namespace udm {
 
 // --- END PARTITION: src/interface/wrapper_funcs.cppm ---
 
+// --- BEGIN PARTITION: src/interface/key.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:key;
+
+export import std.compat;
+*/
+
+// --- START BODY: src/interface/key.cppm ---
+
+export {
+	namespace udm {
+		// FNV-1a, used for the keys of element children
+		constexpr size_t hash_key(const std::string_view &key)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for(auto c : key) {
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return static_cast<size_t>(hash);
+		}
+
+		// Child key with a precomputed hash. Keys that are used frequently should be created once and then reused, e.g.:
+		// static constexpr udm::Key KEY_POSITION {"position"};
+		// auto pos = el[KEY_POSITION];
+		// The key refers to the string it was created from, it does not copy it.
+		struct Key {
+			constexpr Key() : Key {std::string_view {}} {}
+			constexpr explicit Key(const std::string_view &str) : str {str}, hash {hash_key(str)} {}
+			constexpr explicit Key(const char *str) : Key {std::string_view {str}} {}
+			explicit Key(const std::string &str) : Key {std::string_view {str}} {}
+			std::string_view str;
+			size_t hash = 0;
+		};
+
+		struct KeyHash {
+			using is_transparent = void;
+			size_t operator()(const std::string_view &key) const { return hash_key(key); }
+			size_t operator()(const std::string &key) const { return hash_key(key); }
+			size_t operator()(const char *key) const { return hash_key(key); }
+			size_t operator()(const Key &key) const { return key.hash; }
+		};
+
+		struct KeyEqual {
+			using is_transparent = void;
+			static std::string_view ToString(const std::string_view &key) { return key; }
+			static std::string_view ToString(const Key &key) { return key.str; }
+			template<typename T0, typename T1>
+			bool operator()(const T0 &a, const T1 &b) const
+			{
+				return ToString(a) == ToString(b);
+			}
+		};
+
+		// Map with heterogeneous lookup for std::string, std::string_view, const char* and Key
+		template<typename T>
+		using KeyMap = std::unordered_map<std::string, T, KeyHash, KeyEqual>;
+	}
+}
+
+// --- END PARTITION: src/interface/key.cppm ---
+
 // --- BEGIN PARTITION: src/interface/property_wrapper.cppm ---
 /*
 // SPDX-FileCopyrightText: © 2021 Silverlan <opensource@pragma-engine.com>
@@ -1872,6 +1973,7 @@ export module pragma.udm:property_wrapper;
 
 import :conversion;
 export import :enums;
+export import :key;
 export import :trivial_types;
 export import :types;
 import :wrapper_funcs;
@@ -1911,6 +2013,9 @@ export {
 			LinkedPropertyWrapper AddArray(const std::string_view &path, const StructDescription &strct, const std::vector<T> &values, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false) const;
 			template<typename T>
 			LinkedPropertyWrapper AddArray(const std::string_view &path, const std::vector<T> &values, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false) const;
+			// Takes ownership of the vector's buffer without copying if T is a trivial type and the array is uncompressed
+			template<typename T>
+			LinkedPropertyWrapper AddArray(const std::string_view &path, std::vector<T> &&values, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false) const;
 			template<typename T>
 			LinkedPropertyWrapper AddArray(const std::string_view &path, uint32_t size, const T *data, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false) const;
 			bool IsArrayItem() const;
@@ -1925,11 +2030,26 @@ export {
 			Blob GetBlobData(Type &outType) const;
 			template<class T>
 			BlobResult GetBlobData(T &v) const;
+			// Note: The value accessors un-share all values along the path (see Property::Unshare), use GetConstValuePtr or
+			// TryGetConstValue if the value is only read
 			template<typename T>
 			T &GetValue() const;
 			template<typename T>
 			T *GetValuePtr() const;
+			template<typename T>
+			const T *GetConstValuePtr() const;
 			void *GetValuePtr(Type &outType) const;
+			// Non-throwing accessors for optional values. Instead of throwing, they return an AccessError if the key or index doesn't exist
+			// or the type doesn't match. On success the returned pointer is never nullptr. If a value has to be decompressed or un-shared
+			// and that fails, InvalidProperty is returned.
+			template<typename T>
+			std::expected<T *, AccessError> TryGetValue() const noexcept;
+			template<typename T>
+			std::expected<const T *, AccessError> TryGetConstValue() const noexcept;
+			std::expected<PropertyWrapper, AccessError> TryIndex(uint32_t idx) const noexcept;
+			std::expected<PropertyWrapper, AccessError> TryGetChild(const Key &key) const noexcept;
+			// Same path syntax as GetFromPath (see for_each_path_segment)
+			std::expected<PropertyWrapper, AccessError> TryGetFromPath(const std::string_view &path) const noexcept;
 			template<typename T>
 			T ToValue(const T &defaultValue, bool *optOutIsDefined = nullptr) const;
 			template<typename T>
@@ -1969,7 +2089,7 @@ export {
 				}
 				else if constexpr(std::is_enum_v<TBase>) {
 					using TEnum = TBase;
-					auto *ptr = GetValuePtr<std::string>();
+					auto *ptr = GetConstValuePtr<std::string>();
 					if(ptr) {
 						auto e = magic_enum::enum_cast<TEnum>(*ptr);
 						if(!e.has_value())
@@ -1994,7 +2114,7 @@ export {
 					return true;
 				}
 				else {
-					auto *ptr = GetValuePtr<T>();
+					auto *ptr = GetConstValuePtr<T>();
 					if(ptr) {
 						valOut = *ptr;
 						return true;
@@ -2012,6 +2132,9 @@ export {
 			ArrayIterator<T> begin() const;
 			template<typename T>
 			ArrayIterator<T> end() const;
+			// Contiguous view over all array values, see Array::AsSpan. Returns an empty span if this is not an array or T doesn't match the value type.
+			template<typename T>
+			std::span<T> AsSpan() const;
 			ArrayIterator<LinkedPropertyWrapper> begin() const;
 			ArrayIterator<LinkedPropertyWrapper> end() const;
 			LinkedPropertyWrapper operator[](uint32_t idx) const;
@@ -2025,10 +2148,12 @@ export {
 			uint32_t GetChildCount() const;
 			//
 
+			// Path syntax as described in for_each_path_segment, e.g. a/b[2]/"c d". Returns an invalid wrapper if the path is malformed.
 			LinkedPropertyWrapper GetFromPath(const std::string_view &key) const;
 			LinkedPropertyWrapper operator[](const std::string_view &key) const;
 			LinkedPropertyWrapper operator[](const std::string &key) const;
 			LinkedPropertyWrapper operator[](const char *key) const;
+			LinkedPropertyWrapper operator[](const Key &key) const;
 			bool operator==(const PropertyWrapper &other) const;
 			bool operator!=(const PropertyWrapper &other) const;
 			template<typename T>
@@ -2048,6 +2173,9 @@ export {
 			const LinkedPropertyWrapper *GetLinked() const { return const_cast<PropertyWrapper *>(this)->GetLinked(); };
 		  protected:
 			bool IsArrayItem(bool includeIfElementOfArrayItem) const;
+			[[noreturn]] void ThrowAccessError(AccessError err, Type requestedType) const;
+			// Un-shares the values of all properties along the path, from the top down
+			void UnsharePath() const;
 			bool linked = false;
 		};
 
@@ -2084,15 +2212,21 @@ export {
 			LinkedPropertyWrapper operator[](const std::string_view &key) const;
 			LinkedPropertyWrapper operator[](const std::string &key) const;
 			LinkedPropertyWrapper operator[](const char *key) const;
+			LinkedPropertyWrapper operator[](const Key &key) const;
 
 			std::string GetPath() const;
 			PProperty ClaimOwnership() const;
+			// Returns true if the property (or one of its parents) is shared with other properties (see MergeFlags::CopyOnWrite)
+			bool IsShared() const;
+			// Copies all shared properties along the path to this property, so it can safely be written to
+			void Unshare();
 			ElementIteratorWrapper ElIt();
 			std::unique_ptr<LinkedPropertyWrapper> prev = nullptr;
 			std::string propName;
 
 			// For internal use only!
 			void InitializeProperty(Type type = Type::Element, bool getOnly = false);
+			void AppendPath(std::string &outPath) const;
 			Property *GetProperty(std::vector<uint32_t> *optOutArrayIndices = nullptr) const;
 		};
 
@@ -2173,6 +2307,7 @@ export {
 		{
 			if(prop == nullptr)
 				throw LogicError {"Cannot assign property value: Property is invalid!"};
+			UnsharePath();
 			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
 			if constexpr(pragma::util::is_specialization<TBase, std::optional>::value) {
 				// Value is std::optional
@@ -2339,6 +2474,20 @@ export {
 			return AddArray<T>(path, values.size(), values.data(), arrayType, pathToElements);
 		}
 
+		template<typename T>
+		LinkedPropertyWrapper PropertyWrapper::AddArray(const std::string_view &path, std::vector<T> &&values, ArrayType arrayType, bool pathToElements) const
+		{
+			constexpr auto valueType = type_to_enum<T>();
+			if constexpr(is_trivial_type(valueType) && valueType != Type::Nil && !std::is_same_v<T, bool>) {
+				if(arrayType == ArrayType::Raw) {
+					auto prop = AddArray(path, 0u, valueType, arrayType, pathToElements);
+					prop.template GetValue<Array>().AdoptValues(std::move(values));
+					return prop;
+				}
+			}
+			return AddArray<T>(path, static_cast<const std::vector<T> &>(values), arrayType, pathToElements);
+		}
+
 		template<typename T>
 		LinkedPropertyWrapper PropertyWrapper::AddArray(const std::string_view &path, uint32_t size, const T *data, ArrayType arrayType, bool pathToElements) const
 		{
@@ -2372,8 +2521,8 @@ export {
 				return result;
 			if(IsArrayItem(true)) {
 				if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
-					auto &a = get_property_value<Array>(*prop);
-					auto *el = get_array_value_ptr<Element>(a, arrayIndex);
+					auto *a = get_property_value_ptr<Array>(std::as_const(*prop));
+					auto *el = a ? get_array_value_ptr<Element>(*a, arrayIndex) : nullptr;
 					if(!el)
 						return BlobResult::InvalidProperty;
 					auto *child = find_element_child(*el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
@@ -2388,44 +2537,97 @@ export {
 		template<typename T>
 		T &PropertyWrapper::GetValue() const
 		{
+			auto res = TryGetValue<T>();
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), type_to_enum<T>());
+			return **res;
+		}
+
+		template<typename T>
+		std::expected<T *, AccessError> PropertyWrapper::TryGetValue() const noexcept
+		{
+			auto res = TryGetConstValue<T>();
+			if(!res)
+				return std::unexpected {res.error()};
+			try {
+				UnsharePath(); // The values are kept by the properties along the path, so the pointer remains valid
+			}
+			catch(...) {
+				return std::unexpected {AccessError::InvalidProperty};
+			}
+			return const_cast<T *>(*res);
+		}
+
+		template<typename T>
+		std::expected<const T *, AccessError> PropertyWrapper::TryGetConstValue() const noexcept
+		{
+			if(!prop)
+				return std::unexpected {AccessError::InvalidProperty};
+			const T *ptr = nullptr;
 			if(arrayIndex != std::numeric_limits<uint32_t>::max()) {
-				auto *a = get_property_value_ptr<Array>(*prop);
+				auto *a = get_property_value_ptr<Array>(std::as_const(*prop));
 				if(a) {
+					if(arrayIndex >= get_array_size(*a))
+						return std::unexpected {AccessError::OutOfBounds};
+					const void *values = nullptr;
+					try {
+						values = get_array_values(*a);
+					}
+					catch(...) {
+						// The values couldn't be decompressed
+					}
+					if(!values)
+						return std::unexpected {AccessError::InvalidProperty};
 					if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
-						auto &el = const_cast<Element &>(get_array_value<Element>(*a, arrayIndex));
-						auto &propName = static_cast<const LinkedPropertyWrapper &>(*this).propName;
-						auto *child = find_element_child(el, propName);
+						auto *el = get_array_value_ptr<Element>(*a, arrayIndex);
+						if(!el)
+							return std::unexpected {AccessError::TypeMismatch};
+						auto *child = find_element_child(*el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
 						if(!child)
-							throw LogicError {"Attempted to retrieve value of property '" + propName + "' from array element at index " + std::to_string(arrayIndex) + ", but property does not exist!"};
-						return get_property_value<T>(**child);
+							return std::unexpected {AccessError::NotFound};
+						ptr = get_property_value_ptr<T>(std::as_const(**child));
 					}
-					if(is_array_value_type(*a, type_to_enum<T>()) == false)
-						throw LogicError {"Type mismatch, requested type is " + std::string {magic_enum::enum_name(type_to_enum<T>())} + ", but actual type is " + std::string {magic_enum::enum_name(get_array_value_type(*a))} + "!"};
-					return static_cast<T *>(get_array_values(*a))[arrayIndex];
+					else if(is_array_value_type(*a, type_to_enum<T>()))
+						ptr = &static_cast<const T *>(values)[arrayIndex];
+					if(!ptr)
+						return std::unexpected {AccessError::TypeMismatch};
+					return ptr;
 				}
 			}
-			return get_property_value<T>(**this);
+			ptr = get_property_value_ptr<T>(std::as_const(*prop));
+			if(!ptr)
+				return std::unexpected {AccessError::TypeMismatch};
+			return ptr;
 		}
 
 		template<typename T>
 		T *PropertyWrapper::GetValuePtr() const
+		{
+			auto *ptr = GetConstValuePtr<T>();
+			if(ptr)
+				UnsharePath(); // The values are kept by the properties along the path, so the pointer remains valid
+			return const_cast<T *>(ptr);
+		}
+
+		template<typename T>
+		const T *PropertyWrapper::GetConstValuePtr() const
 		{
 			if(arrayIndex != std::numeric_limits<uint32_t>::max()) {
-				auto *a = get_property_value_ptr<Array>(*prop);
+				auto *a = get_property_value_ptr<Array>(std::as_const(*prop));
 				if(a) {
 					if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
-						auto &el = get_array_value<Element>(*a, arrayIndex);
-						auto *child = find_element_child(el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
+						auto *el = get_array_value_ptr<Element>(*a, arrayIndex);
+						auto *child = el ? find_element_child(*el, static_cast<const LinkedPropertyWrapper &>(*this).propName) : nullptr;
 						if(!child)
 							return nullptr;
-						return get_property_value_ptr<T>(**child);
+						return get_property_value_ptr<T>(std::as_const(**child));
 					}
 					if(is_array_value_type(*a, type_to_enum<T>()) == false)
 						return nullptr;
-					return &static_cast<T *>(get_array_values(*a))[arrayIndex];
+					return &static_cast<const T *>(get_array_values(*a))[arrayIndex];
 				}
 			}
-			return prop ? get_property_value_ptr<T>(**this) : nullptr;
+			return prop ? get_property_value_ptr<T>(std::as_const(*prop)) : nullptr;
 		}
 
 		template<typename T>
@@ -2454,7 +2656,7 @@ export {
 			if constexpr(pragma::util::is_c_string<T>())
 				return operator==(std::string {other});
 			else {
-				auto *val = GetValuePtr<T>();
+				auto *val = GetConstValuePtr<T>();
 				if(val)
 					return *val == other;
 				auto valConv = ToValue<T>();
@@ -2468,7 +2670,8 @@ export {
 		{
 			if(!static_cast<bool>(*this))
 				return ArrayIterator<T> {};
-			auto *a = GetValuePtr<Array>();
+			// Values are un-shared once they're accessed through the iterator
+			auto *a = const_cast<Array *>(GetConstValuePtr<Array>());
 			if(a == nullptr)
 				return ArrayIterator<T> {};
 			ArrayIterator<T> it;
@@ -2478,11 +2681,29 @@ export {
 			return it;
 		}
 		template<typename T>
+		std::span<T> PropertyWrapper::AsSpan() const
+		{
+			if(!static_cast<bool>(*this))
+				return {};
+			auto *a = const_cast<Array *>(GetConstValuePtr<Array>());
+			if(a == nullptr)
+				return {};
+			auto span = get_array_span<const T>(*a);
+			if(span.empty())
+				return {};
+			if constexpr(std::is_const_v<T>)
+				return span;
+			else {
+				UnsharePath(); // Values may be modified through the span, the array keeps its values
+				return get_array_span<T>(*a); // Retrieved again, read-only borrowed values are moved into internal storage
+			}
+		}
+		template<typename T>
 		ArrayIterator<T> PropertyWrapper::end() const
 		{
 			if(!static_cast<bool>(*this))
 				return ArrayIterator<T> {};
-			auto *a = GetValuePtr<Array>();
+			auto *a = const_cast<Array *>(GetConstValuePtr<Array>());
 			if(a == nullptr)
 				return ArrayIterator<T> {};
 			ArrayIterator<T> it;
@@ -2496,20 +2717,27 @@ export {
 			if(!this) // This can happen in chained expressions. TODO: This is technically undefined behavior and should be implemented differently!
 				return {};
 			if(IsArrayItem(true)) {
-				auto &a = get_property_value<Array>(*prop);
+				auto *a = get_property_value_ptr<Array>(std::as_const(*prop));
+				if(!a)
+					return {};
 				if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
-					auto &el = get_array_value<Element>(a, arrayIndex);
-					auto *child = find_element_child(el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
+					auto *el = get_array_value_ptr<Element>(*a, arrayIndex);
+					auto *child = el ? find_element_child(*el, static_cast<const LinkedPropertyWrapper &>(*this).propName) : nullptr;
 					if(!child)
 						return {};
 					return to_property_value<T>(**child);
 				}
 				auto vs = [&](auto tag) -> std::optional<T> {
-					if constexpr(is_convertible<typename decltype(tag)::type, T>())
-						return std::optional<T> {convert<typename decltype(tag)::type, T>(const_cast<PropertyWrapper *>(this)->GetValue<typename decltype(tag)::type>())};
+					using TTag = typename decltype(tag)::type;
+					if constexpr(is_convertible<TTag, T>()) {
+						auto res = TryGetConstValue<TTag>();
+						if(!res) [[unlikely]]
+							ThrowAccessError(res.error(), type_to_enum<TTag>());
+						return std::optional<T> {convert<TTag, T>(**res)};
+					}
 					return {};
 				};
-				auto valueType = get_array_value_type(a);
+				auto valueType = get_array_value_type(*a);
 				return visit(valueType, vs);
 			}
 			if(prop)
@@ -2544,7 +2772,7 @@ export {
 		template<typename T>
 		class ArrayIterator {
 		  public:
-			using iterator_category = std::forward_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
 			using value_type = T &;
 			using difference_type = std::ptrdiff_t;
 			using pointer = T *;
@@ -2556,11 +2784,23 @@ export {
 			ArrayIterator(const ArrayIterator &other);
 			ArrayIterator &operator++();
 			ArrayIterator operator++(int);
-			ArrayIterator operator+(uint32_t n);
+			ArrayIterator &operator--();
+			ArrayIterator operator--(int);
+			ArrayIterator &operator+=(difference_type n);
+			ArrayIterator &operator-=(difference_type n);
+			ArrayIterator operator+(difference_type n) const;
+			ArrayIterator operator-(difference_type n) const;
+			difference_type operator-(const ArrayIterator &other) const;
 			reference operator*();
 			pointer operator->();
+			reference operator[](difference_type n) const
+			    requires(!std::is_same_v<T, LinkedPropertyWrapper>);
 			bool operator==(const ArrayIterator &other) const;
 			bool operator!=(const ArrayIterator &other) const;
+			bool operator<(const ArrayIterator &other) const { return m_curProperty.arrayIndex < other.m_curProperty.arrayIndex; }
+			bool operator>(const ArrayIterator &other) const { return other < *this; }
+			bool operator<=(const ArrayIterator &other) const { return !(other < *this); }
+			bool operator>=(const ArrayIterator &other) const { return !(*this < other); }
 
 			LinkedPropertyWrapper &GetProperty() { return m_curProperty; }
 		  private:
@@ -2603,14 +2843,64 @@ export {
 		}
 
 		template<typename T>
-		ArrayIterator<T> ArrayIterator<T>::operator+(uint32_t n)
+		ArrayIterator<T> &ArrayIterator<T>::operator--()
+		{
+			--m_curProperty.arrayIndex;
+			return *this;
+		}
+
+		template<typename T>
+		ArrayIterator<T> ArrayIterator<T>::operator--(int)
+		{
+			auto it = *this;
+			it.operator--();
+			return it;
+		}
+
+		template<typename T>
+		ArrayIterator<T> &ArrayIterator<T>::operator+=(difference_type n)
+		{
+			m_curProperty.arrayIndex = static_cast<uint32_t>(static_cast<difference_type>(m_curProperty.arrayIndex) + n);
+			return *this;
+		}
+
+		template<typename T>
+		ArrayIterator<T> &ArrayIterator<T>::operator-=(difference_type n)
+		{
+			return operator+=(-n);
+		}
+
+		template<typename T>
+		ArrayIterator<T> ArrayIterator<T>::operator+(difference_type n) const
+		{
+			auto it = *this;
+			it += n;
+			return it;
+		}
+
+		template<typename T>
+		ArrayIterator<T> ArrayIterator<T>::operator-(difference_type n) const
 		{
 			auto it = *this;
-			for(auto i = decltype(n) {0u}; i < n; ++i)
-				it.operator++();
+			it -= n;
 			return it;
 		}
 
+		template<typename T>
+		typename ArrayIterator<T>::difference_type ArrayIterator<T>::operator-(const ArrayIterator &other) const
+		{
+			return static_cast<difference_type>(m_curProperty.arrayIndex) - static_cast<difference_type>(other.m_curProperty.arrayIndex);
+		}
+
+		template<typename T>
+		typename ArrayIterator<T>::reference ArrayIterator<T>::operator[](difference_type n) const
+		    requires(!std::is_same_v<T, LinkedPropertyWrapper>)
+		{
+			PropertyWrapper item {m_curProperty};
+			item.arrayIndex = static_cast<uint32_t>(static_cast<difference_type>(item.arrayIndex) + n);
+			return get_property_value<T>(item);
+		}
+
 		template<typename T>
 		typename ArrayIterator<T>::reference ArrayIterator<T>::operator*()
 		{
@@ -2701,7 +2991,7 @@ import :wrapper_funcs;
 export {
 	namespace udm {
 		struct DLLUDM ElementIteratorPair {
-			ElementIteratorPair(pragma::string::StringMap<PProperty>::iterator &it);
+			ElementIteratorPair(KeyMap<PProperty>::iterator &it);
 			ElementIteratorPair();
 			bool operator==(const ElementIteratorPair &other) const;
 			bool operator!=(const ElementIteratorPair &other) const;
@@ -2719,7 +3009,7 @@ export {
 
 			ElementIterator();
 			ElementIterator(Element &e);
-			ElementIterator(Element &e, pragma::string::StringMap<PProperty> &c, pragma::string::StringMap<PProperty>::iterator it);
+			ElementIterator(Element &e, KeyMap<PProperty> &c, KeyMap<PProperty>::iterator it);
 			ElementIterator(const ElementIterator &other);
 			ElementIterator &operator++();
 			ElementIterator operator++(int);
@@ -2728,8 +3018,8 @@ export {
 			bool operator==(const ElementIterator &other) const;
 			bool operator!=(const ElementIterator &other) const;
 		  private:
-			pragma::string::StringMap<PProperty> *m_propertyMap = nullptr;
-			pragma::string::StringMap<PProperty>::iterator m_iterator {};
+			KeyMap<PProperty> *m_propertyMap = nullptr;
+			KeyMap<PProperty>::iterator m_iterator {};
 			ElementIteratorPair m_pair;
 		};
 
@@ -2742,21 +3032,32 @@ export {
 		};
 
 		struct DLLUDM Element {
+			Element() = default;
+			~Element();
 			void AddChild(std::string &&key, const PProperty &o);
 			void AddChild(const std::string &key, const PProperty &o);
 			void Copy(const Element &other);
-			pragma::string::StringMap<PProperty> children;
+			KeyMap<PProperty> children;
 			PropertyWrapper fromProperty {};
 			PropertyWrapper parentProperty {};
 
 			LinkedPropertyWrapper operator[](const std::string &key) { return fromProperty[key]; }
-			LinkedPropertyWrapper operator[](const char *key) { return operator[](std::string {key}); }
+			LinkedPropertyWrapper operator[](const char *key) { return fromProperty[key]; }
+			LinkedPropertyWrapper operator[](const Key &key) { return fromProperty[key]; }
 
 			LinkedPropertyWrapper Add(const std::string_view &path, Type type = Type::Element, bool pathToElements = false);
 			LinkedPropertyWrapper AddArray(const std::string_view &path, std::optional<uint32_t> size = {}, Type type = Type::Element, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false);
+			// Same as above, but the key is never treated as a path
+			LinkedPropertyWrapper Add(const Key &key, Type type = Type::Element);
+			LinkedPropertyWrapper AddArray(const Key &key, std::optional<uint32_t> size = {}, Type type = Type::Element, ArrayType arrayType = ArrayType::Raw);
 			void ToAscii(AsciiSaveFlags flags, std::stringstream &ss, const std::optional<std::string> &prefix = {}) const;
 
 			void Merge(const Element &other, MergeFlags mergeFlags = MergeFlags::OverwriteExisting);
+			// Makes sure the value of the child isn't shared with other properties (see Property::Unshare) and returns it
+			Property *UnshareChild(const std::string_view &key);
+			// Returns the key of the specified child, or nullptr if it's not a child of this element.
+			// Note: Properties that are removed from the children map directly have to be detached (see Property::parent) first.
+			const std::string *FindKey(const Property &child) const;
 
 			bool operator==(const Element &other) const;
 			bool operator!=(const Element &other) const { return !operator==(other); }
@@ -2769,21 +3070,32 @@ export {
 			ElementIterator end();
 		  private:
 			friend void erase_element_child(Element &e, Element &child);
+			friend void remove_element_child(Element &e, const std::string_view &key);
 			template<typename T>
 			friend void set_element_value(Element &parent, Element &child, T &&v);
 
 			template<typename T>
 			void SetValue(Element &child, T &&v);
 			void EraseValue(const Element &child);
+			void EraseValue(const std::string_view &key);
+			void EraseValue(KeyMap<PProperty>::iterator it);
+			KeyMap<PProperty>::iterator FindChild(const Element &child);
+			// Resets the parent of all children owned by this element
+			void DetachChildren();
+			// Un-shares the property owning this element before it is modified
+			void PrepareWrite();
+			// Returns the child with the specified key, or adds it if it doesn't exist. If 'replaceMismatchingType' is true, an existing child of a different type is replaced.
+			Property &FindOrAddChild(const Key &key, Type type, bool replaceMismatchingType);
+			void InitializeArray(Property &prop, std::optional<uint32_t> size, Type type);
 		};
 
 		template<typename T>
 		void Element::SetValue(Element &child, T &&v)
 		{
-			auto it = std::find_if(children.begin(), children.end(), [&child](const std::pair<std::string, PProperty> &pair) { return get_property_type(*pair.second) == Type::Element && get_property_value(*pair.second) == &child; });
+			auto it = FindChild(child);
 			if(it == children.end())
 				return;
-			children[it->first] = create_property<T>(std::forward<T>(v));
+			AddChild(it->first, create_property<T>(std::forward<T>(v)));
 		}
 	}
 }
@@ -2813,6 +3125,80 @@ import :structure;
 
 export {
 	namespace udm {
+		// View over values with a fixed byte distance between them (e.g. a single member of all items of a struct array)
+		template<typename T>
+		class StridedSpan {
+		  public:
+			using value_type = std::remove_cv_t<T>;
+			using BytePtr = std::conditional_t<std::is_const_v<T>, const uint8_t *, uint8_t *>;
+			class Iterator {
+			  public:
+				using iterator_category = std::random_access_iterator_tag;
+				using value_type = StridedSpan::value_type;
+				using difference_type = std::ptrdiff_t;
+				using pointer = T *;
+				using reference = T &;
+
+				Iterator() = default;
+				Iterator(BytePtr ptr, size_t stride) : m_ptr {ptr}, m_stride {stride} {}
+				reference operator*() const { return *reinterpret_cast<T *>(m_ptr); }
+				pointer operator->() const { return reinterpret_cast<T *>(m_ptr); }
+				reference operator[](difference_type n) const { return *reinterpret_cast<T *>(m_ptr + n * static_cast<difference_type>(m_stride)); }
+				Iterator &operator++()
+				{
+					m_ptr += m_stride;
+					return *this;
+				}
+				Iterator operator++(int)
+				{
+					auto it = *this;
+					m_ptr += m_stride;
+					return it;
+				}
+				Iterator &operator--()
+				{
+					m_ptr -= m_stride;
+					return *this;
+				}
+				Iterator operator--(int)
+				{
+					auto it = *this;
+					m_ptr -= m_stride;
+					return it;
+				}
+				Iterator &operator+=(difference_type n)
+				{
+					m_ptr += n * static_cast<difference_type>(m_stride);
+					return *this;
+				}
+				Iterator &operator-=(difference_type n) { return operator+=(-n); }
+				Iterator operator+(difference_type n) const { return Iterator {*this} += n; }
+				Iterator operator-(difference_type n) const { return Iterator {*this} -= n; }
+				friend Iterator operator+(difference_type n, const Iterator &it) { return it + n; }
+				difference_type operator-(const Iterator &other) const { return (m_stride > 0) ? (m_ptr - other.m_ptr) / static_cast<difference_type>(m_stride) : 0; }
+				bool operator==(const Iterator &other) const { return m_ptr == other.m_ptr; }
+				auto operator<=>(const Iterator &other) const { return m_ptr <=> other.m_ptr; }
+			  private:
+				BytePtr m_ptr = nullptr;
+				size_t m_stride = 0;
+			};
+
+			StridedSpan() = default;
+			StridedSpan(BytePtr data, size_t size, size_t stride) : m_data {data}, m_size {size}, m_stride {stride} {}
+			T &operator[](size_t idx) const { return *reinterpret_cast<T *>(m_data + idx * m_stride); }
+			size_t size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+			// Distance between two values in bytes
+			size_t stride() const { return m_stride; }
+			BytePtr data() const { return m_data; }
+			Iterator begin() const { return Iterator {m_data, m_stride}; }
+			Iterator end() const { return Iterator {m_data + m_size * m_stride, m_stride}; }
+		  private:
+			BytePtr m_data = nullptr;
+			size_t m_size = 0;
+			size_t m_stride = 0;
+		};
+
 		struct DLLUDM Array {
 			virtual ~Array();
 			PropertyWrapper fromProperty {};
@@ -2831,28 +3217,34 @@ export {
 			Type GetValueType() const { return m_valueType; }
 			uint32_t GetSize() const { return m_size; }
 			uint32_t GetValueSize() const;
-			virtual void *GetValues() { return GetValuePtr(); }
-			const void *GetValues() const { return const_cast<Array *>(this)->GetValues(); }
+			// Note: Non-const accessors un-share the array if it is shared with other properties (see Property::Unshare)
+			void *GetValues()
+			{
+				PrepareWrite();
+				return LoadValues();
+			}
+			const void *GetValues() const { return const_cast<Array *>(this)->LoadValues(); }
 			void Resize(uint32_t newSize);
 			void AddValueRange(uint32_t startIndex, uint32_t count);
 			void RemoveValueRange(uint32_t startIndex, uint32_t count);
 			void *GetValuePtr(uint32_t idx);
+			const void *GetValuePtr(uint32_t idx) const;
 			template<typename T>
 			T *GetValuePtr(uint32_t idx);
 			template<typename T>
-			const T *GetValuePtr(uint32_t idx) const
-			{
-				return const_cast<Array *>(this)->GetValuePtr<T>(idx);
-			}
+			const T *GetValuePtr(uint32_t idx) const;
 			PropertyWrapper operator[](uint32_t idx);
-			const PropertyWrapper operator[](uint32_t idx) const { return const_cast<Array *>(this)->operator[](idx); }
+			const PropertyWrapper operator[](uint32_t idx) const;
 			template<typename T>
 			T &GetValue(uint32_t idx);
 			template<typename T>
-			const T &GetValue(uint32_t idx) const
-			{
-				return const_cast<Array *>(this)->GetValue<T>(idx);
-			}
+			const T &GetValue(uint32_t idx) const;
+			// Non-throwing alternative to GetValue, the returned pointer is never nullptr on success. If the values have to be decompressed
+			// or un-shared and that fails, InvalidProperty is returned.
+			template<typename T>
+			std::expected<T *, AccessError> TryGetValue(uint32_t idx) noexcept;
+			template<typename T>
+			std::expected<const T *, AccessError> TryGetValue(uint32_t idx) const noexcept;
 			template<typename T>
 			void SetValue(uint32_t idx, T &&value);
 			template<typename T>
@@ -2871,7 +3263,7 @@ export {
 			template<typename T>
 			const T *GetFront() const
 			{
-				return const_cast<Array *>(this)->GetFront<T>();
+				return !IsEmpty() ? GetValuePtr<T>(0u) : nullptr;
 			}
 			template<typename T>
 			T *GetBack()
@@ -2881,7 +3273,7 @@ export {
 			template<typename T>
 			const T *GetBack() const
 			{
-				return const_cast<Array *>(this)->GetBack<T>();
+				return !IsEmpty() ? GetValuePtr<T>(m_size - 1) : nullptr;
 			}
 
 			template<typename T>
@@ -2899,22 +3291,80 @@ export {
 
 			using Range = std::tuple<uint32_t, uint32_t, uint32_t>;
 			void Resize(uint32_t newSize, Range r0, Range r1, bool defaultInitializeNewValues);
+
+			// Takes ownership of the vector's buffer without copying. Only supported for uncompressed arrays of trivial types.
+			template<typename T>
+			void AdoptValues(std::vector<T> &&values);
+			// Takes ownership of an external buffer of 'size' values of type 'valueType', which will be released with 'deleter'.
+			void AdoptValues(Type valueType, void *values, uint32_t size, std::function<void(void *)> deleter);
+			// References an external buffer without taking ownership. The caller has to ensure the buffer outlives the array
+			// (or until the array is cleared or resized, which will copy the data into internal storage).
+			void BorrowValues(Type valueType, void *values, uint32_t size);
+			// Same as above, but the buffer is never written to: The values are copied into internal storage before the array is modified
+			// for the first time, which makes it possible to borrow read-only memory (e.g. a MappedFile).
+			void BorrowValues(Type valueType, const void *values, uint32_t size);
+			// Moves the values into 'outValues' and clears the array. The buffer is moved without copying if it was adopted from a
+			// std::vector<T>, otherwise the values are copied. Returns false if T does not match the value type of the array.
+			template<typename T>
+			bool ReleaseValues(std::vector<T> &outValues);
+			bool HasExternalValues() const { return m_storage != Storage::Internal; }
+
+			// Returns a contiguous view over all values. T can either be the value type of the array, or, for struct arrays,
+			// a trivially copyable type with the same size as the struct. Compressed arrays are decompressed once.
+			// The view is invalidated if the array is resized, cleared or compressed. Throws a LogicError if T doesn't match the value type.
+			template<typename T>
+			std::span<T> AsSpan();
+			template<typename T>
+			std::span<const T> AsSpan() const;
+			// Non-throwing alternative to AsSpan (see TryGetValue)
+			template<typename T>
+			std::expected<std::span<T>, AccessError> TryAsSpan() noexcept;
+			template<typename T>
+			std::expected<std::span<const T>, AccessError> TryAsSpan() const noexcept;
+			// Returns a view over a single member of all items of a struct array. T has to match the member type.
+			template<typename T>
+			StridedSpan<T> GetStructMemberSpan(StructDescription::MemberCountType memberIdx);
+			template<typename T>
+			StridedSpan<T> GetStructMemberSpan(const std::string_view &memberName);
+			template<typename T>
+			StridedSpan<const T> GetStructMemberSpan(StructDescription::MemberCountType memberIdx) const;
+			template<typename T>
+			StridedSpan<const T> GetStructMemberSpan(const std::string_view &memberName) const;
+			bool IsBorrowed() const { return m_storage == Storage::Borrowed || m_storage == Storage::BorrowedReadOnly; }
 		  protected:
 			friend Property;
 			friend PropertyWrapper;
+			friend MemoryStatistics;
 			virtual void Clear();
+			// Returns the values without un-sharing them, compressed arrays are decompressed
+			virtual void *LoadValues() { return GetValuePtr(); }
+			// Un-shares the property owning this array before it is modified and copies read-only borrowed values into internal storage.
+			// 'discardValues' can be set if the caller replaces the values, in which case they're not copied.
+			void PrepareWrite(bool discardValues = false);
 
 			void *GetValuePtr();
 			const void *GetValuePtr() const { return const_cast<Array *>(this)->GetValuePtr(); }
+			[[noreturn]] void ThrowAccessError(AccessError err, uint32_t idx, Type requestedType) const;
 			void *GetHeaderPtr();
 			const void *GetHeaderPtr() const { return const_cast<Array *>(this)->GetHeaderPtr(); }
 			uint64_t GetHeaderSize() const;
 			void ReleaseValues();
 			uint8_t *AllocateData(uint64_t size) const;
 
+			enum class Storage : uint8_t {
+				Internal = 0,     // Allocated with AllocateData
+				Vector,           // Adopted from a std::vector, owned by m_externalValues
+				External,         // Adopted buffer with custom deleter, owned by m_externalValues
+				Borrowed,         // Not owned
+				BorrowedReadOnly, // Not owned, copied into internal storage before the array is modified
+			};
+			void SetExternalValues(Type valueType, void *values, uint32_t size, std::shared_ptr<void> owner, Storage storage);
+
 			void *m_values = nullptr;
 			uint32_t m_size = 0;
 			Type m_valueType = Type::Nil;
+			Storage m_storage = Storage::Internal;
+			std::shared_ptr<void> m_externalValues = nullptr;
 		};
 
 		struct DLLUDM ArrayLz4 : public Array {
@@ -2931,7 +3381,6 @@ export {
 			ArrayLz4 &operator=(const ArrayLz4 &other);
 			const BlobLz4 &GetCompressedBlob() const { return const_cast<ArrayLz4 *>(this)->GetCompressedBlob(); }
 			BlobLz4 &GetCompressedBlob();
-			virtual void *GetValues() override;
 			virtual void SetValueType(Type valueType) override;
 			virtual ArrayType GetArrayType() const override { return ArrayType::Compressed; }
 			void ClearUncompressedMemory();
@@ -2943,7 +3392,12 @@ export {
 			friend Property;
 			friend PropertyWrapper;
 			friend AsciiReader;
+			friend FrozenDataBuilder;
+			friend MemoryStatistics;
 			virtual StructDescription *GetStructuredDataInfo() override;
+			virtual void *LoadValues() override;
+			// Copies the compressed data of the other array without decompressing it, returns false if it isn't compressed
+			bool CopyCompressed(const ArrayLz4 &other);
 			void InitializeSize(uint32_t size);
 			void Decompress();
 			void Compress();
@@ -2962,21 +3416,222 @@ export {
 				return nullptr;
 			return &GetValue<T>(idx);
 		}
+		template<typename T>
+		const T *Array::GetValuePtr(uint32_t idx) const
+		{
+			if(type_to_enum<T>() != m_valueType)
+				return nullptr;
+			return &GetValue<T>(idx);
+		}
 
 		template<typename T>
 		T &Array::GetValue(uint32_t idx)
+		{
+			auto res = TryGetValue<T>(idx);
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), idx, type_to_enum<std::remove_cv_t<std::remove_reference_t<T>>>());
+			return **res;
+		}
+		template<typename T>
+		const T &Array::GetValue(uint32_t idx) const
+		{
+			auto res = TryGetValue<T>(idx);
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), idx, type_to_enum<std::remove_cv_t<std::remove_reference_t<T>>>());
+			return **res;
+		}
+
+		template<typename T>
+		std::expected<T *, AccessError> Array::TryGetValue(uint32_t idx) noexcept
+		{
+			// Has to be called before the values are retrieved, since read-only borrowed values are moved into internal storage
+			try {
+				PrepareWrite();
+			}
+			catch(...) {
+				return std::unexpected {AccessError::InvalidProperty};
+			}
+			auto res = static_cast<const Array *>(this)->TryGetValue<T>(idx);
+			if(!res)
+				return std::unexpected {res.error()};
+			return const_cast<T *>(*res);
+		}
+		template<typename T>
+		std::expected<const T *, AccessError> Array::TryGetValue(uint32_t idx) const noexcept
 		{
 			if(idx >= m_size)
-				throw OutOfBoundsError {"Array index " + std::to_string(idx) + " out of bounds of array of size " + std::to_string(m_size) + "!"};
+				return std::unexpected {AccessError::OutOfBounds};
 			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
-			auto vs = [this, idx](auto tag) -> T & {
-				using TTag = typename decltype(tag)::type;
-				if constexpr(std::is_same_v<TTag, TBase>)
-					return static_cast<TTag *>(GetValues())[idx];
-				throw LogicError {"Attempted to retrieve value of type " + std::string {magic_enum::enum_name(type_to_enum<T>())} + " from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
-			};
-			auto valueType = GetValueType();
-			return visit(valueType, vs);
+			if(type_to_enum<TBase>() != GetValueType())
+				return std::unexpected {AccessError::TypeMismatch};
+			const TBase *values = nullptr;
+			try {
+				values = static_cast<const TBase *>(GetValues());
+			}
+			catch(...) {
+				// The values couldn't be decompressed
+			}
+			if(!values)
+				return std::unexpected {AccessError::InvalidProperty};
+			return &values[idx];
+		}
+
+		template<typename T>
+		std::span<T> Array::AsSpan()
+		{
+			if constexpr(!std::is_const_v<T>)
+				PrepareWrite(); // See TryGetValue
+			auto span = static_cast<const Array *>(this)->AsSpan<T>();
+			return std::span<T> {const_cast<T *>(span.data()), span.size()};
+		}
+		template<typename T>
+		std::span<const T> Array::AsSpan() const
+		{
+			using TBase = std::remove_cv_t<T>;
+			constexpr auto type = type_to_enum_s<TBase>();
+			if constexpr(type == Type::Invalid) {
+				static_assert(std::is_trivially_copyable_v<TBase>, "Custom span types have to be trivially copyable!");
+				if(m_valueType != Type::Struct)
+					throw LogicError {"Attempted to retrieve span of custom type from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
+				auto *values = GetValues(); // Has to be called before GetValueSize in case the array is compressed
+				if(GetValueSize() != sizeof(TBase))
+					throw LogicError {"Size of custom span type (" + std::to_string(sizeof(TBase)) + ") does not match size of struct (" + std::to_string(GetValueSize()) + ")!"};
+				return std::span<const T> {static_cast<const T *>(values), values ? m_size : 0};
+			}
+			else {
+				if(m_valueType != type)
+					throw LogicError {"Attempted to retrieve span of type " + std::string {magic_enum::enum_name(type)} + " from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
+				auto *values = GetValues();
+				return std::span<const T> {static_cast<const T *>(values), values ? m_size : 0};
+			}
+		}
+		template<typename T>
+		std::expected<std::span<T>, AccessError> Array::TryAsSpan() noexcept
+		{
+			if constexpr(!std::is_const_v<T>) {
+				try {
+					PrepareWrite(); // See TryGetValue
+				}
+				catch(...) {
+					return std::unexpected {AccessError::InvalidProperty};
+				}
+			}
+			auto span = static_cast<const Array *>(this)->TryAsSpan<T>();
+			if(!span)
+				return std::unexpected {span.error()};
+			return std::span<T> {const_cast<T *>(span->data()), span->size()};
+		}
+		template<typename T>
+		std::expected<std::span<const T>, AccessError> Array::TryAsSpan() const noexcept
+		{
+			using TBase = std::remove_cv_t<T>;
+			constexpr auto type = type_to_enum_s<TBase>();
+			if constexpr(type == Type::Invalid) {
+				static_assert(std::is_trivially_copyable_v<TBase>, "Custom span types have to be trivially copyable!");
+				if(m_valueType != Type::Struct)
+					return std::unexpected {AccessError::TypeMismatch};
+			}
+			else if(m_valueType != type)
+				return std::unexpected {AccessError::TypeMismatch};
+			const void *values = nullptr;
+			try {
+				values = GetValues();
+			}
+			catch(...) {
+				return std::unexpected {AccessError::InvalidProperty}; // The values couldn't be decompressed
+			}
+			if constexpr(type == Type::Invalid) {
+				// Has to be checked after the array has been decompressed
+				if(GetValueSize() != sizeof(TBase))
+					return std::unexpected {AccessError::TypeMismatch};
+			}
+			return std::span<const T> {static_cast<const T *>(values), values ? m_size : 0};
+		}
+
+		template<typename T>
+		StridedSpan<T> Array::GetStructMemberSpan(StructDescription::MemberCountType memberIdx)
+		{
+			if constexpr(!std::is_const_v<T>)
+				PrepareWrite(); // See TryGetValue
+			auto span = static_cast<const Array *>(this)->GetStructMemberSpan<T>(memberIdx);
+			return StridedSpan<T> {const_cast<typename StridedSpan<T>::BytePtr>(span.data()), span.size(), span.stride()};
+		}
+		template<typename T>
+		StridedSpan<const T> Array::GetStructMemberSpan(StructDescription::MemberCountType memberIdx) const
+		{
+			if(m_valueType != Type::Struct)
+				throw LogicError {"Attempted to retrieve struct member span from array of type " + std::string {magic_enum::enum_name(m_valueType)} + "!"};
+			auto *values = static_cast<const uint8_t *>(GetValues());
+			auto *strct = GetStructuredDataInfo();
+			if(!strct)
+				throw ImplementationError {"Struct array has invalid structure data info!"};
+			if(memberIdx >= strct->types.size())
+				throw OutOfBoundsError {"Struct member index " + std::to_string(memberIdx) + " out of bounds of struct with " + std::to_string(strct->types.size()) + " members!"};
+			constexpr auto type = type_to_enum_s<std::remove_cv_t<T>>();
+			auto memberType = strct->types[memberIdx];
+			if(memberType != type)
+				throw LogicError {"Attempted to retrieve span of type " + std::string {magic_enum::enum_name(type)} + " for struct member of type " + std::string {magic_enum::enum_name(memberType)} + "!"};
+			if(!values)
+				return {};
+			return StridedSpan<const T> {values + strct->GetMemberOffset(memberIdx), m_size, strct->GetDataSizeRequirement()};
+		}
+
+		template<typename T>
+		StridedSpan<T> Array::GetStructMemberSpan(const std::string_view &memberName)
+		{
+			if constexpr(!std::is_const_v<T>)
+				PrepareWrite(); // See TryGetValue
+			auto span = static_cast<const Array *>(this)->GetStructMemberSpan<T>(memberName);
+			return StridedSpan<T> {const_cast<typename StridedSpan<T>::BytePtr>(span.data()), span.size(), span.stride()};
+		}
+		template<typename T>
+		StridedSpan<const T> Array::GetStructMemberSpan(const std::string_view &memberName) const
+		{
+			auto *strct = (m_valueType == Type::Struct) ? GetStructuredDataInfo() : nullptr;
+			auto memberIdx = strct ? strct->FindMember(memberName) : std::optional<StructDescription::MemberCountType> {};
+			if(!memberIdx.has_value())
+				throw LogicError {"Struct has no member '" + std::string {memberName} + "'!"};
+			return GetStructMemberSpan<T>(*memberIdx);
+		}
+
+		template<typename T>
+		void Array::AdoptValues(std::vector<T> &&values)
+		{
+			constexpr auto valueType = type_to_enum_s<T>();
+			static_assert(valueType != Type::Invalid && valueType != Type::Nil && is_trivial_type(valueType), "Only vectors of trivial types can be adopted!");
+			static_assert(!std::is_same_v<T, bool>, "std::vector<bool> does not have contiguous storage!");
+			if(values.size() > std::numeric_limits<uint32_t>::max())
+				throw OutOfBoundsError {"Vector size exceeds maximum array size!"};
+			auto size = static_cast<uint32_t>(values.size());
+			auto owner = std::make_shared<std::vector<T>>(std::move(values));
+			auto *data = owner->data();
+			SetExternalValues(valueType, data, size, std::move(owner), Storage::Vector);
+		}
+
+		template<typename T>
+		bool Array::ReleaseValues(std::vector<T> &outValues)
+		{
+			constexpr auto valueType = type_to_enum_s<T>();
+			if constexpr(valueType == Type::Invalid || !is_trivial_type(valueType))
+				return false;
+			else {
+				if(m_valueType != valueType)
+					return false;
+				PrepareWrite();
+				if(m_storage == Storage::Vector && m_externalValues.use_count() == 1) {
+					// The vector was adopted with the same value type (see AdoptValues), so it can be moved out directly
+					outValues = std::move(*static_cast<std::vector<T> *>(m_externalValues.get()));
+					Clear();
+					return true;
+				}
+				auto *values = static_cast<const T *>(GetValues());
+				if(values)
+					outValues.assign(values, values + m_size);
+				else
+					outValues.clear();
+				Clear();
+				return true;
+			}
 		}
 
 		template<typename T>
@@ -3056,6 +3711,7 @@ module;
 export module pragma.udm:util;
 
 export import :array;
+import :file;
 import :structure;
 import :types.element;
 import :types.string;
@@ -3123,7 +3779,12 @@ export {
 			}
 		}
 
+		// Writes all values other than elements and arrays as strings
 		void to_json(LinkedPropertyWrapperArg prop, std::stringstream &ss);
+		// Writes standard JSON through a fixed-size buffer: numeric values as numbers, vectors, matrices and structs as arrays of numbers,
+		// blobs as base64 strings and nil as null. Compressed blobs and arrays are decompressed.
+		DLLUDM void to_json(LinkedPropertyWrapperArg prop, IFile &f, JsonFormat format = JsonFormat::Pretty);
+		DLLUDM void to_json(LinkedPropertyWrapperArg prop, std::string &outStr, JsonFormat format = JsonFormat::Pretty);
 	}
 }
 
@@ -3177,15 +3838,37 @@ export {
 			template<typename T>
 			void operator=(T &&v);
 			void Copy(const Property &other, bool deepCopy);
+			void Copy(const Property &other, MergeFlags mergeFlags);
 			PProperty Copy(bool deepCopy = false) const;
+			PProperty Copy(MergeFlags mergeFlags) const;
 
 			Hash CalcHash() const;
 
+			// Returns a new property which shares the value of this property until either of them is written to (see MergeFlags::CopyOnWrite).
+			// Trivial values are copied immediately.
+			// Ownership: The property that is written to keeps the value object and the other properties receive a copy, so that references
+			// obtained through the writer remain valid. References that were obtained through one of the other properties before the write
+			// refer to the writer's value afterwards, i.e. only accesses through the properties (or their wrappers) are isolated from each other.
+			// Threading: Since a write replaces the values of the other properties, properties sharing a value have to be synchronized as if they
+			// were one document, even if they belong to different ones. None of them may be written to while any of them is read on another thread.
+			PProperty Share() const;
+			// Returns true if the value is shared with other properties
+			bool IsShared() const { return m_nextShared != nullptr; }
+			// Makes sure neither the value of this property nor the value of any of its parents is shared with other properties, so it can
+			// be written to. The other properties receive a copy of the value, while this property keeps it (see Share).
+			// This is done automatically by all non-const accessors.
+			void Unshare();
+
 			Type type = Type::Nil;
 			DataValue value = nullptr;
+			// Element this property was first added to and its key within that element, used for reverse lookups (see Element::FindKey).
+			// The key points to the key of the element's map node and is only valid as long as the parent is set.
+			Element *parent = nullptr;
+			const std::string *key = nullptr;
 
 			LinkedPropertyWrapper operator[](const std::string &key);
 			LinkedPropertyWrapper operator[](const char *key);
+			LinkedPropertyWrapper operator[](const Key &key);
 
 			bool operator==(const Property &other) const;
 			bool operator!=(const Property &other) const { return !operator==(other); }
@@ -3206,7 +3889,15 @@ export {
 			const T &GetValue() const;
 			template<typename T>
 			T *GetValuePtr();
+			template<typename T>
+			const T *GetValuePtr() const;
 			void *GetValuePtr(Type &outType);
+			// Non-throwing alternative to GetValue, the returned pointer is never nullptr on success. If the value has to be un-shared
+			// and can't be copied, InvalidProperty is returned.
+			template<typename T>
+			std::expected<T *, AccessError> TryGetValue() noexcept;
+			template<typename T>
+			std::expected<const T *, AccessError> TryGetValue() const noexcept;
 			template<typename T>
 			T ToValue(const T &defaultValue) const;
 			template<typename T>
@@ -3275,6 +3966,8 @@ export {
 			static uint32_t GetStringSizeRequirement(const String &str);
 		  private:
 			friend PropertyWrapper;
+			friend AsciiReader;
+			friend AsciiWriter;
 			bool ReadStructHeader(IFile &f, StructDescription &strct);
 			static void WriteStructHeader(IFile &f, const StructDescription &strct);
 			template<bool ENABLE_EXCEPTIONS, typename T>
@@ -3285,21 +3978,47 @@ export {
 			template<typename T>
 			static void WriteBlockSize(IFile &f, uint64_t offset);
 
+			// Large enough for any numeric value, including doubles in fixed notation
+			static constexpr size_t NUMERIC_STRING_BUFFER_SIZE = 384;
+			// Writes the value to [first, last) without any allocations and returns a pointer past the last character.
+			// Floating point values are written with a fixed precision (see GetAsciiPrecision) and trailing zeroes are removed.
+			template<typename T>
+			static char *NumericTypeToChars(T value, char *first, char *last);
 			template<typename T>
 			static void NumericTypeToString(T value, std::stringstream &ss);
 			template<typename T>
+			static void NumericTypeToString(T value, std::string &outStr);
+			template<typename T>
 			static std::string NumericTypeToString(T value);
-			static void SetAppropriatePrecision(std::stringstream &ss, Type type);
-			static void RemoveTrailingZeroes(std::string &str);
+			static int GetAsciiPrecision(Type type);
+			static char *RemoveTrailingZeroes(char *first, char *last);
 			void Initialize();
 			void Clear();
 			template<typename T>
 			T &GetValue(Type type);
+			template<typename T>
+			const T &GetValue(Type type) const;
+			template<typename T>
+			std::expected<T *, AccessError> TryGetValue(Type type) noexcept;
+			template<typename T>
+			std::expected<const T *, AccessError> TryGetValue(Type type) const noexcept;
+			[[noreturn]] void ThrowAccessError(AccessError err, Type requestedType) const;
+
+			void UnshareParents();
+			void UnshareValue();
+			// Removes this property from the ring of properties sharing its value and returns the next property in the ring
+			Property *LeaveSharedRing();
+			// Points the back-references of the value (e.g. Element::fromProperty) to this property
+			void BindValue();
+			bool IsValueBoundTo(const Property &prop) const;
+			// Properties sharing the same value form a ring, which is only modified on the thread that copies or writes the data
+			mutable Property *m_nextShared = nullptr;
 		};
 
 		template<bool ENABLE_EXCEPTIONS, typename T>
 		bool Property::Assign(T &&v)
 		{
+			Unshare();
 			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
 			if constexpr(pragma::util::is_specialization<TBase, std::vector>::value) {
 				using TValueType = typename TBase::value_type;
@@ -3312,6 +4031,13 @@ export {
 				auto valueType = type_to_enum<TValueType>();
 				auto size = v.size();
 				auto &a = *static_cast<Array *>(value);
+				if constexpr(!std::is_lvalue_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>> && is_trivial_type(type_to_enum<TValueType>()) && type_to_enum<TValueType>() != Type::Nil && !std::is_same_v<TValueType, bool>) {
+					// Take ownership of the buffer instead of copying it
+					if(a.GetArrayType() == ArrayType::Raw) {
+						a.AdoptValues(std::move(v));
+						return true;
+					}
+				}
 				a.Clear();
 				a.SetValueType(valueType);
 				a.Resize(size);
@@ -3419,46 +4145,42 @@ export {
 		}
 
 		template<typename T>
-		void Property::NumericTypeToString(T value, std::stringstream &ss)
+		char *Property::NumericTypeToChars(T value, char *first, char *last)
 		{
 			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
-			if constexpr(std::is_same_v<TBase, Half>) {
-				NumericTypeToString<float>(value, ss);
-				return;
-			}
-			if constexpr(!std::is_floating_point_v<T>) {
-				if constexpr(std::is_same_v<T, Int8> || std::is_same_v<T, UInt8>)
-					ss << +value;
-				else
-					ss << value;
-				return;
+			if constexpr(std::is_same_v<TBase, Half>)
+				return NumericTypeToChars<float>(value, first, last);
+			else if constexpr(std::is_same_v<TBase, Int8> || std::is_same_v<TBase, UInt8> || std::is_same_v<TBase, Boolean>)
+				return std::to_chars(first, last, +value).ptr;
+			else if constexpr(!std::is_floating_point_v<TBase>)
+				return std::to_chars(first, last, value).ptr;
+			else {
+				auto res = std::to_chars(first, last, value, std::chars_format::fixed, GetAsciiPrecision(type_to_enum<TBase>()));
+				if(res.ec != std::errc {})
+					return first;
+				return RemoveTrailingZeroes(first, res.ptr);
 			}
-			// SetAppropriatePrecision(ss,type_to_enum<T>());
-			ss << NumericTypeToString(value);
+		}
+		template<typename T>
+		void Property::NumericTypeToString(T value, std::stringstream &ss)
+		{
+			std::array<char, NUMERIC_STRING_BUFFER_SIZE> buf;
+			auto *end = NumericTypeToChars(value, buf.data(), buf.data() + buf.size());
+			ss.write(buf.data(), end - buf.data());
+		}
+		template<typename T>
+		void Property::NumericTypeToString(T value, std::string &outStr)
+		{
+			std::array<char, NUMERIC_STRING_BUFFER_SIZE> buf;
+			auto *end = NumericTypeToChars(value, buf.data(), buf.data() + buf.size());
+			outStr.append(buf.data(), end);
 		}
 		template<typename T>
 		std::string Property::NumericTypeToString(T value)
 		{
-			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
-			if constexpr(std::is_same_v<TBase, Half>)
-				return NumericTypeToString<float>(value);
-			if constexpr(!std::is_floating_point_v<T>) {
-				if constexpr(std::is_same_v<T, Int8> || std::is_same_v<T, UInt8>)
-					return std::to_string(+value);
-				return std::to_string(value);
-			}
-			// TODO: This is not very efficient...
-			// (We need a temporary stringstream because we want to
-			// remove trailing zeroes)
-			std::stringstream tmp;
-			SetAppropriatePrecision(tmp, type_to_enum<T>());
-			if constexpr(std::is_same_v<T, Int8> || std::is_same_v<T, UInt8>)
-				tmp << +value;
-			else
-				tmp << value;
-			auto str = tmp.str();
-			RemoveTrailingZeroes(str);
-			return str;
+			std::array<char, NUMERIC_STRING_BUFFER_SIZE> buf;
+			auto *end = NumericTypeToChars(value, buf.data(), buf.data() + buf.size());
+			return std::string {buf.data(), end};
 		}
 
 		template<typename T>
@@ -3470,7 +4192,7 @@ export {
 		template<typename T>
 		const T &Property::GetValue() const
 		{
-			return const_cast<Property *>(this)->GetValue<T>();
+			return GetValue<T>(type_to_enum<T>());
 		}
 		template<typename T>
 		T Property::ToValue(const T &defaultValue) const
@@ -3506,7 +4228,7 @@ export {
 			}
 			auto vs = [&](auto tag) -> std::optional<T> {
 				if constexpr(is_convertible<typename decltype(tag)::type, T>())
-					return convert<typename decltype(tag)::type, T>(const_cast<Property *>(this)->GetValue<typename decltype(tag)::type>());
+					return convert<typename decltype(tag)::type, T>(GetValue<typename decltype(tag)::type>());
 				return {};
 			};
 			return visit(type, vs);
@@ -3518,20 +4240,74 @@ export {
 		T &Property::GetValue(Type type)
 		{
 			assert(value && this->type == type);
+			auto res = TryGetValue<T>(type);
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), type);
+			return **res;
+		}
+		template<typename T>
+		const T &Property::GetValue(Type type) const
+		{
+			auto res = TryGetValue<T>(type);
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), type);
+			return **res;
+		}
+
+		template<typename T>
+		std::expected<T *, AccessError> Property::TryGetValue(Type type) noexcept
+		{
+			auto res = static_cast<const Property *>(this)->TryGetValue<T>(type);
+			if(!res)
+				return std::unexpected {res.error()};
+			try {
+				Unshare();
+			}
+			catch(...) {
+				return std::unexpected {AccessError::InvalidProperty};
+			}
+			return const_cast<T *>(*res);
+		}
+		template<typename T>
+		std::expected<const T *, AccessError> Property::TryGetValue(Type type) const noexcept
+		{
 			if(this->type != type && !(this->type == Type::ArrayLz4 && type == Type::Array))
-				throw LogicError {"Type mismatch, requested type is " + std::string {magic_enum::enum_name(type)} + ", but actual type is " + std::string {magic_enum::enum_name(this->type)} + "!"};
-			return *GetValuePtr<T>();
+				return std::unexpected {AccessError::TypeMismatch};
+			auto *ptr = GetValuePtr<T>();
+			if(!ptr)
+				return std::unexpected {AccessError::InvalidProperty};
+			return ptr;
+		}
+		template<typename T>
+		std::expected<T *, AccessError> Property::TryGetValue() noexcept
+		{
+			return TryGetValue<T>(type_to_enum<T>());
+		}
+		template<typename T>
+		std::expected<const T *, AccessError> Property::TryGetValue() const noexcept
+		{
+			return TryGetValue<T>(type_to_enum<T>());
 		}
 
 		template<typename T>
 		T *Property::GetValuePtr()
 		{
 			// TODO: this should never be null, but there are certain cases where it seems to happen
+			if(!this)
+				return nullptr;
+			auto *ptr = static_cast<const Property *>(this)->GetValuePtr<T>();
+			if(ptr)
+				Unshare(); // The value is kept by this property, so the pointer remains valid
+			return const_cast<T *>(ptr);
+		}
+		template<typename T>
+		const T *Property::GetValuePtr() const
+		{
 			if(!this)
 				return nullptr;
 			if constexpr(std::is_same_v<T, Array>)
-				return is_array_type(this->type) ? reinterpret_cast<T *>(value) : nullptr;
-			return (this->type == type_to_enum<T>()) ? reinterpret_cast<T *>(value) : nullptr;
+				return is_array_type(this->type) ? reinterpret_cast<const T *>(value) : nullptr;
+			return (this->type == type_to_enum<T>()) ? reinterpret_cast<const T *>(value) : nullptr;
 		}
 
 		template<class T>
@@ -3569,6 +4345,421 @@ export {
 
 // --- END PARTITION: src/interface/property.cppm ---
 
+// --- BEGIN PARTITION: src/interface/path_cursor.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:path_cursor;
+
+export import :array;
+export import :conversion;
+export import :property;
+export import :types.element;
+*/
+
+// --- START BODY: src/interface/path_cursor.cppm ---
+
+export {
+	namespace udm {
+		// Lightweight alternative to LinkedPropertyWrapper chains for walking paths. The cursor keeps a fixed-size stack
+		// of frames and never allocates, keys are looked up without creating temporary strings.
+		// The cursor is invalidated if a property on its current path is removed or replaced.
+		class DLLUDM PathCursor {
+		  public:
+			static constexpr uint32_t MAX_DEPTH = 32;
+			static constexpr auto INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+			struct Frame {
+				Property *prop = nullptr; // Set if the value is a property
+				Array *array = nullptr;   // Set if the value is an array item
+				uint32_t arrayIndex = INVALID_INDEX;
+				std::string_view key; // Key within the parent element, empty for array items and the root
+			};
+
+			PathCursor() = default;
+			explicit PathCursor(Property &root);
+			// The cursor is invalid if the wrapper does not refer to an existing property or array item
+			explicit PathCursor(const PropertyWrapper &root);
+
+			// Moves to the child with the specified key of the current element (or element array item).
+			// Returns false and leaves the cursor unchanged if the child doesn't exist or the cursor is at MAX_DEPTH.
+			bool Down(const std::string_view &key);
+			bool Down(const Key &key);
+			// Moves to the item at the specified index of the current array
+			bool Down(uint32_t idx);
+			// Same path syntax as PropertyWrapper::GetFromPath (e.g. a/b[2]/"c d", see parse_path). The cursor is left unchanged if any part of
+			// the path doesn't exist.
+			bool DownPath(const std::string_view &path);
+			bool Up(uint32_t levels = 1);
+			void Reset();
+
+			bool IsValid() const { return m_depth > 0; }
+			explicit operator bool() const { return IsValid(); }
+			// Number of frames below the root
+			uint32_t GetDepth() const { return (m_depth > 0) ? (m_depth - 1) : 0; }
+			const Frame &GetFrame() const { return m_frames[m_depth - 1]; }
+			bool IsArrayItem() const { return IsValid() && GetFrame().array; }
+			Type GetType() const;
+			// Returns nullptr for array items.
+			// Note: Values are not un-shared by these accessors, Unshare has to be called before they're modified (see Property::Unshare)
+			Property *GetProperty() const { return IsValid() ? GetFrame().prop : nullptr; }
+			Element *GetElement() const { return IsValid() ? GetElement(GetFrame()) : nullptr; }
+			Array *GetArray() const { return IsValid() ? GetArray(GetFrame()) : nullptr; }
+			uint32_t GetSize() const;
+
+			template<typename T>
+			T *GetValuePtr() const;
+			template<typename T>
+			std::optional<T> ToValue() const;
+			template<typename T>
+			T ToValue(const T &defaultValue) const
+			{
+				auto val = ToValue<T>();
+				return val.has_value() ? *val : defaultValue;
+			}
+			template<typename T>
+			T operator()(const T &defaultValue) const
+			{
+				return ToValue<T>(defaultValue);
+			}
+			// Assigns a value to the current property or array item. Shared properties (see MergeFlags::CopyOnWrite) along the path
+			// are unshared first. Returns false if the cursor is invalid.
+			template<typename T>
+			bool SetValue(T &&value);
+			// Makes sure the values of the properties along the path aren't shared with other properties
+			void Unshare() const;
+		  private:
+			static Element *GetElement(const Frame &frame);
+			static Array *GetArray(const Frame &frame);
+			bool Push(const Frame &frame);
+
+			std::array<Frame, MAX_DEPTH + 1> m_frames {};
+			uint32_t m_depth = 0;
+		};
+
+		template<typename T>
+		T *PathCursor::GetValuePtr() const
+		{
+			if(!IsValid())
+				return nullptr;
+			Unshare(); // The value may be modified through the returned pointer
+			auto &frame = GetFrame();
+			if(frame.array)
+				return (frame.arrayIndex < frame.array->GetSize()) ? frame.array->GetValuePtr<T>(frame.arrayIndex) : nullptr;
+			return frame.prop->GetValuePtr<T>();
+		}
+
+		template<typename T>
+		std::optional<T> PathCursor::ToValue() const
+		{
+			if(!IsValid())
+				return {};
+			auto &frame = GetFrame();
+			if(!frame.array)
+				return frame.prop->ToValue<T>();
+			if(frame.arrayIndex >= frame.array->GetSize())
+				return {};
+			auto vs = [&frame](auto tag) -> std::optional<T> {
+				using TTag = typename decltype(tag)::type;
+				if constexpr(is_convertible<TTag, T>())
+					return convert<TTag, T>(std::as_const(*frame.array).GetValue<TTag>(frame.arrayIndex));
+				return {};
+			};
+			return visit(frame.array->GetValueType(), vs);
+		}
+
+		template<typename T>
+		bool PathCursor::SetValue(T &&value)
+		{
+			if(!IsValid())
+				return false;
+			Unshare();
+			auto &frame = GetFrame();
+			if(frame.array) {
+				if(frame.arrayIndex >= frame.array->GetSize())
+					return false;
+				frame.array->SetValue(frame.arrayIndex, std::forward<T>(value));
+				return true;
+			}
+			*frame.prop = std::forward<T>(value);
+			return true;
+		}
+	}
+}
+
+// --- END PARTITION: src/interface/path_cursor.cppm ---
+
+// --- BEGIN PARTITION: src/interface/path_cache.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:path_cache;
+
+export import :path_cursor;
+export import :property_wrapper;
+*/
+
+// --- START BODY: src/interface/path_cache.cppm ---
+
+export {
+	namespace udm {
+		// Invalidates the path caches of the tree containing the property, element or array. This is done automatically whenever the structure
+		// of a tree changes (children being added, removed or replaced, arrays being reallocated or element/array values being destroyed),
+		// but has to be called manually if Element::children is modified directly.
+		DLLUDM void invalidate_path_caches(const Property &prop);
+		DLLUDM void invalidate_path_caches(const Element &el);
+		DLLUDM void invalidate_path_caches(const Array &a);
+		// Invalidates all path caches
+		DLLUDM void invalidate_path_caches();
+
+		// Caches the results of path lookups relative to a root property. Paths use the same syntax as PathCursor::DownPath.
+		// The cache is only invalidated by structural changes of the tree containing the root property, but properties that have been added
+		// to multiple elements only count as part of the tree of the element they were added to first (see Property::parent).
+		// Note: The cache is not thread-safe.
+		class DLLUDM PathCache {
+		  public:
+			struct Statistics {
+				uint64_t hits = 0;
+				uint64_t misses = 0;
+				uint64_t invalidations = 0;
+			};
+			PathCache() = default;
+			PathCache(const PathCache &) = delete;
+			PathCache &operator=(const PathCache &) = delete;
+			~PathCache();
+
+			// Returns an invalid wrapper if the path doesn't exist
+			PropertyWrapper Find(Property &root, const std::string_view &path);
+			void Clear();
+			size_t GetSize() const { return m_entries.size(); }
+			const Statistics &GetStatistics() const { return m_statistics; }
+			void ResetStatistics() { m_statistics = {}; }
+		  private:
+			struct Entry {
+				Property *prop = nullptr;
+				Array *array = nullptr;
+				uint32_t arrayIndex = PathCursor::INVALID_INDEX;
+			};
+			friend void invalidate_path_caches(const Property &prop);
+			friend void invalidate_path_caches();
+			void Validate(Property &root);
+			void SetRoot(Property *root);
+			pragma::string::StringMap<Entry> m_entries;
+			Property *m_root = nullptr;
+			// Incremented whenever the structure of the tree containing the root changes
+			std::atomic<uint64_t> m_generation = 0;
+			uint64_t m_validGeneration = 0;
+			Statistics m_statistics {};
+		};
+	}
+}
+
+// --- END PARTITION: src/interface/path_cache.cppm ---
+
+// --- BEGIN PARTITION: src/interface/frozen.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:frozen;
+
+export import :conversion;
+export import :core;
+export import :enums;
+export import :types;
+*/
+
+// --- START BODY: src/interface/frozen.cppm ---
+
+export {
+	namespace udm {
+		// Immutable representation of a property tree, stored in a single contiguous buffer.
+		// All offsets are relative to the start of the buffer.
+#pragma pack(push, 1)
+		struct FrozenNode {
+			uint64_t offset = 0; // Offset to the value, child table (elements) or item table (arrays of non-trivial types)
+			uint32_t size = 0;   // Number of children or array items, or number of bytes for strings and blobs
+			Type type = Type::Nil;
+			Type valueType = Type::Nil; // Arrays only
+			ArrayType arrayType = ArrayType::Raw;
+			uint8_t reserved = 0;
+		};
+		struct FrozenChild {
+			uint64_t keyOffset = 0;
+			uint32_t keyLength = 0;
+			uint32_t reserved = 0;
+			FrozenNode node {};
+		};
+		struct FrozenStruct {
+			uint64_t dataOffset = 0;
+			uint32_t dataSize = 0; // Size of a single struct value
+			uint16_t memberCount = 0;
+			uint16_t reserved = 0;
+			// Followed by FrozenStructMember[memberCount]
+		};
+		struct FrozenStructMember {
+			uint64_t nameOffset = 0;
+			uint32_t nameLength = 0;
+			Type type = Type::Nil;
+			std::array<uint8_t, 3> reserved {};
+		};
+#pragma pack(pop)
+		static_assert(sizeof(FrozenNode) == 16 && sizeof(FrozenChild) == 32 && sizeof(FrozenStruct) == 16 && sizeof(FrozenStructMember) == 16);
+
+		class FrozenData;
+		// Lightweight read-only view of a value within a FrozenData buffer. Only valid as long as the FrozenData instance exists.
+		class DLLUDM FrozenProperty {
+		  public:
+			FrozenProperty() = default;
+			FrozenProperty(const uint8_t *data, const FrozenNode *node) : m_data {data}, m_node {node} {}
+
+			Type GetType() const { return m_node ? m_node->type : Type::Nil; }
+			bool IsType(Type type) const { return GetType() == type; }
+			Type GetValueType() const { return m_node ? m_node->valueType : Type::Nil; }
+			ArrayType GetArrayType() const { return m_node ? m_node->arrayType : ArrayType::Raw; }
+			// Number of children for elements, number of items for arrays
+			uint32_t GetSize() const;
+
+			// Element children are sorted by key
+			std::string_view GetKey(uint32_t idx) const;
+			FrozenProperty GetChild(uint32_t idx) const;
+			FrozenProperty operator[](const std::string_view &key) const;
+			FrozenProperty operator[](const char *key) const { return operator[](std::string_view {key}); }
+			FrozenProperty operator[](uint32_t idx) const;
+			FrozenProperty GetFromPath(const std::string_view &path) const;
+
+			// Returns nullptr if the property is not of type T, T has to be a trivial type
+			template<typename T>
+			const T *GetValuePtr() const;
+			template<typename T>
+			std::optional<T> ToValue() const;
+			template<typename T>
+			T ToValue(const T &defaultValue) const;
+			template<typename T>
+			T operator()(const T &defaultValue) const
+			{
+				return ToValue<T>(defaultValue);
+			}
+
+			// String, Utf8String and Reference values
+			std::string_view GetString() const;
+			// Blob, BlobLz4 (compressed), Utf8String and Struct values
+			std::span<const uint8_t> GetBlobData() const;
+			// Arrays of trivial types
+			template<typename T>
+			std::span<const T> GetArray() const;
+
+			PProperty Thaw() const;
+
+			explicit operator bool() const { return m_node != nullptr; }
+		  private:
+			friend FrozenData;
+			template<typename T>
+			const T *GetData(uint64_t offset) const
+			{
+				return reinterpret_cast<const T *>(m_data + offset);
+			}
+			std::string_view GetString(uint64_t offset, uint32_t len) const { return std::string_view {reinterpret_cast<const char *>(m_data) + offset, len}; }
+			const void *GetPayload() const { return m_data + m_node->offset; }
+			void ThawValue(void *outValue) const;
+			void ThawStruct(StructDescription &outDesc) const;
+
+			const uint8_t *m_data = nullptr;
+			const FrozenNode *m_node = nullptr;
+		};
+
+		class DLLUDM FrozenData {
+		  public:
+			static std::shared_ptr<const FrozenData> Create(const Property &root, const Header &header = {});
+			FrozenData(const FrozenData &) = delete;
+			FrozenData &operator=(const FrozenData &) = delete;
+
+			FrozenProperty GetRoot() const { return FrozenProperty {m_buffer.get(), reinterpret_cast<const FrozenNode *>(m_buffer.get())}; }
+			FrozenProperty operator[](const std::string_view &key) const { return GetRoot()[key]; }
+			FrozenProperty GetFromPath(const std::string_view &path) const { return GetRoot().GetFromPath(path); }
+			FrozenProperty GetAssetData() const;
+			const Header &GetHeader() const { return m_header; }
+			// Size of the buffer in bytes
+			size_t GetSize() const { return m_size; }
+
+			std::shared_ptr<Data> Thaw() const;
+		  private:
+			FrozenData() = default;
+			std::unique_ptr<uint8_t[]> m_buffer = nullptr;
+			size_t m_size = 0;
+			Header m_header {};
+		};
+
+		template<typename T>
+		const T *FrozenProperty::GetValuePtr() const
+		{
+			constexpr auto type = type_to_enum_s<T>();
+			if constexpr(type == Type::Invalid || !is_trivial_type(type))
+				return nullptr;
+			else {
+				if(!m_node || m_node->type != type)
+					return nullptr;
+				return static_cast<const T *>(GetPayload());
+			}
+		}
+
+		template<typename T>
+		std::optional<T> FrozenProperty::ToValue() const
+		{
+			if(!m_node)
+				return {};
+			auto vs = [&](auto tag) -> std::optional<T> {
+				using TTag = typename decltype(tag)::type;
+				if constexpr(is_trivial_type(type_to_enum<TTag>())) {
+					if constexpr(is_convertible<TTag, T>())
+						return convert<TTag, T>(*static_cast<const TTag *>(GetPayload()));
+				}
+				else if constexpr(std::is_same_v<TTag, String>) {
+					if constexpr(is_convertible<TTag, T>())
+						return convert<TTag, T>(String {GetString()});
+				}
+				return {};
+			};
+			return visit(m_node->type, vs);
+		}
+
+		template<typename T>
+		T FrozenProperty::ToValue(const T &defaultValue) const
+		{
+			auto val = ToValue<T>();
+			return val.has_value() ? *val : defaultValue;
+		}
+
+		template<typename T>
+		std::span<const T> FrozenProperty::GetArray() const
+		{
+			constexpr auto type = type_to_enum_s<T>();
+			if constexpr(type == Type::Invalid || !is_trivial_type(type))
+				return {};
+			else {
+				if(!m_node || !is_array_type(m_node->type) || m_node->valueType != type)
+					return {};
+				return std::span<const T> {static_cast<const T *>(GetPayload()), m_node->size};
+			}
+		}
+	}
+}
+
+// --- END PARTITION: src/interface/frozen.cppm ---
+
 // --- BEGIN PARTITION: src/interface/data.cppm ---
 /*
 // SPDX-FileCopyrightText: © 2021 Silverlan <opensource@pragma-engine.com>
@@ -3583,6 +4774,9 @@ export module pragma.udm:data;
 export import :core;
 export import :enums;
 export import :file;
+import :frozen;
+export import :key;
+import :path_cache;
 import :property;
 export import :types;
 */
@@ -3605,8 +4799,34 @@ export {
 			static std::shared_ptr<Data> Open(const std::string &fileName);
 			static std::shared_ptr<Data> Open(std::unique_ptr<IFile> &&f);
 			static std::shared_ptr<Data> Open(const pragma::filesystem::VFilePtr &f);
+			// Parses ASCII data in place, without copying the buffer first. The buffer only has to remain valid until the function returns.
+			static std::shared_ptr<Data> LoadAscii(const std::string_view &data);
+			// Memory-maps the file at the specified path and parses it in place. The path is a regular file system path, not a virtual one.
+			static std::shared_ptr<Data> LoadAsciiMapped(const std::string &systemPath);
+			// Converts between the binary and the ASCII format in a single pass, without building a property tree. Apart from the input buffer
+			// (and the positions of its blocks for ASCII input), memory usage only depends on the nesting depth and the size of the largest array
+			// that doesn't contain elements. The result is equivalent to loading the input and saving it in the other format. Binary input has
+			// to be seekable, since children are written in sorted order, and so does binary output, since block sizes are only known once the
+			// block has been written.
+			static void TranscodeToAscii(IFile &in, IFile &out, AsciiSaveFlags flags = AsciiSaveFlags::Default);
+			static void TranscodeToBinary(const std::string_view &ascii, IFile &out);
+			static void TranscodeToBinaryMapped(const std::string &systemPath, IFile &out);
+			// Parses JSON in place. Objects become elements, and arrays whose items are all numbers, booleans, strings, objects or arrays become
+			// typed arrays. Integers become Int32, or UInt64 (Int64 if any of them are negative) if they don't fit, other numbers Double, null
+			// becomes Nil. If the root object has no "assetData" key, the entire document becomes the asset data, otherwise "assetVersion" is
+			// read as UInt32.
+			// 'typeHints' overrides the type of the values at specific paths, i.e. keys starting at the root object separated by '/', without
+			// array indices. For arrays the hint is the value type, e.g. {"mesh/vertices", Type::Vector3} packs both [[x,y,z],...] and [x,y,z,...]
+			// into a Vector3 array. Numeric values can be hinted as any numeric type, strings as Reference, Utf8String or Blob (base64 data).
+			static std::shared_ptr<Data> LoadJson(const std::string_view &json, const KeyMap<Type> &typeHints = {});
 			static std::shared_ptr<Data> Create(const std::string &assetType, Version assetVersion);
 			static std::shared_ptr<Data> Create();
+			// By default the copy shares all properties with this instance until either of them is modified. Until then both have to be
+			// synchronized as one document, and references obtained from one of them may refer to the other's values once it is written to
+			// (see Property::Share).
+			std::shared_ptr<Data> Copy(MergeFlags mergeFlags = MergeFlags::CopyOnWrite) const;
+			// Creates an immutable copy of this data in a single contiguous buffer, which can be shared between threads
+			std::shared_ptr<const FrozenData> Freeze() const;
 			static bool DebugTest();
 
 			PProperty LoadProperty(const std::string_view &path) const;
@@ -3625,7 +4845,14 @@ export {
 			bool operator==(const Data &other) const;
 			bool operator!=(const Data &other) const { return !operator==(other); }
 
+			// Child of the asset data. Doesn't use the path cache, so lookups can be made concurrently (see PathCache).
 			LinkedPropertyWrapper operator[](const std::string &key) const;
+			// Resolves a path relative to the root element (see PathCursor::DownPath). If the path cache is enabled, the result is cached
+			// until the structure of the data changes.
+			PropertyWrapper ResolvePath(const std::string_view &path);
+			void SetPathCacheEnabled(bool enabled);
+			bool IsPathCacheEnabled() const { return m_pathCache != nullptr; }
+			const PathCache *GetPathCache() const { return m_pathCache.get(); }
 			Element *operator->();
 			const Element *operator->() const;
 			Element &operator*();
@@ -3641,11 +4868,19 @@ export {
 			const Header &GetHeader() const { return m_header; }
 
 			static std::string ReadKey(IFile &f);
-			static void WriteKey(IFile &f, const std::string &key);
+			static void WriteKey(IFile &f, const std::string_view &key);
 		  private:
 			friend AsciiReader;
+			friend AsciiWriter;
+			friend JsonReader;
 			friend ArrayLz4;
+			friend FrozenData;
+			// Wraps the root in an asset data element if it doesn't have one, then initializes the header from it
+			static std::shared_ptr<Data> CreateFromRootProperty(PProperty rootProp);
 			bool ValidateHeaderProperties();
+			// Throws an InvalidFormatError if the header is invalid
+			static Header ReadHeader(IFile &f);
+			void ToAscii(AsciiWriter &writer, AsciiSaveFlags flags) const;
 			static void SkipProperty(IFile &f, Type type);
 			PProperty LoadProperty(Type type, const std::string_view &path) const;
 			static PProperty ReadProperty(IFile &f);
@@ -3654,6 +4889,7 @@ export {
 			Header m_header;
 			std::unique_ptr<IFile> m_file = nullptr;
 			PProperty m_rootProperty = nullptr;
+			std::unique_ptr<PathCache> m_pathCache = nullptr;
 		};
 	}
 }
@@ -3669,6 +4905,7 @@ module;
 
 export module pragma.udm:wrapper_funcs_impl;
 
+import :path_cache;
 import :property;
 import :types.string;
 import :wrapper_funcs;
@@ -3706,6 +4943,11 @@ export {
 		return prop.GetValuePtr<T>();
 	}
 	template<typename T>
+	const T *udm::get_property_value_ptr(const Property &prop)
+	{
+		return prop.GetValuePtr<T>();
+	}
+	template<typename T>
 	std::optional<T> udm::to_property_value(Property &prop)
 	{
 		return prop.ToValue<T>();
@@ -3734,6 +4976,11 @@ export {
 	{
 		return a.GetValuePtr<T>(idx);
 	}
+	template<typename T>
+	const T *udm::get_array_value_ptr(const Array &a, uint32_t idx)
+	{
+		return a.GetValuePtr<T>(idx);
+	}
 	template<typename T>
 	    requires(!udm::is_struct_type<T>)
 	void udm::set_array_value(Array &a, uint32_t idx, T &&v)
@@ -3743,6 +4990,13 @@ export {
 	uint32_t udm::get_array_value_size(const Array &a) { return a.GetValueSize(); }
 	uint32_t udm::get_array_size(const Array &a) { return a.GetSize(); }
 	void *udm::get_array_values(Array &a) { return a.GetValues(); }
+	const void *udm::get_array_values(const Array &a) { return a.GetValues(); }
+	template<typename T>
+	std::span<T> udm::get_array_span(Array &a)
+	{
+		auto span = a.TryAsSpan<T>();
+		return span ? *span : std::span<T> {};
+	}
 	bool udm::is_array_value_type(const Array &a, Type pvalueType) { return a.IsValueType(pvalueType); }
 
 	template<typename T>
@@ -3763,19 +5017,21 @@ export {
 			return nullptr;
 		return &it->second;
 	}
-	void udm::remove_element_child(Element &e, const std::string_view &key)
+	const udm::PProperty *udm::find_element_child(const Element &e, const std::string_view &key)
 	{
 		auto it = e.children.find(key);
 		if(it == e.children.end())
-			return;
-		e.children.erase(it);
+			return nullptr;
+		return &it->second;
 	}
+	void udm::remove_element_child(Element &e, const std::string_view &key) { e.EraseValue(key); }
 	void udm::erase_element_child(Element &e, Element &child) { e.EraseValue(child); }
-	void udm::set_element_child_value(Element &e, const std::string_view &key, const PProperty &prop) { e.children[std::string {key}] = prop; }
+	void udm::set_element_child_value(Element &e, const std::string_view &key, const PProperty &prop) { e.AddChild(std::string {key}, prop); }
 	template<typename T>
 	void udm::set_element_value(Element &parent, Element &child, T &&v)
 	{
 		parent.SetValue(child, std::forward<T>(v));
+		invalidate_path_caches(parent);
 	}
 	udm::PropertyWrapper &udm::get_element_parent_property(Element &e) { return e.parentProperty; }
 
@@ -3836,11 +5092,15 @@ export {
 				udm::get_property_value<T>(*static_cast<Property *>(nullptr));
 				udm::get_property_value<T>(*static_cast<PropertyWrapper *>(nullptr));
 				udm::get_property_value_ptr<T>(*static_cast<Property *>(nullptr));
+				udm::get_property_value_ptr<T>(*static_cast<const Property *>(nullptr));
 				udm::to_property_value<T>(*static_cast<Property *>(nullptr));
 				udm::set_property_value(*static_cast<Property *>(nullptr), v);
 
 				udm::get_array_value<T>(*static_cast<Array *>(nullptr), 0u);
 				udm::get_array_value_ptr<T>(*static_cast<Array *>(nullptr), 0u);
+				udm::get_array_value_ptr<T>(*static_cast<const Array *>(nullptr), 0u);
+				udm::get_array_span<T>(*static_cast<Array *>(nullptr));
+				udm::get_array_span<const T>(*static_cast<Array *>(nullptr));
 				udm::set_array_value<T>(*static_cast<Array *>(nullptr), 0u, std::forward<T>(v));
 				udm::get_array_begin_iterator<T>(*static_cast<Array *>(nullptr), *static_cast<ArrayIterator<T> *>(nullptr));
 				udm::get_array_end_iterator<T>(*static_cast<Array *>(nullptr), *static_cast<ArrayIterator<T> *>(nullptr));
@@ -3869,6 +5129,931 @@ export {
 
 // --- END PARTITION: src/interface/wrapper_funcs_impl.cppm ---
 
+// --- BEGIN PARTITION: src/interface/statistics.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:statistics;
+
+export import :enums;
+export import :types;
+*/
+
+// --- START BODY: src/interface/statistics.cppm ---
+
+export {
+	namespace udm {
+		// Note: All sizes are estimates of the heap memory held by a property tree; Allocator and hash map bookkeeping overhead is approximated.
+		// Values shared between multiple properties (see MergeFlags::CopyOnWrite) are only counted once.
+		struct DLLUDM MemoryStatistics {
+			struct Subtree {
+				std::string path;
+				uint64_t size = 0;
+			};
+			static MemoryStatistics Calculate(const Property &prop, uint32_t numLargestSubtrees = 10);
+			static MemoryStatistics Calculate(const Element &el, uint32_t numLargestSubtrees = 10);
+
+			uint64_t nodeBytes = 0;    // Property, Element and Array objects, as well as the hash map entries holding them
+			uint64_t keyBytes = 0;     // Heap memory of element keys (keys covered by the small string optimization are included in nodeBytes)
+			uint64_t trivialBytes = 0; // Values of trivial type (numbers, vectors, matrices, etc.)
+			uint64_t stringBytes = 0;  // String, Utf8String and Reference values
+			uint64_t structBytes = 0;  // Struct values (excluding struct arrays)
+			uint64_t arrayBytes = 0;   // Uncompressed array data
+			uint64_t lz4CompressedBytes = 0;   // Compressed data of ArrayLz4 arrays
+			uint64_t lz4DecompressedBytes = 0; // Uncompressed data of ArrayLz4 arrays that is currently held in memory
+			uint64_t blobBytes = 0;            // Blob and BlobLz4 values
+			// Number of properties per type, elements stored in arrays are included
+			std::array<uint64_t, static_cast<size_t>(Type::Count)> typeCounts {};
+			uint32_t maxDepth = 0;
+			// Sorted by size in descending order. Subtrees of compressed element arrays are only included while the array is decompressed.
+			std::vector<Subtree> largestSubtrees;
+
+			uint64_t GetTotalSize() const;
+			uint64_t GetTypeCount(Type type) const;
+			uint64_t GetNodeCount() const;
+		  private:
+			struct Collector;
+		};
+	}
+}
+
+// --- END PARTITION: src/interface/statistics.cppm ---
+
+// --- BEGIN PARTITION: src/interface/parallel.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:parallel;
+
+export import :array;
+export import :property_wrapper;
+*/
+
+// --- START BODY: src/interface/parallel.cppm ---
+
+export {
+	namespace udm {
+		constexpr uint32_t PARALLEL_MIN_ITEMS_PER_TASK = 1024;
+
+		// Number of threads used for parallel operations (including the calling thread)
+		DLLUDM uint32_t get_parallel_thread_count();
+		// Number of chunks [0, numItems) is split into by parallel_for
+		DLLUDM uint32_t get_parallel_chunk_count(uint32_t numItems, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK);
+		// Splits [0, numItems) into chunks and runs them on a shared worker pool. The calling thread participates and
+		// the function blocks until all chunks have been processed. If a chunk throws an exception, the first one is rethrown.
+		DLLUDM void parallel_for(uint32_t numItems, const std::function<void(uint32_t chunkIdx, uint32_t start, uint32_t end)> &task, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK);
+		// Compressed arrays are decompressed the first time their values are accessed, which isn't thread-safe. These decompress the array
+		// (or the value of the property, if it is a compressed array) on the calling thread, so it can be handed to parallel_for.
+		DLLUDM void prepare_parallel_access(const Array &a);
+		DLLUDM void prepare_parallel_access(const Property &prop);
+
+		// The functions below operate on the values of an array (see Array::AsSpan), func has to be safe to call concurrently.
+		template<typename T, typename TFunc>
+		void parallel_for_each(std::span<T> values, TFunc &&func, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			parallel_for(
+			  static_cast<uint32_t>(values.size()),
+			  [&values, &func](uint32_t, uint32_t start, uint32_t end) {
+				  for(auto i = start; i < end; ++i)
+					  func(values[i]);
+			  },
+			  minItemsPerTask);
+		}
+		template<typename T, typename TFunc>
+		void parallel_for_each(Array &a, TFunc &&func, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			parallel_for_each(a.AsSpan<T>(), std::forward<TFunc>(func), minItemsPerTask);
+		}
+		template<typename T, typename TFunc>
+		void parallel_for_each(const PropertyWrapper &prop, TFunc &&func, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			parallel_for_each(prop.AsSpan<T>(), std::forward<TFunc>(func), minItemsPerTask);
+		}
+
+		// Resizes 'out' to the size of 'in' and assigns func(in[i]) to out[i]. 'in' and 'out' may be the same array if TIn and TOut are the same type.
+		template<typename TIn, typename TOut, typename TFunc>
+		void parallel_transform(const Array &in, Array &out, TFunc &&func, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			constexpr auto outType = type_to_enum_s<TOut>();
+			static_assert(outType != Type::Invalid, "Output type has to be a UDM type!");
+			auto inValues = in.AsSpan<TIn>();
+			if(&in == &out && !std::is_same_v<TIn, TOut>)
+				throw InvalidUsageError {"In-place transform requires input and output types to match!"};
+			out.SetValueType(outType);
+			out.Resize(static_cast<uint32_t>(inValues.size()));
+			auto outValues = out.AsSpan<TOut>();
+			parallel_for(
+			  static_cast<uint32_t>(inValues.size()),
+			  [&inValues, &outValues, &func](uint32_t, uint32_t start, uint32_t end) {
+				  for(auto i = start; i < end; ++i)
+					  outValues[i] = func(inValues[i]);
+			  },
+			  minItemsPerTask);
+		}
+
+		// Returns reduce(...reduce(reduce(init, transform(a[0])), transform(a[1]))..., transform(a[n - 1])). reduce has to be associative,
+		// since chunks are reduced independently and then combined in order.
+		template<typename T, typename TResult, typename TReduce, typename TTransform>
+		TResult parallel_transform_reduce(std::span<const T> values, TResult init, TReduce &&reduce, TTransform &&transform, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			auto numItems = static_cast<uint32_t>(values.size());
+			std::vector<std::optional<TResult>> chunkResults {};
+			chunkResults.resize(get_parallel_chunk_count(numItems, minItemsPerTask));
+			parallel_for(
+			  numItems,
+			  [&values, &reduce, &transform, &chunkResults](uint32_t chunkIdx, uint32_t start, uint32_t end) {
+				  TResult result = transform(values[start]);
+				  for(auto i = start + 1; i < end; ++i)
+					  result = reduce(std::move(result), transform(values[i]));
+				  chunkResults[chunkIdx] = std::move(result);
+			  },
+			  minItemsPerTask);
+			for(auto &chunkResult : chunkResults) {
+				if(chunkResult.has_value())
+					init = reduce(std::move(init), std::move(*chunkResult));
+			}
+			return init;
+		}
+		template<typename T, typename TResult, typename TReduce, typename TTransform>
+		TResult parallel_transform_reduce(const Array &a, TResult init, TReduce &&reduce, TTransform &&transform, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			return parallel_transform_reduce<T, TResult>(a.AsSpan<T>(), std::move(init), std::forward<TReduce>(reduce), std::forward<TTransform>(transform), minItemsPerTask);
+		}
+		template<typename T, typename TResult, typename TReduce>
+		TResult parallel_reduce(const Array &a, TResult init, TReduce &&reduce, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			return parallel_transform_reduce<T, TResult>(a, std::move(init), std::forward<TReduce>(reduce), [](const T &v) -> TResult { return v; }, minItemsPerTask);
+		}
+		template<typename T, typename TResult, typename TReduce>
+		TResult parallel_reduce(const PropertyWrapper &prop, TResult init, TReduce &&reduce, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			return parallel_transform_reduce<T, TResult>(prop.AsSpan<const T>(), std::move(init), std::forward<TReduce>(reduce), [](const T &v) -> TResult { return v; }, minItemsPerTask);
+		}
+	}
+}
+
+// --- END PARTITION: src/interface/parallel.cppm ---
+
+// --- BEGIN PARTITION: src/interface/path_query.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:path_query;
+
+export import :exception;
+export import :path_cursor;
+import :util;
+*/
+
+// --- START BODY: src/interface/path_query.cppm ---
+
+export {
+	namespace udm {
+		struct PathSegment {
+			static constexpr auto INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+			Key key {};                       // Child key with precomputed hash, only set if this is not an index segment
+			uint32_t index = INVALID_INDEX;   // Array index
+			constexpr bool IsIndex() const { return index != INVALID_INDEX; }
+		};
+
+		// Splits a path (e.g. a/b[3]/"c d") into key and array index segments and calls 'callback' for each of them. Keys may be enclosed in quotes,
+		// in which case they may contain any character except for quotes. The segment keys refer to the path string.
+		// Returns false if the path is invalid or the callback returned false.
+		template<typename TCallback>
+		    requires(std::is_invocable_r_v<bool, TCallback, const PathSegment &>)
+		constexpr bool for_each_path_segment(const std::string_view &path, TCallback &&callback)
+		{
+			size_t i = 0;
+			while(i < path.length()) {
+				if(path[i] == '\"') {
+					auto end = path.find('\"', i + 1);
+					if(end == std::string_view::npos || !callback(PathSegment {Key {path.substr(i + 1, end - i - 1)}}))
+						return false;
+					i = end + 1;
+				}
+				else {
+					auto end = i;
+					while(end < path.length() && path[end] != PATH_SEPARATOR && path[end] != '[')
+						++end;
+					if(end > i && !callback(PathSegment {Key {path.substr(i, end - i)}}))
+						return false;
+					i = end;
+				}
+				while(i < path.length() && path[i] == '[') {
+					uint32_t idx = 0;
+					auto j = i + 1;
+					for(; j < path.length() && path[j] >= '0' && path[j] <= '9'; ++j) {
+						if(idx > (PathSegment::INVALID_INDEX - 10) / 10)
+							return false; // Overflow
+						idx = idx * 10 + (path[j] - '0');
+					}
+					if(j == i + 1 || j >= path.length() || path[j] != ']' || !callback(PathSegment {{}, idx}))
+						return false;
+					i = j + 1;
+				}
+				if(i < path.length()) {
+					if(path[i] != PATH_SEPARATOR)
+						return false;
+					++i;
+				}
+			}
+			return true;
+		}
+
+		// Same as above, but writes the segments to outSegments. Returns the number of segments, or std::nullopt if the path is invalid or
+		// outSegments is too small.
+		constexpr std::optional<size_t> parse_path(const std::string_view &path, std::span<PathSegment> outSegments)
+		{
+			size_t count = 0;
+			auto valid = for_each_path_segment(path, [&count, &outSegments](const PathSegment &segment) {
+				if(count >= outSegments.size())
+					return false;
+				outSegments[count++] = segment;
+				return true;
+			});
+			if(!valid)
+				return {};
+			return count;
+		}
+
+		// Moves the cursor along the segments. If a segment can't be resolved, the cursor is left unchanged and false is returned.
+		DLLUDM bool evaluate_path(PathCursor &cursor, std::span<const PathSegment> segments);
+
+		// Parsed path that can be evaluated against any number of documents without parsing it again.
+		class DLLUDM PathQuery {
+		  public:
+			// Throws an InvalidUsageError if the path is invalid
+			static PathQuery Compile(const std::string_view &path);
+			PathQuery() = default;
+
+			PathCursor Evaluate(Property &root) const;
+			PathCursor Evaluate(const PropertyWrapper &root) const;
+			const std::string &GetPath() const;
+			std::span<const PathSegment> GetSegments() const { return m_segments; }
+		  private:
+			// Shared between copies, since the segments refer to it
+			std::shared_ptr<const std::string> m_path = nullptr;
+			std::vector<PathSegment> m_segments;
+		};
+
+		// Path query for string literals that is parsed at compile time, e.g.:
+		// constexpr udm::StaticPathQuery query {"a/b[3]/c"};
+		// The segments refer to the string, so it has to outlive the query.
+		template<size_t N>
+		class StaticPathQuery {
+		  public:
+			constexpr StaticPathQuery(const char (&path)[N])
+			{
+				auto count = parse_path(std::string_view {path, N - 1}, m_segments);
+				if(!count.has_value())
+					throw InvalidUsageError {"Invalid path '" + std::string {path} + "'!"};
+				m_count = *count;
+			}
+			PathCursor Evaluate(Property &root) const
+			{
+				PathCursor cursor {root};
+				return evaluate_path(cursor, GetSegments()) ? cursor : PathCursor {};
+			}
+			PathCursor Evaluate(const PropertyWrapper &root) const
+			{
+				PathCursor cursor {root};
+				return evaluate_path(cursor, GetSegments()) ? cursor : PathCursor {};
+			}
+			constexpr std::span<const PathSegment> GetSegments() const { return std::span<const PathSegment> {m_segments.data(), m_count}; }
+		  private:
+			std::array<PathSegment, N> m_segments {};
+			size_t m_count = 0;
+		};
+	}
+}
+
+// --- END PARTITION: src/interface/path_query.cppm ---
+
+// --- BEGIN PARTITION: src/interface/query.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:query;
+
+export import :exception;
+export import :parallel;
+export import :path_cursor;
+*/
+
+// --- START BODY: src/interface/query.cppm ---
+
+export {
+	namespace udm {
+		// Query over a property tree, e.g. "mesh/*/vertices" or "entities[*][?class == \"light\"]/name".
+		// Segments are separated by '/' and consist of an optional name followed by any number of selectors:
+		// - key, "quoted key": Child with the specified key
+		// - *: All children of an element, or all items of an array
+		// - **: The property itself and all of its descendants (items of arrays that don't contain elements are excluded)
+		// - [n]: Array item at index n
+		// - [*], [a:b], [a:], [:b]: All array items, or the items in the half-open range [a, b)
+		// - [?key], [?key op value]: Only keeps elements that have a child with the specified key (and whose value satisfies the comparison).
+		//   Supported operators are ==, !=, <, <=, > and >=, the value can be a quoted string, a number, true or false.
+		class DLLUDM Query {
+		  public:
+			static constexpr uint32_t MIN_ITEMS_PER_TASK = 64;
+			// Throws an InvalidUsageError if the query is invalid
+			static Query Compile(const std::string_view &query);
+			Query() = default;
+
+			// Results are in document order, i.e. children of elements are sorted by key (the order in which they're saved) and array items
+			// by index. If 'parallel' is true, branches are evaluated on the worker pool once a selector matches more than minItemsPerTask
+			// properties (see parallel_for).
+			std::vector<PropertyWrapper> Evaluate(Property &root, bool parallel = true, uint32_t minItemsPerTask = MIN_ITEMS_PER_TASK) const;
+			std::vector<PropertyWrapper> Evaluate(const PropertyWrapper &root, bool parallel = true, uint32_t minItemsPerTask = MIN_ITEMS_PER_TASK) const;
+			// Calls 'callback' for each result in document order without collecting them first. Evaluation stops if the callback returns false.
+			void ForEach(Property &root, const std::function<bool(const PropertyWrapper &)> &callback) const;
+			void ForEach(const PropertyWrapper &root, const std::function<bool(const PropertyWrapper &)> &callback) const;
+			const std::string &GetQuery() const { return m_query; }
+		  private:
+			enum class CompareOp : uint8_t { Exists = 0, Equal, NotEqual, Less, LessOrEqual, Greater, GreaterOrEqual };
+			struct Step {
+				enum class Kind : uint8_t { Child = 0, AnyChild, Descendants, Index, Range, Predicate };
+				Kind kind = Kind::Child;
+				std::string key;
+				uint32_t start = 0;
+				uint32_t end = std::numeric_limits<uint32_t>::max();
+				CompareOp op = CompareOp::Exists;
+				std::variant<std::string, double, bool> value;
+			};
+			using Node = PathCursor::Frame;
+			using Callback = std::function<bool(const Node &)>;
+			struct EvaluationContext;
+			bool Evaluate(EvaluationContext &ctx, const Node &node, size_t stepIdx) const;
+			// Returns false if evaluation was stopped by the output callback
+			bool EvaluateAll(EvaluationContext &ctx, const std::vector<Node> &nodes, size_t stepIdx, bool descendants) const;
+			bool EvaluateDescendants(EvaluationContext &ctx, const Node &node, size_t stepIdx) const;
+			bool Matches(const Node &node, const Step &step) const;
+			std::vector<PropertyWrapper> Evaluate(const Node &root, bool parallel, uint32_t minItemsPerTask) const;
+			void ForEach(const Node &root, const std::function<bool(const PropertyWrapper &)> &callback) const;
+
+			std::string m_query;
+			std::vector<Step> m_steps;
+		};
+	}
+}
+
+// --- END PARTITION: src/interface/query.cppm ---
+
+// --- BEGIN PARTITION: src/interface/walk.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+#include "util_enum_flags.hpp"
+
+export module pragma.udm:walk;
+
+export import :array;
+export import :parallel;
+export import :property;
+export import :types.element;
+*/
+
+// --- START BODY: src/interface/walk.cppm ---
+
+export {
+	namespace udm {
+		enum class WalkResult : uint8_t {
+			Continue = 0,
+			SkipChildren, // Don't visit the children of the current node
+			Stop,         // Stop the walk entirely
+		};
+
+		enum class WalkFlags : uint32_t {
+			None = 0u,
+			// By default only items of element arrays are visited, with this flag the items of all arrays are visited
+			VisitAllArrayItems = 1u,
+		};
+
+		// Node visited by walk(). Array items don't have a property of their own, they're identified by the owning array and their index instead.
+		struct WalkNode {
+			static constexpr auto INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+			Property *prop = nullptr; // nullptr for array items
+			Array *array = nullptr;   // Owning array of an array item
+			uint32_t index = INVALID_INDEX;
+			std::string_view key; // Key within the parent element, empty for array items and the root
+			uint32_t depth = 0;
+			Type type = Type::Nil;
+
+			bool IsArrayItem() const { return array != nullptr; }
+			// Note: Values are not un-shared (see Property::Unshare), values of properties that were copied with MergeFlags::CopyOnWrite
+			// must not be modified through the node.
+			template<typename T>
+			T *GetValuePtr() const
+			{
+				return const_cast<T *>(array ? std::as_const(*array).GetValuePtr<T>(index) : std::as_const(*prop).GetValuePtr<T>());
+			}
+			Element *GetElement() const { return (type == Type::Element) ? GetValuePtr<Element>() : nullptr; }
+			Array *GetArray() const { return is_array_type(type) ? GetValuePtr<Array>() : nullptr; }
+		};
+
+		struct WalkContext {
+			WalkFlags flags = WalkFlags::None;
+			bool parallel = false;
+			uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK;
+			std::atomic<bool> stopped = false;
+		};
+
+		template<typename TVisitor>
+		bool walk_node(const WalkNode &node, TVisitor &visitor, WalkContext &ctx);
+		template<typename TVisitor>
+		bool walk_children(const WalkNode &node, TVisitor &visitor, WalkContext &ctx)
+		{
+			auto depth = node.depth + 1;
+			auto *el = node.GetElement();
+			if(el) {
+				if(!ctx.parallel || el->children.size() < ctx.minItemsPerTask) {
+					for(auto &[key, child] : el->children) {
+						if(child && !walk_node(WalkNode {child.get(), nullptr, WalkNode::INVALID_INDEX, key, depth, child->type}, visitor, ctx))
+							return false;
+					}
+					return true;
+				}
+				// Element children can't be accessed by index, so they have to be collected first
+				std::vector<std::pair<const std::string *, Property *>> children;
+				children.reserve(el->children.size());
+				for(auto &[key, child] : el->children) {
+					if(!child)
+						continue;
+					prepare_parallel_access(*child);
+					children.push_back({&key, child.get()});
+				}
+				parallel_for(
+				  static_cast<uint32_t>(children.size()),
+				  [&children, &visitor, &ctx, depth](uint32_t, uint32_t start, uint32_t end) {
+					  for(auto i = start; i < end; ++i) {
+						  auto &[key, child] = children[i];
+						  if(!walk_node(WalkNode {child, nullptr, WalkNode::INVALID_INDEX, *key, depth, child->type}, visitor, ctx))
+							  return;
+					  }
+				  },
+				  ctx.minItemsPerTask);
+				return !ctx.stopped;
+			}
+			auto *a = node.GetArray();
+			if(!a)
+				return true;
+			auto valueType = a->GetValueType();
+			if(valueType != Type::Element && !pragma::math::is_flag_set(ctx.flags, WalkFlags::VisitAllArrayItems))
+				return true;
+			auto size = a->GetSize();
+			if(!ctx.parallel || size < ctx.minItemsPerTask) {
+				for(auto i = decltype(size) {0u}; i < size; ++i) {
+					if(!walk_node(WalkNode {nullptr, a, i, {}, depth, valueType}, visitor, ctx))
+						return false;
+				}
+				return true;
+			}
+			prepare_parallel_access(*a);
+			parallel_for(
+			  size,
+			  [a, valueType, &visitor, &ctx, depth](uint32_t, uint32_t start, uint32_t end) {
+				  for(auto i = start; i < end; ++i) {
+					  if(!walk_node(WalkNode {nullptr, a, i, {}, depth, valueType}, visitor, ctx))
+						  return;
+				  }
+			  },
+			  ctx.minItemsPerTask);
+			return !ctx.stopped;
+		}
+
+		template<typename TVisitor>
+		bool walk_node(const WalkNode &node, TVisitor &visitor, WalkContext &ctx)
+		{
+			if(ctx.parallel && ctx.stopped.load(std::memory_order_relaxed))
+				return false;
+			auto result = WalkResult::Continue;
+			if constexpr(std::is_void_v<std::invoke_result_t<TVisitor &, const WalkNode &>>)
+				visitor(node);
+			else
+				result = visitor(node);
+			if(result == WalkResult::SkipChildren)
+				return true;
+			if(result == WalkResult::Stop) {
+				ctx.stopped = true;
+				return false;
+			}
+			return walk_children(node, visitor, ctx);
+		}
+
+		// Visits the property and all of its descendants in depth-first order without allocating any wrappers.
+		// The visitor is called as visitor(const WalkNode &) and may return a WalkResult to prune or stop the walk.
+		// Returns false if the walk was stopped. The tree must not be modified structurally during the walk.
+		template<typename TVisitor>
+		bool walk(Property &root, TVisitor &&visitor, WalkFlags flags = WalkFlags::None)
+		{
+			WalkContext ctx {flags};
+			return walk_node(WalkNode {&root, nullptr, WalkNode::INVALID_INDEX, {}, 0, root.type}, visitor, ctx);
+		}
+
+		// Same as walk(), but the children of elements and arrays with at least minItemsPerTask children are visited on the worker pool
+		// (see parallel_for). The visitor has to be safe to call concurrently, and the order in which nodes are visited is unspecified (parents
+		// are always visited before their children). If the walk is stopped, nodes that are already being visited on other threads may still complete.
+		// Compressed arrays are decompressed before they're handed to other threads (see prepare_parallel_access).
+		template<typename TVisitor>
+		bool walk_parallel(Property &root, TVisitor &&visitor, WalkFlags flags = WalkFlags::None, uint32_t minItemsPerTask = 64)
+		{
+			WalkContext ctx {flags, true, minItemsPerTask};
+			return walk_node(WalkNode {&root, nullptr, WalkNode::INVALID_INDEX, {}, 0, root.type}, visitor, ctx);
+		}
+	}
+
+	REGISTER_ENUM_FLAGS(udm::WalkFlags)
+}
+
+// --- END PARTITION: src/interface/walk.cppm ---
+
+// --- BEGIN PARTITION: src/interface/struct_binding.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:struct_binding;
+
+export import :exception;
+export import :key;
+export import :property;
+export import :types.element;
+*/
+
+// --- START BODY: src/interface/struct_binding.cppm ---
+
+export {
+	namespace udm {
+		template<typename TClass, typename TMember>
+		struct StructMember {
+			using ClassType = TClass;
+			using MemberType = TMember;
+			Key key;
+			TMember TClass::*member;
+		};
+		template<typename TClass, typename TMember>
+		constexpr StructMember<TClass, TMember> struct_member(const char *key, TMember TClass::*member)
+		{
+			return StructMember<TClass, TMember> {Key {key}, member};
+		}
+
+		// Specialize this template to bind a C++ struct to an element, e.g.:
+		// template<>
+		// struct udm::StructBinding<Transform> {
+		// 	static constexpr auto members = std::make_tuple(udm::struct_member("position", &Transform::position), udm::struct_member("rotation", &Transform::rotation));
+		// };
+		// Members have to be UDM value types (see type_to_enum) or bound structs themselves, which are stored as child elements.
+		template<typename T>
+		struct StructBinding;
+
+		template<typename T>
+		concept BoundStruct = requires { StructBinding<T>::members; };
+
+		template<typename T>
+		constexpr bool is_bindable_member_type()
+		{
+			if constexpr(BoundStruct<T>)
+				return true;
+			else
+				return type_to_enum_s<T>() != Type::Invalid && type_to_enum_s<T>() != Type::Element && !is_array_type(type_to_enum_s<T>());
+		}
+
+		template<BoundStruct T>
+		bool read_struct(const Element &el, T &outValue);
+
+		// Reads a single member, values of a different type are converted if possible. Returns false if the child doesn't exist or can't be converted.
+		template<typename TMember>
+		bool read_struct_member(const Element &el, const Key &key, TMember &outValue)
+		{
+			static_assert(is_bindable_member_type<TMember>(), "Member type is not supported!");
+			auto it = el.children.find(key);
+			if(it == el.children.end() || !it->second)
+				return false;
+			const auto &prop = *it->second;
+			if constexpr(BoundStruct<TMember>) {
+				auto *child = prop.GetValuePtr<Element>();
+				return child && read_struct(*child, outValue);
+			}
+			else {
+				auto *value = prop.GetValuePtr<TMember>();
+				if(value) {
+					outValue = *value;
+					return true;
+				}
+				auto converted = prop.ToValue<TMember>();
+				if(!converted.has_value())
+					return false;
+				outValue = std::move(*converted);
+				return true;
+			}
+		}
+
+		// Assigns all bound members that exist in the element. Returns false if any of them were missing or couldn't be converted,
+		// in which case they're left unchanged.
+		template<BoundStruct T>
+		bool read_struct(const Element &el, T &outValue)
+		{
+			return std::apply([&el, &outValue](const auto &...members) { return (static_cast<uint32_t>(read_struct_member(el, members.key, outValue.*members.member)) + ... + 0u) == sizeof...(members); },
+			  StructBinding<T>::members);
+		}
+		template<BoundStruct T>
+		bool read_struct(const PropertyWrapper &prop, T &outValue)
+		{
+			auto *el = prop.GetConstValuePtr<Element>();
+			return el && read_struct(*el, outValue);
+		}
+
+		template<BoundStruct T>
+		void write_struct(Element &el, const T &value);
+
+		// Children of a different type are replaced
+		template<typename TMember>
+		void write_struct_member(Element &el, const Key &key, const TMember &value)
+		{
+			static_assert(is_bindable_member_type<TMember>(), "Member type is not supported!");
+			if constexpr(BoundStruct<TMember>) {
+				auto child = el.Add(key, Type::Element);
+				write_struct(*child->GetValuePtr<Element>(), value);
+			}
+			else {
+				auto child = el.Add(key, type_to_enum<TMember>());
+				*child->GetValuePtr<TMember>() = value;
+			}
+		}
+
+		template<BoundStruct T>
+		void write_struct(Element &el, const T &value)
+		{
+			std::apply([&el, &value](const auto &...members) { (write_struct_member(el, members.key, value.*members.member), ...); }, StructBinding<T>::members);
+		}
+		template<BoundStruct T>
+		void write_struct(const PropertyWrapper &prop, const T &value)
+		{
+			auto *el = prop.GetValuePtr<Element>();
+			if(!el)
+				throw InvalidUsageError {"Attempted to write struct to non-element property!"};
+			write_struct(*el, value);
+		}
+	}
+}
+
+// --- END PARTITION: src/interface/struct_binding.cppm ---
+
+// --- BEGIN PARTITION: src/interface/base64.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:base64;
+
+export import std.compat;
+*/
+
+// --- START BODY: src/interface/base64.cppm ---
+
+export {
+	namespace udm {
+		// Number of characters 'size' bytes are encoded to, including padding
+		constexpr size_t base64_get_encoded_size(size_t size) { return ((size + 2) / 3) * 4; }
+		// Upper bound for the number of bytes 'size' characters are decoded to
+		constexpr size_t base64_get_max_decoded_size(size_t size) { return ((size + 3) / 4) * 3; }
+
+		// Writes base64_get_encoded_size(size) characters to 'out'
+		DLLUDM void base64_encode(const void *data, size_t size, char *out);
+		DLLUDM std::string base64_encode(const void *data, size_t size);
+		// Decodes 'str' into 'out', which has to have room for at least base64_get_max_decoded_size(str.size()) bytes.
+		// Whitespace is ignored. Returns the number of bytes written, or std::nullopt if 'str' is not valid base64.
+		DLLUDM std::optional<size_t> base64_decode(const std::string_view &str, void *out);
+	}
+}
+
+// --- END PARTITION: src/interface/base64.cppm ---
+
+// --- BEGIN PARTITION: src/interface/text_writer.cppm ---
+/*
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:text_writer;
+
+export import :file;
+export import :structure;
+export import :trivial_types;
+*/
+
+// --- START BODY: src/interface/text_writer.cppm ---
+
+export {
+	namespace udm {
+		// Output of the text formats (see AsciiWriter and JsonWriter), which is written through a fixed-size buffer to a file, a stream or a string
+		class DLLUDM TextBuffer {
+		  public:
+			static constexpr size_t BUFFER_SIZE = 64 * 1024;
+			TextBuffer(IFile &f);
+			TextBuffer(std::stringstream &ss);
+			TextBuffer(std::string &outStr);
+			TextBuffer(const TextBuffer &) = delete;
+			TextBuffer &operator=(const TextBuffer &) = delete;
+			~TextBuffer();
+			void Flush();
+			// Number of characters written so far, including the ones that haven't been flushed yet
+			size_t Tell() const { return m_numFlushed + m_size; }
+		  protected:
+			void Write(const std::string_view &str);
+			void Write(char c);
+			// Encodes the data straight into the buffer, without any delimiters
+			void WriteBase64(const void *data, size_t size);
+			// Calls write(first, last) with room for at least maxSize characters in the buffer, write returns a pointer past the last character it wrote
+			template<typename TFunc>
+			void WriteChars(size_t maxSize, const TFunc &write);
+		  private:
+			void WriteToSink(const char *data, size_t size);
+
+			IFile *m_file = nullptr;
+			std::stringstream *m_stream = nullptr;
+			std::string *m_string = nullptr;
+			std::unique_ptr<char[]> m_buffer;
+			size_t m_size = 0;
+			size_t m_numFlushed = 0;
+		};
+
+		// Values that are written as lists of numbers in both text formats. TDerived has to provide WriteNumber for all numeric types and
+		// WriteValue for all generic types, and TDerived::LIST_SEPARATOR is written between the lists of transforms and matrices.
+		template<class TDerived>
+		class TextWriter : public TextBuffer {
+		  public:
+			using TextBuffer::TextBuffer;
+			// Writes the members of the struct as a list, e.g. "[1,2,3]"
+			void WriteStructValue(const StructDescription &strct, const void *data);
+		  protected:
+			template<typename... T>
+			void WriteNumberList(T... values);
+
+			void WriteValue(const Vector2 &v) { WriteNumberList(v.x, v.y); }
+			void WriteValue(const Vector2i &v) { WriteNumberList(v.x, v.y); }
+			void WriteValue(const Vector3 &v) { WriteNumberList(v.x, v.y, v.z); }
+			void WriteValue(const Vector3i &v) { WriteNumberList(v.x, v.y, v.z); }
+			void WriteValue(const Vector4 &v) { WriteNumberList(v.x, v.y, v.z, v.w); }
+			void WriteValue(const Vector4i &v) { WriteNumberList(v.x, v.y, v.z, v.w); }
+			void WriteValue(const Quaternion &q) { WriteNumberList(q.w, q.x, q.y, q.z); }
+			void WriteValue(const EulerAngles &a) { WriteNumberList(a.p, a.y, a.r); }
+			void WriteValue(const Srgba &srgb) { WriteNumberList(srgb[0], srgb[1], srgb[2], srgb[3]); }
+			void WriteValue(const HdrColor &col) { WriteNumberList(col[0], col[1], col[2]); }
+			void WriteValue(const Transform &t);
+			void WriteValue(const ScaledTransform &t);
+			void WriteValue(const Mat4 &m);
+			void WriteValue(const Mat3x4 &m);
+		  private:
+			TDerived &GetDerived() { return static_cast<TDerived &>(*this); }
+			void WriteListSeparator() { Write(TDerived::LIST_SEPARATOR); }
+		};
+
+		template<typename TFunc>
+		void TextBuffer::WriteChars(size_t maxSize, const TFunc &write)
+		{
+			if(m_size + maxSize > BUFFER_SIZE)
+				Flush();
+			auto *first = m_buffer.get() + m_size;
+			auto *last = write(first, first + maxSize);
+			m_size += last - first;
+		}
+
+		template<class TDerived>
+		template<typename... T>
+		void TextWriter<TDerived>::WriteNumberList(T... values)
+		{
+			Write('[');
+			auto first = true;
+			auto writeValue = [this, &first](auto value) {
+				if(first)
+					first = false;
+				else
+					Write(',');
+				GetDerived().WriteNumber(value);
+			};
+			(writeValue(values), ...);
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteValue(const Transform &t)
+		{
+			auto &pos = t.GetOrigin();
+			auto &rot = t.GetRotation();
+			Write('[');
+			WriteNumberList(pos.x, pos.y, pos.z);
+			WriteListSeparator();
+			WriteNumberList(rot.w, rot.x, rot.y, rot.z);
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteValue(const ScaledTransform &t)
+		{
+			auto &pos = t.GetOrigin();
+			auto &rot = t.GetRotation();
+			auto &scale = t.GetScale();
+			Write('[');
+			WriteNumberList(pos.x, pos.y, pos.z);
+			WriteListSeparator();
+			WriteNumberList(rot.w, rot.x, rot.y, rot.z);
+			WriteListSeparator();
+			WriteNumberList(scale.x, scale.y, scale.z);
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteValue(const Mat4 &m)
+		{
+			Write('[');
+			for(uint8_t i = 0; i < 4; ++i) {
+				if(i > 0)
+					WriteListSeparator();
+				WriteNumberList(m[i][0], m[i][1], m[i][2], m[i][3]);
+			}
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteValue(const Mat3x4 &m)
+		{
+			Write('[');
+			for(uint8_t i = 0; i < 3; ++i) {
+				if(i > 0)
+					WriteListSeparator();
+				WriteNumberList(m[i][0], m[i][1], m[i][2], m[i][3]);
+			}
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteStructValue(const StructDescription &strct, const void *data)
+		{
+			Write('[');
+			auto n = strct.GetMemberCount();
+			auto *ptr = static_cast<const uint8_t *>(data);
+			for(auto i = decltype(n) {0u}; i < n; ++i) {
+				if(i > 0)
+					Write(',');
+				auto type = strct.types[i];
+				if(is_numeric_type(type)) {
+					std::visit(
+					  [this, ptr](auto tag) {
+						  using T = typename decltype(tag)::type;
+						  GetDerived().WriteNumber(*reinterpret_cast<const T *>(ptr));
+					  },
+					  get_numeric_tag(type));
+				}
+				else if(is_generic_type(type)) {
+					std::visit(
+					  [this, ptr](auto tag) {
+						  using T = typename decltype(tag)::type;
+						  GetDerived().WriteValue(*reinterpret_cast<const T *>(ptr));
+					  },
+					  get_generic_tag(type));
+				}
+				else
+					throw InvalidUsageError {"Non-trivial types are not allowed for structs!"};
+				ptr += size_of(type);
+			}
+			Write(']');
+		}
+	}
+}
+
+// --- END PARTITION: src/interface/text_writer.cppm ---
+
 // --- BEGIN PARTITION: src/interface/udm.cppm ---
 /*
 // SPDX-FileCopyrightText: (c) 2025 Silverlan <opensource@pragma-engine.com>
@@ -3880,6 +6065,7 @@ export module pragma.udm;
 export import :array;
 export import :array_iterator;
 export import :asset_data;
+export import :base64;
 export import :basic_types;
 export import :types.blob;
 export import :conversion;
@@ -3889,15 +6075,26 @@ export import :types.element;
 export import :enums;
 export import :exception;
 export import :file;
+export import :frozen;
 export import :half;
+export import :key;
+export import :parallel;
+export import :path_cache;
+export import :path_cursor;
+export import :path_query;
+export import :query;
 export import :property;
 export import :property_wrapper;
 export import :reference;
+export import :statistics;
 export import :types.string;
 export import :structure;
+export import :struct_binding;
+export import :text_writer;
 export import :trivial_types;
 export import :types;
 export import :util;
+export import :walk;
 export import :wrapper_funcs;
 export import :wrapper_funcs_impl;
 */
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:parallel;
+
+export import :array;
+export import :property_wrapper;
+
+export {
+	namespace udm {
+		constexpr uint32_t PARALLEL_MIN_ITEMS_PER_TASK = 1024;
+
+		// Number of threads used for parallel operations (including the calling thread)
+		DLLUDM uint32_t get_parallel_thread_count();
+		// Number of chunks [0, numItems) is split into by parallel_for
+		DLLUDM uint32_t get_parallel_chunk_count(uint32_t numItems, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK);
+		// Splits [0, numItems) into chunks and runs them on a shared worker pool. The calling thread participates and
+		// the function blocks until all chunks have been processed. If a chunk throws an exception, the first one is rethrown.
+		DLLUDM void parallel_for(uint32_t numItems, const std::function<void(uint32_t chunkIdx, uint32_t start, uint32_t end)> &task, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK);
+		// Compressed arrays are decompressed the first time their values are accessed, which isn't thread-safe. These decompress the array
+		// (or the value of the property, if it is a compressed array) on the calling thread, so it can be handed to parallel_for.
+		DLLUDM void prepare_parallel_access(const Array &a);
+		DLLUDM void prepare_parallel_access(const Property &prop);
+
+		// The functions below operate on the values of an array (see Array::AsSpan), func has to be safe to call concurrently.
+		template<typename T, typename TFunc>
+		void parallel_for_each(std::span<T> values, TFunc &&func, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			parallel_for(
+			  static_cast<uint32_t>(values.size()),
+			  [&values, &func](uint32_t, uint32_t start, uint32_t end) {
+				  for(auto i = start; i < end; ++i)
+					  func(values[i]);
+			  },
+			  minItemsPerTask);
+		}
+		template<typename T, typename TFunc>
+		void parallel_for_each(Array &a, TFunc &&func, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			parallel_for_each(a.AsSpan<T>(), std::forward<TFunc>(func), minItemsPerTask);
+		}
+		template<typename T, typename TFunc>
+		void parallel_for_each(const PropertyWrapper &prop, TFunc &&func, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			parallel_for_each(prop.AsSpan<T>(), std::forward<TFunc>(func), minItemsPerTask);
+		}
+
+		// Resizes 'out' to the size of 'in' and assigns func(in[i]) to out[i]. 'in' and 'out' may be the same array if TIn and TOut are the same type.
+		template<typename TIn, typename TOut, typename TFunc>
+		void parallel_transform(const Array &in, Array &out, TFunc &&func, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			constexpr auto outType = type_to_enum_s<TOut>();
+			static_assert(outType != Type::Invalid, "Output type has to be a UDM type!");
+			auto inValues = in.AsSpan<TIn>();
+			if(&in == &out && !std::is_same_v<TIn, TOut>)
+				throw InvalidUsageError {"In-place transform requires input and output types to match!"};
+			out.SetValueType(outType);
+			out.Resize(static_cast<uint32_t>(inValues.size()));
+			auto outValues = out.AsSpan<TOut>();
+			parallel_for(
+			  static_cast<uint32_t>(inValues.size()),
+			  [&inValues, &outValues, &func](uint32_t, uint32_t start, uint32_t end) {
+				  for(auto i = start; i < end; ++i)
+					  outValues[i] = func(inValues[i]);
+			  },
+			  minItemsPerTask);
+		}
+
+		// Returns reduce(...reduce(reduce(init, transform(a[0])), transform(a[1]))..., transform(a[n - 1])). reduce has to be associative,
+		// since chunks are reduced independently and then combined in order.
+		template<typename T, typename TResult, typename TReduce, typename TTransform>
+		TResult parallel_transform_reduce(std::span<const T> values, TResult init, TReduce &&reduce, TTransform &&transform, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			auto numItems = static_cast<uint32_t>(values.size());
+			std::vector<std::optional<TResult>> chunkResults {};
+			chunkResults.resize(get_parallel_chunk_count(numItems, minItemsPerTask));
+			parallel_for(
+			  numItems,
+			  [&values, &reduce, &transform, &chunkResults](uint32_t chunkIdx, uint32_t start, uint32_t end) {
+				  TResult result = transform(values[start]);
+				  for(auto i = start + 1; i < end; ++i)
+					  result = reduce(std::move(result), transform(values[i]));
+				  chunkResults[chunkIdx] = std::move(result);
+			  },
+			  minItemsPerTask);
+			for(auto &chunkResult : chunkResults) {
+				if(chunkResult.has_value())
+					init = reduce(std::move(init), std::move(*chunkResult));
+			}
+			return init;
+		}
+		template<typename T, typename TResult, typename TReduce, typename TTransform>
+		TResult parallel_transform_reduce(const Array &a, TResult init, TReduce &&reduce, TTransform &&transform, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			return parallel_transform_reduce<T, TResult>(a.AsSpan<T>(), std::move(init), std::forward<TReduce>(reduce), std::forward<TTransform>(transform), minItemsPerTask);
+		}
+		template<typename T, typename TResult, typename TReduce>
+		TResult parallel_reduce(const Array &a, TResult init, TReduce &&reduce, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			return parallel_transform_reduce<T, TResult>(a, std::move(init), std::forward<TReduce>(reduce), [](const T &v) -> TResult { return v; }, minItemsPerTask);
+		}
+		template<typename T, typename TResult, typename TReduce>
+		TResult parallel_reduce(const PropertyWrapper &prop, TResult init, TReduce &&reduce, uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK)
+		{
+			return parallel_transform_reduce<T, TResult>(prop.AsSpan<const T>(), std::move(init), std::forward<TReduce>(reduce), [](const T &v) -> TResult { return v; }, minItemsPerTask);
+		}
+	}
+}
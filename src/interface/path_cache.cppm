@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:path_cache;
+
+export import :path_cursor;
+export import :property_wrapper;
+
+export {
+	namespace udm {
+		// Invalidates the path caches of the tree containing the property, element or array. This is done automatically whenever the structure
+		// of a tree changes (children being added, removed or replaced, arrays being reallocated or element/array values being destroyed),
+		// but has to be called manually if Element::children is modified directly.
+		DLLUDM void invalidate_path_caches(const Property &prop);
+		DLLUDM void invalidate_path_caches(const Element &el);
+		DLLUDM void invalidate_path_caches(const Array &a);
+		// Invalidates all path caches
+		DLLUDM void invalidate_path_caches();
+
+		// Caches the results of path lookups relative to a root property. Paths use the same syntax as PathCursor::DownPath.
+		// The cache is only invalidated by structural changes of the tree containing the root property, but properties that have been added
+		// to multiple elements only count as part of the tree of the element they were added to first (see Property::parent).
+		// Note: The cache is not thread-safe.
+		class DLLUDM PathCache {
+		  public:
+			struct Statistics {
+				uint64_t hits = 0;
+				uint64_t misses = 0;
+				uint64_t invalidations = 0;
+			};
+			PathCache() = default;
+			PathCache(const PathCache &) = delete;
+			PathCache &operator=(const PathCache &) = delete;
+			~PathCache();
+
+			// Returns an invalid wrapper if the path doesn't exist
+			PropertyWrapper Find(Property &root, const std::string_view &path);
+			void Clear();
+			size_t GetSize() const { return m_entries.size(); }
+			const Statistics &GetStatistics() const { return m_statistics; }
+			void ResetStatistics() { m_statistics = {}; }
+		  private:
+			struct Entry {
+				Property *prop = nullptr;
+				Array *array = nullptr;
+				uint32_t arrayIndex = PathCursor::INVALID_INDEX;
+			};
+			friend void invalidate_path_caches(const Property &prop);
+			friend void invalidate_path_caches();
+			void Validate(Property &root);
+			void SetRoot(Property *root);
+			pragma::string::StringMap<Entry> m_entries;
+			Property *m_root = nullptr;
+			// Incremented whenever the structure of the tree containing the root changes
+			std::atomic<uint64_t> m_generation = 0;
+			uint64_t m_validGeneration = 0;
+			Statistics m_statistics {};
+		};
+	}
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:path_cursor;
+
+export import :array;
+export import :conversion;
+export import :property;
+export import :types.element;
+
+export {
+	namespace udm {
+		// Lightweight alternative to LinkedPropertyWrapper chains for walking paths. The cursor keeps a fixed-size stack
+		// of frames and never allocates, keys are looked up without creating temporary strings.
+		// The cursor is invalidated if a property on its current path is removed or replaced.
+		class DLLUDM PathCursor {
+		  public:
+			static constexpr uint32_t MAX_DEPTH = 32;
+			static constexpr auto INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+			struct Frame {
+				Property *prop = nullptr; // Set if the value is a property
+				Array *array = nullptr;   // Set if the value is an array item
+				uint32_t arrayIndex = INVALID_INDEX;
+				std::string_view key; // Key within the parent element, empty for array items and the root
+			};
+
+			PathCursor() = default;
+			explicit PathCursor(Property &root);
+			// The cursor is invalid if the wrapper does not refer to an existing property or array item
+			explicit PathCursor(const PropertyWrapper &root);
+
+			// Moves to the child with the specified key of the current element (or element array item).
+			// Returns false and leaves the cursor unchanged if the child doesn't exist or the cursor is at MAX_DEPTH.
+			bool Down(const std::string_view &key);
+			bool Down(const Key &key);
+			// Moves to the item at the specified index of the current array
+			bool Down(uint32_t idx);
+			// Same path syntax as PropertyWrapper::GetFromPath (e.g. a/b[2]/"c d", see parse_path). The cursor is left unchanged if any part of
+			// the path doesn't exist.
+			bool DownPath(const std::string_view &path);
+			bool Up(uint32_t levels = 1);
+			void Reset();
+
+			bool IsValid() const { return m_depth > 0; }
+			explicit operator bool() const { return IsValid(); }
+			// Number of frames below the root
+			uint32_t GetDepth() const { return (m_depth > 0) ? (m_depth - 1) : 0; }
+			const Frame &GetFrame() const { return m_frames[m_depth - 1]; }
+			bool IsArrayItem() const { return IsValid() && GetFrame().array; }
+			Type GetType() const;
+			// Returns nullptr for array items.
+			// Note: Values are not un-shared by these accessors, Unshare has to be called before they're modified (see Property::Unshare)
+			Property *GetProperty() const { return IsValid() ? GetFrame().prop : nullptr; }
+			Element *GetElement() const { return IsValid() ? GetElement(GetFrame()) : nullptr; }
+			Array *GetArray() const { return IsValid() ? GetArray(GetFrame()) : nullptr; }
+			uint32_t GetSize() const;
+
+			template<typename T>
+			T *GetValuePtr() const;
+			template<typename T>
+			std::optional<T> ToValue() const;
+			template<typename T>
+			T ToValue(const T &defaultValue) const
+			{
+				auto val = ToValue<T>();
+				return val.has_value() ? *val : defaultValue;
+			}
+			template<typename T>
+			T operator()(const T &defaultValue) const
+			{
+				return ToValue<T>(defaultValue);
+			}
+			// Assigns a value to the current property or array item. Shared properties (see MergeFlags::CopyOnWrite) along the path
+			// are unshared first. Returns false if the cursor is invalid.
+			template<typename T>
+			bool SetValue(T &&value);
+			// Makes sure the values of the properties along the path aren't shared with other properties
+			void Unshare() const;
+		  private:
+			static Element *GetElement(const Frame &frame);
+			static Array *GetArray(const Frame &frame);
+			bool Push(const Frame &frame);
+
+			std::array<Frame, MAX_DEPTH + 1> m_frames {};
+			uint32_t m_depth = 0;
+		};
+
+		template<typename T>
+		T *PathCursor::GetValuePtr() const
+		{
+			if(!IsValid())
+				return nullptr;
+			Unshare(); // The value may be modified through the returned pointer
+			auto &frame = GetFrame();
+			if(frame.array)
+				return (frame.arrayIndex < frame.array->GetSize()) ? frame.array->GetValuePtr<T>(frame.arrayIndex) : nullptr;
+			return frame.prop->GetValuePtr<T>();
+		}
+
+		template<typename T>
+		std::optional<T> PathCursor::ToValue() const
+		{
+			if(!IsValid())
+				return {};
+			auto &frame = GetFrame();
+			if(!frame.array)
+				return frame.prop->ToValue<T>();
+			if(frame.arrayIndex >= frame.array->GetSize())
+				return {};
+			auto vs = [&frame](auto tag) -> std::optional<T> {
+				using TTag = typename decltype(tag)::type;
+				if constexpr(is_convertible<TTag, T>())
+					return convert<TTag, T>(std::as_const(*frame.array).GetValue<TTag>(frame.arrayIndex));
+				return {};
+			};
+			return visit(frame.array->GetValueType(), vs);
+		}
+
+		template<typename T>
+		bool PathCursor::SetValue(T &&value)
+		{
+			if(!IsValid())
+				return false;
+			Unshare();
+			auto &frame = GetFrame();
+			if(frame.array) {
+				if(frame.arrayIndex >= frame.array->GetSize())
+					return false;
+				frame.array->SetValue(frame.arrayIndex, std::forward<T>(value));
+				return true;
+			}
+			*frame.prop = std::forward<T>(value);
+			return true;
+		}
+	}
+}
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:path_query;
+
+export import :exception;
+export import :path_cursor;
+import :util;
+
+export {
+	namespace udm {
+		struct PathSegment {
+			static constexpr auto INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+			Key key {};                       // Child key with precomputed hash, only set if this is not an index segment
+			uint32_t index = INVALID_INDEX;   // Array index
+			constexpr bool IsIndex() const { return index != INVALID_INDEX; }
+		};
+
+		// Splits a path (e.g. a/b[3]/"c d") into key and array index segments and calls 'callback' for each of them. Keys may be enclosed in quotes,
+		// in which case they may contain any character except for quotes. The segment keys refer to the path string.
+		// Returns false if the path is invalid or the callback returned false.
+		template<typename TCallback>
+		    requires(std::is_invocable_r_v<bool, TCallback, const PathSegment &>)
+		constexpr bool for_each_path_segment(const std::string_view &path, TCallback &&callback)
+		{
+			size_t i = 0;
+			while(i < path.length()) {
+				if(path[i] == '\"') {
+					auto end = path.find('\"', i + 1);
+					if(end == std::string_view::npos || !callback(PathSegment {Key {path.substr(i + 1, end - i - 1)}}))
+						return false;
+					i = end + 1;
+				}
+				else {
+					auto end = i;
+					while(end < path.length() && path[end] != PATH_SEPARATOR && path[end] != '[')
+						++end;
+					if(end > i && !callback(PathSegment {Key {path.substr(i, end - i)}}))
+						return false;
+					i = end;
+				}
+				while(i < path.length() && path[i] == '[') {
+					uint32_t idx = 0;
+					auto j = i + 1;
+					for(; j < path.length() && path[j] >= '0' && path[j] <= '9'; ++j) {
+						if(idx > (PathSegment::INVALID_INDEX - 10) / 10)
+							return false; // Overflow
+						idx = idx * 10 + (path[j] - '0');
+					}
+					if(j == i + 1 || j >= path.length() || path[j] != ']' || !callback(PathSegment {{}, idx}))
+						return false;
+					i = j + 1;
+				}
+				if(i < path.length()) {
+					if(path[i] != PATH_SEPARATOR)
+						return false;
+					++i;
+				}
+			}
+			return true;
+		}
+
+		// Same as above, but writes the segments to outSegments. Returns the number of segments, or std::nullopt if the path is invalid or
+		// outSegments is too small.
+		constexpr std::optional<size_t> parse_path(const std::string_view &path, std::span<PathSegment> outSegments)
+		{
+			size_t count = 0;
+			auto valid = for_each_path_segment(path, [&count, &outSegments](const PathSegment &segment) {
+				if(count >= outSegments.size())
+					return false;
+				outSegments[count++] = segment;
+				return true;
+			});
+			if(!valid)
+				return {};
+			return count;
+		}
+
+		// Moves the cursor along the segments. If a segment can't be resolved, the cursor is left unchanged and false is returned.
+		DLLUDM bool evaluate_path(PathCursor &cursor, std::span<const PathSegment> segments);
+
+		// Parsed path that can be evaluated against any number of documents without parsing it again.
+		class DLLUDM PathQuery {
+		  public:
+			// Throws an InvalidUsageError if the path is invalid
+			static PathQuery Compile(const std::string_view &path);
+			PathQuery() = default;
+
+			PathCursor Evaluate(Property &root) const;
+			PathCursor Evaluate(const PropertyWrapper &root) const;
+			const std::string &GetPath() const;
+			std::span<const PathSegment> GetSegments() const { return m_segments; }
+		  private:
+			// Shared between copies, since the segments refer to it
+			std::shared_ptr<const std::string> m_path = nullptr;
+			std::vector<PathSegment> m_segments;
+		};
+
+		// Path query for string literals that is parsed at compile time, e.g.:
+		// constexpr udm::StaticPathQuery query {"a/b[3]/c"};
+		// The segments refer to the string, so it has to outlive the query.
+		template<size_t N>
+		class StaticPathQuery {
+		  public:
+			constexpr StaticPathQuery(const char (&path)[N])
+			{
+				auto count = parse_path(std::string_view {path, N - 1}, m_segments);
+				if(!count.has_value())
+					throw InvalidUsageError {"Invalid path '" + std::string {path} + "'!"};
+				m_count = *count;
+			}
+			PathCursor Evaluate(Property &root) const
+			{
+				PathCursor cursor {root};
+				return evaluate_path(cursor, GetSegments()) ? cursor : PathCursor {};
+			}
+			PathCursor Evaluate(const PropertyWrapper &root) const
+			{
+				PathCursor cursor {root};
+				return evaluate_path(cursor, GetSegments()) ? cursor : PathCursor {};
+			}
+			constexpr std::span<const PathSegment> GetSegments() const { return std::span<const PathSegment> {m_segments.data(), m_count}; }
+		  private:
+			std::array<PathSegment, N> m_segments {};
+			size_t m_count = 0;
+		};
+	}
+}
@@ -41,15 +41,37 @@ export {
 			template<typename T>
 			void operator=(T &&v);
 			void Copy(const Property &other, bool deepCopy);
+			void Copy(const Property &other, MergeFlags mergeFlags);
 			PProperty Copy(bool deepCopy = false) const;
+			PProperty Copy(MergeFlags mergeFlags) const;
 
 			Hash CalcHash() const;
 
+			// Returns a new property which shares the value of this property until either of them is written to (see MergeFlags::CopyOnWrite).
+			// Trivial values are copied immediately.
+			// Ownership: The property that is written to keeps the value object and the other properties receive a copy, so that references
+			// obtained through the writer remain valid. References that were obtained through one of the other properties before the write
+			// refer to the writer's value afterwards, i.e. only accesses through the properties (or their wrappers) are isolated from each other.
+			// Threading: Since a write replaces the values of the other properties, properties sharing a value have to be synchronized as if they
+			// were one document, even if they belong to different ones. None of them may be written to while any of them is read on another thread.
+			PProperty Share() const;
+			// Returns true if the value is shared with other properties
+			bool IsShared() const { return m_nextShared != nullptr; }
+			// Makes sure neither the value of this property nor the value of any of its parents is shared with other properties, so it can
+			// be written to. The other properties receive a copy of the value, while this property keeps it (see Share).
+			// This is done automatically by all non-const accessors.
+			void Unshare();
+
 			Type type = Type::Nil;
 			DataValue value = nullptr;
+			// Element this property was first added to and its key within that element, used for reverse lookups (see Element::FindKey).
+			// The key points to the key of the element's map node and is only valid as long as the parent is set.
+			Element *parent = nullptr;
+			const std::string *key = nullptr;
 
 			LinkedPropertyWrapper operator[](const std::string &key);
 			LinkedPropertyWrapper operator[](const char *key);
+			LinkedPropertyWrapper operator[](const Key &key);
 
 			bool operator==(const Property &other) const;
 			bool operator!=(const Property &other) const { return !operator==(other); }
@@ -70,7 +92,15 @@ export {
 			const T &GetValue() const;
 			template<typename T>
 			T *GetValuePtr();
+			template<typename T>
+			const T *GetValuePtr() const;
 			void *GetValuePtr(Type &outType);
+			// Non-throwing alternative to GetValue, the returned pointer is never nullptr on success. If the value has to be un-shared
+			// and can't be copied, InvalidProperty is returned.
+			template<typename T>
+			std::expected<T *, AccessError> TryGetValue() noexcept;
+			template<typename T>
+			std::expected<const T *, AccessError> TryGetValue() const noexcept;
 			template<typename T>
 			T ToValue(const T &defaultValue) const;
 			template<typename T>
@@ -139,6 +169,8 @@ export {
 			static uint32_t GetStringSizeRequirement(const String &str);
 		  private:
 			friend PropertyWrapper;
+			friend AsciiReader;
+			friend AsciiWriter;
 			bool ReadStructHeader(IFile &f, StructDescription &strct);
 			static void WriteStructHeader(IFile &f, const StructDescription &strct);
 			template<bool ENABLE_EXCEPTIONS, typename T>
@@ -149,21 +181,47 @@ export {
 			template<typename T>
 			static void WriteBlockSize(IFile &f, uint64_t offset);
 
+			// Large enough for any numeric value, including doubles in fixed notation
+			static constexpr size_t NUMERIC_STRING_BUFFER_SIZE = 384;
+			// Writes the value to [first, last) without any allocations and returns a pointer past the last character.
+			// Floating point values are written with a fixed precision (see GetAsciiPrecision) and trailing zeroes are removed.
+			template<typename T>
+			static char *NumericTypeToChars(T value, char *first, char *last);
 			template<typename T>
 			static void NumericTypeToString(T value, std::stringstream &ss);
 			template<typename T>
+			static void NumericTypeToString(T value, std::string &outStr);
+			template<typename T>
 			static std::string NumericTypeToString(T value);
-			static void SetAppropriatePrecision(std::stringstream &ss, Type type);
-			static void RemoveTrailingZeroes(std::string &str);
+			static int GetAsciiPrecision(Type type);
+			static char *RemoveTrailingZeroes(char *first, char *last);
 			void Initialize();
 			void Clear();
 			template<typename T>
 			T &GetValue(Type type);
+			template<typename T>
+			const T &GetValue(Type type) const;
+			template<typename T>
+			std::expected<T *, AccessError> TryGetValue(Type type) noexcept;
+			template<typename T>
+			std::expected<const T *, AccessError> TryGetValue(Type type) const noexcept;
+			[[noreturn]] void ThrowAccessError(AccessError err, Type requestedType) const;
+
+			void UnshareParents();
+			void UnshareValue();
+			// Removes this property from the ring of properties sharing its value and returns the next property in the ring
+			Property *LeaveSharedRing();
+			// Points the back-references of the value (e.g. Element::fromProperty) to this property
+			void BindValue();
+			bool IsValueBoundTo(const Property &prop) const;
+			// Properties sharing the same value form a ring, which is only modified on the thread that copies or writes the data
+			mutable Property *m_nextShared = nullptr;
 		};
 
 		template<bool ENABLE_EXCEPTIONS, typename T>
 		bool Property::Assign(T &&v)
 		{
+			Unshare();
 			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
 			if constexpr(pragma::util::is_specialization<TBase, std::vector>::value) {
 				using TValueType = typename TBase::value_type;
@@ -176,6 +234,13 @@ export {
 				auto valueType = type_to_enum<TValueType>();
 				auto size = v.size();
 				auto &a = *static_cast<Array *>(value);
+				if constexpr(!std::is_lvalue_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>> && is_trivial_type(type_to_enum<TValueType>()) && type_to_enum<TValueType>() != Type::Nil && !std::is_same_v<TValueType, bool>) {
+					// Take ownership of the buffer instead of copying it
+					if(a.GetArrayType() == ArrayType::Raw) {
+						a.AdoptValues(std::move(v));
+						return true;
+					}
+				}
 				a.Clear();
 				a.SetValueType(valueType);
 				a.Resize(size);
@@ -283,46 +348,42 @@ export {
 		}
 
 		template<typename T>
-		void Property::NumericTypeToString(T value, std::stringstream &ss)
+		char *Property::NumericTypeToChars(T value, char *first, char *last)
 		{
 			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
-			if constexpr(std::is_same_v<TBase, Half>) {
-				NumericTypeToString<float>(value, ss);
-				return;
-			}
-			if constexpr(!std::is_floating_point_v<T>) {
-				if constexpr(std::is_same_v<T, Int8> || std::is_same_v<T, UInt8>)
-					ss << +value;
-				else
-					ss << value;
-				return;
+			if constexpr(std::is_same_v<TBase, Half>)
+				return NumericTypeToChars<float>(value, first, last);
+			else if constexpr(std::is_same_v<TBase, Int8> || std::is_same_v<TBase, UInt8> || std::is_same_v<TBase, Boolean>)
+				return std::to_chars(first, last, +value).ptr;
+			else if constexpr(!std::is_floating_point_v<TBase>)
+				return std::to_chars(first, last, value).ptr;
+			else {
+				auto res = std::to_chars(first, last, value, std::chars_format::fixed, GetAsciiPrecision(type_to_enum<TBase>()));
+				if(res.ec != std::errc {})
+					return first;
+				return RemoveTrailingZeroes(first, res.ptr);
 			}
-			// SetAppropriatePrecision(ss,type_to_enum<T>());
-			ss << NumericTypeToString(value);
+		}
+		template<typename T>
+		void Property::NumericTypeToString(T value, std::stringstream &ss)
+		{
+			std::array<char, NUMERIC_STRING_BUFFER_SIZE> buf;
+			auto *end = NumericTypeToChars(value, buf.data(), buf.data() + buf.size());
+			ss.write(buf.data(), end - buf.data());
+		}
+		template<typename T>
+		void Property::NumericTypeToString(T value, std::string &outStr)
+		{
+			std::array<char, NUMERIC_STRING_BUFFER_SIZE> buf;
+			auto *end = NumericTypeToChars(value, buf.data(), buf.data() + buf.size());
+			outStr.append(buf.data(), end);
 		}
 		template<typename T>
 		std::string Property::NumericTypeToString(T value)
 		{
-			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
-			if constexpr(std::is_same_v<TBase, Half>)
-				return NumericTypeToString<float>(value);
-			if constexpr(!std::is_floating_point_v<T>) {
-				if constexpr(std::is_same_v<T, Int8> || std::is_same_v<T, UInt8>)
-					return std::to_string(+value);
-				return std::to_string(value);
-			}
-			// TODO: This is not very efficient...
-			// (We need a temporary stringstream because we want to
-			// remove trailing zeroes)
-			std::stringstream tmp;
-			SetAppropriatePrecision(tmp, type_to_enum<T>());
-			if constexpr(std::is_same_v<T, Int8> || std::is_same_v<T, UInt8>)
-				tmp << +value;
-			else
-				tmp << value;
-			auto str = tmp.str();
-			RemoveTrailingZeroes(str);
-			return str;
+			std::array<char, NUMERIC_STRING_BUFFER_SIZE> buf;
+			auto *end = NumericTypeToChars(value, buf.data(), buf.data() + buf.size());
+			return std::string {buf.data(), end};
 		}
 
 		template<typename T>
@@ -334,7 +395,7 @@ export {
 		template<typename T>
 		const T &Property::GetValue() const
 		{
-			return const_cast<Property *>(this)->GetValue<T>();
+			return GetValue<T>(type_to_enum<T>());
 		}
 		template<typename T>
 		T Property::ToValue(const T &defaultValue) const
@@ -370,7 +431,7 @@ export {
 			}
 			auto vs = [&](auto tag) -> std::optional<T> {
 				if constexpr(is_convertible<typename decltype(tag)::type, T>())
-					return convert<typename decltype(tag)::type, T>(const_cast<Property *>(this)->GetValue<typename decltype(tag)::type>());
+					return convert<typename decltype(tag)::type, T>(GetValue<typename decltype(tag)::type>());
 				return {};
 			};
 			return visit(type, vs);
@@ -382,20 +443,74 @@ export {
 		T &Property::GetValue(Type type)
 		{
 			assert(value && this->type == type);
+			auto res = TryGetValue<T>(type);
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), type);
+			return **res;
+		}
+		template<typename T>
+		const T &Property::GetValue(Type type) const
+		{
+			auto res = TryGetValue<T>(type);
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), type);
+			return **res;
+		}
+
+		template<typename T>
+		std::expected<T *, AccessError> Property::TryGetValue(Type type) noexcept
+		{
+			auto res = static_cast<const Property *>(this)->TryGetValue<T>(type);
+			if(!res)
+				return std::unexpected {res.error()};
+			try {
+				Unshare();
+			}
+			catch(...) {
+				return std::unexpected {AccessError::InvalidProperty};
+			}
+			return const_cast<T *>(*res);
+		}
+		template<typename T>
+		std::expected<const T *, AccessError> Property::TryGetValue(Type type) const noexcept
+		{
 			if(this->type != type && !(this->type == Type::ArrayLz4 && type == Type::Array))
-				throw LogicError {"Type mismatch, requested type is " + std::string {magic_enum::enum_name(type)} + ", but actual type is " + std::string {magic_enum::enum_name(this->type)} + "!"};
-			return *GetValuePtr<T>();
+				return std::unexpected {AccessError::TypeMismatch};
+			auto *ptr = GetValuePtr<T>();
+			if(!ptr)
+				return std::unexpected {AccessError::InvalidProperty};
+			return ptr;
+		}
+		template<typename T>
+		std::expected<T *, AccessError> Property::TryGetValue() noexcept
+		{
+			return TryGetValue<T>(type_to_enum<T>());
+		}
+		template<typename T>
+		std::expected<const T *, AccessError> Property::TryGetValue() const noexcept
+		{
+			return TryGetValue<T>(type_to_enum<T>());
 		}
 
 		template<typename T>
 		T *Property::GetValuePtr()
 		{
 			// TODO: this should never be null, but there are certain cases where it seems to happen
+			if(!this)
+				return nullptr;
+			auto *ptr = static_cast<const Property *>(this)->GetValuePtr<T>();
+			if(ptr)
+				Unshare(); // The value is kept by this property, so the pointer remains valid
+			return const_cast<T *>(ptr);
+		}
+		template<typename T>
+		const T *Property::GetValuePtr() const
+		{
 			if(!this)
 				return nullptr;
 			if constexpr(std::is_same_v<T, Array>)
-				return is_array_type(this->type) ? reinterpret_cast<T *>(value) : nullptr;
-			return (this->type == type_to_enum<T>()) ? reinterpret_cast<T *>(value) : nullptr;
+				return is_array_type(this->type) ? reinterpret_cast<const T *>(value) : nullptr;
+			return (this->type == type_to_enum<T>()) ? reinterpret_cast<const T *>(value) : nullptr;
 		}
 
 		template<class T>
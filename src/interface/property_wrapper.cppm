@@ -9,6 +9,7 @@ export module pragma.udm:property_wrapper;
 
 import :conversion;
 export import :enums;
+export import :key;
 export import :trivial_types;
 export import :types;
 import :wrapper_funcs;
@@ -45,6 +46,9 @@ export {
 			LinkedPropertyWrapper AddArray(const std::string_view &path, const StructDescription &strct, const std::vector<T> &values, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false) const;
 			template<typename T>
 			LinkedPropertyWrapper AddArray(const std::string_view &path, const std::vector<T> &values, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false) const;
+			// Takes ownership of the vector's buffer without copying if T is a trivial type and the array is uncompressed
+			template<typename T>
+			LinkedPropertyWrapper AddArray(const std::string_view &path, std::vector<T> &&values, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false) const;
 			template<typename T>
 			LinkedPropertyWrapper AddArray(const std::string_view &path, uint32_t size, const T *data, ArrayType arrayType = ArrayType::Raw, bool pathToElements = false) const;
 			bool IsArrayItem() const;
@@ -59,11 +63,26 @@ export {
 			Blob GetBlobData(Type &outType) const;
 			template<class T>
 			BlobResult GetBlobData(T &v) const;
+			// Note: The value accessors un-share all values along the path (see Property::Unshare), use GetConstValuePtr or
+			// TryGetConstValue if the value is only read
 			template<typename T>
 			T &GetValue() const;
 			template<typename T>
 			T *GetValuePtr() const;
+			template<typename T>
+			const T *GetConstValuePtr() const;
 			void *GetValuePtr(Type &outType) const;
+			// Non-throwing accessors for optional values. Instead of throwing, they return an AccessError if the key or index doesn't exist
+			// or the type doesn't match. On success the returned pointer is never nullptr. If a value has to be decompressed or un-shared
+			// and that fails, InvalidProperty is returned.
+			template<typename T>
+			std::expected<T *, AccessError> TryGetValue() const noexcept;
+			template<typename T>
+			std::expected<const T *, AccessError> TryGetConstValue() const noexcept;
+			std::expected<PropertyWrapper, AccessError> TryIndex(uint32_t idx) const noexcept;
+			std::expected<PropertyWrapper, AccessError> TryGetChild(const Key &key) const noexcept;
+			// Same path syntax as GetFromPath (see for_each_path_segment)
+			std::expected<PropertyWrapper, AccessError> TryGetFromPath(const std::string_view &path) const noexcept;
 			template<typename T>
 			T ToValue(const T &defaultValue, bool *optOutIsDefined = nullptr) const;
 			template<typename T>
@@ -103,7 +122,7 @@ export {
 				}
 				else if constexpr(std::is_enum_v<TBase>) {
 					using TEnum = TBase;
-					auto *ptr = GetValuePtr<std::string>();
+					auto *ptr = GetConstValuePtr<std::string>();
 					if(ptr) {
 						auto e = magic_enum::enum_cast<TEnum>(*ptr);
 						if(!e.has_value())
@@ -128,7 +147,7 @@ export {
 					return true;
 				}
 				else {
-					auto *ptr = GetValuePtr<T>();
+					auto *ptr = GetConstValuePtr<T>();
 					if(ptr) {
 						valOut = *ptr;
 						return true;
@@ -146,6 +165,9 @@ export {
 			ArrayIterator<T> begin() const;
 			template<typename T>
 			ArrayIterator<T> end() const;
+			// Contiguous view over all array values, see Array::AsSpan. Returns an empty span if this is not an array or T doesn't match the value type.
+			template<typename T>
+			std::span<T> AsSpan() const;
 			ArrayIterator<LinkedPropertyWrapper> begin() const;
 			ArrayIterator<LinkedPropertyWrapper> end() const;
 			LinkedPropertyWrapper operator[](uint32_t idx) const;
@@ -159,10 +181,12 @@ export {
 			uint32_t GetChildCount() const;
 			//
 
+			// Path syntax as described in for_each_path_segment, e.g. a/b[2]/"c d". Returns an invalid wrapper if the path is malformed.
 			LinkedPropertyWrapper GetFromPath(const std::string_view &key) const;
 			LinkedPropertyWrapper operator[](const std::string_view &key) const;
 			LinkedPropertyWrapper operator[](const std::string &key) const;
 			LinkedPropertyWrapper operator[](const char *key) const;
+			LinkedPropertyWrapper operator[](const Key &key) const;
 			bool operator==(const PropertyWrapper &other) const;
 			bool operator!=(const PropertyWrapper &other) const;
 			template<typename T>
@@ -182,6 +206,9 @@ export {
 			const LinkedPropertyWrapper *GetLinked() const { return const_cast<PropertyWrapper *>(this)->GetLinked(); };
 		  protected:
 			bool IsArrayItem(bool includeIfElementOfArrayItem) const;
+			[[noreturn]] void ThrowAccessError(AccessError err, Type requestedType) const;
+			// Un-shares the values of all properties along the path, from the top down
+			void UnsharePath() const;
 			bool linked = false;
 		};
 
@@ -218,15 +245,21 @@ export {
 			LinkedPropertyWrapper operator[](const std::string_view &key) const;
 			LinkedPropertyWrapper operator[](const std::string &key) const;
 			LinkedPropertyWrapper operator[](const char *key) const;
+			LinkedPropertyWrapper operator[](const Key &key) const;
 
 			std::string GetPath() const;
 			PProperty ClaimOwnership() const;
+			// Returns true if the property (or one of its parents) is shared with other properties (see MergeFlags::CopyOnWrite)
+			bool IsShared() const;
+			// Copies all shared properties along the path to this property, so it can safely be written to
+			void Unshare();
 			ElementIteratorWrapper ElIt();
 			std::unique_ptr<LinkedPropertyWrapper> prev = nullptr;
 			std::string propName;
 
 			// For internal use only!
 			void InitializeProperty(Type type = Type::Element, bool getOnly = false);
+			void AppendPath(std::string &outPath) const;
 			Property *GetProperty(std::vector<uint32_t> *optOutArrayIndices = nullptr) const;
 		};
 
@@ -307,6 +340,7 @@ export {
 		{
 			if(prop == nullptr)
 				throw LogicError {"Cannot assign property value: Property is invalid!"};
+			UnsharePath();
 			using TBase = std::remove_cv_t<std::remove_reference_t<T>>;
 			if constexpr(pragma::util::is_specialization<TBase, std::optional>::value) {
 				// Value is std::optional
@@ -473,6 +507,20 @@ export {
 			return AddArray<T>(path, values.size(), values.data(), arrayType, pathToElements);
 		}
 
+		template<typename T>
+		LinkedPropertyWrapper PropertyWrapper::AddArray(const std::string_view &path, std::vector<T> &&values, ArrayType arrayType, bool pathToElements) const
+		{
+			constexpr auto valueType = type_to_enum<T>();
+			if constexpr(is_trivial_type(valueType) && valueType != Type::Nil && !std::is_same_v<T, bool>) {
+				if(arrayType == ArrayType::Raw) {
+					auto prop = AddArray(path, 0u, valueType, arrayType, pathToElements);
+					prop.template GetValue<Array>().AdoptValues(std::move(values));
+					return prop;
+				}
+			}
+			return AddArray<T>(path, static_cast<const std::vector<T> &>(values), arrayType, pathToElements);
+		}
+
 		template<typename T>
 		LinkedPropertyWrapper PropertyWrapper::AddArray(const std::string_view &path, uint32_t size, const T *data, ArrayType arrayType, bool pathToElements) const
 		{
@@ -506,8 +554,8 @@ export {
 				return result;
 			if(IsArrayItem(true)) {
 				if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
-					auto &a = get_property_value<Array>(*prop);
-					auto *el = get_array_value_ptr<Element>(a, arrayIndex);
+					auto *a = get_property_value_ptr<Array>(std::as_const(*prop));
+					auto *el = a ? get_array_value_ptr<Element>(*a, arrayIndex) : nullptr;
 					if(!el)
 						return BlobResult::InvalidProperty;
 					auto *child = find_element_child(*el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
@@ -522,44 +570,97 @@ export {
 		template<typename T>
 		T &PropertyWrapper::GetValue() const
 		{
+			auto res = TryGetValue<T>();
+			if(!res) [[unlikely]]
+				ThrowAccessError(res.error(), type_to_enum<T>());
+			return **res;
+		}
+
+		template<typename T>
+		std::expected<T *, AccessError> PropertyWrapper::TryGetValue() const noexcept
+		{
+			auto res = TryGetConstValue<T>();
+			if(!res)
+				return std::unexpected {res.error()};
+			try {
+				UnsharePath(); // The values are kept by the properties along the path, so the pointer remains valid
+			}
+			catch(...) {
+				return std::unexpected {AccessError::InvalidProperty};
+			}
+			return const_cast<T *>(*res);
+		}
+
+		template<typename T>
+		std::expected<const T *, AccessError> PropertyWrapper::TryGetConstValue() const noexcept
+		{
+			if(!prop)
+				return std::unexpected {AccessError::InvalidProperty};
+			const T *ptr = nullptr;
 			if(arrayIndex != std::numeric_limits<uint32_t>::max()) {
-				auto *a = get_property_value_ptr<Array>(*prop);
+				auto *a = get_property_value_ptr<Array>(std::as_const(*prop));
 				if(a) {
+					if(arrayIndex >= get_array_size(*a))
+						return std::unexpected {AccessError::OutOfBounds};
+					const void *values = nullptr;
+					try {
+						values = get_array_values(*a);
+					}
+					catch(...) {
+						// The values couldn't be decompressed
+					}
+					if(!values)
+						return std::unexpected {AccessError::InvalidProperty};
 					if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
-						auto &el = const_cast<Element &>(get_array_value<Element>(*a, arrayIndex));
-						auto &propName = static_cast<const LinkedPropertyWrapper &>(*this).propName;
-						auto *child = find_element_child(el, propName);
+						auto *el = get_array_value_ptr<Element>(*a, arrayIndex);
+						if(!el)
+							return std::unexpected {AccessError::TypeMismatch};
+						auto *child = find_element_child(*el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
 						if(!child)
-							throw LogicError {"Attempted to retrieve value of property '" + propName + "' from array element at index " + std::to_string(arrayIndex) + ", but property does not exist!"};
-						return get_property_value<T>(**child);
+							return std::unexpected {AccessError::NotFound};
+						ptr = get_property_value_ptr<T>(std::as_const(**child));
 					}
-					if(is_array_value_type(*a, type_to_enum<T>()) == false)
-						throw LogicError {"Type mismatch, requested type is " + std::string {magic_enum::enum_name(type_to_enum<T>())} + ", but actual type is " + std::string {magic_enum::enum_name(get_array_value_type(*a))} + "!"};
-					return static_cast<T *>(get_array_values(*a))[arrayIndex];
+					else if(is_array_value_type(*a, type_to_enum<T>()))
+						ptr = &static_cast<const T *>(values)[arrayIndex];
+					if(!ptr)
+						return std::unexpected {AccessError::TypeMismatch};
+					return ptr;
 				}
 			}
-			return get_property_value<T>(**this);
+			ptr = get_property_value_ptr<T>(std::as_const(*prop));
+			if(!ptr)
+				return std::unexpected {AccessError::TypeMismatch};
+			return ptr;
 		}
 
 		template<typename T>
 		T *PropertyWrapper::GetValuePtr() const
+		{
+			auto *ptr = GetConstValuePtr<T>();
+			if(ptr)
+				UnsharePath(); // The values are kept by the properties along the path, so the pointer remains valid
+			return const_cast<T *>(ptr);
+		}
+
+		template<typename T>
+		const T *PropertyWrapper::GetConstValuePtr() const
 		{
 			if(arrayIndex != std::numeric_limits<uint32_t>::max()) {
-				auto *a = get_property_value_ptr<Array>(*prop);
+				auto *a = get_property_value_ptr<Array>(std::as_const(*prop));
 				if(a) {
 					if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
-						auto &el = get_array_value<Element>(*a, arrayIndex);
-						auto *child = find_element_child(el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
+						auto *el = get_array_value_ptr<Element>(*a, arrayIndex);
+						auto *child = el ? find_element_child(*el, static_cast<const LinkedPropertyWrapper &>(*this).propName) : nullptr;
 						if(!child)
 							return nullptr;
-						return get_property_value_ptr<T>(**child);
+						return get_property_value_ptr<T>(std::as_const(**child));
 					}
 					if(is_array_value_type(*a, type_to_enum<T>()) == false)
 						return nullptr;
-					return &static_cast<T *>(get_array_values(*a))[arrayIndex];
+					return &static_cast<const T *>(get_array_values(*a))[arrayIndex];
 				}
 			}
-			return prop ? get_property_value_ptr<T>(**this) : nullptr;
+			return prop ? get_property_value_ptr<T>(std::as_const(*prop)) : nullptr;
 		}
 
 		template<typename T>
@@ -588,7 +689,7 @@ export {
 			if constexpr(pragma::util::is_c_string<T>())
 				return operator==(std::string {other});
 			else {
-				auto *val = GetValuePtr<T>();
+				auto *val = GetConstValuePtr<T>();
 				if(val)
 					return *val == other;
 				auto valConv = ToValue<T>();
@@ -602,7 +703,8 @@ export {
 		{
 			if(!static_cast<bool>(*this))
 				return ArrayIterator<T> {};
-			auto *a = GetValuePtr<Array>();
+			// Values are un-shared once they're accessed through the iterator
+			auto *a = const_cast<Array *>(GetConstValuePtr<Array>());
 			if(a == nullptr)
 				return ArrayIterator<T> {};
 			ArrayIterator<T> it;
@@ -612,11 +714,29 @@ export {
 			return it;
 		}
 		template<typename T>
+		std::span<T> PropertyWrapper::AsSpan() const
+		{
+			if(!static_cast<bool>(*this))
+				return {};
+			auto *a = const_cast<Array *>(GetConstValuePtr<Array>());
+			if(a == nullptr)
+				return {};
+			auto span = get_array_span<const T>(*a);
+			if(span.empty())
+				return {};
+			if constexpr(std::is_const_v<T>)
+				return span;
+			else {
+				UnsharePath(); // Values may be modified through the span, the array keeps its values
+				return get_array_span<T>(*a); // Retrieved again, read-only borrowed values are moved into internal storage
+			}
+		}
+		template<typename T>
 		ArrayIterator<T> PropertyWrapper::end() const
 		{
 			if(!static_cast<bool>(*this))
 				return ArrayIterator<T> {};
-			auto *a = GetValuePtr<Array>();
+			auto *a = const_cast<Array *>(GetConstValuePtr<Array>());
 			if(a == nullptr)
 				return ArrayIterator<T> {};
 			ArrayIterator<T> it;
@@ -630,20 +750,27 @@ export {
 			if(!this) // This can happen in chained expressions. TODO: This is technically undefined behavior and should be implemented differently!
 				return {};
 			if(IsArrayItem(true)) {
-				auto &a = get_property_value<Array>(*prop);
+				auto *a = get_property_value_ptr<Array>(std::as_const(*prop));
+				if(!a)
+					return {};
 				if(linked && !static_cast<const LinkedPropertyWrapper &>(*this).propName.empty()) {
-					auto &el = get_array_value<Element>(a, arrayIndex);
-					auto *child = find_element_child(el, static_cast<const LinkedPropertyWrapper &>(*this).propName);
+					auto *el = get_array_value_ptr<Element>(*a, arrayIndex);
+					auto *child = el ? find_element_child(*el, static_cast<const LinkedPropertyWrapper &>(*this).propName) : nullptr;
 					if(!child)
 						return {};
 					return to_property_value<T>(**child);
 				}
 				auto vs = [&](auto tag) -> std::optional<T> {
-					if constexpr(is_convertible<typename decltype(tag)::type, T>())
-						return std::optional<T> {convert<typename decltype(tag)::type, T>(const_cast<PropertyWrapper *>(this)->GetValue<typename decltype(tag)::type>())};
+					using TTag = typename decltype(tag)::type;
+					if constexpr(is_convertible<TTag, T>()) {
+						auto res = TryGetConstValue<TTag>();
+						if(!res) [[unlikely]]
+							ThrowAccessError(res.error(), type_to_enum<TTag>());
+						return std::optional<T> {convert<TTag, T>(**res)};
+					}
 					return {};
 				};
-				auto valueType = get_array_value_type(a);
+				auto valueType = get_array_value_type(*a);
 				return visit(valueType, vs);
 			}
 			if(prop)
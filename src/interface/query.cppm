@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:query;
+
+export import :exception;
+export import :parallel;
+export import :path_cursor;
+
+export {
+	namespace udm {
+		// Query over a property tree, e.g. "mesh/*/vertices" or "entities[*][?class == \"light\"]/name".
+		// Segments are separated by '/' and consist of an optional name followed by any number of selectors:
+		// - key, "quoted key": Child with the specified key
+		// - *: All children of an element, or all items of an array
+		// - **: The property itself and all of its descendants (items of arrays that don't contain elements are excluded)
+		// - [n]: Array item at index n
+		// - [*], [a:b], [a:], [:b]: All array items, or the items in the half-open range [a, b)
+		// - [?key], [?key op value]: Only keeps elements that have a child with the specified key (and whose value satisfies the comparison).
+		//   Supported operators are ==, !=, <, <=, > and >=, the value can be a quoted string, a number, true or false.
+		class DLLUDM Query {
+		  public:
+			static constexpr uint32_t MIN_ITEMS_PER_TASK = 64;
+			// Throws an InvalidUsageError if the query is invalid
+			static Query Compile(const std::string_view &query);
+			Query() = default;
+
+			// Results are in document order, i.e. children of elements are sorted by key (the order in which they're saved) and array items
+			// by index. If 'parallel' is true, branches are evaluated on the worker pool once a selector matches more than minItemsPerTask
+			// properties (see parallel_for).
+			std::vector<PropertyWrapper> Evaluate(Property &root, bool parallel = true, uint32_t minItemsPerTask = MIN_ITEMS_PER_TASK) const;
+			std::vector<PropertyWrapper> Evaluate(const PropertyWrapper &root, bool parallel = true, uint32_t minItemsPerTask = MIN_ITEMS_PER_TASK) const;
+			// Calls 'callback' for each result in document order without collecting them first. Evaluation stops if the callback returns false.
+			void ForEach(Property &root, const std::function<bool(const PropertyWrapper &)> &callback) const;
+			void ForEach(const PropertyWrapper &root, const std::function<bool(const PropertyWrapper &)> &callback) const;
+			const std::string &GetQuery() const { return m_query; }
+		  private:
+			enum class CompareOp : uint8_t { Exists = 0, Equal, NotEqual, Less, LessOrEqual, Greater, GreaterOrEqual };
+			struct Step {
+				enum class Kind : uint8_t { Child = 0, AnyChild, Descendants, Index, Range, Predicate };
+				Kind kind = Kind::Child;
+				std::string key;
+				uint32_t start = 0;
+				uint32_t end = std::numeric_limits<uint32_t>::max();
+				CompareOp op = CompareOp::Exists;
+				std::variant<std::string, double, bool> value;
+			};
+			using Node = PathCursor::Frame;
+			using Callback = std::function<bool(const Node &)>;
+			struct EvaluationContext;
+			bool Evaluate(EvaluationContext &ctx, const Node &node, size_t stepIdx) const;
+			// Returns false if evaluation was stopped by the output callback
+			bool EvaluateAll(EvaluationContext &ctx, const std::vector<Node> &nodes, size_t stepIdx, bool descendants) const;
+			bool EvaluateDescendants(EvaluationContext &ctx, const Node &node, size_t stepIdx) const;
+			bool Matches(const Node &node, const Step &step) const;
+			std::vector<PropertyWrapper> Evaluate(const Node &root, bool parallel, uint32_t minItemsPerTask) const;
+			void ForEach(const Node &root, const std::function<bool(const PropertyWrapper &)> &callback) const;
+
+			std::string m_query;
+			std::vector<Step> m_steps;
+		};
+	}
+}
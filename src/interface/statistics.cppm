@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:statistics;
+
+export import :enums;
+export import :types;
+
+export {
+	namespace udm {
+		// Note: All sizes are estimates of the heap memory held by a property tree; Allocator and hash map bookkeeping overhead is approximated.
+		// Values shared between multiple properties (see MergeFlags::CopyOnWrite) are only counted once.
+		struct DLLUDM MemoryStatistics {
+			struct Subtree {
+				std::string path;
+				uint64_t size = 0;
+			};
+			static MemoryStatistics Calculate(const Property &prop, uint32_t numLargestSubtrees = 10);
+			static MemoryStatistics Calculate(const Element &el, uint32_t numLargestSubtrees = 10);
+
+			uint64_t nodeBytes = 0;    // Property, Element and Array objects, as well as the hash map entries holding them
+			uint64_t keyBytes = 0;     // Heap memory of element keys (keys covered by the small string optimization are included in nodeBytes)
+			uint64_t trivialBytes = 0; // Values of trivial type (numbers, vectors, matrices, etc.)
+			uint64_t stringBytes = 0;  // String, Utf8String and Reference values
+			uint64_t structBytes = 0;  // Struct values (excluding struct arrays)
+			uint64_t arrayBytes = 0;   // Uncompressed array data
+			uint64_t lz4CompressedBytes = 0;   // Compressed data of ArrayLz4 arrays
+			uint64_t lz4DecompressedBytes = 0; // Uncompressed data of ArrayLz4 arrays that is currently held in memory
+			uint64_t blobBytes = 0;            // Blob and BlobLz4 values
+			// Number of properties per type, elements stored in arrays are included
+			std::array<uint64_t, static_cast<size_t>(Type::Count)> typeCounts {};
+			uint32_t maxDepth = 0;
+			// Sorted by size in descending order. Subtrees of compressed element arrays are only included while the array is decompressed.
+			std::vector<Subtree> largestSubtrees;
+
+			uint64_t GetTotalSize() const;
+			uint64_t GetTypeCount(Type type) const;
+			uint64_t GetNodeCount() const;
+		  private:
+			struct Collector;
+		};
+	}
+}
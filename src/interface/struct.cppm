@@ -20,6 +20,9 @@ export {
 			std::string GetTemplateArgumentList() const;
 			SizeType GetDataSizeRequirement() const;
 			MemberCountType GetMemberCount() const;
+			// Byte offset of the member within the struct data
+			SizeType GetMemberOffset(MemberCountType idx) const;
+			std::optional<MemberCountType> FindMember(const std::string_view &name) const;
 
 			// TODO: Use these once C++20 is available
 			// bool operator==(const Struct&) const=default;
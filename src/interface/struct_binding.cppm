@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:struct_binding;
+
+export import :exception;
+export import :key;
+export import :property;
+export import :types.element;
+
+export {
+	namespace udm {
+		template<typename TClass, typename TMember>
+		struct StructMember {
+			using ClassType = TClass;
+			using MemberType = TMember;
+			Key key;
+			TMember TClass::*member;
+		};
+		template<typename TClass, typename TMember>
+		constexpr StructMember<TClass, TMember> struct_member(const char *key, TMember TClass::*member)
+		{
+			return StructMember<TClass, TMember> {Key {key}, member};
+		}
+
+		// Specialize this template to bind a C++ struct to an element, e.g.:
+		// template<>
+		// struct udm::StructBinding<Transform> {
+		// 	static constexpr auto members = std::make_tuple(udm::struct_member("position", &Transform::position), udm::struct_member("rotation", &Transform::rotation));
+		// };
+		// Members have to be UDM value types (see type_to_enum) or bound structs themselves, which are stored as child elements.
+		template<typename T>
+		struct StructBinding;
+
+		template<typename T>
+		concept BoundStruct = requires { StructBinding<T>::members; };
+
+		template<typename T>
+		constexpr bool is_bindable_member_type()
+		{
+			if constexpr(BoundStruct<T>)
+				return true;
+			else
+				return type_to_enum_s<T>() != Type::Invalid && type_to_enum_s<T>() != Type::Element && !is_array_type(type_to_enum_s<T>());
+		}
+
+		template<BoundStruct T>
+		bool read_struct(const Element &el, T &outValue);
+
+		// Reads a single member, values of a different type are converted if possible. Returns false if the child doesn't exist or can't be converted.
+		template<typename TMember>
+		bool read_struct_member(const Element &el, const Key &key, TMember &outValue)
+		{
+			static_assert(is_bindable_member_type<TMember>(), "Member type is not supported!");
+			auto it = el.children.find(key);
+			if(it == el.children.end() || !it->second)
+				return false;
+			const auto &prop = *it->second;
+			if constexpr(BoundStruct<TMember>) {
+				auto *child = prop.GetValuePtr<Element>();
+				return child && read_struct(*child, outValue);
+			}
+			else {
+				auto *value = prop.GetValuePtr<TMember>();
+				if(value) {
+					outValue = *value;
+					return true;
+				}
+				auto converted = prop.ToValue<TMember>();
+				if(!converted.has_value())
+					return false;
+				outValue = std::move(*converted);
+				return true;
+			}
+		}
+
+		// Assigns all bound members that exist in the element. Returns false if any of them were missing or couldn't be converted,
+		// in which case they're left unchanged.
+		template<BoundStruct T>
+		bool read_struct(const Element &el, T &outValue)
+		{
+			return std::apply([&el, &outValue](const auto &...members) { return (static_cast<uint32_t>(read_struct_member(el, members.key, outValue.*members.member)) + ... + 0u) == sizeof...(members); },
+			  StructBinding<T>::members);
+		}
+		template<BoundStruct T>
+		bool read_struct(const PropertyWrapper &prop, T &outValue)
+		{
+			auto *el = prop.GetConstValuePtr<Element>();
+			return el && read_struct(*el, outValue);
+		}
+
+		template<BoundStruct T>
+		void write_struct(Element &el, const T &value);
+
+		// Children of a different type are replaced
+		template<typename TMember>
+		void write_struct_member(Element &el, const Key &key, const TMember &value)
+		{
+			static_assert(is_bindable_member_type<TMember>(), "Member type is not supported!");
+			if constexpr(BoundStruct<TMember>) {
+				auto child = el.Add(key, Type::Element);
+				write_struct(*child->GetValuePtr<Element>(), value);
+			}
+			else {
+				auto child = el.Add(key, type_to_enum<TMember>());
+				*child->GetValuePtr<TMember>() = value;
+			}
+		}
+
+		template<BoundStruct T>
+		void write_struct(Element &el, const T &value)
+		{
+			std::apply([&el, &value](const auto &...members) { (write_struct_member(el, members.key, value.*members.member), ...); }, StructBinding<T>::members);
+		}
+		template<BoundStruct T>
+		void write_struct(const PropertyWrapper &prop, const T &value)
+		{
+			auto *el = prop.GetValuePtr<Element>();
+			if(!el)
+				throw InvalidUsageError {"Attempted to write struct to non-element property!"};
+			write_struct(*el, value);
+		}
+	}
+}
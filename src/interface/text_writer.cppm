@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+
+export module pragma.udm:text_writer;
+
+export import :file;
+export import :structure;
+export import :trivial_types;
+
+export {
+	namespace udm {
+		// Output of the text formats (see AsciiWriter and JsonWriter), which is written through a fixed-size buffer to a file, a stream or a string
+		class DLLUDM TextBuffer {
+		  public:
+			static constexpr size_t BUFFER_SIZE = 64 * 1024;
+			TextBuffer(IFile &f);
+			TextBuffer(std::stringstream &ss);
+			TextBuffer(std::string &outStr);
+			TextBuffer(const TextBuffer &) = delete;
+			TextBuffer &operator=(const TextBuffer &) = delete;
+			~TextBuffer();
+			void Flush();
+			// Number of characters written so far, including the ones that haven't been flushed yet
+			size_t Tell() const { return m_numFlushed + m_size; }
+		  protected:
+			void Write(const std::string_view &str);
+			void Write(char c);
+			// Encodes the data straight into the buffer, without any delimiters
+			void WriteBase64(const void *data, size_t size);
+			// Calls write(first, last) with room for at least maxSize characters in the buffer, write returns a pointer past the last character it wrote
+			template<typename TFunc>
+			void WriteChars(size_t maxSize, const TFunc &write);
+		  private:
+			void WriteToSink(const char *data, size_t size);
+
+			IFile *m_file = nullptr;
+			std::stringstream *m_stream = nullptr;
+			std::string *m_string = nullptr;
+			std::unique_ptr<char[]> m_buffer;
+			size_t m_size = 0;
+			size_t m_numFlushed = 0;
+		};
+
+		// Values that are written as lists of numbers in both text formats. TDerived has to provide WriteNumber for all numeric types and
+		// WriteValue for all generic types, and TDerived::LIST_SEPARATOR is written between the lists of transforms and matrices.
+		template<class TDerived>
+		class TextWriter : public TextBuffer {
+		  public:
+			using TextBuffer::TextBuffer;
+			// Writes the members of the struct as a list, e.g. "[1,2,3]"
+			void WriteStructValue(const StructDescription &strct, const void *data);
+		  protected:
+			template<typename... T>
+			void WriteNumberList(T... values);
+
+			void WriteValue(const Vector2 &v) { WriteNumberList(v.x, v.y); }
+			void WriteValue(const Vector2i &v) { WriteNumberList(v.x, v.y); }
+			void WriteValue(const Vector3 &v) { WriteNumberList(v.x, v.y, v.z); }
+			void WriteValue(const Vector3i &v) { WriteNumberList(v.x, v.y, v.z); }
+			void WriteValue(const Vector4 &v) { WriteNumberList(v.x, v.y, v.z, v.w); }
+			void WriteValue(const Vector4i &v) { WriteNumberList(v.x, v.y, v.z, v.w); }
+			void WriteValue(const Quaternion &q) { WriteNumberList(q.w, q.x, q.y, q.z); }
+			void WriteValue(const EulerAngles &a) { WriteNumberList(a.p, a.y, a.r); }
+			void WriteValue(const Srgba &srgb) { WriteNumberList(srgb[0], srgb[1], srgb[2], srgb[3]); }
+			void WriteValue(const HdrColor &col) { WriteNumberList(col[0], col[1], col[2]); }
+			void WriteValue(const Transform &t);
+			void WriteValue(const ScaledTransform &t);
+			void WriteValue(const Mat4 &m);
+			void WriteValue(const Mat3x4 &m);
+		  private:
+			TDerived &GetDerived() { return static_cast<TDerived &>(*this); }
+			void WriteListSeparator() { Write(TDerived::LIST_SEPARATOR); }
+		};
+
+		template<typename TFunc>
+		void TextBuffer::WriteChars(size_t maxSize, const TFunc &write)
+		{
+			if(m_size + maxSize > BUFFER_SIZE)
+				Flush();
+			auto *first = m_buffer.get() + m_size;
+			auto *last = write(first, first + maxSize);
+			m_size += last - first;
+		}
+
+		template<class TDerived>
+		template<typename... T>
+		void TextWriter<TDerived>::WriteNumberList(T... values)
+		{
+			Write('[');
+			auto first = true;
+			auto writeValue = [this, &first](auto value) {
+				if(first)
+					first = false;
+				else
+					Write(',');
+				GetDerived().WriteNumber(value);
+			};
+			(writeValue(values), ...);
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteValue(const Transform &t)
+		{
+			auto &pos = t.GetOrigin();
+			auto &rot = t.GetRotation();
+			Write('[');
+			WriteNumberList(pos.x, pos.y, pos.z);
+			WriteListSeparator();
+			WriteNumberList(rot.w, rot.x, rot.y, rot.z);
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteValue(const ScaledTransform &t)
+		{
+			auto &pos = t.GetOrigin();
+			auto &rot = t.GetRotation();
+			auto &scale = t.GetScale();
+			Write('[');
+			WriteNumberList(pos.x, pos.y, pos.z);
+			WriteListSeparator();
+			WriteNumberList(rot.w, rot.x, rot.y, rot.z);
+			WriteListSeparator();
+			WriteNumberList(scale.x, scale.y, scale.z);
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteValue(const Mat4 &m)
+		{
+			Write('[');
+			for(uint8_t i = 0; i < 4; ++i) {
+				if(i > 0)
+					WriteListSeparator();
+				WriteNumberList(m[i][0], m[i][1], m[i][2], m[i][3]);
+			}
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteValue(const Mat3x4 &m)
+		{
+			Write('[');
+			for(uint8_t i = 0; i < 3; ++i) {
+				if(i > 0)
+					WriteListSeparator();
+				WriteNumberList(m[i][0], m[i][1], m[i][2], m[i][3]);
+			}
+			Write(']');
+		}
+		template<class TDerived>
+		void TextWriter<TDerived>::WriteStructValue(const StructDescription &strct, const void *data)
+		{
+			Write('[');
+			auto n = strct.GetMemberCount();
+			auto *ptr = static_cast<const uint8_t *>(data);
+			for(auto i = decltype(n) {0u}; i < n; ++i) {
+				if(i > 0)
+					Write(',');
+				auto type = strct.types[i];
+				if(is_numeric_type(type)) {
+					std::visit(
+					  [this, ptr](auto tag) {
+						  using T = typename decltype(tag)::type;
+						  GetDerived().WriteNumber(*reinterpret_cast<const T *>(ptr));
+					  },
+					  get_numeric_tag(type));
+				}
+				else if(is_generic_type(type)) {
+					std::visit(
+					  [this, ptr](auto tag) {
+						  using T = typename decltype(tag)::type;
+						  GetDerived().WriteValue(*reinterpret_cast<const T *>(ptr));
+					  },
+					  get_generic_tag(type));
+				}
+				else
+					throw InvalidUsageError {"Non-trivial types are not allowed for structs!"};
+				ptr += size_of(type);
+			}
+			Write(']');
+		}
+	}
+}
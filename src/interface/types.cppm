@@ -49,12 +49,18 @@ export {
 		struct Element;
 		struct ElementIteratorPair;
 		class AsciiReader;
+		class AsciiWriter;
+		class JsonReader;
 		struct ArrayLz4;
 		struct AssetData;
 		using AssetDataArg = const AssetData &;
 		enum class FormatType : uint8_t;
 		enum class AsciiSaveFlags : uint32_t;
 		class Data;
+		struct MemoryStatistics;
+		class FrozenData;
+		class FrozenProperty;
+		class FrozenDataBuilder;
 		using Hash = std::array<uint8_t, sizeof(uint32_t) * 4>;
 	};
 }
@@ -7,6 +7,7 @@ export module pragma.udm;
 export import :array;
 export import :array_iterator;
 export import :asset_data;
+export import :base64;
 export import :basic_types;
 export import :types.blob;
 export import :conversion;
@@ -16,14 +17,25 @@ export import :types.element;
 export import :enums;
 export import :exception;
 export import :file;
+export import :frozen;
 export import :half;
+export import :key;
+export import :parallel;
+export import :path_cache;
+export import :path_cursor;
+export import :path_query;
+export import :query;
 export import :property;
 export import :property_wrapper;
 export import :reference;
+export import :statistics;
 export import :types.string;
 export import :structure;
+export import :struct_binding;
+export import :text_writer;
 export import :trivial_types;
 export import :types;
 export import :util;
+export import :walk;
 export import :wrapper_funcs;
 export import :wrapper_funcs_impl;
@@ -8,6 +8,7 @@ module;
 export module pragma.udm:util;
 
 export import :array;
+import :file;
 import :structure;
 import :types.element;
 import :types.string;
@@ -72,6 +73,11 @@ export {
 			}
 		}
 
+		// Writes all values other than elements and arrays as strings
 		void to_json(LinkedPropertyWrapperArg prop, std::stringstream &ss);
+		// Writes standard JSON through a fixed-size buffer: numeric values as numbers, vectors, matrices and structs as arrays of numbers,
+		// blobs as base64 strings and nil as null. Compressed blobs and arrays are decompressed.
+		DLLUDM void to_json(LinkedPropertyWrapperArg prop, IFile &f, JsonFormat format = JsonFormat::Pretty);
+		DLLUDM void to_json(LinkedPropertyWrapperArg prop, std::string &outStr, JsonFormat format = JsonFormat::Pretty);
 	}
 }
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+module;
+
+#include "definitions.hpp"
+#include "util_enum_flags.hpp"
+
+export module pragma.udm:walk;
+
+export import :array;
+export import :parallel;
+export import :property;
+export import :types.element;
+
+export {
+	namespace udm {
+		enum class WalkResult : uint8_t {
+			Continue = 0,
+			SkipChildren, // Don't visit the children of the current node
+			Stop,         // Stop the walk entirely
+		};
+
+		enum class WalkFlags : uint32_t {
+			None = 0u,
+			// By default only items of element arrays are visited, with this flag the items of all arrays are visited
+			VisitAllArrayItems = 1u,
+		};
+
+		// Node visited by walk(). Array items don't have a property of their own, they're identified by the owning array and their index instead.
+		struct WalkNode {
+			static constexpr auto INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+			Property *prop = nullptr; // nullptr for array items
+			Array *array = nullptr;   // Owning array of an array item
+			uint32_t index = INVALID_INDEX;
+			std::string_view key; // Key within the parent element, empty for array items and the root
+			uint32_t depth = 0;
+			Type type = Type::Nil;
+
+			bool IsArrayItem() const { return array != nullptr; }
+			// Note: Values are not un-shared (see Property::Unshare), values of properties that were copied with MergeFlags::CopyOnWrite
+			// must not be modified through the node.
+			template<typename T>
+			T *GetValuePtr() const
+			{
+				return const_cast<T *>(array ? std::as_const(*array).GetValuePtr<T>(index) : std::as_const(*prop).GetValuePtr<T>());
+			}
+			Element *GetElement() const { return (type == Type::Element) ? GetValuePtr<Element>() : nullptr; }
+			Array *GetArray() const { return is_array_type(type) ? GetValuePtr<Array>() : nullptr; }
+		};
+
+		struct WalkContext {
+			WalkFlags flags = WalkFlags::None;
+			bool parallel = false;
+			uint32_t minItemsPerTask = PARALLEL_MIN_ITEMS_PER_TASK;
+			std::atomic<bool> stopped = false;
+		};
+
+		template<typename TVisitor>
+		bool walk_node(const WalkNode &node, TVisitor &visitor, WalkContext &ctx);
+		template<typename TVisitor>
+		bool walk_children(const WalkNode &node, TVisitor &visitor, WalkContext &ctx)
+		{
+			auto depth = node.depth + 1;
+			auto *el = node.GetElement();
+			if(el) {
+				if(!ctx.parallel || el->children.size() < ctx.minItemsPerTask) {
+					for(auto &[key, child] : el->children) {
+						if(child && !walk_node(WalkNode {child.get(), nullptr, WalkNode::INVALID_INDEX, key, depth, child->type}, visitor, ctx))
+							return false;
+					}
+					return true;
+				}
+				// Element children can't be accessed by index, so they have to be collected first
+				std::vector<std::pair<const std::string *, Property *>> children;
+				children.reserve(el->children.size());
+				for(auto &[key, child] : el->children) {
+					if(!child)
+						continue;
+					prepare_parallel_access(*child);
+					children.push_back({&key, child.get()});
+				}
+				parallel_for(
+				  static_cast<uint32_t>(children.size()),
+				  [&children, &visitor, &ctx, depth](uint32_t, uint32_t start, uint32_t end) {
+					  for(auto i = start; i < end; ++i) {
+						  auto &[key, child] = children[i];
+						  if(!walk_node(WalkNode {child, nullptr, WalkNode::INVALID_INDEX, *key, depth, child->type}, visitor, ctx))
+							  return;
+					  }
+				  },
+				  ctx.minItemsPerTask);
+				return !ctx.stopped;
+			}
+			auto *a = node.GetArray();
+			if(!a)
+				return true;
+			auto valueType = a->GetValueType();
+			if(valueType != Type::Element && !pragma::math::is_flag_set(ctx.flags, WalkFlags::VisitAllArrayItems))
+				return true;
+			auto size = a->GetSize();
+			if(!ctx.parallel || size < ctx.minItemsPerTask) {
+				for(auto i = decltype(size) {0u}; i < size; ++i) {
+					if(!walk_node(WalkNode {nullptr, a, i, {}, depth, valueType}, visitor, ctx))
+						return false;
+				}
+				return true;
+			}
+			prepare_parallel_access(*a);
+			parallel_for(
+			  size,
+			  [a, valueType, &visitor, &ctx, depth](uint32_t, uint32_t start, uint32_t end) {
+				  for(auto i = start; i < end; ++i) {
+					  if(!walk_node(WalkNode {nullptr, a, i, {}, depth, valueType}, visitor, ctx))
+						  return;
+				  }
+			  },
+			  ctx.minItemsPerTask);
+			return !ctx.stopped;
+		}
+
+		template<typename TVisitor>
+		bool walk_node(const WalkNode &node, TVisitor &visitor, WalkContext &ctx)
+		{
+			if(ctx.parallel && ctx.stopped.load(std::memory_order_relaxed))
+				return false;
+			auto result = WalkResult::Continue;
+			if constexpr(std::is_void_v<std::invoke_result_t<TVisitor &, const WalkNode &>>)
+				visitor(node);
+			else
+				result = visitor(node);
+			if(result == WalkResult::SkipChildren)
+				return true;
+			if(result == WalkResult::Stop) {
+				ctx.stopped = true;
+				return false;
+			}
+			return walk_children(node, visitor, ctx);
+		}
+
+		// Visits the property and all of its descendants in depth-first order without allocating any wrappers.
+		// The visitor is called as visitor(const WalkNode &) and may return a WalkResult to prune or stop the walk.
+		// Returns false if the walk was stopped. The tree must not be modified structurally during the walk.
+		template<typename TVisitor>
+		bool walk(Property &root, TVisitor &&visitor, WalkFlags flags = WalkFlags::None)
+		{
+			WalkContext ctx {flags};
+			return walk_node(WalkNode {&root, nullptr, WalkNode::INVALID_INDEX, {}, 0, root.type}, visitor, ctx);
+		}
+
+		// Same as walk(), but the children of elements and arrays with at least minItemsPerTask children are visited on the worker pool
+		// (see parallel_for). The visitor has to be safe to call concurrently, and the order in which nodes are visited is unspecified (parents
+		// are always visited before their children). If the walk is stopped, nodes that are already being visited on other threads may still complete.
+		// Compressed arrays are decompressed before they're handed to other threads (see prepare_parallel_access).
+		template<typename TVisitor>
+		bool walk_parallel(Property &root, TVisitor &&visitor, WalkFlags flags = WalkFlags::None, uint32_t minItemsPerTask = 64)
+		{
+			WalkContext ctx {flags, true, minItemsPerTask};
+			return walk_node(WalkNode {&root, nullptr, WalkNode::INVALID_INDEX, {}, 0, root.type}, visitor, ctx);
+		}
+	}
+
+	REGISTER_ENUM_FLAGS(udm::WalkFlags)
+}
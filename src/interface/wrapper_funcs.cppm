@@ -42,6 +42,8 @@ export namespace udm {
 	template<typename T>
 	T *get_property_value_ptr(Property &prop);
 	template<typename T>
+	const T *get_property_value_ptr(const Property &prop);
+	template<typename T>
 	std::optional<T> to_property_value(Property &prop);
 
 	// Any struct or class that isn't a UDM type is assumed to be a struct type
@@ -76,6 +78,8 @@ export namespace udm {
 	T &get_array_value(Array &a, uint32_t idx);
 	template<typename T>
 	T *get_array_value_ptr(Array &a, uint32_t idx);
+	template<typename T>
+	const T *get_array_value_ptr(const Array &a, uint32_t idx);
 
 	uint16_t get_array_structured_data_info_data_size_requirement(Array &a);
 	// Since we can't know all struct types ahead of time, we handle them separately
@@ -96,6 +100,10 @@ export namespace udm {
 	uint32_t get_array_value_size(const Array &a);
 	uint32_t get_array_size(const Array &a);
 	void *get_array_values(Array &a);
+	const void *get_array_values(const Array &a);
+	// Returns an empty span if T doesn't match the value type
+	template<typename T>
+	std::span<T> get_array_span(Array &a);
 	bool is_array_value_type(const Array &a, Type pvalueType);
 
 	template<typename T>
@@ -106,6 +114,7 @@ export namespace udm {
 	void get_array_end_iterator(Array &a, ArrayIterator<T> &outIt);
 
 	PProperty *find_element_child(Element &e, const std::string_view &key);
+	const PProperty *find_element_child(const Element &e, const std::string_view &key);
 	void remove_element_child(Element &e, const std::string_view &key);
 	void erase_element_child(Element &e, Element &child);
 	void set_element_child_value(Element &e, const std::string_view &key, const PProperty &prop);
@@ -5,6 +5,7 @@ module;
 
 export module pragma.udm:wrapper_funcs_impl;
 
+import :path_cache;
 import :property;
 import :types.string;
 import :wrapper_funcs;
@@ -39,6 +40,11 @@ export {
 		return prop.GetValuePtr<T>();
 	}
 	template<typename T>
+	const T *udm::get_property_value_ptr(const Property &prop)
+	{
+		return prop.GetValuePtr<T>();
+	}
+	template<typename T>
 	std::optional<T> udm::to_property_value(Property &prop)
 	{
 		return prop.ToValue<T>();
@@ -67,6 +73,11 @@ export {
 	{
 		return a.GetValuePtr<T>(idx);
 	}
+	template<typename T>
+	const T *udm::get_array_value_ptr(const Array &a, uint32_t idx)
+	{
+		return a.GetValuePtr<T>(idx);
+	}
 	template<typename T>
 	    requires(!udm::is_struct_type<T>)
 	void udm::set_array_value(Array &a, uint32_t idx, T &&v)
@@ -76,6 +87,13 @@ export {
 	uint32_t udm::get_array_value_size(const Array &a) { return a.GetValueSize(); }
 	uint32_t udm::get_array_size(const Array &a) { return a.GetSize(); }
 	void *udm::get_array_values(Array &a) { return a.GetValues(); }
+	const void *udm::get_array_values(const Array &a) { return a.GetValues(); }
+	template<typename T>
+	std::span<T> udm::get_array_span(Array &a)
+	{
+		auto span = a.TryAsSpan<T>();
+		return span ? *span : std::span<T> {};
+	}
 	bool udm::is_array_value_type(const Array &a, Type pvalueType) { return a.IsValueType(pvalueType); }
 
 	template<typename T>
@@ -96,19 +114,21 @@ export {
 			return nullptr;
 		return &it->second;
 	}
-	void udm::remove_element_child(Element &e, const std::string_view &key)
+	const udm::PProperty *udm::find_element_child(const Element &e, const std::string_view &key)
 	{
 		auto it = e.children.find(key);
 		if(it == e.children.end())
-			return;
-		e.children.erase(it);
+			return nullptr;
+		return &it->second;
 	}
+	void udm::remove_element_child(Element &e, const std::string_view &key) { e.EraseValue(key); }
 	void udm::erase_element_child(Element &e, Element &child) { e.EraseValue(child); }
-	void udm::set_element_child_value(Element &e, const std::string_view &key, const PProperty &prop) { e.children[std::string {key}] = prop; }
+	void udm::set_element_child_value(Element &e, const std::string_view &key, const PProperty &prop) { e.AddChild(std::string {key}, prop); }
 	template<typename T>
 	void udm::set_element_value(Element &parent, Element &child, T &&v)
 	{
 		parent.SetValue(child, std::forward<T>(v));
+		invalidate_path_caches(parent);
 	}
 	udm::PropertyWrapper &udm::get_element_parent_property(Element &e) { return e.parentProperty; }
 
@@ -169,11 +189,15 @@ export {
 				udm::get_property_value<T>(*static_cast<Property *>(nullptr));
 				udm::get_property_value<T>(*static_cast<PropertyWrapper *>(nullptr));
 				udm::get_property_value_ptr<T>(*static_cast<Property *>(nullptr));
+				udm::get_property_value_ptr<T>(*static_cast<const Property *>(nullptr));
 				udm::to_property_value<T>(*static_cast<Property *>(nullptr));
 				udm::set_property_value(*static_cast<Property *>(nullptr), v);
 
 				udm::get_array_value<T>(*static_cast<Array *>(nullptr), 0u);
 				udm::get_array_value_ptr<T>(*static_cast<Array *>(nullptr), 0u);
+				udm::get_array_value_ptr<T>(*static_cast<const Array *>(nullptr), 0u);
+				udm::get_array_span<T>(*static_cast<Array *>(nullptr));
+				udm::get_array_span<const T>(*static_cast<Array *>(nullptr));
 				udm::set_array_value<T>(*static_cast<Array *>(nullptr), 0u, std::forward<T>(v));
 				udm::get_array_begin_iterator<T>(*static_cast<Array *>(nullptr), *static_cast<ArrayIterator<T> *>(nullptr));
 				udm::get_array_end_iterator<T>(*static_cast<Array *>(nullptr), *static_cast<ArrayIterator<T> *>(nullptr));
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef __UDM_TEXT_SCAN_HPP__
+#define __UDM_TEXT_SCAN_HPP__
+
+// Character scanning shared by the ASCII and the JSON reader. This header has to be included in the global module fragment.
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UDM_TEXT_SIMD_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define UDM_TEXT_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UDM_TEXT_SIMD_NEON
+#endif
+
+namespace udm::text_scan {
+#ifdef UDM_TEXT_SIMD_NEON
+	// NEON has no movemask, each byte of the comparison result is narrowed to 4 bits instead
+	inline uint64_t get_nibble_mask(uint8x16_t mask) { return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0); }
+#endif
+
+	// Returns a pointer to the first character in [p, end) that is (Match = true) or isn't (Match = false) in the character set, or 'end'.
+	// TCharSet has to provide IsMember(char) and GetMask for the vector types, the 256-bit variant is optional.
+	template<class TCharSet, bool Match>
+	const char *find_char(const char *p, const char *end)
+	{
+#ifdef UDM_TEXT_SIMD_AVX2
+		if constexpr(requires(__m256i v) { TCharSet::GetMask(v); }) {
+			for(; end - p >= 32; p += 32) {
+				auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(TCharSet::GetMask(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)))));
+				if constexpr(!Match)
+					mask = ~mask;
+				if(mask != 0)
+					return p + std::countr_zero(mask);
+			}
+		}
+#endif
+#ifdef UDM_TEXT_SIMD_SSE2
+		for(; end - p >= 16; p += 16) {
+			auto mask = static_cast<uint32_t>(_mm_movemask_epi8(TCharSet::GetMask(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)))));
+			if constexpr(!Match)
+				mask = ~mask & 0xFFFFu;
+			if(mask != 0)
+				return p + std::countr_zero(mask);
+		}
+#elif defined(UDM_TEXT_SIMD_NEON)
+		for(; end - p >= 16; p += 16) {
+			auto v = TCharSet::GetMask(vld1q_u8(reinterpret_cast<const uint8_t *>(p)));
+			if constexpr(!Match)
+				v = vmvnq_u8(v);
+			auto mask = get_nibble_mask(v);
+			if(mask != 0)
+				return p + std::countr_zero(mask) / 4;
+		}
+#endif
+		while(p < end && TCharSet::IsMember(*p) != Match)
+			++p;
+		return p;
+	}
+
+	// Zero-based line of 'cur' and its offset from the start of that line
+	inline void get_cursor_position(const char *begin, const char *cur, uint32_t &outLine, uint32_t &outColumn)
+	{
+		auto *lineStart = begin;
+		outLine = 0;
+		for(auto *p = begin; p < cur; ++p) {
+			auto *next = static_cast<const char *>(memchr(p, '\n', cur - p));
+			if(!next)
+				break;
+			++outLine;
+			p = next;
+			lineStart = next + 1;
+		}
+		outColumn = static_cast<uint32_t>(cur - lineStart);
+	}
+}
+
+#endif
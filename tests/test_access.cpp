@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Path lookups and the non-throwing accessors: GetFromPath and TryGetFromPath have to agree on the path syntax, and the Try* accessors
+// must report errors instead of throwing.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	static_assert(noexcept(std::declval<const udm::PropertyWrapper &>().TryGetValue<int32_t>()));
+	static_assert(noexcept(std::declval<const udm::PropertyWrapper &>().TryGetConstValue<int32_t>()));
+	static_assert(noexcept(std::declval<const udm::PropertyWrapper &>().TryIndex(0)));
+	static_assert(noexcept(std::declval<const udm::PropertyWrapper &>().TryGetChild(udm::Key {"a"})));
+	static_assert(noexcept(std::declval<const udm::PropertyWrapper &>().TryGetFromPath("a")));
+	static_assert(noexcept(std::declval<udm::Property &>().TryGetValue<int32_t>()));
+	static_assert(noexcept(std::declval<udm::Array &>().TryGetValue<int32_t>(0)));
+	static_assert(noexcept(std::declval<const udm::Array &>().TryGetValue<int32_t>(0)));
+	static_assert(noexcept(std::declval<udm::Array &>().TryAsSpan<int32_t>()));
+
+	using udm_test::create_tree;
+
+	void test_path_syntax()
+	{
+		auto root = create_tree();
+		udm::PropertyWrapper wrapper {*root};
+		for(auto &[path, value] : std::initializer_list<std::pair<std::string_view, int32_t>> {{"child/\"a b\"/c", 2}, {"items[1]/n", 1}, {"compressed[1]/n", 1}}) {
+			auto linked = wrapper.GetFromPath(path);
+			auto res = wrapper.TryGetFromPath(path);
+			UDM_CHECK(linked && linked.ToValue<int32_t>() == value);
+			UDM_CHECK(res && res->ToValue<int32_t>() == value);
+		}
+		UDM_CHECK(wrapper.GetFromPath("child/value").ToValue<std::string>() == "a");
+		UDM_CHECK(wrapper.TryGetFromPath("child/value") && wrapper.TryGetFromPath("child/value")->ToValue<std::string>() == "a");
+		for(auto path : {"child/missing", "items[2]/n", "items[x]", "child/\"a b", "items[1"}) {
+			UDM_CHECK(!wrapper.GetFromPath(path));
+			UDM_CHECK(!wrapper.TryGetFromPath(path));
+		}
+	}
+
+	void test_get_from_path_assign()
+	{
+		auto root = create_tree();
+		udm::PropertyWrapper wrapper {*root};
+		wrapper.GetFromPath("items[0]/added") = int32_t {7};
+		auto res = wrapper.TryGetFromPath("items[0]/added");
+		UDM_CHECK(res && res->ToValue<int32_t>() == 7);
+	}
+
+	void test_try_errors()
+	{
+		auto isError = [](const auto &res, udm::AccessError err) { return !res && res.error() == err; };
+		auto root = create_tree();
+		udm::PropertyWrapper wrapper {*root};
+		UDM_CHECK(isError(wrapper.TryGetChild(udm::Key {"missing"}), udm::AccessError::NotFound));
+		UDM_CHECK(isError(wrapper.TryIndex(0), udm::AccessError::TypeMismatch));
+		auto items = wrapper.TryGetChild(udm::Key {"items"});
+		UDM_CHECK(items && isError(items->TryIndex(2), udm::AccessError::OutOfBounds));
+		auto item = items ? items->TryIndex(1) : std::unexpected {udm::AccessError::NotFound};
+		UDM_CHECK(item && isError(item->TryGetValue<int32_t>(), udm::AccessError::TypeMismatch));
+		UDM_CHECK(isError(udm::PropertyWrapper {}.TryGetValue<int32_t>(), udm::AccessError::InvalidProperty));
+		auto value = wrapper.TryGetFromPath("child/value");
+		UDM_CHECK(value && isError(value->TryGetValue<float>(), udm::AccessError::TypeMismatch));
+		auto strValue = value ? value->TryGetValue<std::string>() : std::unexpected {udm::AccessError::NotFound};
+		UDM_CHECK(strValue && **strValue == "a");
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"path_syntax", &test_path_syntax},
+	  {"get_from_path_assign", &test_get_from_path_assign},
+	  {"try_errors", &test_try_errors},
+	});
+}
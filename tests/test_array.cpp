@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// External array storage and span views: Adopted buffers are owned by the array, borrowed buffers are referenced, and read-only
+// borrowed buffers must never be written to, not even through a span.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	udm::Array &add_array(udm::Property &root, const std::string_view &key) { return root.GetValue<udm::Element>().AddArray(key, 0, udm::Type::Float).GetValue<udm::Array>(); }
+
+	void test_adopt_vector()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &a = add_array(*root, "a");
+		std::vector<float> values {1.f, 2.f, 3.f};
+		auto *data = values.data();
+		a.AdoptValues(std::move(values));
+		UDM_CHECK(a.HasExternalValues() && !a.IsBorrowed());
+		UDM_CHECK(a.GetSize() == 3 && std::as_const(a).GetValues() == data);
+		a.GetValue<float>(1) = 5.f;
+		UDM_CHECK(data[1] == 5.f);
+
+		// The buffer is moved back out without copying
+		std::vector<float> released;
+		UDM_CHECK(a.ReleaseValues(released));
+		UDM_CHECK(released.data() == data && released.size() == 3 && released[1] == 5.f);
+		UDM_CHECK(a.GetSize() == 0 && !a.HasExternalValues());
+
+		std::vector<int32_t> mismatch;
+		UDM_CHECK(!a.ReleaseValues(mismatch));
+	}
+
+	void test_adopt_buffer()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &a = add_array(*root, "a");
+		auto deleted = false;
+		auto *values = new float[2] {1.f, 2.f};
+		a.AdoptValues(udm::Type::Float, values, 2, [&deleted](void *p) {
+			delete[] static_cast<float *>(p);
+			deleted = true;
+		});
+		UDM_CHECK(a.HasExternalValues() && a.GetValue<float>(1) == 2.f);
+		UDM_CHECK(!deleted);
+
+		// Resizing copies the values into internal storage and releases the buffer
+		a.Resize(3);
+		UDM_CHECK(deleted && !a.HasExternalValues());
+		UDM_CHECK(a.GetValue<float>(0) == 1.f && a.GetValue<float>(1) == 2.f);
+	}
+
+	void test_borrow()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &a = add_array(*root, "a");
+		std::array<float, 3> values {1.f, 2.f, 3.f};
+		a.BorrowValues(udm::Type::Float, values.data(), static_cast<uint32_t>(values.size()));
+		UDM_CHECK(a.IsBorrowed());
+		a.GetValue<float>(0) = 4.f;
+		a.AsSpan<float>()[2] = 6.f;
+		UDM_CHECK(values[0] == 4.f && values[2] == 6.f);
+		UDM_CHECK(a.IsBorrowed());
+	}
+
+	void test_borrow_read_only()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		const std::array<float, 3> values {1.f, 2.f, 3.f};
+		auto &a = add_array(*root, "a");
+		a.BorrowValues(udm::Type::Float, values.data(), static_cast<uint32_t>(values.size()));
+		UDM_CHECK(a.IsBorrowed() && std::as_const(a).GetValues() == values.data());
+
+		// Reading doesn't copy the values
+		UDM_CHECK(std::as_const(a).GetValue<float>(1) == 2.f && a.IsBorrowed());
+
+		a.GetValue<float>(0) = 4.f;
+		UDM_CHECK(!a.IsBorrowed());
+		UDM_CHECK(values[0] == 1.f && a.GetValue<float>(0) == 4.f);
+
+		auto &b = add_array(*root, "b");
+		b.BorrowValues(udm::Type::Float, values.data(), static_cast<uint32_t>(values.size()));
+		auto span = b.AsSpan<float>();
+		span[1] = 5.f;
+		UDM_CHECK(!b.IsBorrowed() && span.data() != values.data());
+		UDM_CHECK(values[1] == 2.f && b.GetValue<float>(1) == 5.f);
+
+		auto &c = add_array(*root, "c");
+		c.BorrowValues(udm::Type::Float, values.data(), static_cast<uint32_t>(values.size()));
+		auto *ptr = c.GetValuePtr<float>(2);
+		UDM_CHECK(ptr != nullptr && ptr != &values[2]);
+
+		// Released values are always copied from a borrowed buffer
+		auto &d = add_array(*root, "d");
+		d.BorrowValues(udm::Type::Float, values.data(), static_cast<uint32_t>(values.size()));
+		std::vector<float> released;
+		UDM_CHECK(d.ReleaseValues(released));
+		UDM_CHECK(released == std::vector<float>(values.begin(), values.end()) && d.GetSize() == 0);
+
+		// Mutable spans through a property wrapper
+		add_array(*root, "e").BorrowValues(udm::Type::Float, values.data(), static_cast<uint32_t>(values.size()));
+		auto e = udm::PropertyWrapper {*root}["e"];
+		UDM_CHECK(e.AsSpan<const float>().data() == values.data());
+		auto eSpan = e.AsSpan<float>();
+		UDM_CHECK(eSpan.size() == 3 && eSpan.data() != values.data());
+		eSpan[0] = 7.f;
+		UDM_CHECK(values[0] == 1.f && e[0].ToValue<float>() == 7.f);
+	}
+
+	void test_spans()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &a = add_array(*root, "a");
+		a.Resize(4);
+		auto span = a.AsSpan<float>();
+		UDM_CHECK(span.size() == 4 && span.data() == std::as_const(a).GetValues());
+		for(auto i = decltype(span.size()) {0u}; i < span.size(); ++i)
+			span[i] = static_cast<float>(i);
+		UDM_CHECK(a.GetValue<float>(3) == 3.f);
+		UDM_CHECK(std::as_const(a).AsSpan<float>()[2] == 2.f);
+
+		// Mismatching types
+		auto threw = false;
+		try {
+			a.AsSpan<int32_t>();
+		}
+		catch(const udm::LogicError &) {
+			threw = true;
+		}
+		UDM_CHECK(threw);
+		auto res = a.TryAsSpan<int32_t>();
+		UDM_CHECK(!res && res.error() == udm::AccessError::TypeMismatch);
+		UDM_CHECK(a.TryAsSpan<float>().has_value());
+		UDM_CHECK(udm::PropertyWrapper {*root}["a"].AsSpan<int32_t>().empty());
+		UDM_CHECK(udm::PropertyWrapper {*root}["missing"].AsSpan<float>().empty());
+	}
+
+	void test_compressed_spans()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &a = static_cast<udm::ArrayLz4 &>(root->GetValue<udm::Element>().AddArray("a", 3, udm::Type::Float, udm::ArrayType::Compressed).GetValue<udm::Array>());
+		auto span = a.AsSpan<float>();
+		UDM_CHECK(span.size() == 3);
+		span[1] = 2.f;
+
+		// The values are decompressed again for the span
+		a.ClearUncompressedMemory();
+		auto span2 = std::as_const(a).AsSpan<float>();
+		UDM_CHECK(span2.size() == 3 && span2[1] == 2.f);
+	}
+
+	void test_struct_member_spans()
+	{
+		struct Vertex {
+			udm::Vector3 pos;
+			float weight;
+		};
+		auto root = udm::Property::Create<udm::Element>();
+		auto strct = udm::StructDescription::Define<udm::Vector3, float>({"pos", "weight"});
+		std::vector<Vertex> vertices {{{1.f, 2.f, 3.f}, 0.5f}, {{4.f, 5.f, 6.f}, 1.5f}};
+		auto &a = udm::PropertyWrapper {*root}.AddArray("a", strct, vertices).GetValue<udm::Array>();
+
+		auto span = a.AsSpan<Vertex>();
+		UDM_CHECK(span.size() == 2 && span[1].weight == 1.5f);
+
+		auto weights = a.GetStructMemberSpan<float>("weight");
+		UDM_CHECK(weights.size() == 2 && weights.stride() == sizeof(Vertex));
+		UDM_CHECK(weights[0] == 0.5f && weights[1] == 1.5f);
+		weights[0] = 2.5f;
+		UDM_CHECK(span[0].weight == 2.5f);
+		auto positions = std::as_const(a).GetStructMemberSpan<udm::Vector3>(0);
+		UDM_CHECK(positions.size() == 2 && positions[1] == udm::Vector3(4.f, 5.f, 6.f));
+		auto sum = 0.f;
+		for(auto w : weights)
+			sum += w;
+		UDM_CHECK(sum == 4.f);
+
+		// Mismatching member types and sizes
+		auto threw = false;
+		try {
+			a.GetStructMemberSpan<int32_t>("weight");
+		}
+		catch(const udm::LogicError &) {
+			threw = true;
+		}
+		UDM_CHECK(threw);
+		UDM_CHECK(!a.TryAsSpan<udm::Vector3>().has_value() && !a.TryAsSpan<double>().has_value());
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"adopt_vector", &test_adopt_vector},
+	  {"adopt_buffer", &test_adopt_buffer},
+	  {"borrow", &test_borrow},
+	  {"borrow_read_only", &test_borrow_read_only},
+	  {"spans", &test_spans},
+	  {"compressed_spans", &test_compressed_spans},
+	  {"struct_member_spans", &test_struct_member_spans},
+	});
+}
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// ASCII format: Number parsing, value formatting and loading from memory
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	template<typename T>
+	std::optional<T> get_value(const udm::Data &data, const std::string &key)
+	{
+		return data[key].ToValue<T>();
+	}
+
+	void test_integer_parsing()
+	{
+		// Integers are parsed like with strtoll/strtoull, i.e. they're truncated to the target type and negative values wrap around for
+		// unsigned types
+		auto data = udm::Data::LoadAscii("$uint32 a -1\n"
+		                                 "$uint8 b 300\n"
+		                                 "$int32 c 3000000000\n"
+		                                 "$int64 d 99999999999999999999\n"
+		                                 "$int64 e -99999999999999999999\n"
+		                                 "$uint64 f 18446744073709551615\n"
+		                                 "$uint64 g 99999999999999999999\n"
+		                                 "$int32 h 1.9\n"
+		                                 "$int16 i +12\n"
+		                                 "$array j [uint16;2][-1,70000]\n");
+		UDM_CHECK(data != nullptr);
+		if(!data)
+			return;
+		UDM_CHECK(get_value<uint32_t>(*data, "a") == std::numeric_limits<uint32_t>::max());
+		UDM_CHECK(get_value<uint8_t>(*data, "b") == static_cast<uint8_t>(300));
+		UDM_CHECK(get_value<int32_t>(*data, "c") == static_cast<int32_t>(3000000000ll));
+		UDM_CHECK(get_value<int64_t>(*data, "d") == std::numeric_limits<int64_t>::max());
+		UDM_CHECK(get_value<int64_t>(*data, "e") == std::numeric_limits<int64_t>::lowest());
+		UDM_CHECK(get_value<uint64_t>(*data, "f") == std::numeric_limits<uint64_t>::max());
+		UDM_CHECK(get_value<uint64_t>(*data, "g") == std::numeric_limits<uint64_t>::max());
+		UDM_CHECK(get_value<int32_t>(*data, "h") == 1);
+		UDM_CHECK(get_value<int16_t>(*data, "i") == 12);
+		auto j = (*data)["j"];
+		UDM_CHECK(j.GetSize() == 2 && j[0].ToValue<uint16_t>() == std::numeric_limits<uint16_t>::max() && j[1].ToValue<uint16_t>() == static_cast<uint16_t>(70000));
+	}
+
+	void test_float_parsing()
+	{
+		auto data = udm::Data::LoadAscii("$float a 1.5\n"
+		                                 "$double b -2.25e2\n"
+		                                 "$half c 0.5\n"
+		                                 "$float d invalid\n");
+		UDM_CHECK(data != nullptr);
+		if(!data)
+			return;
+		UDM_CHECK(get_value<float>(*data, "a") == 1.5f);
+		UDM_CHECK(get_value<double>(*data, "b") == -225.0);
+		UDM_CHECK(get_value<float>(*data, "c") == 0.5f);
+		UDM_CHECK(get_value<float>(*data, "d") == 0.f);
+	}
+
+	void test_value_formatting()
+	{
+		// ToAsciiValue goes through the same writer as the file output
+		auto flags = udm::AsciiSaveFlags::None;
+		UDM_CHECK(udm::Property::ToAsciiValue(flags, udm::Vector3 {1.f, 2.5f, 3.f}) == "[1,2.5,3]");
+		UDM_CHECK(udm::Property::ToAsciiValue(flags, udm::Quaternion {1.f, 0.f, 0.f, 0.f}) == "[1,0,0,0]");
+		UDM_CHECK(udm::Property::ToAsciiValue(flags, udm::String {"a\\b"}) == "\"a\\\\b\"");
+		UDM_CHECK(udm::Property::ToAsciiValue(flags, udm::Blob {std::vector<uint8_t> {'a', 'b', 'c'}}) == "[YWJj]");
+		UDM_CHECK(udm::Property::ToAsciiValue(flags, udm::Nil {}).empty());
+
+		auto prop = udm::Property::Create<udm::Element>();
+		auto a = prop->GetValue<udm::Element>().AddArray("a", 2, udm::Type::Int32);
+		a[0] = int32_t {1};
+		a[1] = int32_t {2};
+		UDM_CHECK(udm::Property::ToAsciiValue(flags, a.GetValue<udm::Array>()) == "[int32;2][1,2]");
+	}
+
+	void test_memory_file_load()
+	{
+		// Memory files are parsed in place, the cursor has to end up at the same position as if the data had been read
+		std::string ascii = "$uint32 a 5\n";
+		std::unique_ptr<udm::IFile> f = std::make_unique<udm::MemoryFile>(reinterpret_cast<uint8_t *>(ascii.data()), ascii.size());
+		auto data = udm::Data::Load(std::move(f));
+		UDM_CHECK(data && get_value<uint32_t>(*data, "a") == 5);
+		if(f)
+			UDM_CHECK(f->Tell() == ascii.size());
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"integer_parsing", &test_integer_parsing},
+	  {"float_parsing", &test_float_parsing},
+	  {"value_formatting", &test_value_formatting},
+	  {"memory_file_load", &test_memory_file_load},
+	});
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Base64: The SIMD and the scalar code paths have to produce the same results, in particular around the block boundaries
+// (12 bytes / 16 characters per block, decoding requires at least 24 remaining characters).
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	std::vector<uint8_t> create_data(size_t size)
+	{
+		std::vector<uint8_t> data(size);
+		for(auto i = decltype(size) {0u}; i < size; ++i)
+			data[i] = static_cast<uint8_t>(i * 37 + size);
+		return data;
+	}
+	std::optional<std::vector<uint8_t>> decode(const std::string_view &str)
+	{
+		std::vector<uint8_t> data(udm::base64_get_max_decoded_size(str.size()));
+		auto size = udm::base64_decode(str, data.data());
+		if(!size.has_value())
+			return {};
+		data.resize(*size);
+		return data;
+	}
+
+	void test_round_trip()
+	{
+		auto failures = 0u;
+		for(auto size = size_t {0u}; size <= 100; ++size) {
+			auto data = create_data(size);
+			auto str = udm::base64_encode(data.data(), data.size());
+			auto decoded = decode(str);
+			if(str.size() != udm::base64_get_encoded_size(size) || !decoded || *decoded != data)
+				++failures;
+		}
+		UDM_CHECK(failures == 0);
+	}
+
+	void test_known_values()
+	{
+		std::string_view str {"Many hands make light work."};
+		UDM_CHECK(udm::base64_encode(str.data(), str.size()) == "TWFueSBoYW5kcyBtYWtlIGxpZ2h0IHdvcmsu");
+		UDM_CHECK(udm::base64_encode(str.data(), 1) == "TQ==");
+		UDM_CHECK(udm::base64_encode(str.data(), 2) == "TWE=");
+		auto decoded = decode("TWFueSBoYW5kcyBtYWtlIGxpZ2h0IHdvcmsu");
+		UDM_CHECK(decoded && std::string_view {reinterpret_cast<const char *>(decoded->data()), decoded->size()} == str);
+	}
+
+	void test_whitespace()
+	{
+		auto data = create_data(60);
+		auto str = udm::base64_encode(data.data(), data.size());
+		// Whitespace stops block decoding, the rest is decoded by the scalar decoder
+		for(auto pos : {size_t {5}, size_t {16}, size_t {40}, str.size()}) {
+			auto withWhitespace = str;
+			withWhitespace.insert(pos, "\n  \t");
+			auto decoded = decode(withWhitespace);
+			UDM_CHECK(decoded && *decoded == data);
+		}
+	}
+
+	void test_invalid()
+	{
+		auto data = create_data(60);
+		auto str = udm::base64_encode(data.data(), data.size());
+		// Invalid characters in the first block, in a later block and in the scalar tail
+		for(auto pos : {size_t {3}, size_t {20}, str.size() - 2}) {
+			auto invalid = str;
+			invalid[pos] = '*';
+			UDM_CHECK(!decode(invalid).has_value());
+		}
+		UDM_CHECK(!decode("TQ=x").has_value());
+		UDM_CHECK(!decode("T").has_value());
+		UDM_CHECK(!decode("TQ===").has_value());
+		UDM_CHECK(decode("") && decode("")->empty());
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"round_trip", &test_round_trip},
+	  {"known_values", &test_known_values},
+	  {"whitespace", &test_whitespace},
+	  {"invalid", &test_invalid},
+	});
+}
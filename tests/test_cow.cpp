@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Copy-on-write isolation: Every mutation of a copy created with udm::MergeFlags::CopyOnWrite (or udm::Property::Share)
+// must leave the original untouched, and vice versa.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	using udm_test::create_tree;
+
+	udm::PProperty copy_tree(const udm::Property &root) { return root.Copy(udm::MergeFlags::CopyOnWrite); }
+
+	const udm::Element &get_element(const udm::Property &prop) { return std::as_const(prop).GetValue<udm::Element>(); }
+	const udm::Property *find_child(const udm::Property &prop, const std::string &key)
+	{
+		auto &el = get_element(prop);
+		auto it = el.children.find(key);
+		return (it != el.children.end()) ? it->second.get() : nullptr;
+	}
+	std::string get_child_string(const udm::Property &prop)
+	{
+		auto *child = find_child(prop, "child");
+		return child ? std::string {get_element(*child).children.find("value")->second->GetValue<std::string>()} : std::string {};
+	}
+	const udm::Array &get_array(const udm::Property &prop, const std::string &key) { return find_child(prop, key)->GetValue<udm::Array>(); }
+
+	void test_element_add_child()
+	{
+		auto root = create_tree();
+		auto copy = copy_tree(*root);
+		copy->GetValue<udm::Element>().AddChild("added", udm::Property::Create<int32_t>(1));
+		UDM_CHECK(find_child(*root, "added") == nullptr);
+		UDM_CHECK(find_child(*copy, "added") != nullptr);
+
+		// Element reference obtained before the copy was made
+		auto &el = root->GetValue<udm::Element>();
+		auto copy2 = copy_tree(*root);
+		el.AddChild("added2", udm::Property::Create<int32_t>(2));
+		UDM_CHECK(find_child(*copy2, "added2") == nullptr);
+		UDM_CHECK(find_child(*root, "added2") != nullptr);
+	}
+
+	void test_element_set_value()
+	{
+		auto root = create_tree();
+		auto copy = copy_tree(*root);
+		// Assigning a value to an element property replaces the child in its parent element
+		(*copy)["child"] = int32_t {5};
+		UDM_CHECK(find_child(*root, "child")->type == udm::Type::Element);
+		UDM_CHECK(get_child_string(*root) == "a");
+		UDM_CHECK(find_child(*copy, "child")->type == udm::Type::Int32);
+	}
+
+	void test_element_erase_value()
+	{
+		auto root = create_tree();
+		auto copy = copy_tree(*root);
+		// Assigning nullopt to a child of an array item removes the child
+		(*copy)["compressed"][0]["n"] = std::optional<int32_t> {};
+		UDM_CHECK(get_array(*copy, "compressed").GetValue<udm::Element>(0).children.contains("n") == false);
+		UDM_CHECK(get_array(*root, "compressed").GetValue<udm::Element>(0).children.contains("n"));
+	}
+
+	void test_linked_wrapper_setter()
+	{
+		auto root = create_tree();
+		auto copy = copy_tree(*root);
+		(*copy)["child"]["value"] = std::string {"b"};
+		UDM_CHECK(get_child_string(*root) == "a");
+		UDM_CHECK(get_child_string(*copy) == "b");
+
+		(*root)["child"]["value"] = std::string {"c"};
+		UDM_CHECK(get_child_string(*root) == "c");
+		UDM_CHECK(get_child_string(*copy) == "b");
+	}
+
+	void test_unlinked_wrapper_setter()
+	{
+		auto prop = udm::Property::Create<std::string>("a");
+		auto shared = prop->Share();
+		UDM_CHECK(prop->IsShared() && shared->IsShared());
+		udm::PropertyWrapper {*shared} = std::string {"b"};
+		UDM_CHECK(prop->GetValue<std::string>() == "a");
+		UDM_CHECK(shared->GetValue<std::string>() == "b");
+		UDM_CHECK(!prop->IsShared() && !shared->IsShared());
+	}
+
+	void test_property_assignment()
+	{
+		auto prop = udm::Property::Create<std::string>("a");
+		auto shared = prop->Share();
+		*shared = *udm::Property::Create<std::string>("b");
+		UDM_CHECK(prop->GetValue<std::string>() == "a");
+		UDM_CHECK(shared->GetValue<std::string>() == "b");
+
+		auto shared2 = prop->Share();
+		*shared2 = std::string {"c"};
+		UDM_CHECK(prop->GetValue<std::string>() == "a");
+		UDM_CHECK(shared2->GetValue<std::string>() == "c");
+	}
+
+	void test_non_const_get_value()
+	{
+		auto prop = udm::Property::Create<std::string>("a");
+		auto shared = prop->Share();
+		shared->GetValue<std::string>() = "b";
+		UDM_CHECK(prop->GetValue<std::string>() == "a");
+
+		// References obtained before the value was shared are not isolated: The property that is written to keeps the value object,
+		// so the reference refers to the value of the writer afterwards (see Property::Share)
+		auto &value = prop->GetValue<std::string>();
+		auto shared2 = prop->Share();
+		shared2->GetValue<std::string>() = "c";
+		UDM_CHECK(prop->GetValue<std::string>() == "a");
+		UDM_CHECK(shared2->GetValue<std::string>() == "c");
+		UDM_CHECK(&value == &shared2->GetValue<std::string>() && value == "c");
+	}
+
+	void test_array_set_value()
+	{
+		auto root = create_tree();
+		auto copy = copy_tree(*root);
+		(*copy)["arr"][0] = std::string {"z"};
+		UDM_CHECK(get_array(*root, "arr").GetValue<std::string>(0) == "x");
+		UDM_CHECK(get_array(*copy, "arr").GetValue<std::string>(0) == "z");
+
+		// Array reference obtained before the copy was made
+		auto &a = (*root)["arr"].GetValue<udm::Array>();
+		auto copy2 = copy_tree(*root);
+		a.SetValue(1, std::string {"w"});
+		UDM_CHECK(get_array(*copy2, "arr").GetValue<std::string>(1) == "y");
+		UDM_CHECK(get_array(*root, "arr").GetValue<std::string>(1) == "w");
+	}
+
+	void test_array_resize()
+	{
+		auto root = create_tree();
+		auto copy = copy_tree(*root);
+		(*copy)["arr"].Resize(5);
+		UDM_CHECK(get_array(*root, "arr").GetSize() == 2);
+		UDM_CHECK(get_array(*copy, "arr").GetSize() == 5);
+
+		auto &a = (*root)["arr"].GetValue<udm::Array>();
+		auto copy2 = copy_tree(*root);
+		a.Resize(1);
+		UDM_CHECK(get_array(*copy2, "arr").GetSize() == 2);
+		UDM_CHECK(get_array(*root, "arr").GetSize() == 1);
+	}
+
+	void test_compressed_array()
+	{
+		auto root = create_tree();
+		auto copy = copy_tree(*root);
+		(*copy)["compressed"][0]["n"] = int32_t {7};
+		UDM_CHECK(get_array(*root, "compressed").GetValue<udm::Element>(0).children.find("n")->second->GetValue<int32_t>() == 0);
+		UDM_CHECK(get_array(*copy, "compressed").GetValue<udm::Element>(0).children.find("n")->second->GetValue<int32_t>() == 7);
+	}
+
+	void test_move()
+	{
+		auto prop = udm::Property::Create<std::string>("a");
+		auto shared = prop->Share();
+		udm::Property moved {std::move(*shared)};
+		UDM_CHECK(moved.IsShared());
+		UDM_CHECK(!shared->IsShared());
+		moved.GetValue<std::string>() = "b";
+		UDM_CHECK(prop->GetValue<std::string>() == "a");
+		UDM_CHECK(moved.GetValue<std::string>() == "b");
+
+		auto shared2 = prop->Share();
+		udm::Property moved2 {std::move(*shared2)};
+		prop->GetValue<std::string>() = "c";
+		UDM_CHECK(moved2.GetValue<std::string>() == "a");
+	}
+
+	void test_parent_keys()
+	{
+		auto root = create_tree();
+		auto &el = get_element(*root);
+		auto child = el.children.find("child")->second;
+		UDM_CHECK(child->parent == &el && el.FindKey(*child) && *el.FindKey(*child) == "child");
+
+		// The same property added to a second element remains owned by the first one
+		auto other = udm::Property::Create<udm::Element>();
+		auto &otherEl = other->GetValue<udm::Element>();
+		otherEl.AddChild("other", child);
+		UDM_CHECK(child->parent == &el);
+		UDM_CHECK(otherEl.FindKey(*child) && *otherEl.FindKey(*child) == "other");
+
+		// Replaced children are detached
+		root->GetValue<udm::Element>().AddChild("child", udm::Property::Create<int32_t>(1));
+		UDM_CHECK(child->parent == nullptr && child->key == nullptr);
+		UDM_CHECK(el.FindKey(*child) == nullptr);
+		UDM_CHECK(otherEl.FindKey(*child) && *otherEl.FindKey(*child) == "other");
+		{
+			udm::Element copyEl {};
+			copyEl = otherEl;
+			UDM_CHECK(child->parent == &copyEl && *copyEl.FindKey(*child) == "other");
+		}
+		UDM_CHECK(child->parent == nullptr);
+
+		// Both sides of a copy-on-write copy have their own children once the value is un-shared
+		auto root2 = create_tree();
+		auto copy = copy_tree(*root2);
+		copy->GetValue<udm::Element>();
+		for(auto *prop : {root2.get(), copy.get()}) {
+			auto &propEl = get_element(*prop);
+			auto *propChild = find_child(*prop, "child");
+			UDM_CHECK(propChild->parent == &propEl && *propEl.FindKey(*propChild) == "child");
+		}
+	}
+
+	void test_data_copy()
+	{
+		auto data = udm::Data::Create("test", 1);
+		data->GetAssetData().GetData()["child"]["value"] = std::string {"a"};
+		auto copy = data->Copy();
+		copy->GetAssetData().GetData()["child"]["value"] = std::string {"b"};
+		UDM_CHECK(data->GetAssetData().GetData()["child"]["value"].ToValue<std::string>() == "a");
+		UDM_CHECK(copy->GetAssetData().GetData()["child"]["value"].ToValue<std::string>() == "b");
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"element_add_child", &test_element_add_child},
+	  {"element_set_value", &test_element_set_value},
+	  {"element_erase_value", &test_element_erase_value},
+	  {"linked_wrapper_setter", &test_linked_wrapper_setter},
+	  {"unlinked_wrapper_setter", &test_unlinked_wrapper_setter},
+	  {"property_assignment", &test_property_assignment},
+	  {"non_const_get_value", &test_non_const_get_value},
+	  {"array_set_value", &test_array_set_value},
+	  {"array_resize", &test_array_resize},
+	  {"compressed_array", &test_compressed_array},
+	  {"move", &test_move},
+	  {"parent_keys", &test_parent_keys},
+	  {"data_copy", &test_data_copy},
+	});
+}
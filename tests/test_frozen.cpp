@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Frozen data: The frozen representation has to provide the same values as the source document without modifying it, and
+// thawing it has to restore an equal document.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	std::shared_ptr<udm::Data> create_data()
+	{
+		auto data = udm_test::create_data();
+		auto root = data->GetAssetData().GetData();
+		root.AddArray("floats", std::vector<float> {0.5f, 1.25f, 2.f});
+		root["vec"] = udm::Vector3 {1.f, 2.f, 3.f};
+		return data;
+	}
+
+	void test_values()
+	{
+		auto data = create_data();
+		auto frozen = data->Freeze();
+		auto root = frozen->GetAssetData();
+		UDM_CHECK(root.IsType(udm::Type::Element));
+		UDM_CHECK(root["child"]["value"].GetString() == "a");
+		UDM_CHECK(root["child"]["a b"]["c"].ToValue<int32_t>() == 2);
+		auto *vec = root["vec"].GetValuePtr<udm::Vector3>();
+		UDM_CHECK(vec && *vec == udm::Vector3(1.f, 2.f, 3.f));
+		auto floats = root["floats"].GetArray<float>();
+		UDM_CHECK(floats.size() == 3 && floats[1] == 1.25f);
+		UDM_CHECK(root["arr"].GetSize() == 2 && root["arr"][1].GetString() == "y");
+		UDM_CHECK(root["items"][1]["n"].ToValue<int32_t>() == 1);
+		UDM_CHECK(!root["missing"] && !root["items"][2]);
+
+		// Children are sorted by key
+		for(auto i = decltype(root.GetSize()) {1u}; i < root.GetSize(); ++i)
+			UDM_CHECK(root.GetKey(i - 1) < root.GetKey(i));
+	}
+
+	void test_paths()
+	{
+		auto frozen = create_data()->Freeze();
+		UDM_CHECK(frozen->GetFromPath("assetData/child/\"a b\"/c").ToValue<int32_t>() == 2);
+		UDM_CHECK(frozen->GetFromPath("assetData/items[1]/n").ToValue<int32_t>() == 1);
+		UDM_CHECK(!frozen->GetFromPath("assetData/items[2]/n"));
+		UDM_CHECK(!frozen->GetFromPath("assetData/missing"));
+	}
+
+	void test_compressed_array()
+	{
+		// Freezing a compressed array must not decompress the source array
+		auto data = create_data();
+		auto &a = static_cast<udm::ArrayLz4 &>((*data)["compressed"].GetValue<udm::Array>());
+		a.ClearUncompressedMemory();
+		auto compressedSize = std::as_const(a).GetCompressedBlob().compressedData.size();
+		auto frozen = data->Freeze();
+		UDM_CHECK(frozen->GetAssetData()["compressed"][1]["n"].ToValue<int32_t>() == 1);
+		auto stats = udm::MemoryStatistics::Calculate(data->GetRootElement());
+		UDM_CHECK(stats.lz4DecompressedBytes == 0 && stats.lz4CompressedBytes > 0);
+		UDM_CHECK(std::as_const(a).GetCompressedBlob().compressedData.size() == compressedSize);
+	}
+
+	void test_thaw()
+	{
+		auto data = create_data();
+		auto thawed = data->Freeze()->Thaw();
+		UDM_CHECK(thawed && *thawed == *data);
+		UDM_CHECK(thawed && thawed->GetAssetType() == data->GetAssetType() && thawed->GetAssetVersion() == data->GetAssetVersion());
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"values", &test_values},
+	  {"paths", &test_paths},
+	  {"compressed_array", &test_compressed_array},
+	  {"thaw", &test_thaw},
+	});
+}
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// JSON format: Value formatting, and loading JSON back with and without type hints
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	std::string to_json_string(const udm::LinkedPropertyWrapper &prop)
+	{
+		std::string json;
+		udm::to_json(prop, json, udm::JsonFormat::Compact);
+		return json;
+	}
+
+	udm::Type get_array_value_type(const udm::LinkedPropertyWrapper &prop)
+	{
+		auto *a = prop.GetValuePtr<udm::Array>();
+		return a ? a->GetValueType() : udm::Type::Invalid;
+	}
+
+	void test_value_formatting()
+	{
+		auto data = udm::Data::Create("test", 1);
+		auto root = data->GetAssetData().GetData();
+		root["vec"] = udm::Vector3 {1.f, 2.5f, 3.f};
+		root["mat"] = udm::Mat4 {1.f};
+		root["blob"] = udm::Blob {std::vector<uint8_t> {0xFF, 0xFF, 0x00}};
+		root["str"] = std::string {"a\"b"};
+		root["bool"] = true;
+		root["inf"] = std::numeric_limits<float>::infinity();
+
+		UDM_CHECK(to_json_string(root["vec"]) == "[1,2.5,3]");
+		// Nested lists are separated by commas, unlike in the ASCII format
+		UDM_CHECK(to_json_string(root["mat"]) == "[[1,0,0,0],[0,1,0,0],[0,0,1,0],[0,0,0,1]]");
+		UDM_CHECK(udm::Property::ToAsciiValue(udm::AsciiSaveFlags::None, udm::Mat4 {1.f}) == "[[1,0,0,0][0,1,0,0][0,0,1,0][0,0,0,1]]");
+		UDM_CHECK(to_json_string(root["blob"]) == "\"//8A\"");
+		UDM_CHECK(to_json_string(root["str"]) == "\"a\\\"b\"");
+		UDM_CHECK(to_json_string(root["bool"]) == "true");
+		UDM_CHECK(to_json_string(root["inf"]) == "null");
+	}
+
+	void test_large_output()
+	{
+		// Larger than the write buffer, so the output is flushed several times
+		constexpr uint32_t NUM_VALUES = 64 * 1024;
+		auto data = udm::Data::Create("test", 1);
+		auto root = data->GetAssetData().GetData();
+		auto a = root.AddArray("values", NUM_VALUES, udm::Type::UInt32);
+		for(auto i = decltype(NUM_VALUES) {0u}; i < NUM_VALUES; ++i)
+			a[i] = i;
+		auto json = to_json_string(root["values"]);
+		UDM_CHECK(json.size() > udm::TextBuffer::BUFFER_SIZE);
+		UDM_CHECK(json.starts_with("[0,1,2,") && json.ends_with(",65534,65535]"));
+	}
+
+	void test_round_trip()
+	{
+		auto data = udm_test::create_data();
+		auto root = data->GetAssetData().GetData();
+		root["i"] = int32_t {-5};
+		root["big"] = std::numeric_limits<uint64_t>::max();
+		root["neg"] = int64_t {-5'000'000'000};
+		root["d"] = 1.5;
+		root["str"] = std::string {"a\"b\n"};
+		root["vec"] = udm::Vector3 {1.f, 2.5f, 3.f};
+		root["blob"] = udm::Blob {std::vector<uint8_t> {0xFF, 0xFF, 0x00}};
+		root.AddArray("floats", std::vector<float> {0.5f, 1.25f});
+
+		// Pretty output, so that the whitespace between the tokens has to be skipped as well
+		std::string json;
+		udm::to_json(root, json, udm::JsonFormat::Pretty);
+		auto loaded = udm::Data::LoadJson(json, {{"vec", udm::Type::Vector3}, {"blob", udm::Type::Blob}, {"floats", udm::Type::Float}});
+		UDM_CHECK(loaded != nullptr);
+		if(!loaded)
+			return;
+		auto &l = *loaded;
+		UDM_CHECK(l["i"].GetType() == udm::Type::Int32 && l["i"].ToValue<int32_t>() == -5);
+		UDM_CHECK(l["big"].GetType() == udm::Type::UInt64 && l["big"].ToValue<uint64_t>() == std::numeric_limits<uint64_t>::max());
+		UDM_CHECK(l["neg"].GetType() == udm::Type::Int64 && l["neg"].ToValue<int64_t>() == -5'000'000'000);
+		UDM_CHECK(l["d"].GetType() == udm::Type::Double && l["d"].ToValue<double>() == 1.5);
+		UDM_CHECK(l["str"].ToValue<std::string>() == "a\"b\n");
+		UDM_CHECK(l["vec"] == root["vec"]);
+		UDM_CHECK(l["blob"] == root["blob"]);
+		UDM_CHECK(l["floats"] == root["floats"]);
+		UDM_CHECK(l["child"] == root["child"]);
+		UDM_CHECK(l["arr"] == root["arr"]);
+		UDM_CHECK(l["items"] == root["items"]);
+		// Compressed arrays are loaded as regular arrays
+		UDM_CHECK(l["compressed"].GetSize() == 2 && l["compressed"][1]["n"].ToValue<int32_t>() == 1);
+	}
+
+	void test_default_number_types()
+	{
+		auto data = udm::Data::LoadJson(R"({"a":1.5,"b":18446744073709551615,"c":3000000000,"d":-3000000000,"e":7,"f":[1,2.5],"g":[1,3000000000],"h":[-1,18446744073709551615]})");
+		UDM_CHECK(data != nullptr);
+		if(!data)
+			return;
+		auto &d = *data;
+		UDM_CHECK(d["a"].GetType() == udm::Type::Double);
+		UDM_CHECK(d["b"].GetType() == udm::Type::UInt64 && d["b"].ToValue<uint64_t>() == std::numeric_limits<uint64_t>::max());
+		UDM_CHECK(d["c"].GetType() == udm::Type::UInt64 && d["c"].ToValue<uint64_t>() == 3'000'000'000);
+		UDM_CHECK(d["d"].GetType() == udm::Type::Int64 && d["d"].ToValue<int64_t>() == -3'000'000'000);
+		UDM_CHECK(d["e"].GetType() == udm::Type::Int32);
+		UDM_CHECK(get_array_value_type(d["f"]) == udm::Type::Double);
+		UDM_CHECK(get_array_value_type(d["g"]) == udm::Type::UInt64);
+		// Neither Int64 nor UInt64 can hold both values
+		UDM_CHECK(get_array_value_type(d["h"]) == udm::Type::Double);
+	}
+
+	void test_empty_array_hints()
+	{
+		auto data = udm::Data::LoadJson(R"({"a":[],"b":[],"c":[],"d":[],"e":[[]]})",
+		  {{"a", udm::Type::Element}, {"b", udm::Type::Vector3}, {"c", udm::Type::Float}, {"d", udm::Type::Reference}, {"e", udm::Type::Element}});
+		UDM_CHECK(data != nullptr);
+		if(!data)
+			return;
+		auto &d = *data;
+		UDM_CHECK(get_array_value_type(d["a"]) == udm::Type::Element && d["a"].GetSize() == 0);
+		UDM_CHECK(get_array_value_type(d["b"]) == udm::Type::Vector3 && d["b"].GetSize() == 0);
+		UDM_CHECK(get_array_value_type(d["c"]) == udm::Type::Float && d["c"].GetSize() == 0);
+		UDM_CHECK(get_array_value_type(d["d"]) == udm::Type::Reference && d["d"].GetSize() == 0);
+		UDM_CHECK(get_array_value_type(d["e"]) == udm::Type::Array && get_array_value_type(d["e"][0]) == udm::Type::Element);
+
+		// Structs can't be read from JSON
+		auto threw = false;
+		try {
+			udm::Data::LoadJson(R"({"a":[[]]})", {{"a", udm::Type::Struct}});
+		}
+		catch(const udm::DataError &) {
+			threw = true;
+		}
+		UDM_CHECK(threw);
+	}
+
+	void test_asset_version()
+	{
+		// Without a header the entire document is the asset data, so "assetVersion" is an ordinary key
+		auto data = udm::Data::LoadJson(R"({"assetVersion":3,"x":1})");
+		UDM_CHECK(data && data->GetAssetVersion() == 1);
+		if(data)
+			UDM_CHECK((*data)["assetVersion"].GetType() == udm::Type::Int32 && (*data)["assetVersion"].ToValue<int32_t>() == 3);
+
+		data = udm::Data::LoadJson(R"({"assetType":"test","assetVersion":3,"assetData":{"assetVersion":4}})");
+		UDM_CHECK(data && data->GetAssetType() == "test" && data->GetAssetVersion() == 3);
+		if(data)
+			UDM_CHECK((*data)["assetVersion"].GetType() == udm::Type::Int32 && (*data)["assetVersion"].ToValue<int32_t>() == 4);
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"value_formatting", &test_value_formatting},
+	  {"large_output", &test_large_output},
+	  {"round_trip", &test_round_trip},
+	  {"default_number_types", &test_default_number_types},
+	  {"empty_array_hints", &test_empty_array_hints},
+	  {"asset_version", &test_asset_version},
+	});
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Keys: Lookups with pre-hashed keys have to find the same children as lookups with strings, and keys are never treated as paths.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	constexpr udm::Key KEY_CHILD {"child"};
+	constexpr udm::Key KEY_VALUE {"value"};
+
+	void test_hash()
+	{
+		static_assert(KEY_CHILD.hash == udm::hash_key("child"));
+		static_assert(udm::hash_key("child") != udm::hash_key("Child"));
+		udm::KeyHash hash {};
+		std::string str {"child"};
+		UDM_CHECK(hash(KEY_CHILD) == hash(str) && hash(str) == hash(std::string_view {"child"}) && hash("child") == hash(str));
+		udm::KeyEqual equal {};
+		UDM_CHECK(equal(KEY_CHILD, str) && equal(std::string_view {"child"}, KEY_CHILD) && !equal(KEY_CHILD, KEY_VALUE));
+
+		// The key refers to the string
+		udm::Key key {str};
+		UDM_CHECK(key.str.data() == str.data() && key.hash == KEY_CHILD.hash);
+		UDM_CHECK(udm::Key {}.str.empty() && udm::Key {}.hash == udm::hash_key(""));
+	}
+
+	void test_lookup()
+	{
+		auto root = udm_test::create_tree();
+		auto &el = root->GetValue<udm::Element>();
+		auto *child = el.children.find("child")->second.get();
+		UDM_CHECK(el.children.find(KEY_CHILD)->second.get() == child);
+		UDM_CHECK(el.children.find(std::string_view {"child"})->second.get() == child);
+		UDM_CHECK(el.children.find(std::string {"child"})->second.get() == child);
+		UDM_CHECK(el.children.find(udm::Key {"missing"}) == el.children.end());
+
+		UDM_CHECK(el[KEY_CHILD].prop == child && el["child"].prop == child && el[std::string {"child"}].prop == child);
+		UDM_CHECK((*root)[KEY_CHILD].prop == child);
+		udm::PropertyWrapper wrapper {*root};
+		UDM_CHECK(wrapper[KEY_CHILD].prop == child && wrapper[std::string_view {"child"}].prop == child);
+		UDM_CHECK(wrapper[KEY_CHILD][KEY_VALUE].ToValue<std::string>() == "a");
+		UDM_CHECK(wrapper[KEY_CHILD][udm::Key {"a b"}]["c"].ToValue<int32_t>() == 2);
+		UDM_CHECK(wrapper["items"][1][udm::Key {"n"}].ToValue<int32_t>() == 1);
+		UDM_CHECK(!wrapper[udm::Key {"missing"}]);
+
+		auto res = wrapper.TryGetChild(KEY_CHILD);
+		UDM_CHECK(res && res->prop == child);
+		res = wrapper.TryGetChild(udm::Key {"missing"});
+		UDM_CHECK(!res && res.error() == udm::AccessError::NotFound);
+		res = wrapper[KEY_CHILD][KEY_VALUE].TryGetChild(KEY_VALUE);
+		UDM_CHECK(!res && res.error() == udm::AccessError::TypeMismatch);
+	}
+
+	void test_add()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &el = root->GetValue<udm::Element>();
+
+		// Keys are never split into paths
+		el.Add(udm::Key {"a/b"}, udm::Type::Int32) = int32_t {1};
+		UDM_CHECK(el.children.size() == 1 && el.children.contains("a/b"));
+		el.Add("c/d", udm::Type::Int32, true) = int32_t {2};
+		UDM_CHECK(el.children.contains("c") && el["c"]["d"].ToValue<int32_t>() == 2);
+
+		auto a = el.AddArray(udm::Key {"e/f"}, 3, udm::Type::Float);
+		UDM_CHECK(el.children.contains("e/f") && a.GetSize() == 3 && a.GetValue<udm::Array>().GetValueType() == udm::Type::Float);
+		auto compressed = el.AddArray(udm::Key {"g"}, 2, udm::Type::Int32, udm::ArrayType::Compressed);
+		UDM_CHECK(compressed.GetType() == udm::Type::ArrayLz4 && compressed.GetSize() == 2);
+
+		// Adding an existing key with a different type replaces the child
+		el.Add(udm::Key {"a/b"}, udm::Type::String) = std::string {"x"};
+		UDM_CHECK(el.children.size() == 4 && el[udm::Key {"a/b"}].ToValue<std::string>() == "x");
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"hash", &test_hash},
+	  {"lookup", &test_lookup},
+	  {"add", &test_add},
+	});
+}
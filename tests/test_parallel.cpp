@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Parallel traversal: walk_parallel and parallel query evaluation must produce the same results as their serial counterparts,
+// including for compressed arrays that haven't been decompressed yet.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	constexpr uint32_t NUM_ARRAYS = 16;
+	constexpr uint32_t NUM_ITEMS = 32;
+	constexpr uint32_t MIN_ITEMS_PER_TASK = 2;
+
+	// root { c0: arrayLz4 [element] { { n: int32 0 }, ... }, c1: ... }, the arrays are compressed
+	udm::PProperty create_tree()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &el = root->GetValue<udm::Element>();
+		for(auto i = decltype(NUM_ARRAYS) {0u}; i < NUM_ARRAYS; ++i) {
+			auto a = udm_test::add_items(el, "c" + std::to_string(i), NUM_ITEMS, udm::ArrayType::Compressed, i * NUM_ITEMS);
+			static_cast<udm::ArrayLz4 &>(a.GetValue<udm::Array>()).ClearUncompressedMemory();
+		}
+		return root;
+	}
+
+	int64_t get_expected_sum()
+	{
+		constexpr int64_t n = NUM_ARRAYS * NUM_ITEMS;
+		return n * (n - 1) / 2;
+	}
+
+	void test_walk_parallel()
+	{
+		auto root = create_tree();
+		std::atomic<uint32_t> numNodes = 0;
+		std::atomic<int64_t> sum = 0;
+		auto res = udm::walk_parallel(
+		  *root,
+		  [&numNodes, &sum](const udm::WalkNode &node) {
+			  ++numNodes;
+			  if(node.key == "n")
+				  sum += *node.GetValuePtr<int32_t>();
+		  },
+		  udm::WalkFlags::None, MIN_ITEMS_PER_TASK);
+		UDM_CHECK(res);
+		// Root, arrays, array items and their values
+		UDM_CHECK(numNodes == 1 + NUM_ARRAYS + NUM_ARRAYS * NUM_ITEMS * 2);
+		UDM_CHECK(sum == get_expected_sum());
+	}
+
+	void test_query_parallel()
+	{
+		auto query = udm::Query::Compile("*[*]/n");
+		auto serialRoot = create_tree();
+		auto serial = query.Evaluate(*serialRoot, false);
+		auto root = create_tree();
+		auto results = query.Evaluate(*root, true, MIN_ITEMS_PER_TASK);
+		UDM_CHECK(results.size() == NUM_ARRAYS * NUM_ITEMS);
+		UDM_CHECK(results.size() == serial.size());
+		int64_t sum = 0;
+		for(auto i = decltype(results.size()) {0u}; i < results.size() && i < serial.size(); ++i) {
+			sum += results[i].GetValue<int32_t>();
+			UDM_CHECK(results[i].GetValue<int32_t>() == serial[i].GetValue<int32_t>());
+		}
+		UDM_CHECK(sum == get_expected_sum());
+	}
+
+	void test_query_range()
+	{
+		auto root = create_tree();
+		auto results = udm::Query::Compile("c1[4:20]/n").Evaluate(*root, true, MIN_ITEMS_PER_TASK);
+		UDM_CHECK(results.size() == 16);
+		for(auto i = decltype(results.size()) {0u}; i < results.size(); ++i)
+			UDM_CHECK(results[i].GetValue<int32_t>() == static_cast<int32_t>(NUM_ITEMS + 4 + i));
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"walk_parallel", &test_walk_parallel},
+	  {"query_parallel", &test_query_parallel},
+	  {"query_range", &test_query_range},
+	});
+}
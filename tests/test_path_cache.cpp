@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Path caches: Repeated lookups have to be served from the cache, and structural changes of a document must only invalidate
+// the caches of that document.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	std::shared_ptr<udm::Data> create_data()
+	{
+		auto data = udm_test::create_data();
+		data->SetPathCacheEnabled(true);
+		return data;
+	}
+	const udm::PathCache::Statistics &get_statistics(const udm::Data &data) { return data.GetPathCache()->GetStatistics(); }
+
+	void test_hit()
+	{
+		auto data = create_data();
+		auto prop = data->ResolvePath("assetData/child/value");
+		UDM_CHECK(prop && prop.ToValue<std::string>() == "a");
+		UDM_CHECK(get_statistics(*data).misses == 1 && get_statistics(*data).hits == 0);
+
+		prop = data->ResolvePath("assetData/child/value");
+		UDM_CHECK(prop && prop.ToValue<std::string>() == "a");
+		UDM_CHECK(get_statistics(*data).misses == 1 && get_statistics(*data).hits == 1);
+
+		// Paths that don't exist are cached as well
+		UDM_CHECK(!data->ResolvePath("assetData/missing"));
+		UDM_CHECK(!data->ResolvePath("assetData/missing"));
+		UDM_CHECK(get_statistics(*data).misses == 2 && get_statistics(*data).hits == 2);
+		UDM_CHECK(get_statistics(*data).invalidations == 0);
+	}
+
+	void test_invalidate_add_child()
+	{
+		auto data = create_data();
+		UDM_CHECK(!data->ResolvePath("assetData/child/added"));
+		(*data)["child"].GetValuePtr<udm::Element>()->AddChild("added", udm::Property::Create<int32_t>(1));
+		auto prop = data->ResolvePath("assetData/child/added");
+		UDM_CHECK(prop && prop.ToValue<int32_t>() == 1);
+		UDM_CHECK(get_statistics(*data).invalidations == 1);
+	}
+
+	void test_invalidate_erase()
+	{
+		auto data = create_data();
+		UDM_CHECK(data->ResolvePath("assetData/child/value"));
+		(*data)["child"].GetValuePtr<udm::Element>()->EraseValue("value");
+		UDM_CHECK(!data->ResolvePath("assetData/child/value"));
+		UDM_CHECK(get_statistics(*data).invalidations == 1);
+	}
+
+	void test_invalidate_array_resize()
+	{
+		auto data = create_data();
+		auto prop = data->ResolvePath("assetData/items[1]/n");
+		UDM_CHECK(prop && prop.ToValue<int32_t>() == 1);
+		(*data)["items"].GetValuePtr<udm::Array>()->Resize(64);
+		prop = data->ResolvePath("assetData/items[1]/n");
+		UDM_CHECK(prop && prop.ToValue<int32_t>() == 1);
+		UDM_CHECK(get_statistics(*data).invalidations == 1);
+	}
+
+	void test_other_document()
+	{
+		auto data = create_data();
+		auto other = create_data();
+		UDM_CHECK(data->ResolvePath("assetData/child/value"));
+		(*other)["child"].GetValuePtr<udm::Element>()->AddChild("added", udm::Property::Create<int32_t>(1));
+		(*other)["items"].GetValuePtr<udm::Array>()->Resize(64);
+		UDM_CHECK(data->ResolvePath("assetData/child/value"));
+		UDM_CHECK(get_statistics(*data).hits == 1 && get_statistics(*data).invalidations == 0);
+	}
+
+	void test_copy_on_write()
+	{
+		auto data = create_data();
+		auto copy = data->Copy();
+		UDM_CHECK(data->ResolvePath("assetData/child/value"));
+
+		// The copy takes over the shared values when it's written to, so the original receives new ones
+		copy->GetAssetData().GetData()["child"]["value"] = std::string {"b"};
+		auto prop = data->ResolvePath("assetData/child/value");
+		UDM_CHECK(prop && prop.ToValue<std::string>() == "a");
+		UDM_CHECK(get_statistics(*data).invalidations == 1);
+		UDM_CHECK(copy->GetAssetData().GetData()["child"]["value"].ToValue<std::string>() == "b");
+	}
+
+	void test_data_subscript()
+	{
+		auto data = create_data();
+		UDM_CHECK((*data)["child"]["value"].ToValue<std::string>() == "a");
+		UDM_CHECK((*data)["child"].GetPath() == data->GetAssetData().GetData()["child"].GetPath());
+		// Const lookups don't modify the cache
+		UDM_CHECK(data->GetPathCache()->GetSize() == 0);
+		UDM_CHECK(get_statistics(*data).hits == 0 && get_statistics(*data).misses == 0);
+
+		// Keys containing path separators are not split
+		(*data)["a/b"] = int32_t {5};
+		UDM_CHECK((*data)["a/b"].ToValue<int32_t>() == 5);
+		UDM_CHECK(!(*data)["a"]);
+
+		// Writes through the wrapper are still possible for missing properties
+		(*data)["new"] = int32_t {3};
+		UDM_CHECK((*data)["new"].ToValue<int32_t>() == 3);
+		UDM_CHECK((*data)["new"].GetPath() == data->GetAssetData().GetData()["new"].GetPath());
+
+		// Writes through the wrapper of an existing property un-share the path
+		auto copy = data->Copy();
+		(*copy)["new"] = int32_t {4};
+		UDM_CHECK((*data)["new"].ToValue<int32_t>() == 3 && (*copy)["new"].ToValue<int32_t>() == 4);
+	}
+
+	void test_concurrent_subscript()
+	{
+		auto data = create_data();
+		std::vector<std::thread> threads;
+		std::atomic<uint32_t> failures = 0;
+		for(auto i = 0; i < 4; ++i) {
+			threads.emplace_back([&data, &failures]() {
+				const auto &d = *data;
+				for(auto j = 0; j < 1000; ++j) {
+					if(d["child"]["value"].ToValue<std::string>() != "a" || d["items"].GetSize() != 2)
+						++failures;
+				}
+			});
+		}
+		for(auto &t : threads)
+			t.join();
+		UDM_CHECK(failures == 0);
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"hit", &test_hit},
+	  {"invalidate_add_child", &test_invalidate_add_child},
+	  {"invalidate_erase", &test_invalidate_erase},
+	  {"invalidate_array_resize", &test_invalidate_array_resize},
+	  {"other_document", &test_other_document},
+	  {"copy_on_write", &test_copy_on_write},
+	  {"data_subscript", &test_data_subscript},
+	  {"concurrent_subscript", &test_concurrent_subscript},
+	});
+}
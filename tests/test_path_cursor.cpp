@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Path cursor: Walking a path must not allocate, and failed moves have to leave the cursor unchanged.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	uint32_t g_allocations = 0;
+}
+
+void *operator new(std::size_t size)
+{
+	++g_allocations;
+	if(auto *p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc {};
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+	using udm_test::create_tree;
+
+	void test_walk()
+	{
+		auto root = create_tree();
+		udm::PathCursor cursor {*root};
+		UDM_CHECK(cursor.IsValid() && cursor.GetDepth() == 0 && cursor.GetType() == udm::Type::Element);
+		UDM_CHECK(cursor.Down("child") && cursor.Down("a b") && cursor.Down(udm::Key {"c"}));
+		UDM_CHECK(cursor.GetDepth() == 3 && cursor.GetFrame().key == "c");
+		UDM_CHECK(cursor.ToValue<int32_t>() == 2 && cursor.ToValue<float>() == 2.f);
+		UDM_CHECK(cursor.Up(2) && cursor.GetDepth() == 1 && cursor.GetFrame().key == "child");
+		UDM_CHECK(cursor.GetSize() == 2);
+
+		cursor.Reset();
+		UDM_CHECK(cursor.Down("items") && cursor.GetSize() == 2);
+		UDM_CHECK(cursor.Down(1u) && cursor.IsArrayItem() && cursor.GetProperty() == nullptr);
+		UDM_CHECK(cursor.Down("n") && cursor(int32_t {-1}) == 1);
+
+		// Items of compressed arrays
+		cursor.Reset();
+		UDM_CHECK(cursor.DownPath("compressed[1]/n") && cursor.ToValue<int32_t>() == 1);
+		cursor.Reset();
+		UDM_CHECK(cursor.DownPath("arr[1]") && cursor.GetType() == udm::Type::String && cursor.ToValue<std::string>() == "y");
+	}
+
+	void test_failed_moves()
+	{
+		auto root = create_tree();
+		udm::PathCursor cursor {*root};
+		UDM_CHECK(cursor.Down("child"));
+		UDM_CHECK(!cursor.Down("missing") && !cursor.Down(0u));
+		UDM_CHECK(!cursor.DownPath("\"a b\"/missing") && !cursor.DownPath("\"a b\"/c/d"));
+		UDM_CHECK(cursor.GetDepth() == 1 && cursor.GetFrame().key == "child");
+		UDM_CHECK(!cursor.Up(2) && cursor.GetDepth() == 1);
+
+		cursor.Reset();
+		UDM_CHECK(!cursor.DownPath("items[2]/n") && !cursor.DownPath("items[0]/n[0]") && cursor.GetDepth() == 0);
+
+		udm::PathCursor invalid {};
+		UDM_CHECK(!invalid && !invalid.Down("child") && !invalid.ToValue<int32_t>().has_value() && !invalid.SetValue(int32_t {1}));
+		UDM_CHECK(invalid.GetType() == udm::Type::Nil && invalid.GetValuePtr<int32_t>() == nullptr);
+	}
+
+	void test_from_wrapper()
+	{
+		auto root = create_tree();
+		auto &el = root->GetValue<udm::Element>();
+		udm::PathCursor item {el["items"][1]["n"]};
+		UDM_CHECK(item.IsValid() && item.ToValue<int32_t>() == 1);
+		udm::PathCursor str {el["arr"][0]};
+		UDM_CHECK(str.IsArrayItem() && str.ToValue<std::string>() == "x");
+		udm::PathCursor missing {el["missing"]};
+		UDM_CHECK(!missing);
+	}
+
+	void test_max_depth()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto *el = &root->GetValue<udm::Element>();
+		std::string path;
+		for(auto i = decltype(udm::PathCursor::MAX_DEPTH) {0u}; i <= udm::PathCursor::MAX_DEPTH; ++i) {
+			el = el->Add("a").GetValuePtr<udm::Element>();
+			path += (i > 0) ? "/a" : "a";
+		}
+		udm::PathCursor cursor {*root};
+		UDM_CHECK(!cursor.DownPath(path) && cursor.GetDepth() == 0);
+		for(auto i = decltype(udm::PathCursor::MAX_DEPTH) {0u}; i < udm::PathCursor::MAX_DEPTH; ++i)
+			UDM_CHECK(cursor.Down("a"));
+		UDM_CHECK(!cursor.Down("a") && cursor.GetDepth() == udm::PathCursor::MAX_DEPTH);
+	}
+
+	void test_no_allocations()
+	{
+		auto root = create_tree();
+		constexpr udm::Key KEY_N {"n"};
+		auto allocations = g_allocations;
+		udm::PathCursor cursor {*root};
+		auto n = 0;
+		for(auto i = 0; i < 10; ++i) {
+			cursor.Reset();
+			cursor.DownPath("child/\"a b\"/c");
+			n += cursor(int32_t {0});
+			cursor.Reset();
+			cursor.Down("items");
+			cursor.Down(1u);
+			cursor.Down(KEY_N);
+			n += cursor(int32_t {0});
+			cursor.Up();
+			cursor.Down("missing");
+		}
+		UDM_CHECK(n == 30);
+		UDM_CHECK(g_allocations == allocations);
+	}
+
+	void test_set_value()
+	{
+		auto root = create_tree();
+		auto copy = root->Copy(udm::MergeFlags::CopyOnWrite);
+		udm::PathCursor cursor {*copy};
+		UDM_CHECK(cursor.DownPath("items[0]/n") && cursor.SetValue(int32_t {5}));
+		cursor.Reset();
+		UDM_CHECK(cursor.DownPath("arr[1]") && cursor.SetValue(std::string {"z"}));
+		UDM_CHECK((*copy)["items"][0]["n"].ToValue<int32_t>() == 5 && (*copy)["arr"][1].ToValue<std::string>() == "z");
+		UDM_CHECK((*root)["items"][0]["n"].ToValue<int32_t>() == 0 && (*root)["arr"][1].ToValue<std::string>() == "y");
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"walk", &test_walk},
+	  {"failed_moves", &test_failed_moves},
+	  {"from_wrapper", &test_from_wrapper},
+	  {"max_depth", &test_max_depth},
+	  {"no_allocations", &test_no_allocations},
+	  {"set_value", &test_set_value},
+	});
+}
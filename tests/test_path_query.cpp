@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Precompiled path queries: A query is parsed once and has to resolve the same way as PropertyWrapper::GetFromPath in any
+// document it is evaluated against.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	std::shared_ptr<udm::Data> create_data(int32_t n)
+	{
+		auto data = udm_test::create_data();
+		auto root = data->GetAssetData().GetData();
+		root["child"]["a b"]["c"] = n;
+		root["items"][1]["n"] = n + 1;
+		return data;
+	}
+
+	void test_segments()
+	{
+		auto query = udm::PathQuery::Compile("child/\"a b\"/c[3][12]");
+		auto segments = query.GetSegments();
+		UDM_CHECK(segments.size() == 5);
+		if(segments.size() != 5)
+			return;
+		UDM_CHECK(segments[0].key.str == "child" && segments[0].key.hash == udm::hash_key("child") && !segments[0].IsIndex());
+		UDM_CHECK(segments[1].key.str == "a b" && segments[1].key.hash == udm::hash_key("a b"));
+		UDM_CHECK(segments[2].key.str == "c");
+		UDM_CHECK(segments[3].IsIndex() && segments[3].index == 3);
+		UDM_CHECK(segments[4].IsIndex() && segments[4].index == 12);
+		UDM_CHECK(query.GetPath() == "child/\"a b\"/c[3][12]");
+
+		// The segments refer to the path of the query, which is shared between copies
+		std::optional<udm::PathQuery> original = udm::PathQuery::Compile(std::string {"child/value"});
+		auto copy = *original;
+		original = {};
+		UDM_CHECK(copy.GetSegments().size() == 2 && copy.GetSegments()[1].key.str == "value");
+		UDM_CHECK(udm::PathQuery {}.GetPath().empty() && udm::PathQuery {}.GetSegments().empty());
+	}
+
+	void test_invalid_paths()
+	{
+		for(auto path : {"a[", "a[]", "a[x]", "a[1]b", "\"a", "a[99999999999]"}) {
+			auto threw = false;
+			try {
+				udm::PathQuery::Compile(path);
+			}
+			catch(const udm::InvalidUsageError &) {
+				threw = true;
+			}
+			UDM_CHECK(threw);
+		}
+	}
+
+	void test_multiple_documents()
+	{
+		auto queryC = udm::PathQuery::Compile("child/\"a b\"/c");
+		auto queryN = udm::PathQuery::Compile("items[1]/n");
+		auto queryMissing = udm::PathQuery::Compile("items[2]/n");
+		for(auto i = 0; i < 4; ++i) {
+			auto data = create_data(i * 10);
+			auto root = data->GetAssetData().GetData();
+			UDM_CHECK(queryC.Evaluate(root).ToValue<int32_t>() == i * 10);
+			UDM_CHECK(queryN.Evaluate(root).ToValue<int32_t>() == i * 10 + 1);
+			UDM_CHECK(!queryMissing.Evaluate(root));
+			UDM_CHECK(root.GetFromPath("child/\"a b\"/c").ToValue<int32_t>() == queryC.Evaluate(root).ToValue<int32_t>());
+		}
+	}
+
+	void test_evaluate_wrapper()
+	{
+		auto data = create_data(5);
+		auto query = udm::PathQuery::Compile("items[1]/n");
+		auto assetData = data->GetAssetData().GetData();
+		UDM_CHECK(query.Evaluate(assetData).ToValue<int32_t>() == 6);
+		// Relative to an array item
+		auto queryItem = udm::PathQuery::Compile("n");
+		UDM_CHECK(queryItem.Evaluate(assetData["compressed"][1]).ToValue<int32_t>() == 1);
+		UDM_CHECK(!query.Evaluate(assetData["missing"]));
+
+		// An empty query refers to the root
+		auto cursor = udm::PathQuery::Compile("").Evaluate(assetData);
+		UDM_CHECK(cursor && cursor.GetDepth() == 0 && cursor.GetType() == udm::Type::Element);
+
+		// Values can be written through the resulting cursor
+		auto result = query.Evaluate(assetData);
+		UDM_CHECK(result.SetValue(int32_t {7}) && assetData["items"][1]["n"].ToValue<int32_t>() == 7);
+	}
+
+	void test_static_query()
+	{
+		static constexpr udm::StaticPathQuery QUERY {"child/\"a b\"/c"};
+		static_assert(QUERY.GetSegments().size() == 3);
+		static_assert(QUERY.GetSegments()[1].key.hash == udm::hash_key("a b"));
+		for(auto i = 0; i < 3; ++i) {
+			auto data = create_data(i);
+			UDM_CHECK(QUERY.Evaluate(data->GetAssetData().GetData()).ToValue<int32_t>() == i);
+		}
+		static constexpr udm::StaticPathQuery QUERY_INDEX {"arr[1]"};
+		auto root = udm_test::create_tree();
+		UDM_CHECK(QUERY_INDEX.Evaluate(*root).ToValue<std::string>() == "y");
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"segments", &test_segments},
+	  {"invalid_paths", &test_invalid_paths},
+	  {"multiple_documents", &test_multiple_documents},
+	  {"evaluate_wrapper", &test_evaluate_wrapper},
+	  {"static_query", &test_static_query},
+	});
+}
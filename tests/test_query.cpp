@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Queries: Results have to be in document order, regardless of whether they're evaluated in parallel.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	bool is_same(const udm::PropertyWrapper &a, const udm::PropertyWrapper &b) { return a.prop == b.prop && a.arrayIndex == b.arrayIndex; }
+
+	void test_child_order()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &el = root->GetValue<udm::Element>();
+		for(auto *key : {"d", "b", "e", "a", "c"})
+			el.Add(key)["v"] = std::string {key};
+		auto results = udm::Query::Compile("*/v").Evaluate(*root);
+		std::string values;
+		for(auto &res : results)
+			values += res.ToValue<std::string>().value_or("?");
+		UDM_CHECK(values == "abcde");
+	}
+
+	void test_descendants()
+	{
+		auto root = udm_test::create_tree();
+		auto results = udm::Query::Compile("**/n").Evaluate(*root);
+		// compressed[0], compressed[1], items[0], items[1]
+		UDM_CHECK(results.size() == 4);
+		std::vector<int32_t> values;
+		for(auto &res : results)
+			values.push_back(res.ToValue<int32_t>().value_or(-1));
+		UDM_CHECK((values == std::vector<int32_t> {0, 1, 0, 1}));
+	}
+
+	void test_parallel()
+	{
+		constexpr uint32_t NUM_ITEMS = 256;
+		auto root = udm::Property::Create<udm::Element>();
+		auto &el = root->GetValue<udm::Element>();
+		for(auto i = 0; i < 8; ++i)
+			udm_test::add_items(el, "c" + std::to_string(i), NUM_ITEMS, udm::ArrayType::Raw, i * NUM_ITEMS);
+		auto query = udm::Query::Compile("*[*]/n");
+		auto sequential = query.Evaluate(*root, false);
+		auto parallel = query.Evaluate(*root, true, 1);
+		UDM_CHECK(sequential.size() == 8 * NUM_ITEMS && parallel.size() == sequential.size());
+		auto inOrder = true;
+		for(auto i = decltype(sequential.size()) {0u}; i < sequential.size(); ++i) {
+			if(!is_same(sequential[i], parallel[i]) || sequential[i].ToValue<int32_t>() != static_cast<int32_t>(i))
+				inOrder = false;
+		}
+		UDM_CHECK(inOrder);
+
+		std::vector<int32_t> values;
+		query.ForEach(*root, [&values](const udm::PropertyWrapper &prop) {
+			values.push_back(prop.ToValue<int32_t>().value_or(-1));
+			return values.size() < 10;
+		});
+		UDM_CHECK(values.size() == 10 && values.back() == 9);
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"child_order", &test_child_order},
+	  {"descendants", &test_descendants},
+	  {"parallel", &test_parallel},
+	});
+}
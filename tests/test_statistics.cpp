@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Memory statistics: Calculating the statistics must not modify the tree, compressed arrays are counted in the state they're in.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	udm::ArrayLz4 &get_compressed(udm::Property &root) { return static_cast<udm::ArrayLz4 &>(root["compressed"].GetValue<udm::Array>()); }
+
+	void test_type_counts()
+	{
+		auto root = udm_test::create_tree();
+		auto stats = udm::MemoryStatistics::Calculate(*root);
+		// root, child, "a b" and the items of both arrays
+		UDM_CHECK(stats.GetTypeCount(udm::Type::Element) == 7);
+		UDM_CHECK(stats.GetTypeCount(udm::Type::Int32) == 5);
+		UDM_CHECK(stats.GetTypeCount(udm::Type::String) == 1);
+		UDM_CHECK(stats.GetTypeCount(udm::Type::Array) == 2);
+		UDM_CHECK(stats.GetTypeCount(udm::Type::ArrayLz4) == 1);
+		UDM_CHECK(stats.arrayBytes > 0 && stats.stringBytes > 0 && stats.trivialBytes > 0);
+		UDM_CHECK(stats.GetTotalSize() > 0 && !stats.largestSubtrees.empty());
+	}
+
+	void test_decompressed_array()
+	{
+		auto root = udm_test::create_tree();
+		auto &a = get_compressed(*root);
+		auto *values = std::as_const(a).GetValues();
+		auto stats = udm::MemoryStatistics::Calculate(*root);
+		UDM_CHECK(stats.lz4DecompressedBytes > 0);
+		UDM_CHECK(stats.lz4CompressedBytes == 0);
+
+		// The array must not have been compressed by the first pass
+		auto stats2 = udm::MemoryStatistics::Calculate(*root);
+		UDM_CHECK(stats2.lz4DecompressedBytes == stats.lz4DecompressedBytes);
+		UDM_CHECK(stats2.GetTypeCount(udm::Type::Int32) == 5);
+		UDM_CHECK(std::as_const(a).GetValues() == values);
+	}
+
+	void test_compressed_array()
+	{
+		auto root = udm_test::create_tree();
+		get_compressed(*root).ClearUncompressedMemory();
+		auto stats = udm::MemoryStatistics::Calculate(*root);
+		UDM_CHECK(stats.lz4CompressedBytes > 0);
+		UDM_CHECK(stats.lz4DecompressedBytes == 0);
+		// The items of the compressed array aren't counted
+		UDM_CHECK(stats.GetTypeCount(udm::Type::Int32) == 3);
+	}
+
+	void test_persistent_array()
+	{
+		auto root = udm_test::create_tree();
+		auto &a = get_compressed(*root);
+		a.SetUncompressedMemoryPersistent(true);
+		a.ClearUncompressedMemory();
+		auto stats = udm::MemoryStatistics::Calculate(*root);
+		UDM_CHECK(stats.lz4CompressedBytes > 0);
+		UDM_CHECK(stats.lz4DecompressedBytes > 0);
+		UDM_CHECK(stats.GetTypeCount(udm::Type::Int32) == 5);
+	}
+
+	void test_shared_values()
+	{
+		// Values shared between a copy-on-write copy and the original are only counted once
+		auto root = udm::Property::Create<udm::Element>();
+		auto &el = root->GetValue<udm::Element>();
+		el.AddChild("a", udm_test::create_tree());
+		auto stats = udm::MemoryStatistics::Calculate(*root);
+		el.AddChild("b", el.children.find("a")->second->Copy(udm::MergeFlags::CopyOnWrite));
+		auto statsShared = udm::MemoryStatistics::Calculate(*root);
+		UDM_CHECK(statsShared.GetTotalSize() < stats.GetTotalSize() * 2);
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"type_counts", &test_type_counts},
+	  {"decompressed_array", &test_decompressed_array},
+	  {"compressed_array", &test_compressed_array},
+	  {"persistent_array", &test_persistent_array},
+	  {"shared_values", &test_shared_values},
+	});
+}
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Struct bindings: Bound structs have to round-trip through elements, and values of a different type have to be converted.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	struct Transform {
+		udm::Vector3 position {};
+		float scale = 1.f;
+	};
+	struct Light {
+		std::string name;
+		Transform transform;
+		int32_t intensity = 0;
+		bool enabled = false;
+	};
+}
+
+template<>
+struct udm::StructBinding<Transform> {
+	static constexpr auto members = std::make_tuple(udm::struct_member("position", &Transform::position), udm::struct_member("scale", &Transform::scale));
+};
+template<>
+struct udm::StructBinding<Light> {
+	static constexpr auto members
+	  = std::make_tuple(udm::struct_member("name", &Light::name), udm::struct_member("transform", &Light::transform), udm::struct_member("intensity", &Light::intensity), udm::struct_member("enabled", &Light::enabled));
+};
+
+namespace {
+	Light create_light() { return Light {"lamp", Transform {{1.f, 2.f, 3.f}, 2.f}, 5, true}; }
+
+	void test_round_trip()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &el = root->GetValue<udm::Element>();
+		udm::write_struct(el, create_light());
+		UDM_CHECK(el["name"].GetType() == udm::Type::String && el["intensity"].GetType() == udm::Type::Int32 && el["enabled"].GetType() == udm::Type::Boolean);
+		UDM_CHECK(el["transform"].GetType() == udm::Type::Element && el["transform"]["scale"].ToValue<float>() == 2.f);
+
+		Light light {};
+		UDM_CHECK(udm::read_struct(el, light));
+		UDM_CHECK(light.name == "lamp" && light.intensity == 5 && light.enabled);
+		UDM_CHECK(light.transform.position == udm::Vector3(1.f, 2.f, 3.f) && light.transform.scale == 2.f);
+
+		// Through a property wrapper
+		el.Add("other");
+		udm::write_struct(el["other"], Transform {{4.f, 5.f, 6.f}, 3.f});
+		Transform transform {};
+		UDM_CHECK(udm::read_struct(el["other"], transform) && transform.scale == 3.f && transform.position.z == 6.f);
+		UDM_CHECK(el["other"].GetValue<udm::Element>().children.size() == 2);
+		UDM_CHECK(!udm::read_struct(el["missing"], transform));
+	}
+
+	void test_conversion()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &el = root->GetValue<udm::Element>();
+		el["name"] = std::string {"lamp"};
+		el["intensity"] = 7.f;
+		el["enabled"] = true;
+		el["transform"]["position"] = udm::Vector3 {1.f, 1.f, 1.f};
+		el["transform"]["scale"] = 0.5;
+		Light light {};
+		UDM_CHECK(udm::read_struct(el, light));
+		UDM_CHECK(light.intensity == 7 && light.enabled && light.transform.scale == 0.5f);
+
+		// Members are written with their own type, children of a different type are replaced
+		udm::write_struct(el, light);
+		UDM_CHECK(el["intensity"].GetType() == udm::Type::Int32 && el["transform"]["scale"].GetType() == udm::Type::Float);
+	}
+
+	void test_missing_members()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		auto &el = root->GetValue<udm::Element>();
+		el["name"] = std::string {"lamp"};
+		el["intensity"] = udm::Vector3 {};
+		auto light = create_light();
+		light.name = "other";
+		UDM_CHECK(!udm::read_struct(el, light));
+		// Members that exist are still assigned, the others are left unchanged
+		UDM_CHECK(light.name == "lamp" && light.intensity == 5 && light.enabled && light.transform.scale == 2.f);
+
+		auto threw = false;
+		try {
+			udm::write_struct(el["name"], light);
+		}
+		catch(const udm::InvalidUsageError &) {
+			threw = true;
+		}
+		UDM_CHECK(threw);
+	}
+
+	void test_copy_on_write()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		udm::write_struct(root->GetValue<udm::Element>(), create_light());
+		auto copy = root->Copy(udm::MergeFlags::CopyOnWrite);
+		auto light = create_light();
+		light.transform.scale = 4.f;
+		light.intensity = 1;
+		udm::write_struct(copy->GetValue<udm::Element>(), light);
+		Light original {};
+		Light copied {};
+		UDM_CHECK(udm::read_struct(std::as_const(*root).GetValue<udm::Element>(), original) && udm::read_struct(std::as_const(*copy).GetValue<udm::Element>(), copied));
+		UDM_CHECK(original.transform.scale == 2.f && original.intensity == 5);
+		UDM_CHECK(copied.transform.scale == 4.f && copied.intensity == 1);
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"round_trip", &test_round_trip},
+	  {"conversion", &test_conversion},
+	  {"missing_members", &test_missing_members},
+	  {"copy_on_write", &test_copy_on_write},
+	});
+}
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Transcoding between the ASCII and the binary format, in particular for values that are stored as base64 data in the ASCII format
+// and for nested blocks.
+
+import pragma.udm;
+
+#include "udm_test.hpp"
+
+namespace {
+	constexpr auto BASE64_FIXTURE = UDM_TEST_DATA_DIR "/base64_slashes.udm";
+
+	std::string_view get_contents(udm::VectorFile &f) { return std::string_view {static_cast<const char *>(static_cast<const void *>(f.GetData())), f.Tell()}; }
+
+	std::shared_ptr<udm::Data> load_binary(std::unique_ptr<udm::VectorFile> &&f)
+	{
+		f->Seek(0);
+		return udm::Data::Load(std::move(f));
+	}
+
+	// Shared fixture with blob data added to the root and to the items of the compressed array, all of which contain "//" in base64
+	std::shared_ptr<udm::Data> create_data()
+	{
+		constexpr uint32_t NUM_VALUES = 64;
+		auto data = udm_test::create_data();
+		auto root = data->GetAssetData().GetData();
+		std::vector<uint8_t> bytes {0xFF, 0xFF, 0xFF, 0x00};
+		root["blob"] = udm::Blob {std::vector<uint8_t> {bytes}};
+		root["blobLz4"] = udm::compress_lz4_blob(bytes.data(), bytes.size());
+		root["utf8"] = udm::Utf8String {std::vector<uint8_t> {bytes}};
+		auto values = root.AddArray("values", NUM_VALUES, udm::Type::UInt8, udm::ArrayType::Compressed);
+		for(auto i = decltype(NUM_VALUES) {0u}; i < NUM_VALUES; ++i)
+			values[i] = uint8_t {0xFF};
+		auto compressed = root["compressed"];
+		for(auto i = decltype(compressed.GetSize()) {0u}; i < compressed.GetSize(); ++i)
+			compressed[i]["blob"] = udm::Blob {std::vector<uint8_t> {bytes}};
+		return data;
+	}
+
+	// Alternates between child blocks and element arrays, the strings contain brackets and braces that have to be skipped
+	void add_nested_blocks(const udm::LinkedPropertyWrapper &el, uint32_t depth)
+	{
+		el["value"] = static_cast<int32_t>(depth);
+		el["str"] = std::string {"{[}] /*"};
+		auto items = el.AddArray("items", 2, udm::Type::Element);
+		items[1]["child"]["n"] = static_cast<int32_t>(depth);
+		if(depth == 0)
+			return;
+		add_nested_blocks((depth % 2 == 0) ? el.Add("child") : items[0], depth - 1);
+	}
+
+	void test_base64_slashes()
+	{
+		auto data = udm::Data::LoadAsciiMapped(BASE64_FIXTURE);
+		UDM_CHECK(data != nullptr);
+		if(!data)
+			return;
+		auto *blob = (*data)["blob"].GetValuePtr<udm::Blob>();
+		UDM_CHECK(blob && blob->data == std::vector<uint8_t> {0xFF, 0xFF, 0x00});
+		auto *blobLz4 = (*data)["blobLz4"].GetValuePtr<udm::BlobLz4>();
+		UDM_CHECK(blobLz4 && udm::Property::GetBlobData(*blobLz4).data == std::vector<uint8_t> {0xFF, 0xFF, 0xFF});
+		auto *utf8 = (*data)["utf8"].GetValuePtr<udm::Utf8String>();
+		UDM_CHECK(utf8 && utf8->data == std::vector<uint8_t> {0x01, 0xFF, 0xFF, 0xFF});
+		auto values = (*data)["values"];
+		UDM_CHECK(values.GetSize() == 4);
+		for(auto i = decltype(values.GetSize()) {0u}; i < values.GetSize(); ++i)
+			UDM_CHECK(values[i].ToValue<uint8_t>() == 0xFF);
+		UDM_CHECK((*data)["after"].ToValue<uint32_t>() == 5);
+		UDM_CHECK((*data)["child"]["after"].ToValue<uint32_t>() == 6);
+	}
+
+	void test_ascii_to_binary()
+	{
+		// The transcoder only scans the values, so it has to find the same boundaries as the parser
+		auto expected = udm::Data::LoadAsciiMapped(BASE64_FIXTURE);
+		auto f = std::make_unique<udm::VectorFile>();
+		udm::Data::TranscodeToBinaryMapped(BASE64_FIXTURE, *f);
+		auto data = load_binary(std::move(f));
+		UDM_CHECK(expected && data && *data == *expected);
+		if(data)
+			UDM_CHECK((*data)["child"]["after"].ToValue<uint32_t>() == 6);
+	}
+
+	void test_binary_to_ascii()
+	{
+		auto data = create_data();
+		udm::VectorFile bin {};
+		data->Save(bin);
+		for(auto flags : {udm::AsciiSaveFlags::Default, udm::AsciiSaveFlags::DontCompressLz4Arrays}) {
+			bin.Seek(0);
+			udm::VectorFile ascii {};
+			udm::Data::TranscodeToAscii(bin, ascii, flags);
+			auto contents = get_contents(ascii);
+			UDM_CHECK(contents.find("//") != std::string_view::npos);
+
+			auto loaded = udm::Data::LoadAscii(contents);
+			UDM_CHECK(loaded && *loaded == *data);
+
+			// And back again
+			auto f = std::make_unique<udm::VectorFile>();
+			udm::Data::TranscodeToBinary(contents, *f);
+			auto roundTrip = load_binary(std::move(f));
+			UDM_CHECK(roundTrip && *roundTrip == *data);
+		}
+	}
+
+	void test_nested_blocks()
+	{
+		// Child blocks and items of element arrays are skipped when their parent is scanned, and scanned again once they're transcoded
+		auto data = udm_test::create_data();
+		add_nested_blocks(data->GetAssetData().GetData(), 32);
+		udm::VectorFile bin {};
+		data->Save(bin);
+		bin.Seek(0);
+		udm::VectorFile ascii {};
+		udm::Data::TranscodeToAscii(bin, ascii);
+		auto contents = get_contents(ascii);
+		auto f = std::make_unique<udm::VectorFile>();
+		udm::Data::TranscodeToBinary(contents, *f);
+		auto transcoded = load_binary(std::move(f));
+		auto loaded = udm::Data::LoadAscii(contents);
+		UDM_CHECK(transcoded && loaded && *transcoded == *loaded && *transcoded == *data);
+	}
+}
+
+int main()
+{
+	return udm_test::run({
+	  {"base64_slashes", &test_base64_slashes},
+	  {"ascii_to_binary", &test_ascii_to_binary},
+	  {"binary_to_ascii", &test_binary_to_ascii},
+	  {"nested_blocks", &test_nested_blocks},
+	});
+}
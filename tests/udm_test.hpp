@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Minimal test helpers shared by the test executables, has to be included after "import pragma.udm;"
+
+#pragma once
+
+namespace udm_test {
+	inline uint32_t g_failures = 0;
+
+	inline void check(bool condition, std::string_view what, std::source_location loc = std::source_location::current())
+	{
+		if(condition)
+			return;
+		++g_failures;
+		std::cerr << loc.file_name() << ":" << loc.line() << ": Check failed: " << what << std::endl;
+	}
+
+	struct Test {
+		std::string_view name;
+		void (*func)();
+	};
+
+	// Runs all tests and returns the exit code for the test executable
+	inline int run(std::initializer_list<Test> tests)
+	{
+		for(auto &test : tests) {
+			auto failures = g_failures;
+			try {
+				test.func();
+			}
+			catch(const std::exception &e) {
+				++g_failures;
+				std::cerr << test.name << ": Unexpected exception: " << e.what() << std::endl;
+			}
+			std::cout << (g_failures == failures ? "[PASS] " : "[FAIL] ") << test.name << std::endl;
+		}
+		return (g_failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Adds an array of 'count' elements { n: int32 first + i }
+	inline udm::LinkedPropertyWrapper add_items(udm::Element &el, const std::string_view &key, uint32_t count, udm::ArrayType arrayType = udm::ArrayType::Raw, int32_t first = 0)
+	{
+		auto a = el.AddArray(key, count, udm::Type::Element, arrayType);
+		for(auto i = decltype(count) {0u}; i < count; ++i)
+			a[i]["n"] = static_cast<int32_t>(first + i);
+		return a;
+	}
+
+	// Fixture shared by the tests:
+	// { child { value: string "a", "a b" { c: int32 2 } }, arr: [string] { "x", "y" }, items: [element] { { n: int32 0 }, { n: int32 1 } },
+	//   compressed: arrayLz4 [element] { { n: int32 0 }, { n: int32 1 } } }
+	inline void fill_tree(udm::Element &el)
+	{
+		auto child = el.Add("child");
+		child["value"] = std::string {"a"};
+		child.Add("a b")["c"] = int32_t {2};
+		auto arr = el.AddArray("arr", 2, udm::Type::String);
+		arr[0] = std::string {"x"};
+		arr[1] = std::string {"y"};
+		add_items(el, "items", 2);
+		add_items(el, "compressed", 2, udm::ArrayType::Compressed);
+	}
+	inline udm::PProperty create_tree()
+	{
+		auto root = udm::Property::Create<udm::Element>();
+		fill_tree(root->GetValue<udm::Element>());
+		return root;
+	}
+	// Same as create_tree, but as the asset data of a document
+	inline std::shared_ptr<udm::Data> create_data()
+	{
+		auto data = udm::Data::Create("test", 1);
+		fill_tree(*data->GetAssetData().GetData().GetValuePtr<udm::Element>());
+		return data;
+	}
+}
+
+#define UDM_CHECK(cond) udm_test::check((cond), #cond)
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: © 2025 Silverlan <opensource@pragma-engine.com>
+// SPDX-License-Identifier: MIT
+
+// Converts UDM files between the binary and the ASCII format without loading them, e.g.:
+// udm_transcode --to-binary --ext pmdl assets/models out/models
+// Directories are converted recursively and in parallel, the output directory mirrors the input directory.
+
+import pragma.udm;
+
+namespace {
+	enum class Direction : uint8_t { ToBinary = 0, ToAscii };
+	struct Job {
+		std::filesystem::path input;
+		std::filesystem::path output;
+	};
+
+	void print_usage()
+	{
+		std::cout << "Usage: udm_transcode (--to-binary | --to-ascii) [options] <input> <output>\n"
+		          << "<input> and <output> can either be files or directories.\n"
+		          << "Options:\n"
+		          << "  --ext <extension>      ASCII extension of the files to convert in directories, can be specified multiple times (default: udm).\n"
+		          << "                         Binary files use the same extension with a \"_b\" suffix.\n"
+		          << "  --include-header       Include the asset header when writing ASCII files.\n"
+		          << "  --dont-compress-lz4    Write the values of compressed arrays when writing ASCII files.\n";
+	}
+
+	void transcode(const Job &job, Direction direction, udm::AsciiSaveFlags flags)
+	{
+		if(job.output.has_parent_path())
+			std::filesystem::create_directories(job.output.parent_path());
+		auto outMode = pragma::fs::FileMode::Write;
+		if(direction == Direction::ToBinary)
+			outMode |= pragma::fs::FileMode::Binary;
+		auto fOut = pragma::fs::open_system_file(job.output.string(), outMode);
+		if(!fOut)
+			throw udm::FileError {"Unable to open output file '" + job.output.string() + "'!"};
+		pragma::fs::File out {fOut};
+		if(direction == Direction::ToBinary) {
+			udm::Data::TranscodeToBinaryMapped(job.input.string(), out);
+			return;
+		}
+		auto fIn = pragma::fs::open_system_file(job.input.string(), pragma::fs::FileMode::Read | pragma::fs::FileMode::Binary);
+		if(!fIn)
+			throw udm::FileError {"Unable to open input file '" + job.input.string() + "'!"};
+		pragma::fs::File in {fIn};
+		udm::Data::TranscodeToAscii(in, out, flags);
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	std::optional<Direction> direction {};
+	auto flags = udm::AsciiSaveFlags::Default;
+	std::vector<std::string> extensions;
+	std::vector<std::filesystem::path> paths;
+	for(auto i = 1; i < argc; ++i) {
+		std::string_view arg {argv[i]};
+		if(arg == "--to-binary")
+			direction = Direction::ToBinary;
+		else if(arg == "--to-ascii")
+			direction = Direction::ToAscii;
+		else if(arg == "--include-header")
+			flags |= udm::AsciiSaveFlags::IncludeHeader;
+		else if(arg == "--dont-compress-lz4")
+			flags |= udm::AsciiSaveFlags::DontCompressLz4Arrays;
+		else if(arg == "--ext" && i + 1 < argc)
+			extensions.push_back(argv[++i]);
+		else if(arg.starts_with("--")) {
+			print_usage();
+			return 1;
+		}
+		else
+			paths.push_back(argv[i]);
+	}
+	if(!direction.has_value() || paths.size() != 2) {
+		print_usage();
+		return 1;
+	}
+	if(extensions.empty())
+		extensions.push_back("udm");
+
+	auto &input = paths[0];
+	auto &output = paths[1];
+	std::vector<Job> jobs;
+	if(std::filesystem::is_directory(input)) {
+		for(auto &entry : std::filesystem::recursive_directory_iterator {input}) {
+			if(!entry.is_regular_file())
+				continue;
+			auto ext = entry.path().extension().string();
+			if(ext.empty())
+				continue;
+			ext = ext.substr(1);
+			for(auto &asciiExt : extensions) {
+				auto binaryExt = asciiExt + "_b";
+				auto &inExt = (*direction == Direction::ToBinary) ? asciiExt : binaryExt;
+				if(ext != inExt)
+					continue;
+				auto outPath = output / std::filesystem::relative(entry.path(), input);
+				outPath.replace_extension((*direction == Direction::ToBinary) ? binaryExt : asciiExt);
+				jobs.push_back({entry.path(), std::move(outPath)});
+				break;
+			}
+		}
+	}
+	else
+		jobs.push_back({input, output});
+
+	std::mutex errorMutex;
+	std::vector<std::string> errors;
+	udm::parallel_for(
+	  static_cast<uint32_t>(jobs.size()),
+	  [&jobs, &direction, flags, &errorMutex, &errors](uint32_t, uint32_t start, uint32_t end) {
+		  for(auto i = start; i < end; ++i) {
+			  auto &job = jobs[i];
+			  try {
+				  transcode(job, *direction, flags);
+			  }
+			  catch(const std::exception &e) {
+				  // Don't leave incomplete files behind
+				  std::error_code ec;
+				  std::filesystem::remove(job.output, ec);
+				  std::scoped_lock lock {errorMutex};
+				  errors.push_back(job.input.string() + ": " + e.what());
+			  }
+		  }
+	  },
+	  1);
+
+	for(auto &err : errors)
+		std::cerr << "Failed to convert " << err << std::endl;
+	std::cout << "Converted " << (jobs.size() - errors.size()) << " of " << jobs.size() << " file(s)." << std::endl;
+	return errors.empty() ? 0 : 1;
+}